@@ -771,11 +771,26 @@ bool ts::Names::AllInstances::loadFile(const UString& file_name)
 ts::NamesPtr ts::Names::AllInstances::get(const UString& section_name, const UString& file_name, bool create)
 {
     std::lock_guard<std::mutex> lock(_mutex);
-    if (!file_name.empty()) {
-        // Ignore errors (logged on standard error)
-        loadFileLocked(file_name);
+
+    // Fast path: same file and section as a previous call.
+    const auto file_it = _cache.find(file_name);
+    if (file_it != _cache.end()) {
+        const auto sec_it = file_it->second.find(section_name);
+        if (sec_it != file_it->second.end()) {
+            return sec_it->second;
+        }
+    }
+
+    // Ignore errors (logged on standard error)
+    const bool loaded = file_name.empty() || loadFileLocked(file_name);
+    NamesPtr sec(getLocked(section_name, create));
+
+    // Once in the repository, a section stays there forever and can be cached.
+    // If the file could not be loaded, don't cache the section to retry later.
+    if (sec != nullptr && loaded) {
+        _cache[file_name][section_name] = sec;
     }
-    return getLocked(section_name, create);
+    return sec;
 }
 
 // Get or create a section with exclusive lock already held.
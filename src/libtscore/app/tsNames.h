@@ -638,6 +638,10 @@ namespace ts {
             std::set<UString> _loaded_files {};
             std::map<UString, NamesPtr> _names {};
 
+            // Cache of sections, indexed by file name and section name, as provided by the callers.
+            // Avoid the normalization of the section name and the search of the file on each call.
+            std::map<UString, std::map<UString, NamesPtr>> _cache {};
+
             // Load a file with exclusive lock already held.
             bool loadFileLocked(const UString& file_name);
 
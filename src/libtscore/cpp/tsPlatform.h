@@ -434,6 +434,22 @@
     #define TS_NO_ARM_CRC32_INSTRUCTIONS
 #endif
 
+//!
+//! Define TS_NO_SSE2_INSTRUCTIONS from the command line if you want to disable the usage of Intel SSE2 instructions.
+//! @ingroup cpp
+//!
+#if defined(DOXYGEN)
+    #define TS_NO_SSE2_INSTRUCTIONS
+#endif
+
+//!
+//! Define TS_NO_ARM_NEON_INSTRUCTIONS from the command line if you want to disable the usage of Arm64 Neon instructions.
+//! @ingroup cpp
+//!
+#if defined(DOXYGEN)
+    #define TS_NO_ARM_NEON_INSTRUCTIONS
+#endif
+
 
 //----------------------------------------------------------------------------
 // Static linking.
@@ -22,9 +22,15 @@
     #define TS_ARM_CRC32_INSTRUCTIONS 1
 #endif
 
+// Check if Intel x86-64 carry-less multiplication instructions can be used.
+#if defined(TS_X86_64) && defined(__PCLMUL__) && defined(__SSE4_1__) && !defined(TS_NO_X86_CRC32_INSTRUCTIONS)
+    #define TS_X86_CRC32_INSTRUCTIONS 1
+    #include <immintrin.h>
+#endif
+
 // "Hidden" exported bool to inform the SysInfo class that we have compiled accelerated instructions.
 extern const bool tsCRC32IsAccelerated =
-#if defined(TS_ARM_CRC32_INSTRUCTIONS)
+#if defined(TS_ARM_CRC32_INSTRUCTIONS) || defined(TS_X86_CRC32_INSTRUCTIONS)
     true;
 #else
     false;
@@ -45,6 +51,9 @@ uint32_t ts::CRC32::valueAccel() const
     uint32_t x;
     asm("rbit %w0, %w1" : "=r" (x) : "r" (_fcs));
     return x;
+#elif defined(TS_X86_CRC32_INSTRUCTIONS)
+    // With the Intel implementation, the CRC32 value is always directly usable.
+    return _fcs;
 #else
     // Shall not be called.
     assert(false);
@@ -88,6 +97,82 @@ namespace {
 #endif
 
 
+//----------------------------------------------------------------------------
+// Basic operations for the Intel x86-64 carry-less multiplication.
+//----------------------------------------------------------------------------
+
+#if defined(TS_X86_CRC32_INSTRUCTIONS)
+namespace {
+
+    // The MPEG-2 CRC32 is not bit-reflected. The data are loaded in 128-bit
+    // registers in reverse byte order, so that bit N of the register is the
+    // coefficient of X^N in the polynomial of the data block. The CRC32 of a
+    // message M, starting from a previous CRC C, is (M * X^32) mod P where C is
+    // first xor-ed with the first 32 bits of M, P being the generator polynomial.
+    //
+    // A 128-bit accumulator H * X^64 + L is "folded" over the next data block B,
+    // 128 bits away, as H * (X^192 mod P) + L * (X^128 mod P) + B. When folding
+    // four accumulators in parallel over 512 bits, the constants become X^576 mod P
+    // and X^512 mod P. All constants are lower than 2^32 and products fit in 96 bits.
+    // See Intel white paper "Fast CRC Computation for Generic Polynomials Using
+    // PCLMULQDQ Instruction" for more details.
+
+    // Constants for folding: low 64 bits for L, high 64 bits for H. Not declared as static
+    // objects to avoid dynamic initialization using instructions which may not be supported.
+    inline __m128i foldBy1() { return _mm_set_epi64x(0xC5B9CD4C, 0xE8A45605); } // X^192 mod P, X^128 mod P
+    inline __m128i foldBy4() { return _mm_set_epi64x(0x8833794C, 0xE6228B11); } // X^576 mod P, X^512 mod P
+
+    // Constants for the final reduction.
+    constexpr uint64_t X96_MOD_P = 0xF200AA66;   // X^96 mod P
+    constexpr uint64_t X64_MOD_P = 0x490D678D;   // X^64 mod P
+    constexpr uint64_t X64_DIV_P = 0x104D101DF;  // X^64 div P, for Barrett reduction
+    constexpr uint64_t POLY = 0x104C11DB7;       // P
+
+    // Load 16 bytes in reverse byte order.
+    inline __m128i load128(const uint8_t* data)
+    {
+        const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), reverse);
+    }
+
+    // Load the first 16 bytes of a message, with the previous CRC.
+    inline __m128i loadFirst(const uint8_t* data, uint32_t fcs)
+    {
+        return _mm_xor_si128(load128(data), _mm_set_epi32(int(fcs), 0, 0, 0));
+    }
+
+    // Fold an accumulator over the next data block.
+    inline __m128i fold(__m128i acc, __m128i k, __m128i next)
+    {
+        return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(acc, k, 0x11), _mm_clmulepi64_si128(acc, k, 0x00)), next);
+    }
+
+    // Carry-less multiplication of two 64-bit values.
+    inline __m128i clmul64(uint64_t a, uint64_t b)
+    {
+        return _mm_clmulepi64_si128(_mm_cvtsi64_si128(int64_t(a)), _mm_cvtsi64_si128(int64_t(b)), 0x00);
+    }
+
+    // Reduce a 128-bit accumulator into a CRC32 value: (acc * X^32) mod P.
+    inline uint32_t reduce(__m128i acc)
+    {
+        // H * (X^96 mod P) + L * X^32, which fits in 96 bits.
+        const __m128i v = _mm_xor_si128(_mm_clmulepi64_si128(acc, _mm_cvtsi64_si128(int64_t(X96_MOD_P)), 0x01),
+                                        _mm_slli_si128(_mm_move_epi64(acc), 4));
+        // Upper 32 bits * (X^64 mod P) + lower 64 bits, which fits in 64 bits.
+        const uint64_t w = uint64_t(_mm_cvtsi128_si64(_mm_clmulepi64_si128(_mm_srli_si128(v, 8), _mm_cvtsi64_si128(int64_t(X64_MOD_P)), 0x00))) ^
+                           uint64_t(_mm_cvtsi128_si64(v));
+        // Barrett reduction of the 64-bit value: w - floor(w / P) * P.
+        const uint64_t q = uint64_t(_mm_cvtsi128_si64(clmul64(w >> 32, X64_DIV_P))) >> 32;
+        return uint32_t(w ^ uint64_t(_mm_cvtsi128_si64(clmul64(q, POLY))));
+    }
+
+    // Minimum size of data to use the carry-less multiplication. Below this, the portable version is faster.
+    constexpr size_t MIN_CLMUL_SIZE = 32;
+}
+#endif
+
+
 //----------------------------------------------------------------------------
 // Continue the computation of a data area, following a previous CRC32.
 //----------------------------------------------------------------------------
@@ -133,8 +218,98 @@ void ts::CRC32::addAccel(const void* data, size_t size)
     while (size--) {
         crcAdd8(_fcs, *cp8++);
     }
+#elif defined(TS_X86_CRC32_INSTRUCTIONS)
+    const uint8_t* cp = reinterpret_cast<const uint8_t*>(data);
+    if (size < MIN_CLMUL_SIZE) {
+        addStd(cp, size);
+        return;
+    }
+
+    // Fold four accumulators in parallel over 64-byte blocks.
+    __m128i acc = loadFirst(cp, _fcs);
+    if (size >= 128) {
+        __m128i acc1 = load128(cp + 16);
+        __m128i acc2 = load128(cp + 32);
+        __m128i acc3 = load128(cp + 48);
+        cp += 64;
+        size -= 64;
+        while (size >= 64) {
+            acc = fold(acc, foldBy4(), load128(cp));
+            acc1 = fold(acc1, foldBy4(), load128(cp + 16));
+            acc2 = fold(acc2, foldBy4(), load128(cp + 32));
+            acc3 = fold(acc3, foldBy4(), load128(cp + 48));
+            cp += 64;
+            size -= 64;
+        }
+        acc = fold(fold(fold(acc, foldBy1(), acc1), foldBy1(), acc2), foldBy1(), acc3);
+    }
+    else {
+        cp += 16;
+        size -= 16;
+    }
+
+    // Fold remaining 16-byte blocks, then add remaining bytes.
+    while (size >= 16) {
+        acc = fold(acc, foldBy1(), load128(cp));
+        cp += 16;
+        size -= 16;
+    }
+    _fcs = reduce(acc);
+    addStd(cp, size);
 #else
     // Shall not be called.
     assert(false);
 #endif
 }
+
+
+//----------------------------------------------------------------------------
+// Compute the CRC32 of ACCEL_LANES data areas in parallel.
+//----------------------------------------------------------------------------
+
+bool ts::CRC32::ComputeManyAccel(const void* const data[], const size_t size[], uint32_t crc[])
+{
+#if defined(TS_X86_CRC32_INSTRUCTIONS)
+    // Interleaving the folding of several independent areas hides the latency of the carry-less multiplications.
+    const uint8_t* cp[ACCEL_LANES];
+    size_t remain[ACCEL_LANES];
+    __m128i acc[ACCEL_LANES];
+    size_t common = std::numeric_limits<size_t>::max();
+    for (size_t i = 0; i < ACCEL_LANES; ++i) {
+        if (size[i] < MIN_CLMUL_SIZE) {
+            return false;
+        }
+        cp[i] = reinterpret_cast<const uint8_t*>(data[i]);
+        acc[i] = loadFirst(cp[i], 0xFFFFFFFF);
+        cp[i] += 16;
+        remain[i] = size[i] - 16;
+        common = std::min(common, remain[i] / 16);
+    }
+
+    // Fold the 16-byte blocks which are common to all areas.
+    for (size_t blk = 0; blk < common; ++blk) {
+        for (size_t i = 0; i < ACCEL_LANES; ++i) {
+            acc[i] = fold(acc[i], foldBy1(), load128(cp[i]));
+            cp[i] += 16;
+        }
+    }
+
+    // Terminate each area individually.
+    for (size_t i = 0; i < ACCEL_LANES; ++i) {
+        remain[i] -= 16 * common;
+        while (remain[i] >= 16) {
+            acc[i] = fold(acc[i], foldBy1(), load128(cp[i]));
+            cp[i] += 16;
+            remain[i] -= 16;
+        }
+        CRC32 last;
+        last._fcs = reduce(acc[i]);
+        last.addStd(cp[i], remain[i]);
+        crc[i] = last._fcs;
+    }
+    return true;
+#else
+    // Not implemented, use individual computations.
+    return false;
+#endif
+}
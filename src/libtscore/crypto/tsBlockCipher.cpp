@@ -95,6 +95,24 @@ bool ts::BlockCipher::isValidIVSize(size_t size) const
 }
 
 
+//----------------------------------------------------------------------------
+// Check if the basic algorithm can process several contiguous blocks.
+//----------------------------------------------------------------------------
+
+bool ts::BlockCipher::multiBlocksImpl() const
+{
+    // When the system-provided library is used, the algorithm handle is set
+    // with the key. Other implementations process one block at a time.
+#if defined(TS_WINDOWS)
+    return _hkey != nullptr;
+#elif !defined(TS_NO_OPENSSL)
+    return _algo != nullptr;
+#else
+    return false;
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Get the algorithm handle. This is the default implementation, for
 // subclasses not using OpenSSL or Windows BCrypt.
@@ -219,6 +219,12 @@ namespace ts {
         //!
         static constexpr size_t UNLIMITED = std::numeric_limits<size_t>::max();
 
+        //!
+        //! Maximum number of independent blocks which are grouped in one call to the basic algorithm
+        //! by the chaining modes, when the basic algorithm can process several blocks at once.
+        //!
+        static constexpr size_t MULTI_BLOCKS = 16;
+
         //!
         //! Set the maximum number of times a key should be used for encryption.
         //! The default initial value is UNLIMITED.
@@ -320,6 +326,18 @@ namespace ts {
         //!
         void canProcessInPlace(bool can_do) { _can_process_in_place = can_do; }
 
+        //!
+        //! Check if the basic algorithm can process several contiguous blocks in one call.
+        //! This is the case when the basic algorithm is implemented by the system-provided cryptographic
+        //! library. The default encryptImpl() and decryptImpl() then accept any multiple of the block size
+        //! and the library uses its pipelined implementations, based on hardware-accelerated instructions
+        //! when available (AES-NI on Intel, cryptographic extensions on Arm64). Chaining modes use this
+        //! to process independent blocks by groups of up to MULTI_BLOCKS blocks.
+        //! @return True if encryptImpl() and decryptImpl() of the basic algorithm accept several blocks.
+        //! This is known after a key is successfully set.
+        //!
+        bool multiBlocksImpl() const;
+
 #if defined(TS_WINDOWS) || defined(DOXYGEN)
         //!
         //! Get the algorithm handle and subobject size, when the subclass uses Microsoft BCrypt library.
@@ -341,6 +359,22 @@ namespace ts {
     protected:
         ByteBlock work {}; //!< Temporary working buffer.
 
+        //!
+        //! Check if encryption is allowed with the current key and count one more usage of the key.
+        //! This is automatically done by encrypt(). Subclasses which implement specific bulk
+        //! encryption methods shall invoke it once per encrypted message.
+        //! @return True if encryption is allowed, false otherwise.
+        //!
+        bool allowEncrypt();
+
+        //!
+        //! Check if decryption is allowed with the current key and count one more usage of the key.
+        //! This is automatically done by decrypt(). Subclasses which implement specific bulk
+        //! decryption methods shall invoke it once per decrypted message.
+        //! @return True if decryption is allowed, false otherwise.
+        //!
+        bool allowDecrypt();
+
     private:
         bool      _can_process_in_place = false;      // The subclass can encrypt and decrypt in place (identical in/out buffers).
         bool      _key_set = false;                   // Current key successfully set.
@@ -353,10 +387,6 @@ namespace ts {
         ByteBlock _current_iv {};                     // Current initialization vector.
         BlockCipherAlertInterface* _alert = nullptr;  // Alert handler.
 
-        // Check if encryption or decryption is allowed. Increment counters when allowed.
-        bool allowEncrypt();
-        bool allowDecrypt();
-
         // System-specific cryptographic library.
 #if defined(TS_WINDOWS)
         ::BCRYPT_ALG_HANDLE _algo = nullptr;
@@ -59,9 +59,10 @@ namespace ts {
 template<class CIPHER> requires std::derived_from<CIPHER, ts::BlockCipher>
 const ts::BlockCipherProperties& ts::CBC<CIPHER>::Properties()
 {
-    // Need 3 work blocks. The last 2 are only used with "in place" decryption.
+    // Need 1 work block for encryption. Decryption needs 1 work block for the previous
+    // cipher block and MULTI_BLOCKS work blocks to save the cipher text in "in place" mode.
     // Thread-safe init-safe static data pattern:
-    static const BlockCipherProperties props(CIPHER::Properties(), u"CBC", false, CIPHER::BLOCK_SIZE, 3, CIPHER::BLOCK_SIZE);
+    static const BlockCipherProperties props(CIPHER::Properties(), u"CBC", false, CIPHER::BLOCK_SIZE, 1 + BlockCipher::MULTI_BLOCKS, CIPHER::BLOCK_SIZE);
     return props;
 }
 
@@ -129,7 +130,6 @@ bool ts::CBC<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, void
     const size_t bsize = this->properties.block_size;
     uint8_t* work1 = this->work.data();
     uint8_t* work2 = this->work.data() + bsize;
-    uint8_t* work3 = this->work.data() + 2 * bsize;
 
     if (cipher_length % bsize != 0 || this->currentIV().size() != bsize || plain_maxsize < cipher_length) {
         return false;
@@ -142,28 +142,36 @@ bool ts::CBC<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, void
     const uint8_t* ct = reinterpret_cast<const uint8_t*>(cipher);
     uint8_t* pt = reinterpret_cast<uint8_t*>(plain);
 
+    // Unlike encryption, the block decryptions are independent. Process them by groups when possible.
+    const size_t chunk = (this->multiBlocksImpl() ? BlockCipher::MULTI_BLOCKS : 1) * bsize;
+
     while (cipher_length > 0) {
-        // work = decrypt (cipher-text)
-        if (!CIPHER::decryptImpl(ct, bsize, work1, bsize, nullptr)) {
+        const size_t size = std::min(cipher_length, chunk);
+        // With overlapping buffer, need to save current cipher.
+        const uint8_t* input = ct;
+        if (pt == ct) {
+            MemCopy(work2, ct, size);
+            input = work2;
+        }
+        // plain-text = decrypt (cipher-text)
+        if (!CIPHER::decryptImpl(input, size, pt, size, nullptr)) {
             return false;
         }
-        // plain-text = previous-cipher XOR work.
-        // previous-cipher = cipher-text
+        // plain-text = plain-text XOR previous-cipher
+        MemXor(pt, pt, previous, bsize);
+        MemXor(pt + bsize, pt + bsize, input, size - bsize);
+        // previous-cipher = last cipher-text
         if (pt == ct) {
-            // With overlapping buffer, need to save current cipher.
-            MemCopy(work2, ct, bsize);
-            MemXor(pt, previous, work1, bsize);
-            previous = work2;
-            std::swap(work2, work3);
+            MemCopy(work1, input + size - bsize, bsize);
+            previous = work1;
         }
         else {
-            MemXor(pt, previous, work1, bsize);
-            previous = ct;
+            previous = ct + size - bsize;
         }
-        // advance one block
-        ct += bsize;
-        pt += bsize;
-        cipher_length -= bsize;
+        // advance the group of blocks
+        ct += size;
+        pt += size;
+        cipher_length -= size;
     }
 
     return true;
@@ -19,6 +19,11 @@ volatile bool ts::CRC32::_accel_supported = false;
 //----------------------------------------------------------------------------
 
 ts::CRC32::CRC32()
+{
+    CheckAcceleration();
+}
+
+void ts::CRC32::CheckAcceleration()
 {
     // Check once if CRC32 acceleration is supported at runtime.
     // This logic does not require explicit synchronization.
@@ -127,10 +132,43 @@ void ts::CRC32::add(const void* data, size_t size)
         addAccel(data, size);
     }
     else {
-        // Portable implementation, using the pre-computed table.
-        const uint8_t* cp = reinterpret_cast<const uint8_t*>(data);
-        while (size-- > 0) {
-            _fcs = (_fcs << 8) ^ _fcstab_32[((_fcs >> 24) ^ (*cp++)) & 0xFF];
+        addStd(data, size);
+    }
+}
+
+void ts::CRC32::addStd(const void* data, size_t size)
+{
+    // Portable implementation, using the pre-computed table.
+    const uint8_t* cp = reinterpret_cast<const uint8_t*>(data);
+    while (size-- > 0) {
+        _fcs = (_fcs << 8) ^ _fcstab_32[((_fcs >> 24) ^ (*cp++)) & 0xFF];
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Check the CRC32 of several data areas at once.
+//----------------------------------------------------------------------------
+
+size_t ts::CRC32::CheckMany(const void* const data[], const size_t size[], bool valid[], size_t count)
+{
+    CheckAcceleration();
+
+    // The CRC32 of a data area, including its own CRC32, is zero when it is valid.
+    // Areas which are too short to contain a CRC32 are invalid.
+    size_t valid_count = 0;
+    for (size_t first = 0; first < count; first += ACCEL_LANES) {
+        const size_t lanes = std::min(ACCEL_LANES, count - first);
+        uint32_t crc[ACCEL_LANES];
+        if (!_accel_supported || lanes < ACCEL_LANES || !ComputeManyAccel(data + first, size + first, crc)) {
+            for (size_t i = 0; i < lanes; ++i) {
+                crc[i] = CRC32(data[first + i], size[first + i]).value();
+            }
+        }
+        for (size_t i = 0; i < lanes; ++i) {
+            valid[first + i] = size[first + i] >= 4 && crc[i] == 0;
+            valid_count += valid[first + i];
         }
     }
+    return valid_count;
 }
@@ -69,6 +69,19 @@ namespace ts {
         //!
         void reset() { _fcs = 0xFFFFFFFF; }
 
+        //!
+        //! Check the CRC32 of several data areas at once, typically complete MPEG sections.
+        //! Each data area shall end with the 4-byte CRC32 of all preceding bytes, in big endian order.
+        //! When accelerated instructions are available, several data areas are processed in parallel,
+        //! which is faster than checking each data area individually.
+        //! @param [in] data Array of @a count addresses of data areas.
+        //! @param [in] size Array of @a count sizes in bytes of the data areas.
+        //! @param [out] valid Array of @a count booleans receiving the result for each data area.
+        //! @param [in] count Number of data areas.
+        //! @return The number of data areas with a valid CRC32.
+        //!
+        static size_t CheckMany(const void* const data[], const size_t size[], bool valid[], size_t count);
+
         //!
         //! What to do with a CRC32.
         //! Used when building MPEG sections.
@@ -86,8 +99,16 @@ namespace ts {
         static volatile bool _accel_checked;
         static volatile bool _accel_supported;
 
+        static void CheckAcceleration();
+
+        // Portable version.
+        void addStd(const void* data, size_t size);
+
         // Accelerated versions, compiled in a separated module.
+        // ComputeManyAccel() computes the CRC32 of ACCEL_LANES areas in parallel, when possible.
+        static constexpr size_t ACCEL_LANES = 4;
         uint32_t valueAccel() const;
         void addAccel(const void* data, size_t size);
+        static bool ComputeManyAccel(const void* const data[], const size_t size[], uint32_t crc[]);
     };
 }
@@ -84,8 +84,9 @@ namespace ts {
 template<class CIPHER> requires std::derived_from<CIPHER, ts::BlockCipher>
 const ts::BlockCipherProperties& ts::CTR<CIPHER>::Properties()
 {
+    // Work blocks: the counter, then MULTI_BLOCKS successive counters and their encrypted values.
     // Thread-safe init-safe static data pattern:
-    static const BlockCipherProperties props(CIPHER::Properties(), u"CTR", true, 0, 2, CIPHER::BLOCK_SIZE);
+    static const BlockCipherProperties props(CIPHER::Properties(), u"CTR", true, 0, 1 + 2 * BlockCipher::MULTI_BLOCKS, CIPHER::BLOCK_SIZE);
     return props;
 }
 
@@ -148,6 +149,7 @@ bool ts::CTR<CIPHER>::encryptImpl(const void* plain, size_t plain_length, void*
     const size_t bsize = this->properties.block_size;
     uint8_t* work1 = this->work.data();
     uint8_t* work2 = this->work.data() + bsize;
+    uint8_t* work3 = this->work.data() + (1 + BlockCipher::MULTI_BLOCKS) * bsize;
 
     if (plain_length % bsize != 0 || this->currentIV().size() != bsize || cipher_maxsize < plain_length) {
         return false;
@@ -159,22 +161,28 @@ bool ts::CTR<CIPHER>::encryptImpl(const void* plain, size_t plain_length, void*
     // work1 = iv
     MemCopy(work1, this->currentIV().data(), bsize);
 
-    // Loop on all blocks, including last truncated one.
+    // The encryptions of successive counters are independent. Process them by groups when possible.
+    const size_t chunk = (this->multiBlocksImpl() ? BlockCipher::MULTI_BLOCKS : 1) * bsize;
+
+    // Loop on all groups of blocks.
     const uint8_t* pt = reinterpret_cast<const uint8_t*>(plain);
     uint8_t* ct = reinterpret_cast<uint8_t*>(cipher);
 
     while (plain_length > 0) {
-        // work2 = encrypt(work1)
-        if (!CIPHER::encryptImpl(work1, bsize, work2, bsize, nullptr)) {
+        // This group size:
+        const size_t size = std::min(plain_length, chunk);
+        // work2 = successive values of work1, work1 += 1 for each block
+        for (size_t i = 0; i < size; i += bsize) {
+            MemCopy(work2 + i, work1, bsize);
+            incrementCounter();
+        }
+        // work3 = encrypt(work2)
+        if (!CIPHER::encryptImpl(work2, size, work3, size, nullptr)) {
             return false;
         }
-        // This block size:
-        const size_t size = std::min(plain_length, bsize);
-        // cipher-text = plain-text XOR work2
-        MemXor(ct, work2, pt, size);
-        // work1 += 1
-        incrementCounter();
-        // advance one block
+        // cipher-text = plain-text XOR work3
+        MemXor(ct, work3, pt, size);
+        // advance the group of blocks
         ct += size;
         pt += size;
         plain_length -= size;
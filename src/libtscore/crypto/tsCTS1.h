@@ -63,7 +63,7 @@ template<class CIPHER> requires std::derived_from<CIPHER, ts::BlockCipher>
 const ts::BlockCipherProperties& ts::CTS1<CIPHER>::Properties()
 {
     // Thread-safe init-safe static data pattern:
-    static const BlockCipherProperties props(CIPHER::Properties(), u"CTS1", true, CIPHER::BLOCK_SIZE + 1, 3, CIPHER::BLOCK_SIZE);
+    static const BlockCipherProperties props(CIPHER::Properties(), u"CTS1", true, CIPHER::BLOCK_SIZE + 1, 3 + BlockCipher::MULTI_BLOCKS, CIPHER::BLOCK_SIZE);
     return props;
 }
 
@@ -147,6 +147,7 @@ bool ts::CTS1<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, voi
     uint8_t* work1 = this->work.data();
     uint8_t* work2 = this->work.data() + bsize;
     uint8_t* work3 = this->work.data() + 2 * bsize;
+    uint8_t* work4 = this->work.data() + 3 * bsize;
 
     // Data shorter than block size cannot be encrypted.
     // Note that CTS mode requires at least TWO blocks (the last one may
@@ -166,28 +167,38 @@ bool ts::CTS1<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, voi
     const uint8_t* ct = reinterpret_cast<const uint8_t*>(cipher);
     uint8_t* pt = reinterpret_cast<uint8_t*>(plain);
 
-    while (cipher_length > 2 * bsize) {
-        // work = decrypt (cipher-text)
-        if (!CIPHER::decryptImpl(ct, bsize, work1, bsize, nullptr)) {
+    // The block decryptions are independent. Process them by groups when possible.
+    const size_t chunk = (this->multiBlocksImpl() ? BlockCipher::MULTI_BLOCKS : 1) * bsize;
+    size_t cbc_size = cipher_length > 2 * bsize ? (cipher_length - bsize - 1) / bsize * bsize : 0;
+    cipher_length -= cbc_size;
+
+    while (cbc_size > 0) {
+        const size_t size = std::min(cbc_size, chunk);
+        // With overlapping buffer, need to save current cipher.
+        const uint8_t* input = ct;
+        if (pt == ct) {
+            MemCopy(work4, ct, size);
+            input = work4;
+        }
+        // plain-text = decrypt (cipher-text)
+        if (!CIPHER::decryptImpl(input, size, pt, size, nullptr)) {
             return false;
         }
-        // plain-text = previous-cipher XOR work.
-        // previous-cipher = cipher-text
+        // plain-text = plain-text XOR previous-cipher
+        MemXor(pt, pt, previous, bsize);
+        MemXor(pt + bsize, pt + bsize, input, size - bsize);
+        // previous-cipher = last cipher-text
         if (pt == ct) {
-            // With overlapping buffer, need to save current cipher.
-            MemCopy(work2, ct, bsize);
-            MemXor(pt, previous, work1, bsize);
-            previous = work2;
-            std::swap(work2, work3);
+            MemCopy(work3, input + size - bsize, bsize);
+            previous = work3;
         }
         else {
-            MemXor(pt, previous, work1, bsize);
-            previous = ct;
+            previous = ct + size - bsize;
         }
-        // advance one block
-        ct += bsize;
-        pt += bsize;
-        cipher_length -= bsize;
+        // advance the group of blocks
+        ct += size;
+        pt += size;
+        cbc_size -= size;
     }
 
     // Process final two blocks.
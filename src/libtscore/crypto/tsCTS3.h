@@ -92,15 +92,18 @@ bool ts::CTS3<CIPHER>::encryptImpl(const void* plain, size_t plain_length, void*
     const uint8_t* pt = reinterpret_cast<const uint8_t*>(plain);
     uint8_t* ct = reinterpret_cast<uint8_t*>(cipher);
 
-    // Process in ECB mode, except the last 2 blocks
-    while (plain_length > 2 * bsize) {
-        if (!CIPHER::encryptImpl(pt, bsize, ct, bsize, nullptr)) {
+    // Process in ECB mode, except the last 2 blocks.
+    // These blocks are independent, process them at once when possible.
+    const size_t ecb_size = plain_length > 2 * bsize ? (plain_length - bsize - 1) / bsize * bsize : 0;
+    const size_t chunk = this->multiBlocksImpl() ? ecb_size : bsize;
+    for (size_t done = 0; done < ecb_size; done += chunk) {
+        if (!CIPHER::encryptImpl(pt + done, chunk, ct + done, chunk, nullptr)) {
             return false;
         }
-        ct += bsize;
-        pt += bsize;
-        plain_length -= bsize;
     }
+    ct += ecb_size;
+    pt += ecb_size;
+    plain_length -= ecb_size;
 
     // Process final two blocks.
     assert(plain_length > bsize);
@@ -156,15 +159,18 @@ bool ts::CTS3<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, voi
     const uint8_t* ct = reinterpret_cast<const uint8_t*>(cipher);
     uint8_t* pt = reinterpret_cast<uint8_t*>(plain);
 
-    // Process in ECB mode, except the last 2 blocks
-    while (cipher_length > 2 * bsize) {
-        if (!CIPHER::decryptImpl(ct, bsize, pt, bsize, nullptr)) {
+    // Process in ECB mode, except the last 2 blocks.
+    // These blocks are independent, process them at once when possible.
+    const size_t ecb_size = cipher_length > 2 * bsize ? (cipher_length - bsize - 1) / bsize * bsize : 0;
+    const size_t chunk = this->multiBlocksImpl() ? ecb_size : bsize;
+    for (size_t done = 0; done < ecb_size; done += chunk) {
+        if (!CIPHER::decryptImpl(ct + done, chunk, pt + done, chunk, nullptr)) {
             return false;
         }
-        ct += bsize;
-        pt += bsize;
-        cipher_length -= bsize;
     }
+    ct += ecb_size;
+    pt += ecb_size;
+    cipher_length -= ecb_size;
 
     // Process final two blocks.
     assert(cipher_length > bsize);
@@ -98,13 +98,16 @@ bool ts::ECB<CIPHER>::encryptImpl(const void* plain, size_t plain_length, void*
     const uint8_t* pt = reinterpret_cast<const uint8_t*>(plain);
     uint8_t* ct = reinterpret_cast<uint8_t*>(cipher);
 
+    // All blocks are independent, process them at once when possible.
+    const size_t chunk = this->multiBlocksImpl() ? plain_length : bsize;
+
     while (plain_length > 0) {
-        if (!CIPHER::encryptImpl(pt, bsize, ct, bsize, nullptr)) {
+        if (!CIPHER::encryptImpl(pt, chunk, ct, chunk, nullptr)) {
             return false;
         }
-        ct += bsize;
-        pt += bsize;
-        plain_length -= bsize;
+        ct += chunk;
+        pt += chunk;
+        plain_length -= chunk;
     }
 
     return true;
@@ -131,13 +134,16 @@ bool ts::ECB<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, void
     const uint8_t* ct = reinterpret_cast<const uint8_t*>(cipher);
     uint8_t* pt = reinterpret_cast<uint8_t*>(plain);
 
+    // All blocks are independent, process them at once when possible.
+    const size_t chunk = this->multiBlocksImpl() ? cipher_length : bsize;
+
     while (cipher_length > 0) {
-        if (!CIPHER::decryptImpl(ct, bsize, pt, bsize, nullptr)) {
+        if (!CIPHER::decryptImpl(ct, chunk, pt, chunk, nullptr)) {
             return false;
         }
-        ct += bsize;
-        pt += bsize;
-        cipher_length -= bsize;
+        ct += chunk;
+        pt += chunk;
+        cipher_length -= chunk;
     }
 
     return true;
@@ -224,45 +224,44 @@ bool ts::json::OutputArgs::report(const json::Value& root, json::RunningDocument
 }
 
 bool ts::json::OutputArgs::report(const json::Value& root, Report& rep)
+{
+    if (useLine()) {
+        // Generate one JSON line. When sent over the network, use a UTF-8 string.
+        std::string line8;
+        root.oneLiner(rep).toUTF8(line8);
+        return reportLine(line8, rep);
+    }
+    return true;
+}
+
+bool ts::json::OutputArgs::reportLine(const std::string& line, Report& rep)
 {
     bool udp_ok = true;
     bool tcp_ok = true;
 
-    if (_json_line || _json_tcp || _json_udp) {
-
-        // Generate one JSON line.
-        const UString line(root.oneLiner(rep));
-
-        // When sent over the network, use a UTF-8 string.
-        std::string line8;
-        if (_json_tcp || _json_udp) {
-            line.toUTF8(line8);
-        }
-
-        // Report in logger.
-        if (_json_line) {
-            rep.info(_line_prefix + line);
-        }
+    // Report in logger.
+    if (_json_line) {
+        rep.info(_line_prefix + UString::FromUTF8(line));
+    }
 
-        // Report through UDP. Open socket the first time.
-        if (_json_udp) {
-            udp_ok = udpOpen(rep) && _udp_sock.send(line8.data(), line8.size(), rep);
-        }
+    // Report through UDP. Open socket the first time.
+    if (_json_udp) {
+        udp_ok = udpOpen(rep) && _udp_sock.send(line.data(), line.size(), rep);
+    }
 
-        // Report through TCP. Connect to TCP server the first time (--json-tcp-keep) or every time.
-        if (_json_tcp) {
-            tcp_ok = tcpConnect(rep);
-            if (tcp_ok) {
-                tcp_ok = _tcp_sock.sendLine(line8, rep);
-                // In case of send error, retry opening the socket once.
-                // This is useful when the session is kept open and the server disconnected since last time.
-                if (!tcp_ok) {
-                    tcpDisconnect(true, rep);
-                    tcp_ok = tcpConnect(rep) && _tcp_sock.sendLine(line8, rep);
-                }
-                // Disconnect on error or when the connection shall not be kept open.
-                tcpDisconnect(!tcp_ok, rep);
+    // Report through TCP. Connect to TCP server the first time (--json-tcp-keep) or every time.
+    if (_json_tcp) {
+        tcp_ok = tcpConnect(rep);
+        if (tcp_ok) {
+            tcp_ok = _tcp_sock.sendLine(line, rep);
+            // In case of send error, retry opening the socket once.
+            // This is useful when the session is kept open and the server disconnected since last time.
+            if (!tcp_ok) {
+                tcpDisconnect(true, rep);
+                tcp_ok = tcpConnect(rep) && _tcp_sock.sendLine(line, rep);
             }
+            // Disconnect on error or when the connection shall not be kept open.
+            tcpDisconnect(!tcp_ok, rep);
         }
     }
 
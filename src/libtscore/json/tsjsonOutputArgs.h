@@ -73,6 +73,12 @@ namespace ts::json {
         //!
         bool useFile() const { return _json_opt; }
 
+        //!
+        //! Check if a one-line JSON output option is specified (@c -\-json-line, @c -\-json-tcp, @c -\-json-udp).
+        //! @return True if a one-line JSON output option is specified.
+        //!
+        bool useLine() const { return _json_line || _json_tcp || _json_udp; }
+
         //!
         //! Issue a JSON report according to options.
         //! @param [in] root JSON root object.
@@ -99,6 +105,16 @@ namespace ts::json {
         //!
         bool report(const json::Value& root, Report& rep);
 
+        //!
+        //! Issue a one-line JSON report according to options, from an already formatted JSON text.
+        //! This is typically used with a JSON text which is generated by a json::Writer.
+        //! Only the one-line output options are used (assuming @c -\-json is not specified for output files).
+        //! @param [in] line JSON text on one line, in UTF-8 format.
+        //! @param [in] rep Logger to report errors or output one-line JSON when @c -\-json-line is specified.
+        //! @return True on success, false on error.
+        //!
+        bool reportLine(const std::string& line, Report& rep);
+
     private:
         bool              _allow_file = true;     // Output to JSON file is allowed (option --json).
         bool              _json_opt = false;      // Option --json
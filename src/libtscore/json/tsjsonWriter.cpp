@@ -0,0 +1,176 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsjsonWriter.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor and reset.
+//----------------------------------------------------------------------------
+
+ts::json::Writer::Writer(bool one_line, size_t indent) :
+    _one_line(one_line),
+    _indent(indent)
+{
+}
+
+void ts::json::Writer::reset(bool one_line, size_t indent)
+{
+    _text.clear();
+    _levels.clear();
+    _one_line = one_line;
+    _indent = indent;
+}
+
+
+//----------------------------------------------------------------------------
+// Start and end objects and arrays.
+//----------------------------------------------------------------------------
+
+void ts::json::Writer::begin(bool array, const UChar* name, bool optional)
+{
+    if (!optional) {
+        newValue(name);
+        _text.push_back(array ? '[' : '{');
+    }
+    _levels.push_back({array, !optional, true, name});
+}
+
+void ts::json::Writer::end()
+{
+    if (!_levels.empty()) {
+        const Level level(_levels.back());
+        _levels.pop_back();
+        if (level.open) {
+            // Same closing sequence as json::Object and json::Array, even when empty.
+            newLine(_levels.size());
+            _text.push_back(level.array ? ']' : '}');
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Add values.
+//----------------------------------------------------------------------------
+
+void ts::json::Writer::addInteger(const UChar* name, int64_t value)
+{
+    newValue(name);
+
+    // Format the decimal digits from the end of a local buffer.
+    char buf[24];
+    char* const end = buf + sizeof(buf);
+    char* cur = end;
+    uint64_t abs = value < 0 ? uint64_t(0) - uint64_t(value) : uint64_t(value);
+    do {
+        *--cur = char('0' + abs % 10);
+        abs /= 10;
+    } while (abs != 0);
+    if (value < 0) {
+        *--cur = '-';
+    }
+    _text.append(cur, end);
+}
+
+void ts::json::Writer::addString(const UChar* name, const UString& value)
+{
+    newValue(name);
+    appendString(value.data(), value.size());
+}
+
+void ts::json::Writer::addBoolean(const UChar* name, bool value)
+{
+    newValue(name);
+    _text.append(value ? "true" : "false");
+}
+
+
+//----------------------------------------------------------------------------
+// Generate the start of a new value.
+//----------------------------------------------------------------------------
+
+void ts::json::Writer::newValue(const UChar* name)
+{
+    // Generate the optional containers which are not yet open, from outer to inner.
+    for (size_t i = 0; i < _levels.size(); ++i) {
+        if (!_levels[i].open) {
+            newValueAt(i, _levels[i].name);
+            _text.push_back(_levels[i].array ? '[' : '{');
+            _levels[i].open = true;
+        }
+    }
+    newValueAt(_levels.size(), name);
+}
+
+void ts::json::Writer::newValueAt(size_t level, const UChar* name)
+{
+    // Nothing to do for the root value.
+    if (level > 0) {
+        Level& parent(_levels[level - 1]);
+        if (!parent.empty) {
+            _text.push_back(',');
+        }
+        parent.empty = false;
+        newLine(level);
+        if (!parent.array) {
+            const UChar* const nm = name == nullptr ? u"" : name;
+            appendString(nm, std::char_traits<UChar>::length(nm));
+            _text.append(": ");
+        }
+    }
+}
+
+void ts::json::Writer::newLine(size_t level)
+{
+    if (_one_line) {
+        _text.push_back(' ');
+    }
+    else {
+        _text.push_back('\n');
+        _text.append(level * _indent, ' ');
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Generate a quoted and escaped string, same as UString::toJSON().
+//----------------------------------------------------------------------------
+
+void ts::json::Writer::appendString(const UChar* str, size_t size)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    _text.push_back('"');
+    for (size_t i = 0; i < size; ++i) {
+        const UChar c = str[i];
+        char quoted = 0;
+        switch (c) {
+            case QUOTATION_MARK: quoted = '"'; break;
+            case REVERSE_SOLIDUS: quoted = '\\'; break;
+            case BACKSPACE: quoted = 'b'; break;
+            case FORM_FEED: quoted = 'f'; break;
+            case LINE_FEED: quoted = 'n'; break;
+            case CARRIAGE_RETURN: quoted = 'r'; break;
+            case HORIZONTAL_TABULATION: quoted = 't'; break;
+            default: break;
+        }
+        if (quoted != 0) {
+            _text.push_back('\\');
+            _text.push_back(quoted);
+        }
+        else if (c >= 0x0020 && c <= 0x007E) {
+            _text.push_back(char(c));
+        }
+        else {
+            // Other Unicode characters, including surrogates, use one hexa sequence per UTF-16 code unit.
+            const char seq[6] = {'\\', 'u', hex[(c >> 12) & 0x0F], hex[(c >> 8) & 0x0F], hex[(c >> 4) & 0x0F], hex[c & 0x0F]};
+            _text.append(seq, sizeof(seq));
+        }
+    }
+    _text.push_back('"');
+}
@@ -0,0 +1,152 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Incremental generation of a JSON text, without JSON values tree.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsjson.h"
+#include "tsUString.h"
+
+namespace ts::json {
+    //!
+    //! Incremental generation of a JSON text, without JSON values tree.
+    //! @ingroup libtscore json
+    //!
+    //! The JSON text is directly generated in UTF-8 in an internal buffer, as the
+    //! objects, arrays and values are added. The buffer is reused by subsequent
+    //! documents, so that a periodic report does not allocate memory once the
+    //! buffer has reached its full size.
+    //!
+    //! The generated text is identical to the output of print() or oneLiner()
+    //! on the equivalent tree of json::Value, provided that the fields of the
+    //! objects are added in the same order as in a json::Object, i.e. sorted
+    //! by name. Like with json::String, all non-ASCII characters are escaped.
+    //!
+    //! An object or array can be declared as optional: it is generated only when
+    //! a first value is added in it. An optional container which remains empty is
+    //! omitted, as a json::Value query path which is never created.
+    //!
+    class TSCOREDLL Writer
+    {
+        TS_NOCOPY(Writer);
+    public:
+        //!
+        //! Constructor.
+        //! @param [in] one_line If true, the document is generated on one single line, as with oneLiner().
+        //! @param [in] indent Indentation width of each level, when @a one_line is false.
+        //!
+        explicit Writer(bool one_line = false, size_t indent = 2);
+
+        //!
+        //! Clear the document and restart a new one.
+        //! The memory of the internal buffer is preserved.
+        //! @param [in] one_line If true, the document is generated on one single line, as with oneLiner().
+        //! @param [in] indent Indentation width of each level, when @a one_line is false.
+        //!
+        void reset(bool one_line = false, size_t indent = 2);
+
+        //!
+        //! Get the generated JSON text.
+        //! @return A constant reference to the generated UTF-8 text.
+        //!
+        const std::string& text() const { return _text; }
+
+        //!
+        //! Check if the document is complete, i.e. all objects and arrays are closed.
+        //! @return True if the document is complete.
+        //!
+        bool isComplete() const { return _levels.empty() && !_text.empty(); }
+
+        //!
+        //! Start an object.
+        //! @param [in] name Field name when the current container is an object, ignored otherwise.
+        //! When @a optional is true, the string must remain valid until the object is generated.
+        //! @param [in] optional If true, the object is generated only when a first value is added in it.
+        //!
+        void beginObject(const UChar* name = nullptr, bool optional = false) { begin(false, name, optional); }
+
+        //!
+        //! Start an array.
+        //! @param [in] name Field name when the current container is an object, ignored otherwise.
+        //! When @a optional is true, the string must remain valid until the array is generated.
+        //! @param [in] optional If true, the array is generated only when a first value is added in it.
+        //!
+        void beginArray(const UChar* name = nullptr, bool optional = false) { begin(true, name, optional); }
+
+        //!
+        //! End the current object or array.
+        //!
+        void end();
+
+        //!
+        //! Add an integer field in the current object.
+        //! @param [in] name Field name.
+        //! @param [in] value Field value.
+        //!
+        void addInteger(const UChar* name, int64_t value);
+
+        //!
+        //! Add a string field in the current object.
+        //! @param [in] name Field name.
+        //! @param [in] value Field value.
+        //!
+        void addString(const UChar* name, const UString& value);
+
+        //!
+        //! Add a boolean field in the current object.
+        //! @param [in] name Field name.
+        //! @param [in] value Field value.
+        //!
+        void addBoolean(const UChar* name, bool value);
+
+        //!
+        //! Add an integer element in the current array.
+        //! @param [in] value Element value.
+        //!
+        void setInteger(int64_t value) { addInteger(nullptr, value); }
+
+        //!
+        //! Add a string element in the current array.
+        //! @param [in] value Element value.
+        //!
+        void setString(const UString& value) { addString(nullptr, value); }
+
+    private:
+        // Description of an open object or array.
+        struct Level
+        {
+            bool         array = false;    // Array, not object.
+            bool         open = false;     // Opening sequence was generated.
+            bool         empty = true;     // No value generated yet.
+            const UChar* name = nullptr;   // Field name in parent object.
+        };
+
+        std::string        _text {};
+        std::vector<Level> _levels {};
+        bool               _one_line = false;
+        size_t             _indent = 2;
+
+        // Start an object or array.
+        void begin(bool array, const UChar* name, bool optional);
+
+        // Generate the pending optional containers and the start of a new value in the current container.
+        void newValue(const UChar* name);
+
+        // Generate the start of a new value in the container at a given level.
+        void newValueAt(size_t level, const UChar* name);
+
+        // Generate a new line and the margin for a given level.
+        void newLine(size_t level);
+
+        // Generate a quoted and escaped string.
+        void appendString(const UChar* str, size_t size);
+    };
+}
@@ -72,6 +72,9 @@ bool ts::UDPReceiver::open(IP gen, Report& report)
         gen = local_addr.generation();
     }
 
+    // Receive messages by batches when requested.
+    setReceiveBatch(_args.receive_batch);
+
     // Create UDP socket from the superclass.
     // Note: On Windows, bind must be done *before* joining multicast groups.
     bool ok =
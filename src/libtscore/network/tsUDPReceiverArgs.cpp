@@ -110,6 +110,14 @@ void ts::UDPReceiverArgs::DefineArgs(Args& args, bool with_short_options, bool d
               u"Set the reuse port socket option. This is now enabled by default, the option "
               u"is present for legacy only.");
 
+    args.option(u"receive-batch", 0, Args::INTEGER, 0, 1, 1, 64);
+    args.help(u"receive-batch", u"count",
+              u"Receive up to <count> UDP packets in one system call, when they are already available (maximum 64). "
+              u"This reduces the CPU load on high bitrate streams. "
+              u"Each UDP packet keeps its own reception timestamp. "
+              u"Currently, this option is supported on Linux only. It is ignored on other systems. "
+              u"By default, UDP packets are received one by one.");
+
     args.option<cn::milliseconds>(u"receive-timeout");
     args.help(u"receive-timeout",
               u"Specify the UDP reception timeout in milliseconds. "
@@ -159,6 +167,7 @@ bool ts::UDPReceiverArgs::loadArgs(DuckContext& duck,
     mc_loopback = !args.present(u"disable-multicast-loop");
     use_ssm = args.present(u"ssm");
     args.getIntValue(receive_bufsize, u"buffer-size", 0);
+    args.getIntValue(receive_batch, u"receive-batch", 1);
     args.getChronoValue(receive_timeout, u"receive-timeout", receive_timeout);
 
     local_address.clear();
@@ -39,6 +39,7 @@ namespace ts {
         bool             use_ssm = false;            //!< Use source-specific multicast (-\-ssm or SSM syntax used in destination).
         bool             receive_timestamps = true;  //!< Get receive timestamps, currently hardcoded, is there a reason to disable it?
         size_t           receive_bufsize = 0;        //!< Socket receive buffer size in bytes (-\-buffer-size).
+        size_t           receive_batch = 1;          //!< Max number of messages per receive system call (-\-receive-batch).
         cn::milliseconds receive_timeout = cn::milliseconds(-1);  //!< Receive timeout (-\-receive-timeout).
         IPAddress        local_address {};           //!< Optional local addresses on which to listen (-\-local-address).
 
@@ -90,6 +90,9 @@ bool ts::UDPSocket::open(IP gen, Report& report)
 #endif
     }
 
+    // Drop previous batch of received messages, if any.
+    _batch_next = _batch_received = 0;
+
     return true;
 }
 
@@ -106,6 +109,7 @@ bool ts::UDPSocket::close(Report& report)
     }
 
     // Close socket
+    _transmit_time = false;
     return Socket::close(report);
 }
 
@@ -316,6 +320,95 @@ bool ts::UDPSocket::setReceiveTimestamps(bool on, Report& report)
 }
 
 
+//----------------------------------------------------------------------------
+// Enable or disable the transmission of messages at a specified time.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::setTransmitTime(bool on, Report& report)
+{
+#if defined(TS_LINUX) && defined(SO_TXTIME)
+    // The fq queueing discipline requires launch times in the monotonic clock, same as std::chrono::steady_clock.
+    // There is no way to remove the socket option, when disabled, we simply stop sending launch times.
+    if (on) {
+        ::sock_txtime txtime;
+        TS_ZERO(txtime);
+        txtime.clockid = CLOCK_MONOTONIC;
+        report.debug(u"setting socket SO_TXTIME on monotonic clock");
+        if (::setsockopt(getSocket(), SOL_SOCKET, SO_TXTIME, &txtime, sizeof(txtime)) != 0) {
+            report.error(u"socket option SO_TXTIME: %s", SysErrorCodeMessage());
+            return false;
+        }
+    }
+    _transmit_time = on;
+    return true;
+#else
+    if (on) {
+        report.error(u"transmission at specified time is not supported on this system");
+        return false;
+    }
+    return true;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Set the maximum pacing rate of the socket.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::setMaxPacingRate(uint64_t bytes_per_second, Report& report)
+{
+#if defined(TS_LINUX) && defined(SO_MAX_PACING_RATE)
+    // The option is a 32-bit value. Larger values are accepted as 64-bit values on recent kernels.
+    report.debug(u"setting socket SO_MAX_PACING_RATE to %'d bytes/s", bytes_per_second);
+    int status = 0;
+    if (bytes_per_second < 0xFFFFFFFF) {
+        const uint32_t rate = uint32_t(bytes_per_second);
+        status = ::setsockopt(getSocket(), SOL_SOCKET, SO_MAX_PACING_RATE, &rate, sizeof(rate));
+    }
+    else {
+        status = ::setsockopt(getSocket(), SOL_SOCKET, SO_MAX_PACING_RATE, &bytes_per_second, sizeof(bytes_per_second));
+    }
+    if (status != 0) {
+        report.error(u"socket option SO_MAX_PACING_RATE: %s", SysErrorCodeMessage());
+        return false;
+    }
+    return true;
+#else
+    report.error(u"socket pacing rate is not supported on this system");
+    return false;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Set the maximum number of messages to receive in one system call.
+//----------------------------------------------------------------------------
+
+void ts::UDPSocket::setReceiveBatch(size_t count, size_t max_message_size)
+{
+    // The option exists only on Linux and is silently ignored on other systems.
+#if defined(TS_LINUX)
+    _batch_count = count;
+    _batch_msg_size = max_message_size;
+    _batch_next = _batch_received = 0;
+    if (count > 1) {
+        _batch_data.resize(count * max_message_size);
+        _batch_ancil.resize(count * BATCH_ANCIL_SIZE);
+        _batch_senders.resize(count);
+        _batch_vecs.resize(count);
+        _batch_headers.resize(count);
+    }
+    else {
+        _batch_data.clear();
+        _batch_ancil.clear();
+        _batch_senders.clear();
+        _batch_vecs.clear();
+        _batch_headers.clear();
+    }
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Enable or disable the broadcast option.
 //----------------------------------------------------------------------------
@@ -569,6 +662,147 @@ bool ts::UDPSocket::send(const void* data, size_t size, const IPSocketAddress& d
 }
 
 
+//----------------------------------------------------------------------------
+// Send a message at a given time.
+//----------------------------------------------------------------------------
+
+#if defined(TS_LINUX)
+void ts::UDPSocket::setLaunchTime(::msghdr& hdr, void* ancil, monotonic_time launch_time)
+{
+    static_assert(CMSG_SPACE(sizeof(uint64_t)) <= TXTIME_ANCIL_SIZE);
+    hdr.msg_control = ancil;
+    hdr.msg_controllen = CMSG_SPACE(sizeof(uint64_t));
+    ::cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_TXTIME;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+    const uint64_t nanoseconds = uint64_t(cn::duration_cast<cn::nanoseconds>(launch_time.time_since_epoch()).count());
+    MemCopy(CMSG_DATA(cmsg), &nanoseconds, sizeof(nanoseconds));
+}
+#endif
+
+bool ts::UDPSocket::sendAt(const void* data, size_t size, monotonic_time launch_time, const IPSocketAddress& dest_in, Report& report)
+{
+#if defined(TS_LINUX)
+    if (_transmit_time) {
+        IPSocketAddress dest(dest_in);
+        if (!convert(dest, report)) {
+            return false;
+        }
+
+        ::sockaddr_storage addr;
+        const size_t addr_size = dest.get(addr);
+
+        ::iovec vec;
+        vec.iov_base = const_cast<void*>(data);
+        vec.iov_len = size;
+
+        ::msghdr hdr;
+        TS_ZERO(hdr);
+        hdr.msg_name = &addr;
+        hdr.msg_namelen = socklen_t(addr_size);
+        hdr.msg_iov = &vec;
+        hdr.msg_iovlen = 1;
+        uint64_t ancil[TXTIME_ANCIL_SIZE / sizeof(uint64_t)];
+        setLaunchTime(hdr, ancil, launch_time);
+
+        if (::sendmsg(getSocket(), &hdr, 0) < 0) {
+            report.error(u"error sending UDP message: %s", SysErrorCodeMessage());
+            return false;
+        }
+        return true;
+    }
+#endif
+
+    // Launch times are not used.
+    return send(data, size, dest_in, report);
+}
+
+
+//----------------------------------------------------------------------------
+// Send a contiguous buffer as a sequence of messages of identical size.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::sendSegments(const void* data, size_t size, size_t segment_size, const IPSocketAddress& destination, Report& report)
+{
+    return sendSegmentsAt(data, size, segment_size, nullptr, destination, report);
+}
+
+bool ts::UDPSocket::sendSegmentsAt(const void* data, size_t size, size_t segment_size, const monotonic_time* launch_times, const IPSocketAddress& dest_in, Report& report)
+{
+    if (segment_size == 0) {
+        report.error(u"invalid zero segment size in UDP message");
+        return false;
+    }
+
+    const uint8_t* addr = reinterpret_cast<const uint8_t*>(data);
+
+#if defined(TS_LINUX)
+
+    IPSocketAddress dest(dest_in);
+    if (!convert(dest, report)) {
+        return false;
+    }
+
+    ::sockaddr_storage sock_addr;
+    const size_t sock_addr_size = dest.get(sock_addr);
+
+    // Send up to SEND_BATCH_SIZE messages per system call.
+    ::iovec vecs[SEND_BATCH_SIZE];
+    ::mmsghdr headers[SEND_BATCH_SIZE];
+    uint64_t ancils[SEND_BATCH_SIZE][TXTIME_ANCIL_SIZE / sizeof(uint64_t)];
+    const bool use_launch_times = _transmit_time && launch_times != nullptr;
+
+    while (size > 0) {
+        TS_ZERO(vecs);
+        TS_ZERO(headers);
+        size_t count = 0;
+        while (count < SEND_BATCH_SIZE && size > 0) {
+            const size_t len = std::min(size, segment_size);
+            vecs[count].iov_base = const_cast<uint8_t*>(addr);
+            vecs[count].iov_len = len;
+            headers[count].msg_hdr.msg_name = &sock_addr;
+            headers[count].msg_hdr.msg_namelen = socklen_t(sock_addr_size);
+            headers[count].msg_hdr.msg_iov = &vecs[count];
+            headers[count].msg_hdr.msg_iovlen = 1;
+            if (use_launch_times) {
+                setLaunchTime(headers[count].msg_hdr, ancils[count], *launch_times++);
+            }
+            addr += len;
+            size -= len;
+            count++;
+        }
+        // The system may send less messages than requested.
+        for (size_t done = 0; done < count; ) {
+            const int ret = ::sendmmsg(getSocket(), headers + done, static_cast<unsigned int>(count - done), 0);
+            if (ret > 0) {
+                done += size_t(ret);
+            }
+            else if (ret < 0 && errno != EINTR) {
+                report.error(u"error sending UDP message: %s", SysErrorCodeMessage());
+                return false;
+            }
+        }
+    }
+    return true;
+
+#else
+
+    // Portable version, one system call per message.
+    while (size > 0) {
+        const size_t len = std::min(size, segment_size);
+        if (launch_times != nullptr ? !sendAt(addr, len, *launch_times++, dest_in, report) : !send(addr, len, dest_in, report)) {
+            return false;
+        }
+        addr += len;
+        size -= len;
+    }
+    return true;
+
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Receive a message.
 //----------------------------------------------------------------------------
@@ -642,6 +876,13 @@ int ts::UDPSocket::receiveOne(void* data,
     sender.clear();
     destination.clear();
 
+#if defined(TS_LINUX)
+    // Use batches of messages when requested.
+    if (_batch_count > 1) {
+        return receiveBatch(data, max_size, ret_size, sender, destination, timestamp);
+    }
+#endif
+
     // Reserve a socket address to receive the sender address.
     ::sockaddr_storage sender_sock;
     TS_ZERO(sender_sock);
@@ -744,6 +985,83 @@ int ts::UDPSocket::receiveOne(void* data,
         return LastSysErrorCode();
     }
 
+    // Analyze ancillary data: destination address, time stamp.
+    getAncillaryData(hdr, destination, timestamp);
+
+#endif // Windows vs. UNIX
+
+    // Successfully received a message
+    ret_size = size_t(insize);
+    sender = IPSocketAddress(sender_sock);
+
+    return 0; // success
+}
+
+
+//----------------------------------------------------------------------------
+// Receive a message from the current batch, receive a new batch when necessary.
+//----------------------------------------------------------------------------
+
+#if defined(TS_LINUX)
+
+int ts::UDPSocket::receiveBatch(void* data,
+                                size_t max_size,
+                                size_t& ret_size,
+                                IPSocketAddress& sender,
+                                IPSocketAddress& destination,
+                                cn::microseconds* timestamp)
+{
+    // Receive a new batch of messages when the current one is exhausted.
+    if (_batch_next >= _batch_received) {
+        _batch_next = _batch_received = 0;
+
+        // The headers must be rebuilt before each call since some fields are updated by the system.
+        for (size_t i = 0; i < _batch_count; ++i) {
+            TS_ZERO(_batch_senders[i]);
+            _batch_vecs[i].iov_base = _batch_data.data() + i * _batch_msg_size;
+            _batch_vecs[i].iov_len = _batch_msg_size;
+            ::mmsghdr& mh(_batch_headers[i]);
+            TS_ZERO(mh);
+            mh.msg_hdr.msg_name = &_batch_senders[i];
+            mh.msg_hdr.msg_namelen = sizeof(::sockaddr_storage);
+            mh.msg_hdr.msg_iov = &_batch_vecs[i];
+            mh.msg_hdr.msg_iovlen = 1;
+            mh.msg_hdr.msg_control = _batch_ancil.data() + i * BATCH_ANCIL_SIZE;
+            mh.msg_hdr.msg_controllen = BATCH_ANCIL_SIZE;
+        }
+
+        // Wait for the first message, then get all available ones, up to the batch size.
+        const int count = ::recvmmsg(getSocket(), _batch_headers.data(), static_cast<unsigned int>(_batch_count), MSG_WAITFORONE, nullptr);
+        if (count < 0) {
+            return LastSysErrorCode();
+        }
+        _batch_received = size_t(count);
+        if (count == 0) {
+            return 0; // empty message, will be ignored
+        }
+    }
+
+    // Return the next message from the batch.
+    const size_t index = _batch_next++;
+    ::mmsghdr& mh(_batch_headers[index]);
+    ret_size = std::min<size_t>(max_size, mh.msg_len);
+    MemCopy(data, _batch_vecs[index].iov_base, ret_size);
+    sender = IPSocketAddress(_batch_senders[index]);
+    getAncillaryData(mh.msg_hdr, destination, timestamp);
+    return 0;
+}
+
+#endif
+
+
+//----------------------------------------------------------------------------
+// Analyze the ancillary data of a received message.
+//----------------------------------------------------------------------------
+
+#if !defined(TS_WINDOWS)
+
+void ts::UDPSocket::getAncillaryData(::msghdr& hdr, IPSocketAddress& destination, cn::microseconds* timestamp)
+{
     TS_PUSH_WARNING()
     TS_GCC_NOWARNING(zero-as-null-pointer-constant) // invalid definition of CMSG_NXTHDR in musl libc (Alpine Linux)
 #if defined(TS_OPENBSD)
@@ -789,12 +1107,6 @@ int ts::UDPSocket::receiveOne(void* data,
     }
 
     TS_POP_WARNING()
-
-#endif // Windows vs. UNIX
-
-    // Successfully received a message
-    ret_size = size_t(insize);
-    sender = IPSocketAddress(sender_sock);
-
-    return 0; // success
 }
+
+#endif
@@ -18,6 +18,8 @@
 #include "tsAbortInterface.h"
 #include "tsReport.h"
 #include "tsMemory.h"
+#include "tsByteBlock.h"
+#include "tsIPProtocols.h"
 
 #if defined(DOXYGEN) || defined(TS_OPENBSD) || defined(TS_NETBSD) || defined(TS_DRAGONFLYBSD)
     //!
@@ -208,6 +210,57 @@ namespace ts {
         //!
         bool setReceiveTimestamps(bool on, Report& report = CERR);
 
+        //!
+        //! Set the maximum number of messages to receive in one system call.
+        //!
+        //! When @a count is greater than 1, receive() fetches all available messages, up to
+        //! @a count, in one system call. The messages are then returned one by one by subsequent
+        //! calls to receive(), without system call. Each message keeps its own sender and
+        //! destination addresses and its own receive timestamp. This reduces the system call
+        //! overhead on high bitrate streams. The first message is waited for as usual, the
+        //! subsequent messages are returned only when they are already available.
+        //!
+        //! Currently, this option is supported on Linux only, using recvmmsg(). It is ignored on other systems.
+        //! This method shall be called before starting to receive messages.
+        //!
+        //! @param [in] count Maximum number of messages to receive in one system call.
+        //! The value 0 or 1 means one message at a time (the default).
+        //! @param [in] max_message_size Maximum size of each message.
+        //!
+        void setReceiveBatch(size_t count, size_t max_message_size = IP_MAX_PACKET_SIZE);
+
+        //!
+        //! Enable or disable the transmission of messages at a specified time.
+        //!
+        //! When enabled, the launch time of each message is specified in sendAt() or sendSegmentsAt().
+        //! The messages are retained by the kernel until their launch time, allowing a regular
+        //! pacing of the output without sleeping in the application. The launch times are based
+        //! on the monotonic clock (type @c monotonic_time).
+        //!
+        //! Currently, this option is supported on Linux only, using the socket option SO_TXTIME.
+        //! The launch times are honored only when the outgoing interface uses a queueing discipline
+        //! which supports them, typically @c fq (or @c etf with hardware support). With other queueing
+        //! disciplines, the messages are sent immediately.
+        //!
+        //! @param [in] on If true, launch times are used on the socket. Otherwise, they are ignored.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error or when not supported on this system.
+        //!
+        bool setTransmitTime(bool on, Report& report = CERR);
+
+        //!
+        //! Set the maximum pacing rate of the socket.
+        //!
+        //! The kernel spreads the outgoing messages so that the specified rate is never exceeded.
+        //! Currently, this option is supported on Linux only, using the socket option SO_MAX_PACING_RATE.
+        //! It is honored only when the outgoing interface uses the @c fq queueing discipline.
+        //!
+        //! @param [in] bytes_per_second Maximum pacing rate in bytes per second.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error or when not supported on this system.
+        //!
+        bool setMaxPacingRate(uint64_t bytes_per_second, Report& report = CERR);
+
         //!
         //! Enable or disable the broadcast option.
         //!
@@ -336,6 +389,97 @@ namespace ts {
         //!
         virtual bool send(const void* data, size_t size, Report& report = CERR);
 
+        //!
+        //! Send a contiguous buffer as a sequence of messages of identical size to a destination address and port.
+        //!
+        //! The data are split in consecutive messages of @a segment_size bytes. The last message
+        //! may be shorter. On Linux, the messages are sent in batches, using sendmmsg(), with much
+        //! less system calls. On other systems, this is equivalent to calling send() for each message.
+        //!
+        //! @param [in] data Address of the data to send.
+        //! @param [in] size Size in bytes of the data to send.
+        //! @param [in] segment_size Size in bytes of each message.
+        //! @param [in] destination Socket address of the destination.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        bool sendSegments(const void* data, size_t size, size_t segment_size, const IPSocketAddress& destination, Report& report = CERR);
+
+        //!
+        //! Send a contiguous buffer as a sequence of messages of identical size to the default destination address and port.
+        //! @param [in] data Address of the data to send.
+        //! @param [in] size Size in bytes of the data to send.
+        //! @param [in] segment_size Size in bytes of each message.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //! @see sendSegments(const void*, size_t, size_t, const IPSocketAddress&, Report&)
+        //!
+        bool sendSegments(const void* data, size_t size, size_t segment_size, Report& report = CERR)
+        {
+            return sendSegments(data, size, segment_size, _default_destination, report);
+        }
+
+        //!
+        //! Send a message to a destination address and port, at a given time.
+        //!
+        //! The launch time is used only when enabled using setTransmitTime().
+        //! Otherwise, this is equivalent to send().
+        //!
+        //! @param [in] data Address of the message to send.
+        //! @param [in] size Size in bytes of the message to send.
+        //! @param [in] launch_time Time when the message shall be transmitted.
+        //! @param [in] destination Socket address of the destination.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        bool sendAt(const void* data, size_t size, monotonic_time launch_time, const IPSocketAddress& destination, Report& report = CERR);
+
+        //!
+        //! Send a message to the default destination address and port, at a given time.
+        //! @param [in] data Address of the message to send.
+        //! @param [in] size Size in bytes of the message to send.
+        //! @param [in] launch_time Time when the message shall be transmitted.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //! @see sendAt(const void*, size_t, monotonic_time, const IPSocketAddress&, Report&)
+        //!
+        bool sendAt(const void* data, size_t size, monotonic_time launch_time, Report& report = CERR)
+        {
+            return sendAt(data, size, launch_time, _default_destination, report);
+        }
+
+        //!
+        //! Send a contiguous buffer as a sequence of messages of identical size, each one at a given time.
+        //!
+        //! The launch times are used only when enabled using setTransmitTime().
+        //! Otherwise, this is equivalent to sendSegments().
+        //!
+        //! @param [in] data Address of the data to send.
+        //! @param [in] size Size in bytes of the data to send.
+        //! @param [in] segment_size Size in bytes of each message.
+        //! @param [in] launch_times Address of an array of launch times, one per message.
+        //! @param [in] destination Socket address of the destination.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //! @see sendSegments(const void*, size_t, size_t, const IPSocketAddress&, Report&)
+        //!
+        bool sendSegmentsAt(const void* data, size_t size, size_t segment_size, const monotonic_time* launch_times, const IPSocketAddress& destination, Report& report = CERR);
+
+        //!
+        //! Send a contiguous buffer as a sequence of messages of identical size, each one at a given time, to the default destination.
+        //! @param [in] data Address of the data to send.
+        //! @param [in] size Size in bytes of the data to send.
+        //! @param [in] segment_size Size in bytes of each message.
+        //! @param [in] launch_times Address of an array of launch times, one per message.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //! @see sendSegmentsAt(const void*, size_t, size_t, const monotonic_time*, const IPSocketAddress&, Report&)
+        //!
+        bool sendSegmentsAt(const void* data, size_t size, size_t segment_size, const monotonic_time* launch_times, Report& report = CERR)
+        {
+            return sendSegmentsAt(data, size, segment_size, launch_times, _default_destination, report);
+        }
+
         //!
         //! Receive a message.
         //!
@@ -439,6 +583,41 @@ namespace ts {
         SSMReqSet       _ssmcast {};  // Current set of source-specific multicast memberships
 #endif
 
+        bool            _transmit_time = false; // Use launch times, see setTransmitTime().
+
+        // Batch of received messages, see setReceiveBatch().
+        size_t          _batch_count = 0;     // Max number of messages per batch, 0 or 1 if unused.
+        size_t          _batch_msg_size = 0;  // Max size of each message in the batch.
+        size_t          _batch_next = 0;      // Index of next message to return in current batch.
+        size_t          _batch_received = 0;  // Number of received messages in current batch.
+        ByteBlock       _batch_data {};       // Buffers for messages.
+        ByteBlock       _batch_ancil {};      // Buffers for ancillary data.
+#if defined(TS_LINUX)
+        std::vector<::sockaddr_storage> _batch_senders {};
+        std::vector<::iovec>            _batch_vecs {};
+        std::vector<::mmsghdr>          _batch_headers {};
+
+        // Size of ancillary data per message in a batch.
+        static constexpr size_t BATCH_ANCIL_SIZE = 256;
+
+        // Max number of messages per sendmmsg() call.
+        static constexpr size_t SEND_BATCH_SIZE = 64;
+
+        // Size of ancillary data for a launch time.
+        static constexpr size_t TXTIME_ANCIL_SIZE = 64;
+
+        // Fill the ancillary data of a message with a launch time.
+        static void setLaunchTime(::msghdr& hdr, void* ancil, monotonic_time launch_time);
+
+        // Receive a message from the current batch, receive a new batch when necessary. Return a system socket error code.
+        int receiveBatch(void* data, size_t max_size, size_t& ret_size, IPSocketAddress& sender, IPSocketAddress& destination, cn::microseconds* timestamp);
+#endif
+
+#if !defined(TS_WINDOWS)
+        // Analyze the ancillary data of a received message.
+        void getAncillaryData(::msghdr& hdr, IPSocketAddress& destination, cn::microseconds* timestamp);
+#endif
+
         // Perform one receive operation. Hide the system mud. Return a system socket error code.
         int receiveOne(void* data, size_t max_size, size_t& ret_size, IPSocketAddress& sender, IPSocketAddress& destination, Report& report, cn::microseconds* timestamp);
 
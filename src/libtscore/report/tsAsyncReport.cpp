@@ -94,26 +94,35 @@ void ts::AsyncReport::main()
     // Notify subclasses (if any) of thread start.
     asyncThreadStarted();
 
-    for (;;) {
+    bool terminate = false;
+    while (!terminate) {
         // Dequeue next message (infinite wait).
         _log_queue.dequeue(msg);
 
-        // Exit when received a termination message.
-        if (msg->terminate) {
-            break;
-        }
-
-        // Notify subclass of message (or log it on standard error).
-        asyncThreadLog(msg->severity, msg->message);
-
-        // Abort application on fatal error
-        if (msg->severity == Severity::Fatal) {
-            std::exit(EXIT_FAILURE);
-        }
+        // Process all messages which are already queued before writing them at once.
+        do {
+            // Exit when received a termination message.
+            if (msg->terminate) {
+                terminate = true;
+                break;
+            }
+
+            // Notify subclass of message (or log it on standard error).
+            asyncThreadLog(msg->severity, msg->message);
+
+            // Abort application on fatal error
+            if (msg->severity == Severity::Fatal) {
+                flushLogBuffer();
+                std::exit(EXIT_FAILURE);
+            }
+        } while (_log_queue.dequeue(msg, cn::milliseconds::zero()));
+
+        flushLogBuffer();
     }
 
     if (maxSeverity() >= Severity::Debug) {
         asyncThreadLog(Severity::Debug, u"Report logging thread terminated");
+        flushLogBuffer();
     }
 
     // Notify subclasses (if any) of thread completion.
@@ -132,12 +141,24 @@ void ts::AsyncReport::asyncThreadStarted()
 
 void ts::AsyncReport::asyncThreadLog(int severity, const UString& message)
 {
-    // The default implementation logs on stderr.
-    std::cerr << "* ";
+    // The default implementation logs on stderr. Format the complete line in UTF-8.
+    _log_buffer.append("* ");
     if (_time_stamp) {
-        std::cerr << ts::Time::CurrentLocalTime().format(ts::Time::DATETIME) << " - ";
+        ts::Time::CurrentLocalTime().format(ts::Time::DATETIME).appendUTF8(_log_buffer);
+        _log_buffer.append(" - ");
+    }
+    Severity::Header(severity).appendUTF8(_log_buffer);
+    message.appendUTF8(_log_buffer);
+    _log_buffer.push_back('\n');
+}
+
+void ts::AsyncReport::flushLogBuffer()
+{
+    if (!_log_buffer.empty()) {
+        std::cerr.write(_log_buffer.data(), std::streamsize(_log_buffer.size()));
+        std::cerr.flush();
+        _log_buffer.clear();
     }
-    std::cerr << Severity::Header(severity) << message << std::endl;
 }
 
 void ts::AsyncReport::asyncThreadCompleted()
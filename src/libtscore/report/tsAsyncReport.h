@@ -93,7 +93,9 @@ namespace ts {
 
         //!
         //! This method is called in the context of the asynchronous logging thread to log a message.
-        //! The default implementation prints the message on the standard error.
+        //! The default implementation prints the message on the standard error. To reduce the number
+        //! of system calls, the message is formatted in UTF-8 in an internal buffer and all messages
+        //! which are already queued are written at once.
         //! @param [in] severity Severity level of the message.
         //! @param [in] message The message line to log.
         //!
@@ -122,8 +124,12 @@ namespace ts {
         using LogMessageQueue = MessageQueue<LogMessage>;
         using LogMessagePtr = LogMessageQueue::MessagePtr;
 
+        // Write the UTF-8 buffer of formatted messages on the standard error.
+        void flushLogBuffer();
+
         // Private members:
         LogMessageQueue _log_queue {};
+        std::string     _log_buffer {};   // Formatted UTF-8 messages, used in the logging thread only.
         volatile bool   _time_stamp = false;
         volatile bool   _synchronous = false;
         volatile bool   _terminated = false;
@@ -0,0 +1,115 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsNUMA.h"
+
+#if defined(TS_LINUX)
+    #include "tsBeforeStandardHeaders.h"
+    #include <sys/syscall.h>
+    #include <sched.h>
+    #include <unistd.h>
+    #include <linux/mempolicy.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
+
+
+//----------------------------------------------------------------------------
+// Get the list of CPU's which belong to a NUMA node.
+//----------------------------------------------------------------------------
+
+bool ts::GetNUMANodeCPUs(std::vector<int>& cpus, int node)
+{
+    cpus.clear();
+
+#if defined(TS_LINUX)
+
+    // The file contains a list of ranges such as "0-7,16-23".
+    UStringList lines;
+    if (node < 0 || !UString::Load(lines, UString::Format(u"/sys/devices/system/node/node%d/cpulist", node)) || lines.empty()) {
+        return false;
+    }
+    UStringVector ranges;
+    lines.front().split(ranges, u',', true, true);
+    for (const auto& range : ranges) {
+        UStringVector bounds;
+        range.split(bounds, u'-', true, true);
+        int first = 0;
+        int last = 0;
+        if (bounds.empty() || bounds.size() > 2 || !bounds[0].toInteger(first) || !bounds.back().toInteger(last) || first > last) {
+            cpus.clear();
+            return false;
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return !cpus.empty();
+
+#else
+    return false;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Get the list of CPU's on which the current process is allowed to run.
+//----------------------------------------------------------------------------
+
+bool ts::GetProcessCPUs(std::vector<int>& cpus)
+{
+    cpus.clear();
+
+#if defined(TS_LINUX)
+
+    ::cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return false;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowed)) {
+            cpus.push_back(cpu);
+        }
+    }
+    return !cpus.empty();
+
+#else
+    return false;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Bind the physical memory of an address range to a NUMA node.
+//----------------------------------------------------------------------------
+
+bool ts::BindMemoryToNUMANode(void* address, size_t size, int node, std::error_code& error)
+{
+#if defined(TS_LINUX)
+
+    // Use the system call directly, libnuma is not required.
+    // Pages which are already allocated are moved to the node when possible.
+    constexpr size_t ulong_bits = 8 * sizeof(unsigned long);
+    if (node < 0) {
+        error = std::make_error_code(std::errc::invalid_argument);
+        return false;
+    }
+    std::vector<unsigned long> mask(size_t(node) / ulong_bits + 1, 0);
+    mask[size_t(node) / ulong_bits] = 1UL << (size_t(node) % ulong_bits);
+    if (::syscall(SYS_mbind, address, size, MPOL_BIND, mask.data(), mask.size() * ulong_bits + 1, MPOL_MF_MOVE) != 0) {
+        error.assign(errno, std::system_category());
+        return false;
+    }
+    error.clear();
+    return true;
+
+#else
+    error = std::make_error_code(std::errc::operation_not_supported);
+    return false;
+#endif
+}
@@ -0,0 +1,51 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  @ingroup libtscore system
+//!  Placement of memory and threads on NUMA nodes.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsUString.h"
+
+namespace ts {
+    //!
+    //! Get the list of CPU's which belong to a NUMA node.
+    //! This is currently implemented on Linux only.
+    //! @ingroup system
+    //! @param [out] cpus Returned list of CPU numbers in @a node.
+    //! @param [in] node NUMA node number.
+    //! @return True on success, false if @a node does not exist or if NUMA is not supported.
+    //!
+    TSCOREDLL bool GetNUMANodeCPUs(std::vector<int>& cpus, int node);
+
+    //!
+    //! Get the list of CPU's on which the current process is allowed to run.
+    //! This is currently implemented on Linux only.
+    //! @ingroup system
+    //! @param [out] cpus Returned list of CPU numbers.
+    //! @return True on success, false on error or if not supported.
+    //!
+    TSCOREDLL bool GetProcessCPUs(std::vector<int>& cpus);
+
+    //!
+    //! Bind the physical memory of an address range to a NUMA node.
+    //! This is currently implemented on Linux only.
+    //! Pages which are already allocated are moved when possible. It is however recommended
+    //! to call this function before touching the memory for the first time.
+    //! @ingroup system
+    //! @param [in] address Start of the memory area. Must be aligned on a page boundary.
+    //! @param [in] size Size in bytes of the memory area.
+    //! @param [in] node NUMA node number.
+    //! @param [out] error Returned system error code on failure.
+    //! @return True on success, false on error.
+    //!
+    TSCOREDLL bool BindMemoryToNUMANode(void* address, size_t size, int node, std::error_code& error);
+}
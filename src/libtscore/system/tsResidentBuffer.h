@@ -15,6 +15,7 @@
 #include "tsSysUtils.h"
 #include "tsIntegerUtils.h"
 #include "tsSysInfo.h"
+#include "tsNUMA.h"
 
 namespace ts {
     //!
@@ -40,8 +41,14 @@ namespace ts {
         //! page faults.
         //!
         //! @param [in] elem_count Number of @a T elements.
+        //! @param [in] huge_pages If true, try to allocate the buffer in huge pages (2 MB on most
+        //! systems) to reduce TLB misses on large buffers. This is currently implemented on Linux only.
+        //! Explicit huge pages are used when some are reserved in the system. Otherwise, transparent
+        //! huge pages are requested. On failure, normal pages are silently used.
+        //! @param [in] numa_node If not negative, bind the physical memory of the buffer to this NUMA
+        //! node. This is currently implemented on Linux only. Failing to bind the memory is not an error.
         //!
-        ResidentBuffer(size_t elem_count);
+        ResidentBuffer(size_t elem_count, bool huge_pages = false, int numa_node = -1);
 
         //!
         //! Destructor.
@@ -72,6 +79,29 @@ namespace ts {
         //!
         size_t count() const { return _elem_count; }
 
+        //!
+        //! Check if the buffer was successfully allocated in explicit huge pages.
+        //! @return True if huge pages were requested and explicit huge pages were granted by the system.
+        //! @see isTransparentHugePages()
+        //!
+        bool isHugePages() const { return _is_huge; }
+
+        //!
+        //! Check if transparent huge pages were requested for the buffer.
+        //! This is used when no explicit huge page is available. The buffer is aligned on
+        //! a huge page boundary but the system may still use normal pages, depending on its
+        //! configuration and on the memory fragmentation.
+        //! @return True if transparent huge pages were requested for the buffer.
+        //! @see isHugePages()
+        //!
+        bool isTransparentHugePages() const { return _is_thp; }
+
+        //!
+        //! Get the NUMA node to which the buffer memory is bound.
+        //! @return The NUMA node number or -1 if the memory is not bound to a NUMA node.
+        //!
+        int numaNode() const { return _numa_node; }
+
     private:
         char*  _allocated_base = nullptr;  // First allocated address
         char*  _locked_base = nullptr;     // First locked address (mlock, page boundary)
@@ -80,6 +110,10 @@ namespace ts {
         size_t _locked_size = 0;           // Locked size (mlock, multiple of page size)
         size_t _elem_count = 0;            // Element count in locked region
         bool   _is_locked = false;         // False if mlock failed.
+        bool   _is_mapped = false;         // Allocated using mmap() instead of new.
+        bool   _is_huge = false;           // Allocated in explicit huge pages.
+        bool   _is_thp = false;            // Transparent huge pages requested.
+        int    _numa_node = -1;            // NUMA node to which the memory is bound.
         std::error_code _error_code {};    // Lock error code
     };
 }
@@ -91,28 +125,70 @@ namespace ts {
 
 // Constructor, based on required amount of T elements.
 template <typename T>
-ts::ResidentBuffer<T>::ResidentBuffer(size_t elem_count) :
+ts::ResidentBuffer<T>::ResidentBuffer(size_t elem_count, bool huge_pages, int numa_node) :
     _elem_count(elem_count)
 {
     const size_t requested_size = elem_count * sizeof(T);
     const size_t page_size = SysInfo::Instance().memoryPageSize();
 
-    // Allocate enough space to include memory pages around the requested size
-    _allocated_size = requested_size + 2 * page_size;
-    _allocated_base = new char[_allocated_size];
-
-    // Locked space starts at next page boundary after allocated base:
-    // Its size is the next multiple of page size after requested_size:
-    // Be sure to use size_t (unsigned) instead of ptrdiff_t (signed)
-    // to perform arithmetics on pointers because we use modulo operations.
-    assert(sizeof(size_t) == sizeof(char_ptr));
-    _locked_base = char_ptr(round_up(size_t(_allocated_base), page_size));
-    _locked_size = round_up(requested_size, page_size);
+#if defined(TS_LINUX)
+    // Try huge pages first: explicit huge pages (hugetlbfs pool) when available,
+    // then transparent huge pages on a region which is aligned on the huge page size.
+    if (huge_pages) {
+        constexpr size_t huge_page_size = 2 * 1024 * 1024;
+        _locked_size = round_up(std::max<size_t>(requested_size, 1), huge_page_size);
+        _allocated_size = _locked_size;
+        void* addr = ::mmap(nullptr, _allocated_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (addr != MAP_FAILED) {
+            // Explicit huge pages are always aligned on the huge page size.
+            _is_huge = true;
+            _locked_base = char_ptr(addr);
+        }
+        else {
+            // A normal mapping is only aligned on the page size. Allocate one more huge page
+            // to get a region which is aligned on a huge page boundary inside the mapping.
+            _allocated_size = _locked_size + huge_page_size;
+            addr = ::mmap(nullptr, _allocated_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (addr != MAP_FAILED) {
+                _locked_base = char_ptr(round_up(size_t(addr), huge_page_size));
+                _is_thp = ::madvise(_locked_base, _locked_size, MADV_HUGEPAGE) == 0;
+            }
+        }
+        if (addr != MAP_FAILED) {
+            _is_mapped = true;
+            _allocated_base = char_ptr(addr);
+        }
+        else {
+            _locked_size = 0;
+        }
+    }
+#endif
+
+    if (!_is_mapped) {
+        // Allocate enough space to include memory pages around the requested size
+        _allocated_size = requested_size + 2 * page_size;
+        _allocated_base = new char[_allocated_size];
+
+        // Locked space starts at next page boundary after allocated base:
+        // Its size is the next multiple of page size after requested_size:
+        // Be sure to use size_t (unsigned) instead of ptrdiff_t (signed)
+        // to perform arithmetics on pointers because we use modulo operations.
+        assert(sizeof(size_t) == sizeof(char_ptr));
+        _locked_base = char_ptr(round_up(size_t(_allocated_base), page_size));
+        _locked_size = round_up(requested_size, page_size);
+    }
+
+    // Bind the memory to a NUMA node before the pages are touched.
+    std::error_code numa_error;
+    if (numa_node >= 0 && BindMemoryToNUMANode(_locked_base, _locked_size, numa_node, numa_error)) {
+        _numa_node = numa_node;
+    }
+
     _base = new (_locked_base) T[elem_count];
 
     // Integrity checks
     assert(_allocated_base <= _locked_base);
-    assert(_locked_base < _allocated_base + page_size);
+    assert(_locked_base < _allocated_base + page_size || _is_mapped);
     assert(_locked_base + _locked_size <= _allocated_base + _allocated_size);
     assert(requested_size <= _locked_size);
     assert(_locked_size <= _allocated_size);
@@ -175,7 +251,12 @@ ts::ResidentBuffer<T>::~ResidentBuffer()
     }
 
     // Free memory
-    if (_allocated_base != nullptr) {
+    if (_is_mapped) {
+#if defined(TS_UNIX)
+        ::munmap(_allocated_base, _allocated_size);
+#endif
+    }
+    else if (_allocated_base != nullptr) {
         delete[] _allocated_base;
     }
 
@@ -187,5 +268,9 @@ ts::ResidentBuffer<T>::~ResidentBuffer()
     _locked_size = 0;
     _elem_count = 0;
     _is_locked = false;
+    _is_mapped = false;
+    _is_huge = false;
+    _is_thp = false;
+    _numa_node = -1;
 }
 TS_POP_WARNING()
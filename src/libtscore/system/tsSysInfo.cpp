@@ -291,12 +291,19 @@ ts::SysInfo::SysInfo() :
     //
     if (GetEnvironment(u"TS_NO_HARDWARE_ACCELERATION").empty()) {
         if (GetEnvironment(u"TS_NO_CRC32_INSTRUCTIONS").empty()) {
-            #if defined(TS_LINUX) && defined(HWCAP_CRC32)
+            #if defined(TS_X86_64) && defined(TS_GCC)
+                _crcInstructions = tsCRC32IsAccelerated && __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+            #elif defined(TS_LINUX) && defined(HWCAP_CRC32)
                 _crcInstructions = tsCRC32IsAccelerated && (::getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
             #elif defined(TS_MAC)
                 _crcInstructions = tsCRC32IsAccelerated && SysCtrlBool("hw.optional.armv8_crc32");
             #endif
         }
+        if (GetEnvironment(u"TS_NO_AVX2_INSTRUCTIONS").empty()) {
+            #if (defined(TS_X86_64) || defined(TS_I386)) && defined(TS_GCC)
+                _avx2Instructions = __builtin_cpu_supports("avx2");
+            #endif
+        }
     }
 }
 
@@ -337,7 +344,7 @@ TS_REGISTER_FEATURE(u"acceleration", u"Acceleration", ALWAYS, ts::SysInfo::GetAc
 
 ts::UString ts::SysInfo::GetAccelerations()
 {
-    return UString::Format(u"CRC32: %s", UString::YesNo(Instance().crcInstructions()));
+    return UString::Format(u"CRC32: %s, AVX2: %s", UString::YesNo(Instance().crcInstructions()), UString::YesNo(Instance().avx2Instructions()));
 }
 
 
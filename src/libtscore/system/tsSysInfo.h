@@ -90,6 +90,11 @@ namespace ts {
         //!
         bool crcInstructions() const { return _crcInstructions; }
         //!
+        //! Check if the CPU supports the AVX2 vector instructions (Intel x86 only).
+        //! @return True if the CPU supports AVX2 instructions.
+        //!
+        bool avx2Instructions() const { return _avx2Instructions; }
+        //!
         //! Get the operating system version.
         //! @return The operating system version.
         //!
@@ -145,6 +150,7 @@ namespace ts {
         SysOS     _osFamily;
         SysFlavor _osFlavor = UNKNOWN;
         bool      _crcInstructions = false;
+        bool      _avx2Instructions = false;
         int       _systemMajorVersion = -1;
         UString   _systemVersion {};
         UString   _systemName {};
@@ -249,6 +249,34 @@ cn::milliseconds ts::GetProcessCpuTime()
 }
 
 
+//----------------------------------------------------------------------------
+// Get the CPU time of the calling thread.
+//----------------------------------------------------------------------------
+
+cn::nanoseconds ts::GetThreadCpuTime()
+{
+#if defined(TS_WINDOWS)
+
+    ::FILETIME creation_time, exit_time, kernel_time, user_time;
+    if (::GetThreadTimes(::GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time) == 0) {
+        return cn::nanoseconds::zero();
+    }
+    // FILETIME values are in units of 100 nanoseconds.
+    const auto ticks = [](const ::FILETIME& ft) { return (int64_t(ft.dwHighDateTime) << 32) | int64_t(ft.dwLowDateTime); };
+    return cn::nanoseconds(100 * (ticks(kernel_time) + ticks(user_time)));
+
+#else
+
+    ::timespec ts;
+    if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return cn::nanoseconds::zero();
+    }
+    return cn::seconds(ts.tv_sec) + cn::nanoseconds(ts.tv_nsec);
+
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Get the virtual memory size of the process in bytes.
 //----------------------------------------------------------------------------
@@ -112,6 +112,15 @@ namespace ts {
     //!
     TSCOREDLL cn::milliseconds GetProcessCpuTime();
 
+    //!
+    //! Get the CPU time of the calling thread.
+    //! Unlike GetProcessCpuTime(), this function does not throw exceptions. It is designed
+    //! to be frequently called, for instance to collect execution metrics in a thread.
+    //! @ingroup system
+    //! @return The CPU time of the calling thread or zero if it cannot be obtained.
+    //!
+    TSCOREDLL cn::nanoseconds GetThreadCpuTime();
+
     //!
     //! Get the virtual memory size of the process in bytes.
     //! @ingroup system
@@ -11,6 +11,7 @@
 #include "tsSysUtils.h"
 #include "tsSysInfo.h"
 #include "tsIntegerUtils.h"
+#include "tsNUMA.h"
 
 #if defined(TS_LINUX)
     #include "tsBeforeStandardHeaders.h"
@@ -241,6 +242,34 @@ bool ts::Thread::start()
     }
 #endif
 
+#if defined(TS_LINUX)
+    // Pin the thread to one CPU or restrict it to the CPU's of a NUMA node. Ignore errors, the thread can run anywhere.
+    std::vector<int> cpus;
+    if (_attributes._cpu >= 0) {
+        cpus.push_back(_attributes._cpu);
+    }
+    else if (_attributes._numaNode >= 0) {
+        GetNUMANodeCPUs(cpus, _attributes._numaNode);
+    }
+    if (!cpus.empty()) {
+        // Only keep the CPU's which are allowed to the process, otherwise pthread_create() fails.
+        ::cpu_set_t allowed;
+        ::cpu_set_t cpuset;
+        CPU_ZERO(&allowed);
+        CPU_ZERO(&cpuset);
+        if (::sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+            for (int cpu : cpus) {
+                if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) {
+                    CPU_SET(cpu, &cpuset);
+                }
+            }
+        }
+        if (CPU_COUNT(&cpuset) > 0) {
+            ::pthread_attr_setaffinity_np(&attr, sizeof(cpuset), &cpuset);
+        }
+    }
+#endif
+
     // Create the thread
     if (::pthread_create(&_pthread, &attr, Thread::ThreadProc, this) != 0) {
         ::pthread_attr_destroy(&attr);
@@ -148,6 +148,60 @@ namespace ts {
             return _exitOnException;
         }
 
+        //!
+        //! Set the NUMA node on which the thread shall run.
+        //!
+        //! When a NUMA node is specified, the thread is restricted to the CPU's of this node.
+        //! This is currently implemented on Linux only. Failing to set the CPU affinity of
+        //! the thread is not an error, the thread runs on any CPU.
+        //!
+        //! @param [in] node NUMA node number. A negative value means any node (the default).
+        //! @return A reference to this object.
+        //!
+        ThreadAttributes& setNUMANode(int node)
+        {
+            _numaNode = node;
+            return *this;
+        }
+
+        //!
+        //! Get the NUMA node on which the thread shall run.
+        //!
+        //! @return The NUMA node number or a negative value if the thread can run on any node.
+        //! @see setNUMANode()
+        //!
+        int getNUMANode() const
+        {
+            return _numaNode;
+        }
+
+        //!
+        //! Set the CPU on which the thread shall run.
+        //!
+        //! When a CPU is specified, the thread is pinned to this CPU and the NUMA node is ignored.
+        //! This is currently implemented on Linux only. Failing to set the CPU affinity of
+        //! the thread is not an error, the thread runs on any CPU.
+        //!
+        //! @param [in] cpu CPU number. A negative value means any CPU (the default).
+        //! @return A reference to this object.
+        //!
+        ThreadAttributes& setCPU(int cpu)
+        {
+            _cpu = cpu;
+            return *this;
+        }
+
+        //!
+        //! Get the CPU on which the thread shall run.
+        //!
+        //! @return The CPU number or a negative value if the thread can run on any CPU.
+        //! @see setCPU()
+        //!
+        int getCPU() const
+        {
+            return _cpu;
+        }
+
         //!
         //! Set the priority for the thread.
         //!
@@ -273,6 +327,8 @@ namespace ts {
         bool    _deleteWhenTerminated = false;
         bool    _exitOnException = false;
         int     _priority = 0;
+        int     _numaNode = -1;
+        int     _cpu = -1;
         UString _name {};
 
         //
@@ -8,6 +8,15 @@
 
 #include "tsMemory.h"
 
+// Vector instructions which are always available on the target architecture.
+#if defined(__SSE2__) && !defined(TS_NO_SSE2_INSTRUCTIONS)
+    #define TS_SSE2_ZERO_ZERO 1
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__) && !defined(TS_NO_ARM_NEON_INSTRUCTIONS)
+    #define TS_NEON_ZERO_ZERO 1
+    #include <arm_neon.h>
+#endif
+
 
 //----------------------------------------------------------------------------
 // Check if a memory area starts with the specified prefix
@@ -53,30 +62,93 @@ const uint8_t* ts::LocatePattern(const void* area, size_t area_size, const void*
 
 
 //----------------------------------------------------------------------------
-// Locate a 3-byte pattern 00 00 XY into a memory area.
+// Locate 3-byte patterns 00 00 XY into a memory area.
 //----------------------------------------------------------------------------
 
-const uint8_t* ts::LocateZeroZero(const void* area, size_t area_size, uint8_t third)
-{
-    const uint8_t* a = reinterpret_cast<const uint8_t*>(area);
-    while (area_size >= 3) {
-        const uint8_t* next = reinterpret_cast<const uint8_t*>(std::memchr(a, 0x00, area_size - 2));
-        if (next == nullptr) {
-            return nullptr;
-        }
-        else if (next[1] != 0x00) {
-            area_size -= (next - a) + 2;
-            a = next + 2;
+namespace {
+    // Store the offsets of the patterns 00 00 XY, with XY == third (exact) or XY <= third (not exact).
+    // Return the number of stored offsets, up to max_offsets.
+    size_t ScanZeroZero(const uint8_t* area, size_t area_size, uint8_t third, bool exact, size_t* offsets, size_t max_offsets)
+    {
+        size_t count = 0;
+        size_t i = 0;
+
+    #if defined(TS_SSE2_ZERO_ZERO) || defined(TS_NEON_ZERO_ZERO)
+        // Check 16 positions at a time, using three overlapping loads.
+        // Most video payloads contain no 00 00 sequence, except at start codes.
+        while (count < max_offsets && i + 18 <= area_size) {
+        #if defined(TS_SSE2_ZERO_ZERO)
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i vthird = _mm_set1_epi8(char(third));
+            const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(area + i));
+            const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(area + i + 1));
+            const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(area + i + 2));
+            const __m128i m2 = exact ? _mm_cmpeq_epi8(v2, vthird) : _mm_cmpeq_epi8(_mm_min_epu8(v2, vthird), v2);
+            uint32_t mask = uint32_t(_mm_movemask_epi8(_mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(v0, zero), _mm_cmpeq_epi8(v1, zero)), m2)));
+            // One bit per position.
+            while (mask != 0 && count < max_offsets) {
+                offsets[count++] = i + std::countr_zero(mask);
+                mask &= mask - 1;
+            }
+        #else
+            const uint8x16_t zero = vdupq_n_u8(0);
+            const uint8x16_t vthird = vdupq_n_u8(third);
+            const uint8x16_t v0 = vld1q_u8(area + i);
+            const uint8x16_t v1 = vld1q_u8(area + i + 1);
+            const uint8x16_t v2 = vld1q_u8(area + i + 2);
+            const uint8x16_t m2 = exact ? vceqq_u8(v2, vthird) : vcleq_u8(v2, vthird);
+            const uint8x16_t m = vandq_u8(vandq_u8(vceqq_u8(v0, zero), vceqq_u8(v1, zero)), m2);
+            // Narrow the 16 bytes of 00 or FF as 16 nibbles, four bits per position.
+            uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+            while (mask != 0 && count < max_offsets) {
+                const int bit = std::countr_zero(mask);
+                offsets[count++] = i + size_t(bit / 4);
+                mask &= ~(uint64_t(0x0F) << (bit & ~3));
+            }
+        #endif
+            i += 16;
         }
-        else if (next[2] == third) {
-            return next;
+    #else
+        // Without vector instructions, quickly skip the areas without zero.
+        while (count < max_offsets && i + 3 <= area_size) {
+            const uint8_t* next = reinterpret_cast<const uint8_t*>(std::memchr(area + i, 0x00, area_size - i - 2));
+            if (next == nullptr) {
+                return count;
+            }
+            i = next - area;
+            if (next[1] != 0x00) {
+                i += 2;
+            }
+            else {
+                if (exact ? next[2] == third : next[2] <= third) {
+                    offsets[count++] = i;
+                }
+                i++;
+            }
         }
-        else {
-            area_size -= (next - a) + 1;
-            a = next + 1;
+    #endif
+
+        // Remaining positions, one by one.
+        while (count < max_offsets && i + 3 <= area_size) {
+            if (area[i] == 0x00 && area[i + 1] == 0x00 && (exact ? area[i + 2] == third : area[i + 2] <= third)) {
+                offsets[count++] = i;
+            }
+            i++;
         }
+        return count;
     }
-    return nullptr;
+}
+
+const uint8_t* ts::LocateZeroZero(const void* area, size_t area_size, uint8_t third)
+{
+    const uint8_t* const base = reinterpret_cast<const uint8_t*>(area);
+    size_t offset = 0;
+    return ScanZeroZero(base, area_size, third, true, &offset, 1) == 0 ? nullptr : base + offset;
+}
+
+size_t ts::LocateZeroZeroBatch(const void* area, size_t area_size, uint8_t max_third, size_t* offsets, size_t max_offsets)
+{
+    return offsets == nullptr ? 0 : ScanZeroZero(reinterpret_cast<const uint8_t*>(area), area_size, max_third, false, offsets, max_offsets);
 }
 
 
@@ -143,6 +143,23 @@ namespace ts {
     //!
     TSCOREDLL const uint8_t* LocateZeroZero(const void* area, size_t area_size, uint8_t third);
 
+    //!
+    //! Locate all 3-byte patterns 00 00 XY, with XY lower than or equal to a maximum, into a memory area.
+    //! This is typically used to locate all start codes (00 00 01) and end of NALunits (00 00 00 or 00 00 01)
+    //! in video streams, in one single pass. Patterns may overlap, for instance in 00 00 00 01.
+    //! When the returned count is @a max_offsets, there may be more patterns after the last offset.
+    //! In that case, call again this function, starting one byte after the last offset.
+    //! On Intel x86-64 and Arm64, the search uses vector instructions.
+    //! @ingroup cpp
+    //! @param [in] area Address of a memory area to check.
+    //! @param [in] area_size Size in bytes of the memory area.
+    //! @param [in] max_third Maximum value of the third byte of the pattern, after 00 00.
+    //! @param [out] offsets Array receiving the offsets in @a area of the patterns, in increasing order.
+    //! @param [in] max_offsets Maximum number of offsets to store in @a offsets.
+    //! @return Number of patterns which were found and stored in @a offsets.
+    //!
+    TSCOREDLL size_t LocateZeroZeroBatch(const void* area, size_t area_size, uint8_t max_third, size_t* offsets, size_t max_offsets);
+
     //!
     //! Check if a memory area contains all identical byte values.
     //! @ingroup cpp
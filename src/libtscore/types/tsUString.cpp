@@ -86,6 +86,15 @@ void ts::UString::ConvertUTF16ToUTF8(const UChar*& in_start, const UChar* in_end
 
     while (in_start < in_end && out_start < out_end) {
 
+        // Fast path for sequences of ASCII characters, the most frequent case.
+        if (*in_start < 0x0080) {
+            *out_start++ = char(*in_start++);
+            while (in_start < in_end && out_start < out_end && *in_start < 0x0080) {
+                *out_start++ = char(*in_start++);
+            }
+            continue;
+        }
+
         // Get current code point as 16-bit value.
         code = *in_start++;
 
@@ -347,13 +356,20 @@ ts::UString& ts::UString::assignFromUTF8(const char* utf8, size_type count)
 //----------------------------------------------------------------------------
 
 void ts::UString::toUTF8(std::string& utf8) const
+{
+    utf8.clear();
+    AppendUTF8(utf8, data(), size());
+}
+
+void ts::UString::AppendUTF8(std::string& utf8, const UChar* str, size_type count)
 {
     // The maximum number of UTF-8 bytes is 3 times the number of UTF-16 codes.
-    utf8.resize(3 * size());
+    const size_t previous = utf8.size();
+    utf8.resize(previous + 3 * count);
 
-    const UChar* in_start = data();
-    char* out_start = const_cast<char*>(utf8.data());
-    ConvertUTF16ToUTF8(in_start, in_start + size(), out_start, out_start + utf8.size());
+    const UChar* in_start = str;
+    char* out_start = utf8.data() + previous;
+    ConvertUTF16ToUTF8(in_start, in_start + count, out_start, out_start + 3 * count);
 
     utf8.resize(out_start - utf8.data());
 }
@@ -370,18 +386,36 @@ std::string ts::UString::toUTF8() const
 // Output operator for ts::UString on standard text streams with UTF-8 conv.
 //----------------------------------------------------------------------------
 
+namespace {
+    // Write a UTF-16 string in UTF-8 on a text stream, through a local buffer, without memory allocation.
+    std::ostream& WriteUTF8(std::ostream& strm, const ts::UChar* str, size_t count)
+    {
+        // With a field width (std::setw), the padding is computed on the complete UTF-8 string.
+        if (strm.width() != 0) {
+            std::string utf8;
+            ts::UString::AppendUTF8(utf8, str, count);
+            return strm << utf8;
+        }
+        char buffer[512];
+        const ts::UChar* in_start = str;
+        const ts::UChar* const in_end = str + count;
+        while (strm && in_start < in_end) {
+            char* out_start = buffer;
+            ts::UString::ConvertUTF16ToUTF8(in_start, in_end, out_start, buffer + sizeof(buffer));
+            strm.write(buffer, out_start - buffer);
+        }
+        return strm;
+    }
+}
+
 std::ostream& operator<<(std::ostream& strm, const ts::UString& str)
 {
-    std::string utf8;
-    str.toUTF8(utf8);
-    return strm << utf8;
+    return WriteUTF8(strm, str.data(), str.size());
 }
 
 std::ostream& operator<<(std::ostream& strm, const ts::UChar* str)
 {
-    std::string utf8;
-    ts::UString(str).toUTF8(utf8);
-    return strm << utf8;
+    return str == nullptr ? strm : WriteUTF8(strm, str, std::char_traits<ts::UChar>::length(str));
 }
 
 
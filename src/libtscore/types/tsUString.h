@@ -482,6 +482,21 @@ namespace ts {
         //!
         void toUTF8(std::string& utf8) const;
 
+        //!
+        //! Convert this UTF-16 string into UTF-8 and append it to an existing UTF-8 string.
+        //! This is the preferred method to build UTF-8 output lines in a reused buffer.
+        //! @param [in,out] utf8 The UTF-8 string to which the conversion is appended.
+        //!
+        void appendUTF8(std::string& utf8) const { AppendUTF8(utf8, data(), size()); }
+
+        //!
+        //! Convert a UTF-16 string into UTF-8 and append it to an existing UTF-8 string.
+        //! @param [in,out] utf8 The UTF-8 string to which the conversion is appended.
+        //! @param [in] str Address of the UTF-16 string to convert.
+        //! @param [in] count Number of UTF-16 characters in @a str.
+        //!
+        static void AppendUTF8(std::string& utf8, const UChar* str, size_type count);
+
         //!
         //! General routine to convert from UTF-16 to UTF-8.
         //! Stop when the input buffer is empty or the output buffer is full, whichever comes first.
@@ -90,49 +90,49 @@ namespace {
     // reg q,           1 bit
     // reg r,           1 bit
 
-    const int sbox1[32] = {
+    constexpr int sbox1[32] = {
         2,0,1,1,2,3,3,0,
         3,2,2,0,1,1,0,3,
         0,3,3,0,2,2,1,1,
         2,2,0,3,1,1,3,0
     };
 
-    const int sbox2[32] = {
+    constexpr int sbox2[32] = {
         3,1,0,2,2,3,3,0,
         1,3,2,1,0,0,1,2,
         3,1,0,3,3,2,0,2,
         0,0,1,2,2,1,3,1
     };
 
-    const int sbox3[32] = {
+    constexpr int sbox3[32] = {
         2,0,1,2,2,3,3,1,
         1,1,0,3,3,0,2,0,
         1,3,0,1,3,0,2,2,
         2,0,1,2,0,3,3,1
     };
 
-    const int sbox4[32] = {
+    constexpr int sbox4[32] = {
         3,1,2,3,0,2,1,2,
         1,2,0,1,3,0,0,3,
         1,0,3,1,2,3,0,3,
         0,3,2,0,1,2,2,1
     };
 
-    const int sbox5[32] = {
+    constexpr int sbox5[32] = {
         2,0,0,1,3,2,3,2,
         0,1,3,3,1,0,2,1,
         2,3,2,0,0,3,1,1,
         1,0,3,2,3,1,0,2
     };
 
-    const int sbox6[32] = {
+    constexpr int sbox6[32] = {
         0,1,2,3,1,2,2,0,
         0,1,3,0,2,3,1,3,
         2,3,0,2,3,0,1,1,
         2,1,1,2,0,3,3,0
     };
 
-    const int sbox7[32] = {
+    constexpr int sbox7[32] = {
         0,3,2,2,3,0,0,1,
         3,0,1,3,1,2,2,1,
         1,0,3,3,0,1,1,2,
@@ -336,6 +336,277 @@ void ts::DVBCSA2::DVBStreamCipher::cipher(const uint8_t* sb, uint8_t *cb)
 }
 
 
+//----------------------------------------------------------------------------
+// Bitsliced stream cipher
+//----------------------------------------------------------------------------
+//
+// The stream cipher is computed on PARALLEL_COUNT data areas at a time. Each
+// bit of the state of the cipher is represented by a 64-bit word where bit N
+// is the value of this state bit for data area N ("bitslicing"). All boolean
+// operations are consequently applied to 64 data areas at a time. The s-boxes
+// are evaluated as boolean functions using a tree of multiplexers.
+//
+// This is a portable implementation, using 64-bit integers only. On 64-bit
+// platforms, this is fast enough to make the stream cipher cheaper than the
+// block cipher.
+//
+//----------------------------------------------------------------------------
+
+namespace {
+
+    // One bit of state for 64 parallel ciphers.
+    using BitSlice = uint64_t;
+    static_assert(8 * sizeof(BitSlice) == ts::DVBCSA2::PARALLEL_COUNT);
+
+    constexpr BitSlice ALL_ONES = ~BitSlice(0);
+
+    // Compute the 32-bit truth table of one output bit of a 5-bit s-box.
+    constexpr uint32_t TruthTable(const int (&sbox)[32], int bit)
+    {
+        uint32_t table = 0;
+        for (int i = 0; i < 32; ++i) {
+            table |= uint32_t((sbox[i] >> bit) & 1) << i;
+        }
+        return table;
+    }
+
+    // Evaluate a boolean function of 5 inputs on bitsliced inputs. The function is defined by its
+    // truth table. The inputs x4 to x0 are the most to least significant bits of the s-box index.
+    template <uint32_t TABLE>
+    inline BitSlice Eval5(BitSlice x4, BitSlice x3, BitSlice x2, BitSlice x1, BitSlice x0)
+    {
+        // First level: each pair of entries in the truth table is a function of x0 only.
+        BitSlice v[16];
+        for (int k = 0; k < 16; ++k) {
+            switch ((TABLE >> (2 * k)) & 3) {
+                case 0: v[k] = 0; break;
+                case 1: v[k] = ~x0; break;
+                case 2: v[k] = x0; break;
+                default: v[k] = ALL_ONES; break;
+            }
+        }
+        // Next levels: multiplexers on x1 to x4.
+        for (int k = 0; k < 8; ++k) {
+            v[k] = v[2*k] ^ ((v[2*k] ^ v[2*k+1]) & x1);
+        }
+        for (int k = 0; k < 4; ++k) {
+            v[k] = v[2*k] ^ ((v[2*k] ^ v[2*k+1]) & x2);
+        }
+        for (int k = 0; k < 2; ++k) {
+            v[k] = v[2*k] ^ ((v[2*k] ^ v[2*k+1]) & x3);
+        }
+        return v[0] ^ ((v[0] ^ v[1]) & x4);
+    }
+
+    // Transpose a 8x8 bit matrix: bit 8*i+j is swapped with bit 8*j+i.
+    inline uint64_t Transpose8x8(uint64_t x)
+    {
+        uint64_t t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AA;
+        x ^= t ^ (t << 7);
+        t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCC;
+        x ^= t ^ (t << 14);
+        t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0;
+        return x ^ t ^ (t << 28);
+    }
+
+    // Load the byte at some index in up to 64 data areas as 8 bitslices (index in slices is the bit number).
+    void LoadSlices(BitSlice slices[8], const uint8_t* const data[], size_t count, size_t index)
+    {
+        for (size_t bit = 0; bit < 8; ++bit) {
+            slices[bit] = 0;
+        }
+        for (size_t group = 0; group < count; group += 8) {
+            uint64_t x = 0;
+            for (size_t k = 0; k < 8 && group + k < count; ++k) {
+                x |= uint64_t(data[group + k][index]) << (8 * k);
+            }
+            x = Transpose8x8(x);
+            for (size_t bit = 0; bit < 8; ++bit) {
+                slices[bit] |= ((x >> (8 * bit)) & 0xFF) << group;
+            }
+        }
+    }
+
+    // Xor 8 bitslices on the byte at some index in up to 64 data areas, when the data area is large enough.
+    void XorSlices(const BitSlice slices[8], uint8_t* const data[], const size_t size[], size_t count, size_t index)
+    {
+        for (size_t group = 0; group < count; group += 8) {
+            uint64_t x = 0;
+            for (size_t bit = 0; bit < 8; ++bit) {
+                x |= ((slices[bit] >> group) & 0xFF) << (8 * bit);
+            }
+            x = Transpose8x8(x);
+            for (size_t k = 0; k < 8 && group + k < count; ++k) {
+                if (index < size[group + k]) {
+                    data[group + k][index] ^= uint8_t(x >> (8 * k));
+                }
+            }
+        }
+    }
+}
+
+// Same registers as DVBStreamCipher, each nibble is an array of 4 bitslices, index is the bit number.
+class ts::DVBCSA2::DVBStreamCipherParallel
+{
+public:
+    // Constructor: all parallel ciphers are initialized with the same key.
+    DVBStreamCipherParallel(const uint8_t* key);
+
+    // Process one byte: initialization with 8 input bitslices or generation of 8 output bitslices.
+    template <bool INIT>
+    void clock(const BitSlice* in, BitSlice* out);
+
+private:
+    BitSlice A[11][4] {};
+    BitSlice B[11][4] {};
+    BitSlice X[4] {};
+    BitSlice Y[4] {};
+    BitSlice Z[4] {};
+    BitSlice D[4] {};
+    BitSlice E[4] {};
+    BitSlice F[4] {};
+    BitSlice p = 0;
+    BitSlice q = 0;
+    BitSlice r = 0;
+
+    // One step of the cipher, producing two bits. Input nibbles are used during initialization only.
+    template <bool INIT>
+    void step(const BitSlice* in_a, const BitSlice* in_b, BitSlice& hi, BitSlice& lo);
+};
+
+ts::DVBCSA2::DVBStreamCipherParallel::DVBStreamCipherParallel(const uint8_t* key)
+{
+    // Load first 32 bits of key into A[1]..A[8], last 32 bits into B[1]..B[8].
+    for (size_t i = 0; i < 8; ++i) {
+        const int na = (key[i / 2] >> (i % 2 == 0 ? 4 : 0)) & 0x0F;
+        const int nb = (key[4 + i / 2] >> (i % 2 == 0 ? 4 : 0)) & 0x0F;
+        for (size_t bit = 0; bit < 4; ++bit) {
+            A[i + 1][bit] = ((na >> bit) & 1) != 0 ? ALL_ONES : 0;
+            B[i + 1][bit] = ((nb >> bit) & 1) != 0 ? ALL_ONES : 0;
+        }
+    }
+}
+
+template <bool INIT>
+inline void ts::DVBCSA2::DVBStreamCipherParallel::step(const BitSlice* in_a, const BitSlice* in_b, BitSlice& hi, BitSlice& lo)
+{
+    // From A[1]..A[10], 35 bits are selected as inputs to 7 s-boxes.
+    const BitSlice s1b0 = Eval5<TruthTable(sbox1, 0)>(A[4][0], A[1][2], A[6][1], A[7][3], A[9][0]);
+    const BitSlice s1b1 = Eval5<TruthTable(sbox1, 1)>(A[4][0], A[1][2], A[6][1], A[7][3], A[9][0]);
+    const BitSlice s2b0 = Eval5<TruthTable(sbox2, 0)>(A[2][1], A[3][2], A[6][3], A[7][0], A[9][1]);
+    const BitSlice s2b1 = Eval5<TruthTable(sbox2, 1)>(A[2][1], A[3][2], A[6][3], A[7][0], A[9][1]);
+    const BitSlice s3b0 = Eval5<TruthTable(sbox3, 0)>(A[1][3], A[2][0], A[5][1], A[5][3], A[6][2]);
+    const BitSlice s3b1 = Eval5<TruthTable(sbox3, 1)>(A[1][3], A[2][0], A[5][1], A[5][3], A[6][2]);
+    const BitSlice s4b0 = Eval5<TruthTable(sbox4, 0)>(A[3][3], A[1][1], A[2][3], A[4][2], A[8][0]);
+    const BitSlice s4b1 = Eval5<TruthTable(sbox4, 1)>(A[3][3], A[1][1], A[2][3], A[4][2], A[8][0]);
+    const BitSlice s5b0 = Eval5<TruthTable(sbox5, 0)>(A[5][2], A[4][3], A[6][0], A[8][1], A[9][2]);
+    const BitSlice s5b1 = Eval5<TruthTable(sbox5, 1)>(A[5][2], A[4][3], A[6][0], A[8][1], A[9][2]);
+    const BitSlice s6b0 = Eval5<TruthTable(sbox6, 0)>(A[3][1], A[4][1], A[5][0], A[7][2], A[9][3]);
+    const BitSlice s6b1 = Eval5<TruthTable(sbox6, 1)>(A[3][1], A[4][1], A[5][0], A[7][2], A[9][3]);
+    const BitSlice s7b0 = Eval5<TruthTable(sbox7, 0)>(A[2][2], A[3][0], A[7][1], A[8][2], A[8][3]);
+    const BitSlice s7b1 = Eval5<TruthTable(sbox7, 1)>(A[2][2], A[3][0], A[7][1], A[8][2], A[8][3]);
+
+    // Use 4x4 xor to produce extra nibble for T3.
+    const BitSlice extra_B[4] = {
+        B[9][2] ^ B[6][3] ^ B[3][1] ^ B[8][0],
+        B[5][3] ^ B[8][2] ^ B[4][0] ^ B[5][1],
+        B[6][0] ^ B[8][1] ^ B[3][3] ^ B[4][2],
+        B[3][0] ^ B[6][1] ^ B[7][2] ^ B[9][3]
+    };
+
+    BitSlice next_A1[4];
+    BitSlice next_B1[4];
+    BitSlice next_F[4];
+    BitSlice carry = r;
+    for (size_t bit = 0; bit < 4; ++bit) {
+        // T1 and T2, input nibbles and D are only used during initialisation.
+        next_A1[bit] = A[10][bit] ^ X[bit];
+        next_B1[bit] = B[7][bit] ^ B[10][bit] ^ Y[bit];
+        if constexpr (INIT) {
+            next_A1[bit] ^= D[bit] ^ in_a[bit];
+            next_B1[bit] ^= in_b[bit];
+        }
+        // T3 = xor all inputs.
+        D[bit] = E[bit] ^ Z[bit] ^ extra_B[bit];
+        // T4 = sum of Z + E + r when q = 1, E otherwise.
+        const BitSlice sum = Z[bit] ^ E[bit] ^ carry;
+        carry = (Z[bit] & E[bit]) | (carry & (Z[bit] ^ E[bit]));
+        next_F[bit] = E[bit] ^ ((E[bit] ^ sum) & q);
+    }
+    r ^= (r ^ carry) & q;
+
+    // If p = 1, rotate next_B1 left.
+    const BitSlice b3 = next_B1[3];
+    next_B1[3] ^= (next_B1[3] ^ next_B1[2]) & p;
+    next_B1[2] ^= (next_B1[2] ^ next_B1[1]) & p;
+    next_B1[1] ^= (next_B1[1] ^ next_B1[0]) & p;
+    next_B1[0] ^= (next_B1[0] ^ b3) & p;
+
+    // Shift registers.
+    std::memmove(&A[2], &A[1], 9 * sizeof(A[1]));
+    std::memmove(&B[2], &B[1], 9 * sizeof(B[1]));
+    for (size_t bit = 0; bit < 4; ++bit) {
+        A[1][bit] = next_A1[bit];
+        B[1][bit] = next_B1[bit];
+        E[bit] = F[bit];
+        F[bit] = next_F[bit];
+    }
+
+    X[0] = s1b1; X[1] = s2b1; X[2] = s3b0; X[3] = s4b0;
+    Y[0] = s3b1; Y[1] = s4b1; Y[2] = s5b0; Y[3] = s6b0;
+    Z[0] = s5b1; Z[1] = s6b1; Z[2] = s1b0; Z[3] = s2b0;
+    p = s7b1;
+    q = s7b0;
+
+    // 2 output bits are a function of the 4 bits of D, xor 2 by 2.
+    hi = D[2] ^ D[3];
+    lo = D[0] ^ D[1];
+}
+
+template <bool INIT>
+void ts::DVBCSA2::DVBStreamCipherParallel::clock(const BitSlice* in, BitSlice* out)
+{
+    // 4 steps per byte, 2 bits per step, most significant bits first.
+    // During initialization, the most significant nibble of the input byte is used first in A.
+    for (size_t j = 0; j < 4; ++j) {
+        BitSlice hi, lo;
+        if constexpr (INIT) {
+            step<true>(j % 2 == 0 ? in + 4 : in, j % 2 == 0 ? in : in + 4, hi, lo);
+        }
+        else {
+            step<false>(nullptr, nullptr, hi, lo);
+            out[7 - 2 * j] = hi;
+            out[6 - 2 * j] = lo;
+        }
+    }
+}
+
+void ts::DVBCSA2::streamParallel(uint8_t* const data[], const size_t size[], size_t count) const
+{
+    assert(count <= PARALLEL_COUNT);
+
+    DVBStreamCipherParallel stream(_key);
+    BitSlice slices[8];
+
+    // Initialize the stream cipher with the first 8 bytes of each data area.
+    size_t max_size = 0;
+    for (size_t i = 0; i < count; ++i) {
+        assert(size[i] >= 8);
+        max_size = std::max(max_size, size[i]);
+    }
+    for (size_t index = 0; index < 8; ++index) {
+        LoadSlices(slices, data, count, index);
+        stream.clock<true>(slices, nullptr);
+    }
+
+    // Xor the key stream on the rest of the data areas.
+    for (size_t index = 8; index < max_size; ++index) {
+        stream.clock<false>(nullptr, slices);
+        XorSlices(slices, data, size, count, index);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Block cipher
 //----------------------------------------------------------------------------
@@ -357,7 +628,7 @@ namespace {
 
     // S-Box
 
-    const uint8_t block_sbox[256] = {
+    constexpr uint8_t block_sbox[256] = {
         0x3A, 0xEA, 0x68, 0xFE, 0x33, 0xE9, 0x88, 0x1A,
         0x83, 0xCF, 0xE1, 0x7F, 0xBA, 0xE2, 0x38, 0x12,
         0xE8, 0x27, 0x61, 0x95, 0x0C, 0x36, 0xE5, 0x70,
@@ -395,7 +666,7 @@ namespace {
 
     // Permutations
 
-    const int block_perm[256] = {
+    constexpr uint8_t block_perm[256] = {
         0x00, 0x02, 0x80, 0x82, 0x20, 0x22, 0xA0, 0xA2,
         0x10, 0x12, 0x90, 0x92, 0x30, 0x32, 0xB0, 0xB2,
         0x04, 0x06, 0x84, 0x86, 0x24, 0x26, 0xA4, 0xA6,
@@ -430,6 +701,15 @@ namespace {
         0x4D, 0x4F, 0xCD, 0xCF, 0x6D, 0x6F, 0xED, 0xEF,
         0x5D, 0x5F, 0xDD, 0xDF, 0x7D, 0x7F, 0xFD, 0xFF
     };
+
+    // Permutation of the S-Box output, indexed by the S-Box input.
+    constexpr auto block_sbox_perm = [] {
+        std::array<uint8_t, 256> table {};
+        for (size_t i = 0; i < table.size(); ++i) {
+            table[i] = block_perm[block_sbox[i]];
+        }
+        return table;
+    }();
 }
 
 
@@ -473,99 +753,149 @@ void ts::DVBCSA2::DVBBlockCipher::init(const uint8_t *key)
     // xor to give kk
     for (i = 0; i < 7; i++) {
         for (j = 0; j < 8; j++) {
-            _kk[1+i*8+j] = kb[1+i][1+j] ^ i;
+            _kk[1+i*8+j] = uint8_t(kb[1+i][1+j] ^ i);
         }
     }
 }
 
 
+// One round of the block cipher. The 8 registers R1 to R8 are renamed after each
+// round instead of being shifted. After 8 rounds, they are back in place.
+
+#define DECIPHER_ROUND(k, r1, r2, r3, r4, r5, r6, r7, r8) \
+    do {                                                   \
+        const unsigned x = (k) ^ r7;                       \
+        r8 ^= block_sbox[x];                               \
+        r2 ^= r8;                                          \
+        r3 ^= r8;                                          \
+        r4 ^= r8;                                          \
+        r6 ^= block_sbox_perm[x];                          \
+    } while (false)
+
+#define ENCIPHER_ROUND(k, r1, r2, r3, r4, r5, r6, r7, r8) \
+    do {                                                   \
+        const unsigned x = (k) ^ r8;                       \
+        r3 ^= r1;                                          \
+        r4 ^= r1;                                          \
+        r5 ^= r1;                                          \
+        r7 ^= block_sbox_perm[x];                          \
+        r1 ^= block_sbox[x];                               \
+    } while (false)
+
 void ts::DVBCSA2::DVBBlockCipher::decipher(const uint8_t *ib, uint8_t *bd)
 {
-    int i;
-    int sbox_in;
-    int sbox_out;
-    int perm_out;
-    int R[9];
-    int next_R8;
-
-    R[1] = ib[0];
-    R[2] = ib[1];
-    R[3] = ib[2];
-    R[4] = ib[3];
-    R[5] = ib[4];
-    R[6] = ib[5];
-    R[7] = ib[6];
-    R[8] = ib[7];
+    unsigned R1 = ib[0];
+    unsigned R2 = ib[1];
+    unsigned R3 = ib[2];
+    unsigned R4 = ib[3];
+    unsigned R5 = ib[4];
+    unsigned R6 = ib[5];
+    unsigned R7 = ib[6];
+    unsigned R8 = ib[7];
 
     // loop over kk[56]..kk[1]
-    for (i = 56; i > 0; i--) {
-        sbox_in  = _kk[i] ^ R[7];
-        sbox_out = block_sbox[sbox_in];
-        perm_out = block_perm[sbox_out];
-        next_R8 = R[7];
-        R[7] = R[6] ^ perm_out;
-        R[6] = R[5];
-        R[5] = R[4] ^ R[8] ^ sbox_out;
-        R[4] = R[3] ^ R[8] ^ sbox_out;
-        R[3] = R[2] ^ R[8] ^ sbox_out;
-        R[2] = R[1];
-        R[1] = R[8] ^ sbox_out;
-        R[8] = next_R8;
-    }
-
-    bd[0] = uint8_t(R[1]);
-    bd[1] = uint8_t(R[2]);
-    bd[2] = uint8_t(R[3]);
-    bd[3] = uint8_t(R[4]);
-    bd[4] = uint8_t(R[5]);
-    bd[5] = uint8_t(R[6]);
-    bd[6] = uint8_t(R[7]);
-    bd[7] = uint8_t(R[8]);
+    for (int i = 56; i > 0; i -= 8) {
+        DECIPHER_ROUND(_kk[i],   R1, R2, R3, R4, R5, R6, R7, R8);
+        DECIPHER_ROUND(_kk[i-1], R8, R1, R2, R3, R4, R5, R6, R7);
+        DECIPHER_ROUND(_kk[i-2], R7, R8, R1, R2, R3, R4, R5, R6);
+        DECIPHER_ROUND(_kk[i-3], R6, R7, R8, R1, R2, R3, R4, R5);
+        DECIPHER_ROUND(_kk[i-4], R5, R6, R7, R8, R1, R2, R3, R4);
+        DECIPHER_ROUND(_kk[i-5], R4, R5, R6, R7, R8, R1, R2, R3);
+        DECIPHER_ROUND(_kk[i-6], R3, R4, R5, R6, R7, R8, R1, R2);
+        DECIPHER_ROUND(_kk[i-7], R2, R3, R4, R5, R6, R7, R8, R1);
+    }
+
+    bd[0] = uint8_t(R1);
+    bd[1] = uint8_t(R2);
+    bd[2] = uint8_t(R3);
+    bd[3] = uint8_t(R4);
+    bd[4] = uint8_t(R5);
+    bd[5] = uint8_t(R6);
+    bd[6] = uint8_t(R7);
+    bd[7] = uint8_t(R8);
 }
 
 
+void ts::DVBCSA2::DVBBlockCipher::decipher(const uint8_t *ib, uint8_t *bd, size_t count)
+{
+    // Decipher 4 independent blocks at a time to hide the latency of the table lookups.
+    for (; count >= 4; count -= 4, ib += 32, bd += 32) {
+        unsigned R[4][8];
+        for (size_t n = 0; n < 4; ++n) {
+            for (size_t j = 0; j < 8; ++j) {
+                R[n][j] = ib[8*n + j];
+            }
+        }
+        for (int i = 56; i > 0; i -= 8) {
+            for (size_t n = 0; n < 4; ++n) {
+                DECIPHER_ROUND(_kk[i],   R[n][0], R[n][1], R[n][2], R[n][3], R[n][4], R[n][5], R[n][6], R[n][7]);
+            }
+            for (size_t n = 0; n < 4; ++n) {
+                DECIPHER_ROUND(_kk[i-1], R[n][7], R[n][0], R[n][1], R[n][2], R[n][3], R[n][4], R[n][5], R[n][6]);
+            }
+            for (size_t n = 0; n < 4; ++n) {
+                DECIPHER_ROUND(_kk[i-2], R[n][6], R[n][7], R[n][0], R[n][1], R[n][2], R[n][3], R[n][4], R[n][5]);
+            }
+            for (size_t n = 0; n < 4; ++n) {
+                DECIPHER_ROUND(_kk[i-3], R[n][5], R[n][6], R[n][7], R[n][0], R[n][1], R[n][2], R[n][3], R[n][4]);
+            }
+            for (size_t n = 0; n < 4; ++n) {
+                DECIPHER_ROUND(_kk[i-4], R[n][4], R[n][5], R[n][6], R[n][7], R[n][0], R[n][1], R[n][2], R[n][3]);
+            }
+            for (size_t n = 0; n < 4; ++n) {
+                DECIPHER_ROUND(_kk[i-5], R[n][3], R[n][4], R[n][5], R[n][6], R[n][7], R[n][0], R[n][1], R[n][2]);
+            }
+            for (size_t n = 0; n < 4; ++n) {
+                DECIPHER_ROUND(_kk[i-6], R[n][2], R[n][3], R[n][4], R[n][5], R[n][6], R[n][7], R[n][0], R[n][1]);
+            }
+            for (size_t n = 0; n < 4; ++n) {
+                DECIPHER_ROUND(_kk[i-7], R[n][1], R[n][2], R[n][3], R[n][4], R[n][5], R[n][6], R[n][7], R[n][0]);
+            }
+        }
+        for (size_t n = 0; n < 4; ++n) {
+            for (size_t j = 0; j < 8; ++j) {
+                bd[8*n + j] = uint8_t(R[n][j]);
+            }
+        }
+    }
+
+    // Remaining blocks, one by one.
+    for (; count > 0; --count, ib += 8, bd += 8) {
+        decipher(ib, bd);
+    }
+}
+
 void ts::DVBCSA2::DVBBlockCipher::encipher(const uint8_t *bd, uint8_t *ib)
 {
-    int i;
-    int sbox_in;
-    int sbox_out;
-    int perm_out;
-    int R[9];
-    int next_R1;
-
-    R[1] = bd[0];
-    R[2] = bd[1];
-    R[3] = bd[2];
-    R[4] = bd[3];
-    R[5] = bd[4];
-    R[6] = bd[5];
-    R[7] = bd[6];
-    R[8] = bd[7];
+    unsigned R1 = bd[0];
+    unsigned R2 = bd[1];
+    unsigned R3 = bd[2];
+    unsigned R4 = bd[3];
+    unsigned R5 = bd[4];
+    unsigned R6 = bd[5];
+    unsigned R7 = bd[6];
+    unsigned R8 = bd[7];
 
     // loop over kk[1]..kk[56]
-    for (i = 1; i <= 56; i++) {
-        sbox_in  = _kk[i] ^ R[8];
-        sbox_out = block_sbox[sbox_in];
-        perm_out = block_perm[sbox_out];
-        next_R1 = R[2];
-        R[2] = R[3] ^ R[1];
-        R[3] = R[4] ^ R[1];
-        R[4] = R[5] ^ R[1];
-        R[5] = R[6];
-        R[6] = R[7] ^ perm_out;
-        R[7] = R[8];
-        R[8] = R[1] ^ sbox_out;
-        R[1] = next_R1;
-    }
-
-    ib[0] = uint8_t(R[1]);
-    ib[1] = uint8_t(R[2]);
-    ib[2] = uint8_t(R[3]);
-    ib[3] = uint8_t(R[4]);
-    ib[4] = uint8_t(R[5]);
-    ib[5] = uint8_t(R[6]);
-    ib[6] = uint8_t(R[7]);
-    ib[7] = uint8_t(R[8]);
+    for (int i = 1; i <= 56; i += 8) {
+        ENCIPHER_ROUND(_kk[i],   R1, R2, R3, R4, R5, R6, R7, R8);
+        ENCIPHER_ROUND(_kk[i+1], R2, R3, R4, R5, R6, R7, R8, R1);
+        ENCIPHER_ROUND(_kk[i+2], R3, R4, R5, R6, R7, R8, R1, R2);
+        ENCIPHER_ROUND(_kk[i+3], R4, R5, R6, R7, R8, R1, R2, R3);
+        ENCIPHER_ROUND(_kk[i+4], R5, R6, R7, R8, R1, R2, R3, R4);
+        ENCIPHER_ROUND(_kk[i+5], R6, R7, R8, R1, R2, R3, R4, R5);
+        ENCIPHER_ROUND(_kk[i+6], R7, R8, R1, R2, R3, R4, R5, R6);
+        ENCIPHER_ROUND(_kk[i+7], R8, R1, R2, R3, R4, R5, R6, R7);
+    }
+
+    ib[0] = uint8_t(R1);
+    ib[1] = uint8_t(R2);
+    ib[2] = uint8_t(R3);
+    ib[3] = uint8_t(R4);
+    ib[4] = uint8_t(R5);
+    ib[5] = uint8_t(R6);
+    ib[6] = uint8_t(R7);
+    ib[7] = uint8_t(R8);
 }
 
 
@@ -740,3 +1070,77 @@ bool ts::DVBCSA2::decryptImpl(const void* input, size_t input_length, void* outp
 
     return true;
 }
+
+
+//----------------------------------------------------------------------------
+// Encrypt or decrypt several data areas (typically TS packets payloads).
+//----------------------------------------------------------------------------
+
+size_t ts::DVBCSA2::encryptMany(uint8_t* const data[], const size_t size[], size_t count)
+{
+    return processMany(data, size, count, true);
+}
+
+size_t ts::DVBCSA2::decryptMany(uint8_t* const data[], const size_t size[], size_t count)
+{
+    return processMany(data, size, count, false);
+}
+
+size_t ts::DVBCSA2::processMany(uint8_t* const data[], const size_t size[], size_t count, bool encrypt)
+{
+    uint8_t* group_data[PARALLEL_COUNT];
+    size_t group_size[PARALLEL_COUNT];
+    size_t done = 0;
+    bool ok = true;
+
+    while (ok && done < count) {
+
+        // Collect the next group of data areas, up to the first error.
+        // Data areas smaller than 8 bytes are left unscrambled.
+        size_t group_count = 0;
+        for (; done < count && group_count < PARALLEL_COUNT; ++done) {
+            ok = (encrypt ? allowEncrypt() : allowDecrypt()) && _init && (data[done] != nullptr || size[done] == 0) && size[done] <= MAX_DATA_SIZE;
+            if (!ok) {
+                break;
+            }
+            if (size[done] >= 8) {
+                group_data[group_count] = data[done];
+                group_size[group_count] = size[done];
+                group_count++;
+            }
+        }
+
+        if (encrypt) {
+            // Perform block cipher in reverse CBC mode, independently on each data area.
+            // After last block is initialization vector (zero in DVB-CSA).
+            for (size_t i = 0; i < group_count; ++i) {
+                uint8_t* const area = group_data[i];
+                size_t blk = group_size[i] / 8 - 1;
+                _block.encipher(area + 8*blk, area + 8*blk);
+                while (blk-- > 0) {
+                    xor_8(area + 8*blk, area + 8*blk, area + 8*(blk+1));
+                    _block.encipher(area + 8*blk, area + 8*blk);
+                }
+            }
+            // The first block is used to initialize the stream cipher, the rest is xor'ed with the stream.
+            streamParallel(group_data, group_size, group_count);
+        }
+        else {
+            // Reverse the stream cipher first, all intermediate blocks are restored.
+            streamParallel(group_data, group_size, group_count);
+            // Decipher all blocks, independently, then xor with next intermediate block.
+            // Last block is xor'ed with IV = 0.
+            uint8_t oblock[MAX_NBLOCKS][8];
+            for (size_t i = 0; i < group_count; ++i) {
+                uint8_t* const area = group_data[i];
+                const size_t nblocks = group_size[i] / 8;
+                _block.decipher(area, oblock[0], nblocks);
+                for (size_t blk = 0; blk + 1 < nblocks; ++blk) {
+                    xor_8(area + 8*blk, oblock[blk], area + 8*(blk+1));
+                }
+                memcpy_8(area + 8*(nblocks-1), oblock[nblocks-1]);
+            }
+        }
+    }
+    return done;
+}
@@ -26,6 +26,8 @@ namespace ts {
         static constexpr size_t KEY_BITS = 64;             //!< DVB CSA-2 control words size in bits.
         static constexpr size_t KEY_SIZE = KEY_BITS / 8;   //!< DVB CSA-2 control words size in bytes.
         static constexpr size_t BLOCK_SIZE = 8;            //!< DVB CSA-2 block size in bytes (informational only, not relevant to scrambling).
+        static constexpr size_t PARALLEL_COUNT = 64;       //!< Number of data areas which are processed in parallel by encryptMany() and decryptMany().
+        static constexpr size_t MAX_DATA_SIZE = 184;       //!< Maximum size in bytes of a data area in encryptMany() and decryptMany().
 
         //!
         //! Control word entropy reduction.
@@ -68,6 +70,42 @@ namespace ts {
         //!
         static bool IsReducedCW(const uint8_t *cw);
 
+        //!
+        //! Encrypt several data areas "in place" using the current control word.
+        //!
+        //! This is typically used to scramble the payloads of many TS packets. The result is the same
+        //! as encrypting each data area using encrypt(). However, the stream cipher is computed on
+        //! PARALLEL_COUNT data areas at a time using a bitsliced implementation, which is much faster.
+        //!
+        //! @param [in,out] data Array of @a count addresses of data areas to encrypt "in place".
+        //! @param [in] size Array of @a count data sizes in bytes. Each size must not be larger than
+        //! MAX_DATA_SIZE. Data areas which are shorter than 8 bytes are left unmodified, as in encrypt().
+        //! @param [in] count Number of data areas. There is no limit, the data areas are processed
+        //! by groups of PARALLEL_COUNT.
+        //! @return The number of encrypted data areas, from the beginning of the arrays. When the returned
+        //! value is lower than @a count, an error occurred (no key, invalid size, key usage limit reached)
+        //! and the remaining data areas are left unmodified.
+        //!
+        size_t encryptMany(uint8_t* const data[], const size_t size[], size_t count);
+
+        //!
+        //! Decrypt several data areas "in place" using the current control word.
+        //!
+        //! This is typically used to descramble the payloads of many TS packets. The result is the same
+        //! as decrypting each data area using decrypt(). However, the stream cipher is computed on
+        //! PARALLEL_COUNT data areas at a time using a bitsliced implementation, which is much faster.
+        //!
+        //! @param [in,out] data Array of @a count addresses of data areas to decrypt "in place".
+        //! @param [in] size Array of @a count data sizes in bytes. Each size must not be larger than
+        //! MAX_DATA_SIZE. Data areas which are shorter than 8 bytes are left unmodified, as in decrypt().
+        //! @param [in] count Number of data areas. There is no limit, the data areas are processed
+        //! by groups of PARALLEL_COUNT.
+        //! @return The number of decrypted data areas, from the beginning of the arrays. When the returned
+        //! value is lower than @a count, an error occurred (no key, invalid size, key usage limit reached)
+        //! and the remaining data areas are left unmodified.
+        //!
+        size_t decryptMany(uint8_t* const data[], const size_t size[], size_t count);
+
     protected:
         //! Properties of this algorithm.
         //! @return A constant reference to the properties.
@@ -83,11 +121,12 @@ namespace ts {
         class DVBBlockCipher
         {
         private:
-            int _kk[57]; // 56..1: scheduled keys, index 0 unused
+            uint8_t _kk[57]; // 56..1: scheduled keys, index 0 unused
         public:
             void init(const uint8_t *cw);
             void encipher(const uint8_t *bd, uint8_t *ib);
             void decipher(const uint8_t *ib, uint8_t *bd);
+            void decipher(const uint8_t *ib, uint8_t *bd, size_t count); // several independent consecutive blocks
         };
 
         // Stream cipher data
@@ -110,6 +149,17 @@ namespace ts {
             void cipher(const uint8_t* sb, uint8_t *cb);
         };
 
+        // Bitsliced stream cipher on PARALLEL_COUNT data areas (defined in implementation).
+        class DVBStreamCipherParallel;
+
+        // Apply the stream cipher on up to PARALLEL_COUNT data areas of at least 8 bytes.
+        // The stream cipher is initialized with the first 8 bytes of each area (unmodified)
+        // and the rest of each area is xor'ed with the key stream.
+        void streamParallel(uint8_t* const data[], const size_t size[], size_t count) const;
+
+        // Common code for encryptMany() and decryptMany().
+        size_t processMany(uint8_t* const data[], const size_t size[], size_t count, bool encrypt);
+
         // DVB-CSA scrambling data
         bool            _init = false;
         EntropyMode     _mode = REDUCE_ENTROPY;
@@ -104,7 +104,7 @@ template<class CIPHER> requires std::derived_from<CIPHER, ts::BlockCipher>
 const ts::BlockCipherProperties& ts::DVS042<CIPHER>::Properties()
 {
     // Thread-safe init-safe static data pattern:
-    static const BlockCipherProperties props(CIPHER::Properties(), u"DVS042", true, 0, 3, CIPHER::BLOCK_SIZE);
+    static const BlockCipherProperties props(CIPHER::Properties(), u"DVS042", true, 0, 2 + BlockCipher::MULTI_BLOCKS, CIPHER::BLOCK_SIZE);
     return props;
 }
 
@@ -225,28 +225,38 @@ bool ts::DVS042<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, v
     const uint8_t* ct = reinterpret_cast<const uint8_t*>(cipher);
     uint8_t* pt = reinterpret_cast<uint8_t*>(plain);
 
-    while (cipher_length >= bsize) {
-        // work = decrypt (cipher-text)
-        if (!CIPHER::decryptImpl(ct, bsize, work1, bsize, nullptr)) {
+    // The block decryptions are independent. Process them by groups when possible.
+    const size_t chunk = (this->multiBlocksImpl() ? BlockCipher::MULTI_BLOCKS : 1) * bsize;
+    size_t cbc_size = cipher_length - cipher_length % bsize;
+    cipher_length -= cbc_size;
+
+    while (cbc_size > 0) {
+        const size_t size = std::min(cbc_size, chunk);
+        // With overlapping buffer, need to save current cipher.
+        const uint8_t* input = ct;
+        if (pt == ct) {
+            MemCopy(work3, ct, size);
+            input = work3;
+        }
+        // plain-text = decrypt (cipher-text)
+        if (!CIPHER::decryptImpl(input, size, pt, size, nullptr)) {
             return false;
         }
-        // plain-text = previous-cipher XOR work.
-        // previous-cipher = cipher-text
+        // plain-text = plain-text XOR previous-cipher
+        MemXor(pt, pt, previous, bsize);
+        MemXor(pt + bsize, pt + bsize, input, size - bsize);
+        // previous-cipher = last cipher-text
         if (pt == ct) {
-            // With overlapping buffer, need to save current cipher.
-            MemCopy(work2, ct, bsize);
-            MemXor(pt, previous, work1, bsize);
+            MemCopy(work2, input + size - bsize, bsize);
             previous = work2;
-            std::swap(work2, work3);
         }
         else {
-            MemXor(pt, previous, work1, bsize);
-            previous = ct;
+            previous = ct + size - bsize;
         }
-        // advance one block
-        ct += bsize;
-        pt += bsize;
-        cipher_length -= bsize;
+        // advance the group of blocks
+        ct += size;
+        pt += size;
+        cbc_size -= size;
     }
 
     // Process final block if incomplete
@@ -105,6 +105,8 @@ void ts::TSAnalyzer::reset()
     _t2mi_demux.reset();
     _lcn.clear();
     _dct.invalidate();
+    _psi_tables.clear();
+    _psi_loaded_pmts.clear();
 
     resetSectionDemux();
 }
@@ -264,20 +266,18 @@ ts::TSAnalyzer::XTIDContextPtr ts::TSAnalyzer::getXTID(const Section& section)
 //  Return a PID context. Allocate a new entry if PID not found.
 //----------------------------------------------------------------------------
 
-ts::TSAnalyzer::PIDContextPtr ts::TSAnalyzer::getPID(PID pid, const UString& description)
+const ts::TSAnalyzer::PIDContextPtr& ts::TSAnalyzer::getPID(PID pid, const UString& description)
 {
-    const PIDContextPtr p(_pids[pid]);
+    PIDContextPtr& p(_pids[pid]);
     if (p == nullptr) {
         // The PID was not yet used, map entry just created.
-        return _pids[pid] = std::make_shared<PIDContext>(pid, description);
+        p = std::make_shared<PIDContext>(pid, description);
     }
-    else {
+    else if (p->description == UNREFERENCED && description != UNREFERENCED) {
         // If the PID was marked as unreferenced, now use actual description.
-        if (p->description == UNREFERENCED && description != UNREFERENCED) {
-            p->description = description;
-        }
-        return p;
+        p->description = description;
     }
+    return p;
 }
 
 
@@ -412,8 +412,18 @@ void ts::TSAnalyzer::handleTable(SectionDemux&, const BinaryTable& table)
     const PID pid = table.sourcePID();
     const TID tid = table.tableId();
 
-    // Trace all table ids to identify missing tables
-    _tid_present.set(tid);
+    if (!_psi_loading) {
+        // Trace all table ids to identify missing tables
+        _tid_present.set(tid);
+
+        // Keep the last occurrence of the tables which describe the structure of the stream.
+        if (_psi_capture && (tid == TID_PAT || tid == TID_CAT || tid == TID_PMT || tid == TID_NIT_ACT || tid == TID_SDT_ACT ||
+            (pid == PID_PSIP && (tid == TID_MGT || tid == TID_TVCT || tid == TID_CVCT))))
+        {
+            const XTID xtid(table.isShortSection() ? XTID(tid) : XTID(tid, table.tableIdExtension()));
+            _psi_tables[std::make_pair(pid, xtid)] = std::make_shared<BinaryTable>(table, ShareMode::SHARE);
+        }
+    }
 
     // Process specific tables
     switch (tid) {
@@ -564,9 +574,22 @@ void ts::TSAnalyzer::analyzeCAT(const CAT& cat)
 
 void ts::TSAnalyzer::analyzePMT(PID pid, const PMT& pmt)
 {
-    // Count the number of PMT's on this PID
+    // Count the number of PMT's on this PID (not in tables from loadPSI()).
+    // The first occurrence of a PMT from loadPSI() was already counted in the previous segment.
     PIDContextPtr ps(getPID(pid));
-    ps->pmt_cnt++;
+    const auto loaded = _psi_loaded_pmts.find(pid);
+    if (_psi_loading) {
+        _psi_loaded_pmts[pid] = pmt.version;
+    }
+    else if (loaded != _psi_loaded_pmts.end() && loaded->second == pmt.version) {
+        _psi_loaded_pmts.erase(loaded);
+    }
+    else {
+        if (loaded != _psi_loaded_pmts.end()) {
+            _psi_loaded_pmts.erase(loaded);
+        }
+        ps->pmt_cnt++;
+    }
 
     // Get service description
     ServiceContextPtr svp(getService(pmt.service_id));
@@ -1459,7 +1482,7 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
     _t2mi_demux.feedPacket(pkt);
 
     // Get PID context
-    PIDContextPtr ps(getPID(pkt.getPID()));
+    const PIDContextPtr& ps(getPID(pkt.getPID()));
     ps->ts_pkt_cnt++;
 
     // Accumulate stat from packet
@@ -1660,6 +1683,292 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
 }
 
 
+//----------------------------------------------------------------------------
+// Capture and reload the tables which describe the structure of the stream.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::setPSICapture(bool on)
+{
+    _psi_capture = on;
+    if (!on) {
+        _psi_tables.clear();
+    }
+}
+
+void ts::TSAnalyzer::getPSI(BinaryTablePtrVector& tables) const
+{
+    tables.clear();
+    tables.reserve(_psi_tables.size());
+    for (const auto& it : _psi_tables) {
+        tables.push_back(it.second);
+    }
+}
+
+void ts::TSAnalyzer::loadPSI(const BinaryTablePtrVector& tables)
+{
+    // The tables are ordered by PID: the PAT comes first and the PMT PID's are known when the PMT's are loaded.
+    _psi_loading = true;
+    for (const auto& table : tables) {
+        if (table != nullptr && table->isValid()) {
+            handleTable(_demux, *table);
+        }
+    }
+    _psi_loading = false;
+    _modified = true;
+}
+
+
+//----------------------------------------------------------------------------
+// Merge the analysis of the next segment of the same stream.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::merge(const TSAnalyzer& next)
+{
+    // Packet indexes in the next segment are shifted by the number of packets in this one.
+    const uint64_t offset = _ts_pkt_cnt;
+
+    _modified = true;
+    _duck.addStandards(next._duck.standards());
+
+    // Global counters.
+    _ts_pkt_cnt += next._ts_pkt_cnt;
+    _invalid_sync += next._invalid_sync;
+    _transport_errors += next._transport_errors;
+    _suspect_ignored += next._suspect_ignored;
+    _ts_bitrate_sum += next._ts_bitrate_sum;
+    _ts_bitrate_cnt += next._ts_bitrate_cnt;
+    _tid_present |= next._tid_present;
+    _preceding_errors = next._preceding_errors;
+    _preceding_suspects = next._preceding_suspects;
+    if (!_ts_id.has_value()) {
+        _ts_id = next._ts_id;
+    }
+    if (!next._country_code.empty()) {
+        _country_code = next._country_code;
+    }
+
+    // Time stamps: the first ones are in this segment, the last ones are in the next one, when present.
+    if (_first_utc == Time::Epoch) {
+        _first_utc = next._first_utc;
+        _first_local = next._first_local;
+    }
+    if (_first_tdt == Time::Epoch) {
+        _first_tdt = next._first_tdt;
+    }
+    if (_first_tot == Time::Epoch) {
+        _first_tot = next._first_tot;
+    }
+    if (_first_stt == Time::Epoch) {
+        _first_stt = next._first_stt;
+    }
+    if (next._last_tdt != Time::Epoch) {
+        _last_tdt = next._last_tdt;
+    }
+    if (next._last_tot != Time::Epoch) {
+        _last_tot = next._last_tot;
+    }
+    if (next._last_stt != Time::Epoch) {
+        _last_stt = next._last_stt;
+    }
+
+    // Services: the latest known characteristics are in the next segment.
+    for (const auto& it : next._services) {
+        const ServiceContext& nsv(*it.second);
+        ServiceContext& sv(*getService(it.first));
+        if (nsv.orig_netw_id.has_value()) {
+            sv.orig_netw_id = nsv.orig_netw_id;
+        }
+        if (nsv.lcn.has_value()) {
+            sv.lcn = nsv.lcn;
+        }
+        if (nsv.service_type != 0) {
+            sv.service_type = nsv.service_type;
+        }
+        if (!nsv.name.empty()) {
+            sv.name = nsv.name;
+        }
+        if (!nsv.provider.empty()) {
+            sv.provider = nsv.provider;
+        }
+        if (nsv.pmt_pid != 0) {
+            sv.pmt_pid = nsv.pmt_pid;
+        }
+        if (nsv.pcr_pid != 0) {
+            sv.pcr_pid = nsv.pcr_pid;
+        }
+        sv.hidden = sv.hidden || nsv.hidden;
+        sv.carry_ssu = sv.carry_ssu || nsv.carry_ssu;
+        sv.carry_t2mi = sv.carry_t2mi || nsv.carry_t2mi;
+    }
+
+    // PID's.
+    for (const auto& it : next._pids) {
+        mergePID(*getPID(it.first), *it.second, offset);
+    }
+
+    // Counters of PID's which are maintained during the analysis.
+    _pcr_pid_cnt = _scrambled_pid_cnt = 0;
+    for (const auto& it : _pids) {
+        if (it.second->pcr_cnt > 0) {
+            _pcr_pid_cnt++;
+        }
+        if (it.second->scrambled) {
+            _scrambled_pid_cnt++;
+        }
+    }
+}
+
+void ts::TSAnalyzer::mergePID(PIDContext& pc, const PIDContext& next, uint64_t offset)
+{
+    // Descriptions.
+    if (pc.description.empty() || pc.description == UNREFERENCED) {
+        pc.description = next.description;
+    }
+    if (pc.comment.empty()) {
+        pc.comment = next.comment;
+    }
+    for (const auto& lang : next.languages) {
+        AppendUnique(pc.languages, lang);
+    }
+    for (const auto& attr : next.attributes) {
+        AppendUnique(pc.attributes, attr);
+    }
+    pc.services.insert(next.services.begin(), next.services.end());
+    pc.cas_operators.insert(next.cas_operators.begin(), next.cas_operators.end());
+    pc.ssu_oui.insert(next.ssu_oui.begin(), next.ssu_oui.end());
+    if (pc.stream_type == 0) {
+        pc.stream_type = next.stream_type;
+    }
+    if (pc.cas_id == 0) {
+        pc.cas_id = next.cas_id;
+    }
+    if (next.pes_stream_id != 0) {
+        pc.same_stream_id = next.same_stream_id && (pc.pes_stream_id == 0 || (pc.same_stream_id && pc.pes_stream_id == next.pes_stream_id));
+        if (pc.pes_stream_id == 0) {
+            pc.pes_stream_id = next.pes_stream_id;
+        }
+    }
+    if (next.audio2.isValid()) {
+        pc.audio2 = next.audio2;
+    }
+
+    // Flags.
+    pc.is_pmt_pid = pc.is_pmt_pid || next.is_pmt_pid;
+    pc.is_pcr_pid = pc.is_pcr_pid || next.is_pcr_pid;
+    pc.referenced = pc.referenced || next.referenced;
+    pc.optional = pc.optional && next.optional;
+    pc.carry_pes = pc.carry_pes || next.carry_pes;
+    pc.carry_section = pc.carry_section || next.carry_section;
+    pc.carry_ecm = pc.carry_ecm || next.carry_ecm;
+    pc.carry_emm = pc.carry_emm || next.carry_emm;
+    pc.carry_audio = pc.carry_audio || next.carry_audio;
+    pc.carry_video = pc.carry_video || next.carry_video;
+    pc.carry_t2mi = pc.carry_t2mi || next.carry_t2mi;
+    pc.carry_iip = pc.carry_iip || next.carry_iip;
+    pc.scrambled = pc.scrambled || next.scrambled;
+
+    // Counters.
+    pc.ts_pkt_cnt += next.ts_pkt_cnt;
+    pc.ts_af_cnt += next.ts_af_cnt;
+    pc.unit_start_cnt += next.unit_start_cnt;
+    pc.pl_start_cnt += next.pl_start_cnt;
+    pc.pmt_cnt += next.pmt_cnt;
+    pc.unexp_discont += next.unexp_discont;
+    pc.exp_discont += next.exp_discont;
+    pc.duplicated += next.duplicated;
+    pc.ts_sc_cnt += next.ts_sc_cnt;
+    pc.inv_ts_sc_cnt += next.inv_ts_sc_cnt;
+    pc.inv_sections += next.inv_sections;
+    pc.inv_pes += next.inv_pes;
+    pc.inv_pes_start += next.inv_pes_start;
+    pc.t2mi_cnt += next.t2mi_cnt;
+    pc.pcr_cnt += next.pcr_cnt;
+    pc.pts_cnt += next.pts_cnt;
+    pc.dts_cnt += next.dts_cnt;
+    pc.pcr_leap_cnt += next.pcr_leap_cnt;
+    pc.pts_leap_cnt += next.pts_leap_cnt;
+    pc.dts_leap_cnt += next.dts_leap_cnt;
+    pc.cryptop_cnt += next.cryptop_cnt;
+    pc.cryptop_ts_cnt += next.cryptop_ts_cnt;
+    pc.ts_bitrate_sum += next.ts_bitrate_sum;
+    pc.ts_bitrate_cnt += next.ts_bitrate_cnt;
+    pc.isdb_layers.accumulate(next.isdb_layers);
+    pc.t2mi_plp_ts.accumulate(next.t2mi_plp_ts);
+
+    // Clocks: first values from this segment, last values from the next one.
+    if (pc.first_pcr == INVALID_PCR) {
+        pc.first_pcr = next.first_pcr;
+    }
+    if (pc.first_pts == INVALID_PTS) {
+        pc.first_pts = next.first_pts;
+    }
+    if (pc.first_dts == INVALID_DTS) {
+        pc.first_dts = next.first_dts;
+    }
+    if (next.last_pcr != INVALID_PCR) {
+        pc.last_pcr = next.last_pcr;
+    }
+    if (next.last_pts != INVALID_PTS) {
+        pc.last_pts = next.last_pts;
+    }
+    if (next.last_dts != INVALID_DTS) {
+        pc.last_dts = next.last_dts;
+    }
+
+    // The analysis state is now the one at the end of the next segment.
+    if (next.ts_pkt_cnt > 0) {
+        pc.cur_continuity = next.cur_continuity;
+        pc.cur_ts_sc = next.cur_ts_sc;
+        pc.cur_ts_sc_pkt = next.cur_ts_sc_pkt + offset;
+        pc.br_last_pcr = next.br_last_pcr;
+        pc.br_last_pcr_pkt = next.br_last_pcr_pkt + offset;
+    }
+
+    // Tables in this PID.
+    for (const auto& it : next.sections) {
+        XTIDContextPtr& xc(pc.sections[it.first]);
+        if (xc == nullptr) {
+            xc = std::make_shared<XTIDContext>(it.first);
+        }
+        MergeXTID(*xc, *it.second, offset);
+    }
+}
+
+void ts::TSAnalyzer::MergeXTID(XTIDContext& xc, const XTIDContext& next, uint64_t offset)
+{
+    if (next.table_count > 0) {
+        if (xc.table_count == 0) {
+            xc.first_pkt = next.first_pkt + offset;
+            xc.first_version = next.first_version;
+            xc.min_repetition_ts = next.min_repetition_ts;
+            xc.max_repetition_ts = next.max_repetition_ts;
+        }
+        else {
+            // Repetition interval across the boundary of the two segments.
+            const uint64_t rep = next.first_pkt + offset - xc.last_pkt;
+            if (xc.table_count < 2 || rep < xc.min_repetition_ts) {
+                xc.min_repetition_ts = rep;
+            }
+            if (xc.table_count < 2 || rep > xc.max_repetition_ts) {
+                xc.max_repetition_ts = rep;
+            }
+            if (next.table_count >= 2) {
+                xc.min_repetition_ts = std::min(xc.min_repetition_ts, next.min_repetition_ts);
+                xc.max_repetition_ts = std::max(xc.max_repetition_ts, next.max_repetition_ts);
+            }
+        }
+        xc.table_count += next.table_count;
+        xc.last_pkt = next.last_pkt + offset;
+        xc.last_version = next.last_version;
+        if (xc.table_count >= 2) {
+            xc.repetition_ts = (xc.last_pkt - xc.first_pkt + (xc.table_count - 1) / 2) / (xc.table_count - 1);
+        }
+    }
+    xc.section_count += next.section_count;
+    xc.versions |= next.versions;
+}
+
+
 //----------------------------------------------------------------------------
 // Specify a "bitrate hint" for the analysis. It is the user-specified
 // bitrate in bits/seconds, based on 188-byte packets. The bitrate is
@@ -15,10 +15,12 @@
 #include "tsTSPacket.h"
 #include "tsTSPacketMetadata.h"
 #include "tsSectionDemux.h"
+#include "tsPIDArray.h"
 #include "tsPESDemux.h"
 #include "tsT2MIDemux.h"
 #include "tsISDB.h"
 #include "tsLogicalChannelNumbers.h"
+#include "tsTablesPtr.h"
 #include "tsPAT.h"
 #include "tsCAT.h"
 #include "tsPMT.h"
@@ -107,6 +109,47 @@ namespace ts {
             _max_consecutive_suspects = count;
         }
 
+        //!
+        //! Enable or disable the capture of the tables which describe the structure of the stream.
+        //! When enabled, the last PAT, CAT, PMT, NIT, SDT, MGT and VCT are kept by the analyzer.
+        //! They can be used later to warm up another analyzer which starts in the middle of the stream.
+        //! @param [in] on True to capture the tables, false to stop and clear the capture.
+        //! @see getPSI()
+        //! @see loadPSI()
+        //!
+        void setPSICapture(bool on);
+
+        //!
+        //! Get the tables which were captured since setPSICapture() was called.
+        //! @param [out] tables The returned captured tables, ordered by PID and table id.
+        //!
+        void getPSI(BinaryTablePtrVector& tables) const;
+
+        //!
+        //! Load the tables which describe the structure of the stream before analyzing packets.
+        //! This is typically used when the analysis starts in the middle of a stream: the analyzer
+        //! immediately knows the services and the PID's, without waiting for the next PAT and PMT.
+        //! The tables are processed as if they were found in the stream but their sections are not counted.
+        //! @param [in] tables The tables to load, typically from getPSI() on another analyzer.
+        //!
+        void loadPSI(const BinaryTablePtrVector& tables);
+
+        //!
+        //! Merge the analysis of the next segment of the same stream into this analyzer.
+        //! This is typically used to analyze large files in parallel: the file is split in
+        //! contiguous segments which are analyzed by distinct analyzers, using loadPSI()
+        //! to warm up all analyzers but the first one. The results are then merged in
+        //! the order of the segments into the analyzer of the first segment.
+        //!
+        //! The merged counters are the same as with a sequential analysis, with the following
+        //! limitations: continuity errors, PCR, PTS and DTS leaps are not checked between two
+        //! segments, PES packets and sections which cross the boundary are lost, the bitrate
+        //! is not evaluated between the last PCR of a segment and the first PCR of the next one.
+        //! @param [in] next The analyzer of the segment which immediately follows the segment
+        //! of this analyzer. It is not modified.
+        //!
+        void merge(const TSAnalyzer& next);
+
         //!
         //! Get the list of service ids.
         //! @param [out] list The returned list of service ids.
@@ -429,8 +472,9 @@ namespace ts {
 
         //!
         //! Map of PIDContext, indexed by PID.
+        //! This is a direct-indexed table because a PID context is searched for each packet.
         //!
-        using PIDContextMap = std::map<PID, PIDContextPtr>;
+        using PIDContextMap = PIDArray<PIDContextPtr>;
 
         //!
         //! Check if a PID context exists.
@@ -444,9 +488,10 @@ namespace ts {
         //! Allocate a new entry if PID not found.
         //! @param [in] pid PID to search.
         //! @param [in] description Initial description of the PID if the context is created.
-        //! @return A safe pointer to the PID context.
+        //! @return A constant reference to a safe pointer to the PID context.
+        //! The reference remains valid until the analysis is reset.
         //!
-        PIDContextPtr getPID(PID pid, const UString& description = UNREFERENCED);
+        const PIDContextPtr& getPID(PID pid, const UString& description = UNREFERENCED);
 
     protected:
 
@@ -574,5 +619,13 @@ namespace ts {
         T2MIDemux    _t2mi_demux {_duck, this};      // T2-MI analysis
         LogicalChannelNumbers _lcn {_duck};          // Accumulate LCN and visible flags
         DCT          _dct {};                        // Last ISDB CDT waiting to be analyzed, waiting for TS id
+        bool         _psi_capture = false;           // Capture the structure tables for getPSI()
+        bool         _psi_loading = false;           // Currently processing tables from loadPSI()
+        std::map<std::pair<PID,XTID>, BinaryTablePtr> _psi_tables {}; // Captured tables, in PID order
+        std::map<PID, uint8_t> _psi_loaded_pmts {};  // Versions of PMT's from loadPSI(), not yet received again
+
+        // Merge the context of a PID or a table from a next segment, starting at packet index 'offset'.
+        void mergePID(PIDContext& pc, const PIDContext& next, uint64_t offset);
+        static void MergeXTID(XTIDContext& xc, const XTIDContext& next, uint64_t offset);
     };
 }
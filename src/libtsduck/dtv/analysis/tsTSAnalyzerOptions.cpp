@@ -55,6 +55,13 @@ void ts::TSAnalyzerOptions::defineArgs(Args& args)
               u"Do not output non-reproduceable information such as system time "
               u"(useful for automated tests).");
 
+    args.option(u"json-stream");
+    args.help(u"json-stream",
+              u"With --json or --json-line, generate the JSON report incrementally, "
+              u"without building an intermediate tree of JSON values. "
+              u"The output is identical but performs much fewer memory allocations. "
+              u"This is recommended for frequent periodic reports on large transport streams.");
+
     args.option(u"service-list");
     args.help(u"service-list", u"Report the list of all service ids.");
 
@@ -135,6 +142,7 @@ bool ts::TSAnalyzerOptions::loadArgs(DuckContext& duck, Args& args)
     error_analysis = args.present(u"error-analysis");
     normalized = args.present(u"normalized");
     deterministic = args.present(u"deterministic");
+    json_stream = args.present(u"json-stream");
     service_list = args.present(u"service-list");
     pid_list = args.present(u"pid-list");
     global_pid_list = args.present(u"global-pid-list");
@@ -47,6 +47,7 @@ namespace ts {
         bool normalized = false;             //!< Option -\-normalized
         bool deterministic = false;          //!< Option -\-deterministic
         json::OutputArgs json {};            //!< Options -\-json and -\-json-line
+        bool json_stream = false;            //!< Option -\-json-stream
 
         // One-line report options:
         bool service_list = false;           //!< Option -\-service-list
@@ -8,6 +8,8 @@
 
 #include "tsTSAnalyzerReport.h"
 #include "tsjsonObject.h"
+#include "tsjsonNumber.h"
+#include "tsjsonString.h"
 #include "tsDVB.h"
 #include "tsOUI.h"
 
@@ -36,6 +38,91 @@
 #define WIDE_PID_COL2   56   // PID list, column 2 (name).
 #define WIDE_PID_COL3   14   // PID list, column 3 (bitrate).
 
+namespace {
+    // Build a JSON tree with the same interface as json::Writer.
+    // Like with json::Writer, optional objects and arrays are omitted when empty.
+    class JSONTreeBuilder
+    {
+        TS_NOBUILD_NOCOPY(JSONTreeBuilder);
+    public:
+        JSONTreeBuilder(ts::json::Value& root) : _root(root) {}
+        void beginObject(const ts::UChar* name = nullptr, bool optional = false) { begin(ts::json::Type::Object, name, optional); }
+        void beginArray(const ts::UChar* name = nullptr, bool optional = false) { begin(ts::json::Type::Array, name, optional); }
+        void end();
+        void addInteger(const ts::UChar* name, int64_t value) { add(name, std::make_shared<ts::json::Number>(value)); }
+        void addString(const ts::UChar* name, const ts::UString& value) { add(name, std::make_shared<ts::json::String>(value)); }
+        void addBoolean(const ts::UChar* name, bool value) { add(name, ts::json::Bool(value)); }
+        void setInteger(int64_t value) { addInteger(nullptr, value); }
+        void setString(const ts::UString& value) { addString(nullptr, value); }
+
+    private:
+        // Description of an open object or array. A null value is the root.
+        struct Level {
+            ts::json::ValuePtr value {};
+            const ts::UChar*   name = nullptr;
+            bool               optional = false;
+        };
+        ts::json::Value&   _root;
+        std::vector<Level> _levels {};
+
+        void begin(ts::json::Type type, const ts::UChar* name, bool optional);
+        void add(const ts::UChar* name, const ts::json::ValuePtr& value);
+    };
+
+    void JSONTreeBuilder::begin(ts::json::Type type, const ts::UChar* name, bool optional)
+    {
+        // The first object is the root. Other objects and arrays are inserted in their parent when complete.
+        _levels.push_back({_levels.empty() ? nullptr : ts::json::Factory(type), name, optional});
+    }
+
+    void JSONTreeBuilder::end()
+    {
+        const Level level(_levels.back());
+        _levels.pop_back();
+        if (level.value != nullptr && (!level.optional || level.value->size() > 0)) {
+            add(level.name, level.value);
+        }
+    }
+
+    void JSONTreeBuilder::add(const ts::UChar* name, const ts::json::ValuePtr& value)
+    {
+        ts::json::Value& parent(_levels.back().value == nullptr ? _root : *_levels.back().value);
+        if (parent.isArray()) {
+            parent.set(value);
+        }
+        else {
+            parent.add(name, value);
+        }
+    }
+
+    // Add the keys of an IntegerMap as a JSON array, if not empty.
+    template <class JSON, class MAP>
+    void WriteKeys(JSON& js, const ts::UChar* name, const MAP& map)
+    {
+        js.beginArray(name, true);
+        for (const auto& it : map) {
+            js.setInteger(it.first);
+        }
+        js.end();
+    }
+
+    // Add a time as a JSON object if valid (not Epoch).
+    template <class JSON>
+    void WriteTime(JSON& js, const ts::UChar* name, const ts::Time& time, const ts::UString& country = ts::UString())
+    {
+        if (time != ts::Time::Epoch) {
+            js.beginObject(name);
+            if (!country.empty()) {
+                js.addString(u"country", country);
+            }
+            js.addString(u"date", time.format(ts::Time::DATE));
+            js.addInteger(u"seconds-since-2000", cn::duration_cast<cn::seconds>(time - ts::Time(2000, 1, 1, 0, 0, 0)).count());
+            js.addString(u"time", time.format(ts::Time::TIME | ts::Time::MILLISECOND));
+            js.end();
+        }
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Constructors and destructors.
@@ -1102,267 +1189,357 @@ void ts::TSAnalyzerReport::reportJSON(TSAnalyzerOptions& opt, std::ostream& stm,
     // Update the global statistics value if internal data were modified.
     recomputeStatistics();
 
-    // Shall we use ISDB information from PID's?
-    // Without ISDB, all layers information have been cleared, except in PID contexts.
-    const bool isdb = bool(_duck.standards() & Standards::ISDB);
-
-    // JSON root.
-    json::Object root;
-
-    // Add user-supplied title.
-    if (!title.empty()) {
-        root.add(u"title", title);
+    // Direct generation of the JSON text, without JSON tree.
+    if (opt.json_stream) {
+        reportJSONStream(opt, stm, title, rep);
+        return;
     }
 
-    // Add transport stream description.
-    json::Value& ts(root.query(u"ts", true));
-    if (_ts_id.has_value()) {
-        ts.add(u"id", *_ts_id);
-    }
-    ts.add(u"bytes", PKT_SIZE * _ts_pkt_cnt);
-    ts.add(u"bitrate", _ts_bitrate.toInt());
-    ts.add(u"bitrate-204", ToBitrate204(_ts_bitrate).toInt());
-    ts.add(u"user-bitrate", _ts_user_bitrate.toInt());
-    ts.add(u"user-bitrate-204", ToBitrate204(_ts_user_bitrate).toInt());
-    ts.add(u"pcr-bitrate", _ts_pcr_bitrate_188.toInt());
-    ts.add(u"pcr-bitrate-204", _ts_pcr_bitrate_204.toInt());
-    ts.add(u"duration", cn::duration_cast<cn::seconds>(_duration).count());
-    _ts_isdb_layers.addKeys(ts, u"isdbt-layers", true);
-    if (!_country_code.empty()) {
-        ts.add(u"country", _country_code);
-    }
+    // Build a JSON tree from the same description as the direct generation of the JSON text.
+    json::Object root;
+    JSONTreeBuilder builder(root);
+    buildJSON(builder, opt, title);
 
-    json::Value& services(root.query(u"ts.services", true));
-    services.add(u"total", _services.size());
-    services.add(u"clear", _services.size() - _scrambled_services_cnt);
-    services.add(u"scrambled", _scrambled_services_cnt);
+    // An output text formatter for JSON output.
+    opt.json.report(root, stm, rep);
+}
 
-    json::Value& packets(root.query(u"ts.packets", true));
-    packets.add(u"total", _ts_pkt_cnt);
-    packets.add(u"invalid-syncs", _invalid_sync);
-    packets.add(u"transport-errors", _transport_errors);
-    packets.add(u"suspect-ignored", _suspect_ignored);
 
-    // Add PID's info.
-    json::Value& pids(root.query(u"ts.pids", true));
-    pids.add(u"total", _pid_cnt);
-    pids.add(u"clear", _pid_cnt - _scrambled_pid_cnt);
-    pids.add(u"scrambled", _scrambled_pid_cnt);
-    pids.add(u"pcr", _pcr_pid_cnt);
-    pids.add(u"unreferenced", _unref_pid_cnt);
+//----------------------------------------------------------------------------
+// This method displays a JSON report, without intermediate JSON tree.
+//----------------------------------------------------------------------------
 
-    // Global PID's (ie. not attached to a service)
-    json::Value& globals(root.query(u"ts.pids.global", true));
-    globals.add(u"total", _global_pid_cnt);
-    globals.add(u"clear", _global_pid_cnt - _global_scr_pids);
-    globals.add(u"scrambled", _global_scr_pids);
-    globals.add(u"packets", _global_pkt_cnt);
-    globals.add(u"bitrate", _global_bitrate.toInt());
-    globals.add(u"bitrate-204", ToBitrate204(_global_bitrate).toInt());
-    globals.add(u"is-scrambled", json::Bool(_global_scr_pids > 0));
-    _global_isdb_layers.addKeys(globals, u"isdbt-layers", true);
-    for (const auto& it : _pids) {
-        const PIDContext& pc(*it.second);
-        if (pc.referenced && pc.services.size() == 0 && (pc.ts_pkt_cnt != 0 || !pc.optional)) {
-            globals.query(u"pids", true, json::Type::Array).set(pc.pid);
-        }
+void ts::TSAnalyzerReport::reportJSONStream(TSAnalyzerOptions& opt, std::ostream& stm, const UString& title, Report& rep)
+{
+    // Process file output.
+    if (opt.json.useFile()) {
+        _json_writer.reset(false);
+        buildJSON(_json_writer, opt, title);
+        stm.write(_json_writer.text().data(), std::streamsize(_json_writer.text().size()));
+        stm << std::endl;
     }
 
-    // Unreferenced PIDs
-    json::Value& unrefs(root.query(u"ts.pids.unreferenced", true));
-    unrefs.add(u"total", _unref_pid_cnt);
-    unrefs.add(u"clear", _unref_pid_cnt - _unref_scr_pids);
-    unrefs.add(u"scrambled", _unref_scr_pids);
-    unrefs.add(u"packets", _unref_pkt_cnt);
-    unrefs.add(u"bitrate", _unref_bitrate.toInt());
-    unrefs.add(u"bitrate-204", ToBitrate204(_unref_bitrate).toInt());
-    unrefs.add(u"is-scrambled", json::Bool(_unref_scr_pids > 0));
-    _unref_isdb_layers.addKeys(unrefs, u"isdbt-layers", true);
-    for (const auto& it : _pids) {
-        const PIDContext& pc (*it.second);
-        if (!pc.referenced && (pc.ts_pkt_cnt != 0 || !pc.optional)) {
-            unrefs.query(u"pids", true, json::Type::Array).set(pc.pid);
-        }
+    // Other output forms.
+    if (opt.json.useLine()) {
+        _json_writer.reset(true);
+        buildJSON(_json_writer, opt, title);
+        opt.json.reportLine(_json_writer.text(), rep);
     }
+}
 
-    // Add first and last UTC and local times.
-    AddTime(root, u"time.utc.tdt.first", _first_tdt);
-    AddTime(root, u"time.utc.tdt.last", _last_tdt);
-    AddTime(root, u"time.utc.tdt.first", _first_tdt);
-    AddTime(root, u"time.utc.tdt.last", _last_tdt);
-    AddTime(root, u"time.local.tot.first", _first_tot, _country_code);
-    AddTime(root, u"time.local.tot.last", _last_tot, _country_code);
-    if (!opt.deterministic) {
-        AddTime(root, u"time.utc.system.first", _first_utc);
-        AddTime(root, u"time.utc.system.last", _last_utc);
-        AddTime(root, u"time.local.system.first", _first_local);
-        AddTime(root, u"time.local.system.last", _last_local);
-    }
 
-    // One node per service
-    for (const auto& it : _services) {
-        const ServiceContext& sv(*it.second);
-        json::Value& jv(root.query(u"services[]", true));
-        jv.add(u"id", sv.service_id);
-        jv.add(u"provider", sv.getProvider());
-        jv.add(u"name", sv.getName());
-        jv.add(u"type", sv.service_type);
-        jv.add(u"type-name", ServiceTypeName(sv.service_type));
-        if (_ts_id.has_value()) {
-            jv.add(u"tsid", *_ts_id);
-        }
-        if (sv.orig_netw_id.has_value()) {
-            jv.add(u"original-network-id", *sv.orig_netw_id);
-        }
-        if (sv.lcn.has_value()) {
-            jv.add(u"lcn", *sv.lcn);
-        }
-        jv.add(u"is-scrambled", json::Bool(sv.scrambled_pid_cnt > 0));
-        jv.query(u"components", true).add(u"total", sv.pid_cnt);
-        jv.query(u"components", true).add(u"clear", sv.pid_cnt - sv.scrambled_pid_cnt);
-        jv.query(u"components", true).add(u"scrambled", sv.scrambled_pid_cnt);
-        jv.add(u"packets", sv.ts_pkt_cnt);
-        jv.add(u"bitrate", sv.bitrate.toInt());
-        jv.add(u"bitrate-204", ToBitrate204(sv.bitrate).toInt());
-        jv.add(u"hidden", json::Bool(sv.hidden));
-        jv.add(u"ssu", json::Bool(sv.carry_ssu));
-        jv.add(u"t2mi", json::Bool(sv.carry_t2mi));
-        if (sv.pmt_pid != 0) {
-            jv.add(u"pmt-pid", sv.pmt_pid);
-        }
-        if (sv.pcr_pid != 0 && sv.pcr_pid != PID_NULL) {
-            jv.add(u"pcr-pid", sv.pcr_pid);
-        }
-        for (const auto& it_pid : _pids) {
-            if (it_pid.second->services.count(sv.service_id) != 0) {
-                // This PID belongs to the service
-                jv.query(u"pids", true, json::Type::Array).set(it_pid.first);
-            }
-        }
-        sv.isdb_layers.addKeys(jv, u"isdbt-layers", true);
-    }
+//----------------------------------------------------------------------------
+// Generate the JSON report in a JSON writer or a JSON tree builder.
+// The fields of each object are generated in alphabetical order, like in
+// a json::Object, so that the generated text is identical in both cases.
+//----------------------------------------------------------------------------
+
+template <class JSON>
+void ts::TSAnalyzerReport::buildJSON(JSON& js, const TSAnalyzerOptions& opt, const UString& title)
+{
+    // Shall we use ISDB information from PID's?
+    const bool isdb = bool(_duck.standards() & Standards::ISDB);
+
+    // JSON root.
+    js.beginObject();
 
     // One node per PID
+    js.beginArray(u"pids", true);
     for (const auto& it : _pids) {
         const PIDContext& pc(*it.second);
         if (pc.ts_pkt_cnt == 0 && pc.optional) {
             continue;
         }
-        json::Value& jv(root.query(u"pids[]", true));
-        jv.add(u"id", pc.pid);
-        jv.add(u"description", pc.fullDescription(true));
-        jv.add(u"pmt", json::Bool(pc.is_pmt_pid));
-        jv.add(u"audio", json::Bool(pc.carry_audio));
-        jv.add(u"video", json::Bool(pc.carry_video));
-        jv.add(u"ecm", json::Bool(pc.carry_ecm));
-        jv.add(u"emm", json::Bool(pc.carry_emm));
+        js.beginObject();
+        js.addBoolean(u"audio", pc.carry_audio);
+        js.addInteger(u"bitrate", pc.bitrate.toInt());
+        js.addInteger(u"bitrate-204", ToBitrate204(pc.bitrate).toInt());
         if (pc.cas_id != 0) {
-            jv.add(u"cas", pc.cas_id);
-        }
-        for (const auto& it2 : pc.cas_operators) {
-            jv.query(u"operators", true, json::Type::Array).set(it2);
+            js.addInteger(u"cas", pc.cas_id);
         }
-        jv.add(u"is-scrambled", json::Bool(pc.scrambled));
         if (pc.crypto_period != 0 && _ts_bitrate != 0) {
-            jv.add(u"crypto-period", ((pc.crypto_period * PKT_SIZE_BITS) / _ts_bitrate).toInt());
+            js.addInteger(u"crypto-period", ((pc.crypto_period * PKT_SIZE_BITS) / _ts_bitrate).toInt());
         }
-        if (pc.same_stream_id) {
-            jv.add(u"pes-stream-id", pc.pes_stream_id);
+        js.addString(u"description", pc.fullDescription(true));
+        js.addBoolean(u"ecm", pc.carry_ecm);
+        js.addBoolean(u"emm", pc.carry_emm);
+        if (pc.first_dts != INVALID_DTS) {
+            js.addInteger(u"first-dts", int64_t(pc.first_dts));
+        }
+        if (pc.first_pcr != INVALID_PCR) {
+            js.addInteger(u"first-pcr", int64_t(pc.first_pcr));
+        }
+        if (pc.first_pts != INVALID_PTS) {
+            js.addInteger(u"first-pts", int64_t(pc.first_pts));
+        }
+        js.addBoolean(u"global", pc.services.size() == 0);
+        js.addInteger(u"id", pc.pid);
+        js.addBoolean(u"iip", pc.carry_iip);
+        if (pc.carry_pes) {
+            js.addInteger(u"invalid-pes-prefix", int64_t(pc.inv_pes_start));
+        }
+        js.addBoolean(u"is-scrambled", pc.scrambled);
+        if (isdb) {
+            WriteKeys(js, u"isdbt-layers", pc.isdb_layers);
         }
         if (!pc.languages.empty()) {
-            // First language as a string (legacy compatibility).
-            jv.add(u"language", pc.languages.front());
-            // All languages as an array of string.
+            // First language as a string (legacy compatibility), all languages as an array of string.
+            js.addString(u"language", pc.languages.front());
+            js.beginArray(u"languages");
             for (const auto& lang : pc.languages) {
-                jv.query(u"languages", true, json::Type::Array).set(lang);
+                js.setString(lang);
             }
+            js.end();
+        }
+        if (pc.first_dts != INVALID_DTS) {
+            js.addInteger(u"last-dts", int64_t(pc.last_dts));
+        }
+        if (pc.first_pcr != INVALID_PCR) {
+            js.addInteger(u"last-pcr", int64_t(pc.last_pcr));
+        }
+        if (pc.first_pts != INVALID_PTS) {
+            js.addInteger(u"last-pts", int64_t(pc.last_pts));
+        }
+        js.beginArray(u"operators", true);
+        for (const auto& it2 : pc.cas_operators) {
+            js.setInteger(it2);
+        }
+        js.end();
+        js.beginObject(u"packets");
+        js.addInteger(u"af", int64_t(pc.ts_af_cnt));
+        js.addInteger(u"clear", int64_t(pc.ts_pkt_cnt - pc.ts_sc_cnt - pc.inv_ts_sc_cnt));
+        js.addInteger(u"discontinuities", int64_t(pc.unexp_discont));
+        js.addInteger(u"dts", int64_t(pc.dts_cnt));
+        js.addInteger(u"dts-leap", int64_t(pc.dts_leap_cnt));
+        js.addInteger(u"duplicated", int64_t(pc.duplicated));
+        js.addInteger(u"invalid-scrambling", int64_t(pc.inv_ts_sc_cnt));
+        js.addInteger(u"pcr", int64_t(pc.pcr_cnt));
+        js.addInteger(u"pcr-leap", int64_t(pc.pcr_leap_cnt));
+        js.addInteger(u"pts", int64_t(pc.pts_cnt));
+        js.addInteger(u"pts-leap", int64_t(pc.pts_leap_cnt));
+        js.addInteger(u"scrambled", int64_t(pc.ts_sc_cnt));
+        js.addInteger(u"total", int64_t(pc.ts_pkt_cnt));
+        js.end();
+        if (pc.carry_pes) {
+            js.addInteger(u"pes", int64_t(pc.pl_start_cnt));
         }
-        jv.add(u"service-count", pc.services.size());
-        jv.add(u"unreferenced", json::Bool(!pc.referenced));
-        jv.add(u"global", json::Bool(pc.services.size() == 0));
+        if (pc.same_stream_id) {
+            js.addInteger(u"pes-stream-id", pc.pes_stream_id);
+        }
+        WriteKeys(js, u"plp", pc.t2mi_plp_ts);
+        js.addBoolean(u"pmt", pc.is_pmt_pid);
+        js.addInteger(u"service-count", int64_t(pc.services.size()));
+        js.beginArray(u"services", true);
         for (const auto& it1 : pc.services) {
-            jv.query(u"services", true, json::Type::Array).set(it1);
+            js.setInteger(it1);
         }
+        js.end();
+        js.beginArray(u"ssu-oui", true);
         for (const auto& it1 : pc.ssu_oui) {
-            jv.query(u"ssu-oui", true, json::Type::Array).set(it1);
+            js.setInteger(it1);
         }
-        jv.add(u"t2mi", json::Bool(pc.carry_t2mi));
-        jv.add(u"iip", json::Bool(pc.carry_iip));
-        if (isdb) {
-            pc.isdb_layers.addKeys(jv, u"isdbt-layers", true);
-        }
-        pc.t2mi_plp_ts.addKeys(jv, u"plp", true);
-        jv.add(u"bitrate", pc.bitrate.toInt());
-        jv.add(u"bitrate-204", ToBitrate204(pc.bitrate).toInt());
-        jv.query(u"packets", true).add(u"total", pc.ts_pkt_cnt);
-        jv.query(u"packets", true).add(u"clear", pc.ts_pkt_cnt - pc.ts_sc_cnt - pc.inv_ts_sc_cnt);
-        jv.query(u"packets", true).add(u"scrambled", pc.ts_sc_cnt);
-        jv.query(u"packets", true).add(u"invalid-scrambling", pc.inv_ts_sc_cnt);
-        jv.query(u"packets", true).add(u"af", pc.ts_af_cnt);
-        jv.query(u"packets", true).add(u"pcr", pc.pcr_cnt);
-        jv.query(u"packets", true).add(u"pts", pc.pts_cnt);
-        jv.query(u"packets", true).add(u"dts", pc.dts_cnt);
-        jv.query(u"packets", true).add(u"pcr-leap", pc.pcr_leap_cnt);
-        jv.query(u"packets", true).add(u"pts-leap", pc.pts_leap_cnt);
-        jv.query(u"packets", true).add(u"dts-leap", pc.dts_leap_cnt);
-        jv.query(u"packets", true).add(u"discontinuities", pc.unexp_discont);
-        jv.query(u"packets", true).add(u"duplicated", pc.duplicated);
-        if (pc.carry_pes) {
-            jv.add(u"pes", pc.pl_start_cnt);
-            jv.add(u"invalid-pes-prefix", pc.inv_pes_start);
+        js.end();
+        js.addBoolean(u"t2mi", pc.carry_t2mi);
+        if (!pc.carry_pes) {
+            js.addInteger(u"unit-start", int64_t(pc.unit_start_cnt));
         }
-        else {
-            jv.add(u"unit-start", pc.unit_start_cnt);
+        js.addBoolean(u"unreferenced", !pc.referenced);
+        js.addBoolean(u"video", pc.carry_video);
+        js.end();
+    }
+    js.end();
+
+    // One node per service
+    js.beginArray(u"services", true);
+    for (const auto& it : _services) {
+        const ServiceContext& sv(*it.second);
+        js.beginObject();
+        js.addInteger(u"bitrate", sv.bitrate.toInt());
+        js.addInteger(u"bitrate-204", ToBitrate204(sv.bitrate).toInt());
+        js.beginObject(u"components");
+        js.addInteger(u"clear", int64_t(sv.pid_cnt - sv.scrambled_pid_cnt));
+        js.addInteger(u"scrambled", int64_t(sv.scrambled_pid_cnt));
+        js.addInteger(u"total", int64_t(sv.pid_cnt));
+        js.end();
+        js.addBoolean(u"hidden", sv.hidden);
+        js.addInteger(u"id", sv.service_id);
+        js.addBoolean(u"is-scrambled", sv.scrambled_pid_cnt > 0);
+        WriteKeys(js, u"isdbt-layers", sv.isdb_layers);
+        if (sv.lcn.has_value()) {
+            js.addInteger(u"lcn", *sv.lcn);
         }
-        if (pc.first_pcr != INVALID_PCR) {
-            jv.add(u"first-pcr", pc.first_pcr);
-            jv.add(u"last-pcr", pc.last_pcr);
+        js.addString(u"name", sv.getName());
+        if (sv.orig_netw_id.has_value()) {
+            js.addInteger(u"original-network-id", *sv.orig_netw_id);
         }
-        if (pc.first_pts != INVALID_PTS) {
-            jv.add(u"first-pts", pc.first_pts);
-            jv.add(u"last-pts", pc.last_pts);
+        js.addInteger(u"packets", int64_t(sv.ts_pkt_cnt));
+        if (sv.pcr_pid != 0 && sv.pcr_pid != PID_NULL) {
+            js.addInteger(u"pcr-pid", sv.pcr_pid);
         }
-        if (pc.first_dts != INVALID_DTS) {
-            jv.add(u"first-dts", pc.first_dts);
-            jv.add(u"last-dts", pc.last_dts);
+        js.beginArray(u"pids", true);
+        for (const auto& it_pid : _pids) {
+            if (it_pid.second->services.count(sv.service_id) != 0) {
+                // This PID belongs to the service
+                js.setInteger(it_pid.first);
+            }
+        }
+        js.end();
+        if (sv.pmt_pid != 0) {
+            js.addInteger(u"pmt-pid", sv.pmt_pid);
         }
+        js.addString(u"provider", sv.getProvider());
+        js.addBoolean(u"ssu", sv.carry_ssu);
+        js.addBoolean(u"t2mi", sv.carry_t2mi);
+        if (_ts_id.has_value()) {
+            js.addInteger(u"tsid", *_ts_id);
+        }
+        js.addInteger(u"type", sv.service_type);
+        js.addString(u"type-name", ServiceTypeName(sv.service_type));
+        js.end();
     }
+    js.end();
 
     // One node per table
+    js.beginArray(u"tables", true);
     for (const auto& pci : _pids) {
         const PIDContext& pc(*pci.second);
         for (const auto& it : pc.sections) {
             const XTIDContext& etc(*it.second);
-            json::Value& jv(root.query(u"tables[]", true));
-            jv.add(u"pid", pc.pid);
-            jv.add(u"tid", etc.xtid.tid());
-            if (etc.xtid.isLongSection()) {
-                jv.add(u"tid-ext", etc.xtid.tidExt());
+            js.beginObject();
+            if (etc.versions.any()) {
+                js.addInteger(u"first-version", etc.first_version);
+                js.addInteger(u"last-version", etc.last_version);
             }
-            jv.add(u"tables", etc.table_count);
-            jv.add(u"sections", etc.section_count);
-            jv.add(u"repetition-pkt", etc.repetition_ts);
-            jv.add(u"min-repetition-pkt", etc.min_repetition_ts);
-            jv.add(u"max-repetition-pkt", etc.max_repetition_ts);
             if (_ts_bitrate != 0) {
-                jv.add(u"repetition-ms", PacketInterval(_ts_bitrate, etc.repetition_ts).count());
-                jv.add(u"min-repetition-ms", PacketInterval(_ts_bitrate, etc.min_repetition_ts).count());
-                jv.add(u"max-repetition-ms", PacketInterval(_ts_bitrate, etc.max_repetition_ts).count());
+                js.addInteger(u"max-repetition-ms", PacketInterval(_ts_bitrate, etc.max_repetition_ts).count());
             }
-            if (etc.versions.any()) {
-                jv.add(u"first-version", etc.first_version);
-                jv.add(u"last-version", etc.last_version);
-                for (size_t i = 0; i < etc.versions.size(); ++i) {
-                    if (etc.versions.test(i)) {
-                        jv.query(u"versions", true, json::Type::Array).set(i);
-                    }
+            js.addInteger(u"max-repetition-pkt", int64_t(etc.max_repetition_ts));
+            if (_ts_bitrate != 0) {
+                js.addInteger(u"min-repetition-ms", PacketInterval(_ts_bitrate, etc.min_repetition_ts).count());
+            }
+            js.addInteger(u"min-repetition-pkt", int64_t(etc.min_repetition_ts));
+            js.addInteger(u"pid", pc.pid);
+            if (_ts_bitrate != 0) {
+                js.addInteger(u"repetition-ms", PacketInterval(_ts_bitrate, etc.repetition_ts).count());
+            }
+            js.addInteger(u"repetition-pkt", int64_t(etc.repetition_ts));
+            js.addInteger(u"sections", int64_t(etc.section_count));
+            js.addInteger(u"tables", int64_t(etc.table_count));
+            js.addInteger(u"tid", etc.xtid.tid());
+            if (etc.xtid.isLongSection()) {
+                js.addInteger(u"tid-ext", etc.xtid.tidExt());
+            }
+            js.beginArray(u"versions", true);
+            for (size_t i = 0; i < etc.versions.size(); ++i) {
+                if (etc.versions.test(i)) {
+                    js.setInteger(int64_t(i));
                 }
             }
+            js.end();
+            js.end();
         }
     }
+    js.end();
 
-    // An output text formatter for JSON output.
-    opt.json.report(root, stm, rep);
+    // Add first and last UTC and local times.
+    js.beginObject(u"time", true);
+    js.beginObject(u"local", true);
+    if (!opt.deterministic) {
+        js.beginObject(u"system", true);
+        WriteTime(js, u"first", _first_local);
+        WriteTime(js, u"last", _last_local);
+        js.end();
+    }
+    js.beginObject(u"tot", true);
+    WriteTime(js, u"first", _first_tot, _country_code);
+    WriteTime(js, u"last", _last_tot, _country_code);
+    js.end();
+    js.end();
+    js.beginObject(u"utc", true);
+    if (!opt.deterministic) {
+        js.beginObject(u"system", true);
+        WriteTime(js, u"first", _first_utc);
+        WriteTime(js, u"last", _last_utc);
+        js.end();
+    }
+    js.beginObject(u"tdt", true);
+    WriteTime(js, u"first", _first_tdt);
+    WriteTime(js, u"last", _last_tdt);
+    js.end();
+    js.end();
+    js.end();
+
+    // Add user-supplied title.
+    if (!title.empty()) {
+        js.addString(u"title", title);
+    }
+
+    // Add transport stream description.
+    js.beginObject(u"ts");
+    js.addInteger(u"bitrate", _ts_bitrate.toInt());
+    js.addInteger(u"bitrate-204", ToBitrate204(_ts_bitrate).toInt());
+    js.addInteger(u"bytes", int64_t(PKT_SIZE * _ts_pkt_cnt));
+    if (!_country_code.empty()) {
+        js.addString(u"country", _country_code);
+    }
+    js.addInteger(u"duration", cn::duration_cast<cn::seconds>(_duration).count());
+    if (_ts_id.has_value()) {
+        js.addInteger(u"id", *_ts_id);
+    }
+    WriteKeys(js, u"isdbt-layers", _ts_isdb_layers);
+
+    js.beginObject(u"packets");
+    js.addInteger(u"invalid-syncs", int64_t(_invalid_sync));
+    js.addInteger(u"suspect-ignored", int64_t(_suspect_ignored));
+    js.addInteger(u"total", int64_t(_ts_pkt_cnt));
+    js.addInteger(u"transport-errors", int64_t(_transport_errors));
+    js.end();
+
+    js.addInteger(u"pcr-bitrate", _ts_pcr_bitrate_188.toInt());
+    js.addInteger(u"pcr-bitrate-204", _ts_pcr_bitrate_204.toInt());
+
+    // Add PID's info.
+    js.beginObject(u"pids");
+    js.addInteger(u"clear", int64_t(_pid_cnt - _scrambled_pid_cnt));
+
+    // Global PID's (ie. not attached to a service)
+    js.beginObject(u"global");
+    js.addInteger(u"bitrate", _global_bitrate.toInt());
+    js.addInteger(u"bitrate-204", ToBitrate204(_global_bitrate).toInt());
+    js.addInteger(u"clear", int64_t(_global_pid_cnt - _global_scr_pids));
+    js.addBoolean(u"is-scrambled", _global_scr_pids > 0);
+    WriteKeys(js, u"isdbt-layers", _global_isdb_layers);
+    js.addInteger(u"packets", int64_t(_global_pkt_cnt));
+    js.beginArray(u"pids", true);
+    for (const auto& it : _pids) {
+        const PIDContext& pc(*it.second);
+        if (pc.referenced && pc.services.size() == 0 && (pc.ts_pkt_cnt != 0 || !pc.optional)) {
+            js.setInteger(pc.pid);
+        }
+    }
+    js.end();
+    js.addInteger(u"scrambled", int64_t(_global_scr_pids));
+    js.addInteger(u"total", int64_t(_global_pid_cnt));
+    js.end();
+
+    js.addInteger(u"pcr", int64_t(_pcr_pid_cnt));
+    js.addInteger(u"scrambled", int64_t(_scrambled_pid_cnt));
+    js.addInteger(u"total", int64_t(_pid_cnt));
+    js.addInteger(u"unreferenced", int64_t(_unref_pid_cnt));
+    js.end();
+
+    js.beginObject(u"services");
+    js.addInteger(u"clear", int64_t(_services.size() - _scrambled_services_cnt));
+    js.addInteger(u"scrambled", int64_t(_scrambled_services_cnt));
+    js.addInteger(u"total", int64_t(_services.size()));
+    js.end();
+
+    js.addInteger(u"user-bitrate", _ts_user_bitrate.toInt());
+    js.addInteger(u"user-bitrate-204", ToBitrate204(_ts_user_bitrate).toInt());
+    js.end();
+
+    // End of JSON root.
+    js.end();
 }
 
 
@@ -1384,21 +1561,3 @@ void ts::TSAnalyzerReport::AddNormalizedTime(std::ostream& stm, const Time& time
         stm << std::endl;
     }
 }
-
-
-//----------------------------------------------------------------------------
-// Add a time as a JSON string if valid (not Epoch).
-//----------------------------------------------------------------------------
-
-void ts::TSAnalyzerReport::AddTime(json::Value& parent, const UString& path, const Time& time, const UString& country)
-{
-    if (time != Time::Epoch) {
-        json::Value& tm(parent.query(path, true));
-        tm.add(u"date", time.format(Time::DATE));
-        tm.add(u"time", time.format(Time::TIME | Time::MILLISECOND));
-        tm.add(u"seconds-since-2000", cn::duration_cast<cn::seconds>(time - Time(2000, 1, 1, 0, 0, 0)).count());
-        if (!country.empty()) {
-            tm.add(u"country", country);
-        }
-    }
-}
@@ -17,6 +17,7 @@
 #include "tsNullReport.h"
 #include "tsGrid.h"
 #include "tsjson.h"
+#include "tsjsonWriter.h"
 
 namespace ts {
     //!
@@ -118,6 +119,15 @@ namespace ts {
         void reportJSON(TSAnalyzerOptions& opt, std::ostream& strm, const UString& title = UString(), Report& rep = NULLREP);
 
     private:
+        json::Writer _json_writer {};  // Reused between JSON reports with option --json-stream.
+
+        // Display a JSON report, without intermediate JSON tree.
+        void reportJSONStream(TSAnalyzerOptions& opt, std::ostream& strm, const UString& title, Report& rep);
+
+        // Generate the JSON report in a json::Writer or in a JSON tree builder with the same interface.
+        template <class JSON>
+        void buildJSON(JSON& js, const TSAnalyzerOptions& opt, const UString& title);
+
         // Display header of a service PID list.
         void reportServiceHeader(Grid& grid, const UString& usage, bool scrambled, const BitRate& bitrate, const BitRate& ts_bitrate, bool wide) const;
 
@@ -135,8 +145,5 @@ namespace ts {
 
         // Display a normalized time if valid (not Epoch).
         static void AddNormalizedTime(std::ostream&, const Time&, const char* type, const UString& country = UString());
-
-        // Add a time as a JSON string if valid (not Epoch).
-        static void AddTime(json::Value& parent, const UString& path, const Time&, const UString& country = UString());
     };
 }
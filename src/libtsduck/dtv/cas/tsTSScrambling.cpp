@@ -530,3 +530,120 @@ bool ts::TSScrambling::decrypt(TSPacket& pkt)
     }
     return ok;
 }
+
+
+//----------------------------------------------------------------------------
+// Encrypt or decrypt several TS packets.
+//----------------------------------------------------------------------------
+
+void ts::TSScrambling::addBatchPacket(TSPacket& pkt)
+{
+    _batch_packets.push_back(&pkt);
+    _batch_data.push_back(pkt.getPayload());
+    _batch_size.push_back(pkt.getPayloadSize());
+}
+
+bool ts::TSScrambling::processBatch(bool encrypt, uint8_t scv)
+{
+    DVBCSA2& algo(_dvbcsa[scv & 1]);
+    const size_t count = _batch_packets.size();
+    const size_t done = encrypt ?
+        algo.encryptMany(_batch_data.data(), _batch_size.data(), count) :
+        algo.decryptMany(_batch_data.data(), _batch_size.data(), count);
+
+    // Update the scrambling control of the processed packets.
+    for (size_t i = 0; i < done; ++i) {
+        _batch_packets[i]->setScrambling(encrypt ? scv : uint8_t(SC_CLEAR));
+    }
+
+    _batch_packets.clear();
+    _batch_data.clear();
+    _batch_size.clear();
+
+    if (done < count) {
+        _report.error(u"packet %s error using %s", encrypt ? u"encryption" : u"decryption", algo.name());
+        return false;
+    }
+    return true;
+}
+
+bool ts::TSScrambling::encrypt(TSPacket* const pkt[], size_t count)
+{
+    // Only DVB-CSA2 has a parallel implementation.
+    if (_scrambler[0] != &_dvbcsa[0]) {
+        for (size_t i = 0; i < count; ++i) {
+            if (!encrypt(*pkt[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // If no current parity is set, start with even by default.
+    if (_encrypt_scv == SC_CLEAR && !setEncryptParity(SC_EVEN_KEY)) {
+        return false;
+    }
+    assert(_encrypt_scv == SC_EVEN_KEY || _encrypt_scv == SC_ODD_KEY);
+
+    // Collect packets to encrypt, stop on the first already encrypted packet.
+    bool ok = true;
+    for (size_t i = 0; ok && i < count; ++i) {
+        if (pkt[i]->isScrambled()) {
+            _report.error(u"try to scramble an already scrambled packet");
+            ok = false;
+        }
+        else if (pkt[i]->getPayloadSize() > 0) {
+            addBatchPacket(*pkt[i]);
+        }
+        else if (pkt[i]->hasPayload()) {
+            pkt[i]->setScrambling(_encrypt_scv);
+        }
+    }
+
+    // Encrypt all packets which were collected before an error.
+    return processBatch(true, _encrypt_scv) && ok;
+}
+
+bool ts::TSScrambling::decrypt(TSPacket* const pkt[], size_t count)
+{
+    // Only DVB-CSA2 has a parallel implementation.
+    if (_scrambler[0] != &_dvbcsa[0]) {
+        for (size_t i = 0; i < count; ++i) {
+            if (!decrypt(*pkt[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+
+        // Clear or invalid packets are silently accepted.
+        const uint8_t scv = pkt[i]->getScrambling();
+        if (scv != SC_EVEN_KEY && scv != SC_ODD_KEY) {
+            continue;
+        }
+
+        // When the parity changes, decrypt previous packets first. Then, in case of
+        // fixed control word, use next key when the scrambling control changes.
+        if (scv != _decrypt_scv) {
+            if (!processBatch(false, _decrypt_scv)) {
+                return false;
+            }
+            _decrypt_scv = scv;
+            if (hasFixedCW() && !setNextFixedCW(_decrypt_scv)) {
+                return false;
+            }
+        }
+
+        if (pkt[i]->getPayloadSize() > 0) {
+            addBatchPacket(*pkt[i]);
+        }
+        else {
+            pkt[i]->setScrambling(SC_CLEAR);
+        }
+    }
+
+    // Decrypt remaining packets with the last parity.
+    return processBatch(false, _decrypt_scv);
+}
@@ -191,6 +191,26 @@ namespace ts {
         //!
         bool decrypt(TSPacket& pkt);
 
+        //!
+        //! Encrypt several TS packets with the current parity and corresponding CW.
+        //! The result is the same as encrypting each packet using encrypt(TSPacket&).
+        //! With DVB-CSA2, the packets are encrypted in parallel, which is much faster.
+        //! @param [in,out] pkt Array of addresses of the packets to encrypt.
+        //! @param [in] count Number of packets in @a pkt.
+        //! @return True on success, false on error. An already encrypted packet is an error.
+        //!
+        bool encrypt(TSPacket* const pkt[], size_t count);
+
+        //!
+        //! Decrypt several TS packets with the CW corresponding to the parity in each packet.
+        //! The result is the same as decrypting each packet using decrypt(TSPacket&).
+        //! With DVB-CSA2, the packets are decrypted in parallel, which is much faster.
+        //! @param [in,out] pkt Array of addresses of the packets to decrypt.
+        //! @param [in] count Number of packets in @a pkt.
+        //! @return True on success, false on error. A clear packet is not an error.
+        //!
+        bool decrypt(TSPacket* const pkt[], size_t count);
+
     private:
         // List of control words
         using CWList = std::list<ByteBlock>;
@@ -211,9 +231,20 @@ namespace ts {
         CTR<AES128>      _aesctr[2] {};
         BlockCipher*     _scrambler[2] {nullptr, nullptr};
 
+        // Payloads of packets to encrypt or decrypt in parallel with DVB-CSA2.
+        std::vector<TSPacket*> _batch_packets {};
+        std::vector<uint8_t*>  _batch_data {};
+        std::vector<size_t>    _batch_size {};
+
         // Set the next fixed control word as scrambling key.
         bool setNextFixedCW(int parity);
 
+        // Add a packet in the batch of packets to process in parallel.
+        void addBatchPacket(TSPacket& pkt);
+
+        // Process all packets in the batch using DVB-CSA2 with the specified parity.
+        bool processBatch(bool encrypt, uint8_t scv);
+
         // Implementation of BlockCipherAlertInterface.
         virtual bool handleBlockCipherAlert(BlockCipher& cipher, AlertReason reason) override;
 
@@ -57,6 +57,7 @@ void ts::AccessUnitIterator::reset()
         // Point to the beginning of area, before the first access unit.
         // Calling next() will find the first one (if any).
         _nalunit = _data;
+        _marks_count = _marks_index = _scan_offset = 0;
         next();
         // Reset NALunit index since we point to the first one.
         _nalunit_index = 0;
@@ -101,22 +102,21 @@ bool ts::AccessUnitIterator::next()
     constexpr size_t StartCodePrefixSize = 3;
     constexpr uint8_t StartCodePrefixThird = 0x01;
 
-    // Remaining size in data area.
-    assert(_nalunit >= _data);
-    assert(_nalunit <= _data + _data_size);
-    size_t remain = _data + _data_size - _nalunit;
-
     // Preset access unit type to an invalid value.
     // If the video format is undefined, we won't be able to extract a valid one.
     _nalunit_type = AVC_AUT_INVALID;
     _nalunit_size = 0;
     _nalunit_header_size = 0;
 
-    // Locate next access unit: starts with 00 00 01.
+    // Locate next access unit: starts with 00 00 01, skip 00 00 00 sequences.
     // The start code prefix 00 00 01 is not part of the NALunit.
     // The NALunit starts at the NALunit type byte (see H.264, 7.3.1).
-    const uint8_t* const p1 = LocateZeroZero(_nalunit, remain, StartCodePrefixThird);
-    if (p1 == nullptr) {
+    size_t start = peekMark();
+    while (start != NPOS && _data[start + 2] != StartCodePrefixThird) {
+        _marks_index++;
+        start = peekMark();
+    }
+    if (start == NPOS) {
         // No next access unit.
         _nalunit = nullptr;
         _nalunit_index++;
@@ -124,26 +124,13 @@ bool ts::AccessUnitIterator::next()
     }
 
     // Jump to first byte of NALunit.
-    remain -= p1 - _nalunit + StartCodePrefixSize;
-    _nalunit = p1 + StartCodePrefixSize;
+    _marks_index++;
+    _nalunit = _data + start + StartCodePrefixSize;
 
     // Locate end of access unit: ends with 00 00 00, 00 00 01 or end of data.
-    const uint8_t* const p2 = LocateZeroZero(_nalunit, remain, StartCodePrefixThird);
-    const uint8_t* const p3 = LocateZeroZero(_nalunit, remain, 0x00);
-    if (p2 == nullptr && p3 == nullptr) {
-        // No 00 00 01, no 00 00 00, the NALunit extends up to the end of data.
-        _nalunit_size = remain;
-    }
-    else if (p2 == nullptr || (p3 != nullptr && p3 < p2)) {
-        // NALunit ends at 00 00 00.
-        assert(p3 != nullptr);
-        _nalunit_size = p3 - _nalunit;
-    }
-    else {
-        // NALunit ends at 00 00 01.
-        assert(p2 != nullptr);
-        _nalunit_size = p2 - _nalunit;
-    }
+    // This pattern is not consumed, it may be the start code of the next NALunit.
+    const size_t end = peekMark();
+    _nalunit_size = (end == NPOS ? _data_size : end) - start - StartCodePrefixSize;
 
     // Extract NALunit type.
     if (_format == CodecType::AVC && _nalunit_size >= 1) {
@@ -163,3 +150,26 @@ bool ts::AccessUnitIterator::next()
     _nalunit_index++;
     return true;
 }
+
+
+//----------------------------------------------------------------------------
+// Get the offset of the next 00 00 00 or 00 00 01 sequence, without consuming it.
+//----------------------------------------------------------------------------
+
+size_t ts::AccessUnitIterator::peekMark()
+{
+    if (_marks_index >= _marks_count) {
+        // Locate the next batch of sequences, in one single pass over the data area.
+        _marks_index = 0;
+        _marks_count = _scan_offset >= _data_size ? 0 : LocateZeroZeroBatch(_data + _scan_offset, _data_size - _scan_offset, 0x01, _marks.data(), _marks.size());
+        for (size_t i = 0; i < _marks_count; ++i) {
+            _marks[i] += _scan_offset;
+        }
+        // If the batch is full, the next search starts after the last sequence.
+        _scan_offset = _marks_count < _marks.size() ? _data_size : _marks[_marks_count - 1] + 1;
+        if (_marks_count == 0) {
+            return NPOS;
+        }
+    }
+    return _marks[_marks_index];
+}
@@ -135,5 +135,14 @@ namespace ts {
         size_t         _nalunit_header_size = 0;
         size_t         _nalunit_index = 0;
         uint8_t        _nalunit_type = AVC_AUT_INVALID;
+
+        // Batch of offsets of the 00 00 00 and 00 00 01 sequences in the data area.
+        std::array<size_t,32> _marks {};
+        size_t         _marks_count = 0;   // Number of offsets in _marks.
+        size_t         _marks_index = 0;   // Index of next offset to use in _marks.
+        size_t         _scan_offset = 0;   // Offset in data area where the next batch starts.
+
+        // Get the offset of the next 00 00 00 or 00 00 01 sequence, without consuming it. Return NPOS at end of data.
+        size_t peekMark();
     };
 }
@@ -7,6 +7,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsAbstractDemux.h"
+#include "tsTSPacket.h"
 
 
 //----------------------------------------------------------------------------
@@ -112,7 +113,7 @@ void ts::AbstractDemux::immediateResetPID(PID pid)
 
 
 //----------------------------------------------------------------------------
-// Feed the demux with a TS packet.
+// Feed the demux with TS packets.
 //----------------------------------------------------------------------------
 
 void ts::AbstractDemux::feedPacket(const TSPacket& pkt)
@@ -122,6 +123,13 @@ void ts::AbstractDemux::feedPacket(const TSPacket& pkt)
     _packet_count++;
 }
 
+void ts::AbstractDemux::feedPackets(const TSPacket* pkt, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        feedPacket(pkt[i]);
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Helpers for subclasses, protecting the invocation to handlers.
@@ -38,6 +38,16 @@ namespace ts {
         //!
         virtual void feedPacket(const TSPacket& pkt);
 
+        //!
+        //! The following method feeds the demux with a batch of contiguous TS packets.
+        //! The default implementation calls feedPacket() for each packet. Subclasses
+        //! may override it to process a batch more efficiently, typically by skipping
+        //! packets from PID's which are not filtered.
+        //! @param [in] pkt Address of the first TS packet.
+        //! @param [in] count Number of contiguous TS packets.
+        //!
+        virtual void feedPackets(const TSPacket* pkt, size_t count);
+
         //!
         //! Replace the list of PID's to filter.
         //! The method resetPID() is invoked on each removed PID.
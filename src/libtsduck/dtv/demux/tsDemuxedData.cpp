@@ -90,14 +90,27 @@ void ts::DemuxedData::reload(const void* content, size_t content_size, PID sourc
 {
     _source_pid = source_pid;
     _first_pkt = _last_pkt = 0;
-    _data = std::make_shared<ByteBlock>(content, content_size);
+    const uint8_t* const data = reinterpret_cast<const uint8_t*>(content);
+    if (exclusiveData() && (data + content_size <= _data->data() || data >= _data->data() + _data->size())) {
+        // The previous binary content is not shared with another object, reuse its memory.
+        _data->copy(content, content_size);
+    }
+    else {
+        _data = std::make_shared<ByteBlock>(content, content_size);
+    }
 }
 
 void ts::DemuxedData::reload(const ByteBlock& content, PID source_pid)
 {
     _source_pid = source_pid;
     _first_pkt = _last_pkt = 0;
-    _data = std::make_shared<ByteBlock>(content);
+    if (exclusiveData() && &content != _data.get()) {
+        // The previous binary content is not shared with another object, reuse its memory.
+        *_data = content;
+    }
+    else if (&content != _data.get()) {
+        _data = std::make_shared<ByteBlock>(content);
+    }
 }
 
 void ts::DemuxedData::reload(const ByteBlockPtr& content_ptr, PID source_pid)
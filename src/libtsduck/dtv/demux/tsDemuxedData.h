@@ -215,6 +215,13 @@ namespace ts {
         bool matchContent(const ByteBlock& pattern, const ByteBlock& mask = ByteBlock()) const;
 
     protected:
+        //!
+        //! Check if the binary content is exclusively owned by this object.
+        //! When the content is not shared with another object, its memory can be reused.
+        //! @return True if the binary content exists and is not shared with another object.
+        //!
+        bool exclusiveData() const { return _data != nullptr && _data.use_count() == 1; }
+
         //!
         //! Read/write access to the full binary content of the data for subclasses.
         //! @return Address of the full binary content of the data.
@@ -28,7 +28,8 @@ ts::SectionDemux::Status::Status() :
     inv_sect_version(0),
     wrong_crc(0),
     is_next(0),
-    truncated_sect(0)
+    truncated_sect(0),
+    unchanged(0)
 {
 }
 
@@ -49,6 +50,7 @@ void ts::SectionDemux::Status::reset()
     wrong_crc = 0;
     is_next = 0;
     truncated_sect = 0;
+    unchanged = 0;
 }
 
 // Check if any counter is non zero.
@@ -108,6 +110,9 @@ void ts::SectionDemux::Status::display(Report& report, int level, const UString&
     if (!errors_only || is_next != 0) {
         report.log(level, u"%sNext sections (not yet applicable): %'d", prefix, is_next);
     }
+    if (!errors_only && unchanged != 0) {
+        report.log(level, u"%sSkipped unchanged sections: %'d", prefix, unchanged);
+    }
 }
 
 
@@ -202,7 +207,81 @@ void ts::SectionDemux::immediateResetPID(PID pid)
 
 
 //----------------------------------------------------------------------------
-// Feed the depacketizer with a TS packet.
+// Skip / process unchanged repetitions of long sections.
+//----------------------------------------------------------------------------
+
+void ts::SectionDemux::setSkipUnchangedSections(bool on)
+{
+    _skip_unchanged = on;
+    if (!on) {
+        // Forget all fingerprints, they will be rebuilt if skipping is enabled again.
+        for (auto& it : _pids) {
+            it.second.fingerprints.clear();
+        }
+    }
+}
+
+bool ts::SectionDemux::isUnchanged(const PIDContext& pc, const XTID& xtid, uint8_t section_number, const uint8_t* section, size_t section_length) const
+{
+    // Compare the section with the fingerprint of its previous valid occurrence.
+    const auto fp = pc.fingerprints.find(FingerprintKey(xtid, section_number));
+    if (fp == pc.fingerprints.end() || fp->second.header != GetUInt64(section) || fp->second.crc != GetUInt32(section + section_length - 4)) {
+        return false;
+    }
+
+    // When tables are reassembled, the section must be still present in the table context.
+    // Otherwise, a previous table version was interrupted by another one and the section is needed again.
+    if (_table_handler != nullptr) {
+        const auto ctx = pc.tids.find(xtid);
+        if (ctx == pc.tids.end()) {
+            return false;
+        }
+        const XTIDContext& tc(ctx->second);
+        const uint8_t version = (section[5] >> 1) & 0x1F;
+        return tc.sect_expected > 0 && tc.version == version && section_number < tc.sects.size() && tc.sects[section_number] != nullptr;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Allocate and recycle Section objects.
+//----------------------------------------------------------------------------
+
+ts::SectionPtr ts::SectionDemux::newSection(const uint8_t* content, size_t content_size, PID pid)
+{
+    if (_section_pool.empty()) {
+        return std::make_shared<Section>(content, content_size, pid, CRC32::CHECK);
+    }
+    else {
+        // Reuse a previously allocated section and its binary content.
+        SectionPtr sect(std::move(_section_pool.back()));
+        _section_pool.pop_back();
+        sect->reload(content, content_size, pid, CRC32::CHECK);
+        sect->setAttribute(UString());
+        return sect;
+    }
+}
+
+void ts::SectionDemux::recycleSection(SectionPtr& sect)
+{
+    // A section can be reused only when no one else references it (application, binary table).
+    if (sect != nullptr && sect.use_count() == 1 && _section_pool.size() < SECTION_POOL_SIZE) {
+        _section_pool.push_back(std::move(sect));
+    }
+    sect.reset();
+}
+
+void ts::SectionDemux::recycleSections(SectionPtrVector& sects)
+{
+    for (auto& sect : sects) {
+        recycleSection(sect);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Feed the depacketizer with TS packets.
 //----------------------------------------------------------------------------
 
 void ts::SectionDemux::feedPacket(const TSPacket& pkt)
@@ -213,6 +292,19 @@ void ts::SectionDemux::feedPacket(const TSPacket& pkt)
     SuperClass::feedPacket(pkt);
 }
 
+void ts::SectionDemux::feedPackets(const TSPacket* pkt, size_t count)
+{
+    // Extract all PID's at once, then only touch the packets from filtered PID's.
+    // The PID filter is checked on each packet because it can be modified by the handlers.
+    _headers.load(pkt, count);
+    for (size_t i = 0; i < count; ++i) {
+        if (_pid_filter[_headers.pid(i)]) {
+            processPacket(pkt[i]);
+        }
+        SuperClass::feedPacket(pkt[i]);
+    }
+}
+
 void ts::SectionDemux::processPacket(const TSPacket& pkt)
 {
     // Reject invalid packets
@@ -434,6 +526,12 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
             section_ok = false;
         }
 
+        // Unchanged repetitions of long sections are ignored, without CRC32 validation.
+        if (section_ok && long_header && _skip_unchanged && isUnchanged(pc, xtid, section_number, ts_start, section_length)) {
+            _status.unchanged++;
+            section_ok = false;
+        }
+
         if (section_ok) {
 
             // Get the list of standards which define this table id and add them in context.
@@ -454,6 +552,7 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
                     tc->sect_expected == 0 ||    // new TID on this PID
                     tc->version != version)      // new version
                 {
+                    recycleSections(tc->sects);
                     tc->init(version, last_section_number);
                 }
 
@@ -478,7 +577,7 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
                 if (section_length != old.size() || !MemEqual(ts_start, old.content(), section_length)) {
                     _duck.report().log(_ts_error_level, u"section updated without version update, PID %n, TID %n, section %d, version %d, packet index %'d", pid, tid, section_number, version, _packet_count);
                     // Reset the previous content of the section and make sure the table will be notified again.
-                    tc->sects[section_number].reset();
+                    recycleSection(tc->sects[section_number]);
                     assert(tc->sect_received > 0);
                     tc->sect_received--;
                     tc->notified = false;
@@ -494,7 +593,7 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
             SectionPtr sect_ptr;
 
             if (section_ok && (_section_handler != nullptr || (tc != nullptr && tc->sects[section_number] == nullptr))) {
-                sect_ptr = std::make_shared<Section>(ts_start, section_length, pid, CRC32::CHECK);
+                sect_ptr = newSection(ts_start, section_length, pid);
                 sect_ptr->setFirstTSPacketIndex(pusi_pkt_index);
                 sect_ptr->setLastTSPacketIndex(_packet_count);
                 if (!sect_ptr->isValid()) {
@@ -505,6 +604,12 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
                         return; // demux was reset
                     }
                 }
+                else if (long_header && _skip_unchanged) {
+                    // Keep the fingerprint of this valid section to detect its unchanged repetitions.
+                    SectionFingerprint& fp(pc.fingerprints[FingerprintKey(xtid, section_number)]);
+                    fp.header = GetUInt64(ts_start);
+                    fp.crc = GetUInt32(ts_start + section_length - 4);
+                }
             }
 
             // Mark that we are in the context of a table or section handler.
@@ -535,6 +640,9 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
             if (afterCallingHandler(true)) {
                 return;  // the PID of this packet or the complete demux was reset.
             }
+
+            // Recycle the section when it was not stored in the TID context.
+            recycleSection(sect_ptr);
         }
 
         // Move to next section in the buffer
@@ -18,6 +18,8 @@
 #include "tsSectionHandlerInterface.h"
 #include "tsInvalidSectionHandlerInterface.h"
 #include "tsXTID.h"
+#include "tsTSPacketHeaders.h"
+#include "tsPIDArray.h"
 
 namespace ts {
     //!
@@ -52,6 +54,7 @@ namespace ts {
 
         // Inherited methods
         virtual void feedPacket(const TSPacket& pkt) override;
+        virtual void feedPackets(const TSPacket* pkt, size_t count) override;
 
         //!
         //! Pack sections in all incomplete tables and notify these rebuilt tables.
@@ -141,6 +144,21 @@ namespace ts {
             _track_invalid_version = on;
         }
 
+        //!
+        //! Skip / process unchanged repetitions of long sections.
+        //! By default, all sections are reported to the section handler, including the
+        //! cyclic repetitions of identical sections. When skipping is enabled, the header
+        //! and the CRC32 of each valid long section are kept for each PID, table id, table
+        //! id extension and section number. A later section with the same header and CRC32
+        //! is considered as an unchanged repetition. It is dropped as soon as it is
+        //! reassembled, without CRC32 computation and without notification. A section with
+        //! a different header or CRC32 is fully processed and validated. Use this option
+        //! when the application is only interested in new section contents.
+        //! @param [in] on Skip unchanged long sections. This is false by default.
+        //! @see Status::unchanged
+        //!
+        void setSkipUnchangedSections(bool on);
+
         //!
         //! Set the log level for messages reporting transport stream errors in demux.
         //! By default, the log level is Severity::Debug.
@@ -167,6 +185,7 @@ namespace ts {
             uint64_t wrong_crc;        //!< Number of sections with wrong CRC32.
             uint64_t is_next;          //!< Number of sections with "next" flag (not yet applicable).
             uint64_t truncated_sect;   //!< Number of truncated sections.
+            uint64_t unchanged;        //!< Number of skipped unchanged sections (not an error), see setSkipUnchangedSections().
 
             //!
             //! Default constructor.
@@ -252,6 +271,13 @@ namespace ts {
             void notify(SectionDemux& demux, bool pack, bool fill_eit);
         };
 
+        // Fingerprint of a valid long section, to detect unchanged repetitions.
+        struct SectionFingerprint
+        {
+            uint64_t header = 0;  // Long section header: TID to last section number.
+            uint32_t crc = 0;     // CRC32 field at end of section.
+        };
+
         // This internal structure contains the analysis context for one PID.
         struct PIDContext
         {
@@ -261,6 +287,8 @@ namespace ts {
             ByteBlock     ts {};                 // TS payload buffer
             std::map<XTID,XTIDContext> tids {};  // TID analysis contexts
 
+            std::map<uint32_t,SectionFingerprint> fingerprints {};  // Last valid sections, with setSkipUnchangedSections().
+
             // Default constructor.
             PIDContext() = default;
 
@@ -278,15 +306,38 @@ namespace ts {
         // Return true if a delayed reset was executed.
         bool notifyInvalid(PID pid, Section::Status status, const uint8_t* ts_start, size_t ts_size);
 
+        // Check if a long section is an unchanged repetition. Return true if it can be skipped.
+        bool isUnchanged(const PIDContext& pc, const XTID& xtid, uint8_t section_number, const uint8_t* section, size_t section_length) const;
+
+        // Build the key of a section fingerprint in a PID context.
+        static uint32_t FingerprintKey(const XTID& xtid, uint8_t section_number)
+        {
+            return (uint32_t(xtid.tid()) << 24) | (uint32_t(xtid.tidExt()) << 8) | section_number;
+        }
+
+        // Get a new section, reusing a recycled one when possible.
+        SectionPtr newSection(const uint8_t* content, size_t content_size, PID pid);
+
+        // Recycle sections which are no longer used. The section pointers are reset.
+        // Only sections which are not referenced elsewhere are reused by newSection().
+        void recycleSection(SectionPtr& sect);
+        void recycleSections(SectionPtrVector& sects);
+
+        // Maximum number of recycled sections which are kept for reuse.
+        static constexpr size_t SECTION_POOL_SIZE = 32;
+
         // Private members:
         TableHandlerInterface*          _table_handler = nullptr;
         SectionHandlerInterface*        _section_handler = nullptr;
         InvalidSectionHandlerInterface* _invalid_handler = nullptr;
-        std::map<PID,PIDContext>        _pids {};
+        PIDArray<PIDContext>            _pids {};
+        TSPacketHeaders                 _headers {};  // Side table of packet headers in feedPackets().
+        SectionPtrVector                _section_pool {};  // Recycled sections, see newSection().
         Status _status {};
         bool   _get_current = true;
         bool   _get_next = false;
         bool   _track_invalid_version = false;
+        bool   _skip_unchanged = false;
         int    _ts_error_level {Severity::Debug};
     };
 }
@@ -383,22 +383,36 @@ bool ts::SectionFile::saveBinary(std::ostream& strm, Report& report) const
 
 bool ts::SectionFile::loadBuffer(const void* buffer, size_t size)
 {
-    bool success = true;
+    // Locate all complete sections in the buffer.
+    std::vector<const void*> addresses;
+    std::vector<size_t> sizes;
     const uint8_t* data = reinterpret_cast<const uint8_t*>(buffer);
     while (size >= 3) {
         const size_t section_size = 3 + (GetUInt16(data + 1) & 0x0FFF);
         if (section_size > size) {
             break;
         }
-        SectionPtr sp(new Section(data, section_size, PID_NULL, CRC32::CHECK));
-        if (sp != nullptr && sp->isValid()) {
+        addresses.push_back(data);
+        sizes.push_back(section_size);
+        data += section_size;
+        size -= section_size;
+    }
+
+    // Check the CRC32 of all sections at once, faster than checking each section individually.
+    const std::unique_ptr<bool[]> crc_ok(new bool[addresses.size()]);
+    CRC32::CheckMany(addresses.data(), sizes.data(), crc_ok.get(), addresses.size());
+
+    // Short sections have no CRC32. The CRC32 of long sections is already checked.
+    bool success = true;
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        const bool is_long = Section::StartLongSection(reinterpret_cast<const uint8_t*>(addresses[i]), sizes[i]);
+        SectionPtr sp(new Section(addresses[i], sizes[i], PID_NULL, CRC32::IGNORE));
+        if (sp != nullptr && sp->isValid() && (!is_long || crc_ok[i])) {
             add(sp);
         }
         else {
             success = false;
         }
-        data += section_size;
-        size -= section_size;
     }
     return success && size == 0;
 }
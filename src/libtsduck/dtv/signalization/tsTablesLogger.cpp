@@ -16,6 +16,7 @@
 #include "tsSimulCryptDate.h"
 #include "tsjsonArray.h"
 #include "tsjsonObject.h"
+#include "tsxmlElement.h"
 #include "tsMJD.h"
 
 
@@ -235,6 +236,15 @@ void ts::TablesLogger::defineArgs(Args& args)
     args.option(u"text-output", 0, Args::FILENAME);
     args.help(u"text-output", u"A synonym for --output-file.");
 
+    args.option(u"threads", 0, Args::INTEGER, 0, 1, 1, 64);
+    args.help(u"threads", u"count",
+              u"Deserialize and format the tables in XML and JSON using the specified number of worker threads. "
+              u"The tables are still output in their order of reception. "
+              u"This applies to --xml-output, --json-output, --log-xml-line, --log-json-line and --ip-udp. "
+              u"This is useful on streams with many tables, such as full EIT schedules, when the formatting "
+              u"cannot keep up with the input. "
+              u"By default, the tables are formatted in the packet processing thread.");
+
     args.option(u"time-stamp");
     args.help(u"time-stamp", u"Display a time stamp (current local time) with each table.");
 
@@ -327,6 +337,7 @@ bool ts::TablesLogger::loadArgs(DuckContext& duck, Args& args)
     _udp_raw = args.present(u"no-encapsulation");
     _use_current = !args.present(u"exclude-current");
     _use_next = args.present(u"include-next");
+    args.getIntValue(_threads, u"threads", 1);
 
     // Check consistency of options.
     if (_rewrite_binary && _bin_multi_files) {
@@ -403,6 +414,10 @@ bool ts::TablesLogger::open()
     _demux.setCurrentNext(_use_current, _use_next);
     _cas_mapper.setCurrentNext(_use_current, _use_next);
 
+    // With --all-sections, unchanged repetitions of sections are never reported with --all-once
+    // or --no-deep-duplicate. Drop them in the demux, before CRC32 validation and hashing.
+    _demux.setSkipUnchangedSections(_all_sections && (_all_once || _no_deep_duplicate));
+
     // Track invalid section versions.
     _demux.trackInvalidSectionVersions(_invalid_versions);
     _cas_mapper.trackInvalidSectionVersions(_invalid_versions);
@@ -451,6 +466,9 @@ bool ts::TablesLogger::open()
         return false;
     }
 
+    // Start the worker threads which format the tables.
+    startWorkers();
+
     // Initialize UDP output.
     if (_use_udp) {
         IPSocketAddress dest;
@@ -477,6 +495,10 @@ bool ts::TablesLogger::open()
 
 void ts::TablesLogger::close()
 {
+    // Output all pending formatted tables.
+    outputJobs(0);
+    stopWorkers();
+
     if (!_exit) {
 
         // Pack sections in incomplete tables if required.
@@ -514,6 +536,10 @@ void ts::TablesLogger::feedPacket(const TSPacket& pkt)
         _cas_mapper.feedPacket(pkt);
         _packet_count++;
     }
+    if (!_pending_jobs.empty()) {
+        // Output the tables which were formatted by the worker threads in the meantime.
+        outputJobs(_max_pending_jobs);
+    }
 }
 
 
@@ -615,40 +641,6 @@ void ts::TablesLogger::handleTable(SectionDemux& demux, const BinaryTable& table
         postDisplay();
     }
 
-    // Save table in XML format.
-    if (_use_xml) {
-        if (_rewrite_xml) {
-            // Build and save a new document each time.
-            xml::Document doc(_report);
-            doc.initialize(u"tsduck");
-            table.toXML(_duck, doc.rootElement(), _xml_options);
-            doc.save(_xml_destination, 2);
-        }
-        else {
-            // Just add the table in the running doc.
-            // Convert the table into an XML structure, print and delete the XML table.
-            table.toXML(_duck, _xml_doc.rootElement(), _xml_options);
-            _xml_doc.flush();
-        }
-    }
-
-    // Save table in JSON format.
-    if (_use_json) {
-        // First, build an XML document with the table.
-        xml::Document doc(_report);
-        doc.initialize(u"tsduck");
-        table.toXML(_duck, doc.rootElement(), _xml_options);
-        if (_rewrite_json) {
-            // Convert to JSON and save a new document each time.
-            _x2j_conv.convertToJSON(doc)->save(_json_destination, 2, true, _report);
-        }
-        else {
-            // Convert to JSON. Force "tsduck" root to appear so that the path to the first table is always the same.
-            // Query the first (and only) converted table and add it to the running document.
-            _json_doc.add(_x2j_conv.convertToJSON(doc, true)->query(u"#nodes[0]"));
-        }
-    }
-
     // Save table in binary format.
     if (_use_binary) {
         // In case of rewrite for each table, create a new file.
@@ -664,24 +656,20 @@ void ts::TablesLogger::handleTable(SectionDemux& demux, const BinaryTable& table
         }
     }
 
-    // Log table as a one-liner XML and/or JSON.
-    if (_log_xml_line || _log_json_line) {
-        logXMLJSON(table);
-    }
-
-    // Log table as a one-liner hexadecimal.
-    if (_log_hexa_line) {
-        UString line;
-        // Concatenate all sections in hexa.
-        for (size_t i = 0; i < table.sectionCount(); ++i) {
-            line.append(UString::Dump(table.sectionAt(i)->content(), table.sectionAt(i)->size(), UString::COMPACT));
+    // Save table in XML and JSON formats, log one-liners, send table in UDP message.
+    // With --threads, the formatting is done by worker threads and the output is delayed.
+    if (_use_xml || _use_json || _log_xml_line || _log_json_line || _log_hexa_line || _use_udp) {
+        const FormatJobPtr job(std::make_shared<FormatJob>(table, _duck.standards(), _report));
+        if (_workers.empty()) {
+            formatTable(_duck, *job);
+            outputTable(*job);
+        }
+        else {
+            _pending_jobs.push_back(job);
+            FormatJobPtr msg(job);
+            _jobs_queue.enqueue(msg);
+            outputJobs(_max_pending_jobs);
         }
-        _report.info(_log_hexa_prefix + line);
-    }
-
-    // Send binary table in UDP message.
-    if (_use_udp) {
-        sendUDP(table);
     }
 
     // Notify table, either at once or section by section.
@@ -850,46 +838,169 @@ void ts::TablesLogger::handleInvalidSection(SectionDemux& demux, const DemuxedDa
 
 
 //----------------------------------------------------------------------------
-// Build an XML document with one table.
-// In case of error serializing the table, error message are printed.
+// Format and output tables, possibly using worker threads.
 //----------------------------------------------------------------------------
 
-bool ts::TablesLogger::buildXML(xml::Document& doc, const BinaryTable& table)
+ts::TablesLogger::FormatJob::FormatJob(const BinaryTable& tab, Standards std, Report& report) :
+    table(tab, ShareMode::SHARE),
+    standards(std),
+    xml_doc(report)
+{
+}
+
+ts::TablesLogger::FormatThread::FormatThread(TablesLogger& logger, const DuckContext::SavedArgs& args) :
+    _logger(logger),
+    _duck(&logger._report)
 {
-    doc.initialize(u"tsduck");
-    return table.toXML(_duck, doc.rootElement(), _xml_options) != nullptr;
+    _duck.restoreArgs(args);
 }
 
+ts::TablesLogger::FormatThread::~FormatThread()
+{
+    waitForTermination();
+}
 
-//----------------------------------------------------------------------------
-// Build a JSON one-liner from an XML document containing one table.
-//----------------------------------------------------------------------------
+void ts::TablesLogger::FormatThread::main()
+{
+    // Loop on jobs to format, until a null pointer is received.
+    for (;;) {
+        FormatJobPtr job;
+        _logger._jobs_queue.dequeue(job);
+        if (job == nullptr) {
+            break;
+        }
+        _duck.addStandards(job->standards);
+        _logger.formatTable(_duck, *job);
+        std::lock_guard<std::mutex> lock(_logger._jobs_mutex);
+        job->done = true;
+        _logger._job_done.notify_all();
+    }
+}
+
+void ts::TablesLogger::startWorkers()
+{
+    // Worker threads are useful only when tables are formatted in XML or JSON.
+    if (_threads > 1 && _workers.empty() &&
+        (_use_xml || _use_json || _log_xml_line || _log_json_line || (_use_udp && _udp_format != SectionFormat::BINARY)))
+    {
+        DuckContext::SavedArgs args;
+        _duck.saveArgs(args);
+        _max_pending_jobs = 8 * _threads;
+        for (size_t i = 0; i < _threads; ++i) {
+            _workers.push_back(std::make_shared<FormatThread>(*this, args));
+            _workers.back()->start();
+        }
+        _report.debug(u"TablesLogger uses %d formatting threads", _threads);
+    }
+}
 
-ts::UString ts::TablesLogger::buildJSON(const xml::Document& doc)
+void ts::TablesLogger::stopWorkers()
 {
-    // Convert the XML document into JSON.
-    // Force "tsduck" root to appear so that the path to the first table is always the same.
-    const json::ValuePtr root(_x2j_conv.convertToJSON(doc, true));
+    // Send one null job to each thread, then wait for their termination.
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        FormatJobPtr end;
+        _jobs_queue.forceEnqueue(end);
+    }
+    _workers.clear();
+}
 
-    // Query the first (and only) converted table and serialize it as one line.
-    return root->query(u"#nodes[0]").oneLiner(_report);
+void ts::TablesLogger::outputJobs(size_t max_pending)
+{
+    while (!_pending_jobs.empty()) {
+        const FormatJobPtr job(_pending_jobs.front());
+        {
+            std::unique_lock<std::mutex> lock(_jobs_mutex);
+            if (_pending_jobs.size() > max_pending) {
+                // Too many pending jobs, wait for the oldest one.
+                _job_done.wait(lock, [&job]() { return job->done; });
+            }
+            else if (!job->done) {
+                // The oldest job is not yet formatted, the next ones must wait for it.
+                break;
+            }
+        }
+        _pending_jobs.pop_front();
+        outputTable(*job);
+    }
 }
 
+void ts::TablesLogger::formatTable(DuckContext& duck, FormatJob& job)
+{
+    const bool udp_xml = _use_udp && _udp_format == SectionFormat::XML;
+    const bool udp_json = _use_udp && _udp_format == SectionFormat::JSON;
 
-//----------------------------------------------------------------------------
-// Log XML or JSON one-liners.
-//----------------------------------------------------------------------------
+    // All formats start with an XML structure.
+    // In case of error serializing the table, error message are printed.
+    if (_use_xml || _use_json || _log_xml_line || _log_json_line || udp_xml || udp_json) {
+        job.xml_doc.initialize(u"tsduck");
+        job.xml_table = job.table.toXML(duck, job.xml_doc.rootElement(), _xml_options);
+    }
+    if (job.xml_table == nullptr) {
+        return;
+    }
+    if (_log_xml_line || udp_xml) {
+        job.xml_line = job.xml_doc.oneLiner();
+    }
+    if (_use_json && _rewrite_json) {
+        job.json_file = _x2j_conv.convertToJSON(job.xml_doc);
+    }
+    if ((_use_json && !_rewrite_json) || _log_json_line || udp_json) {
+        // Force "tsduck" root to appear so that the path to the first table is always the same.
+        job.json_root = _x2j_conv.convertToJSON(job.xml_doc, true);
+    }
+    if (_log_json_line || udp_json) {
+        // Query the first (and only) converted table and serialize it as one line.
+        job.json_line = job.json_root->query(u"#nodes[0]").oneLiner(_report);
+    }
+}
 
-void ts::TablesLogger::logXMLJSON(const BinaryTable& table)
+void ts::TablesLogger::outputTable(FormatJob& job)
 {
-    xml::Document doc(_report);
-    if (buildXML(doc, table)) {
-        if (_log_xml_line) {
-            _report.info(_log_xml_prefix + doc.oneLiner());
+    // Save table in XML format.
+    if (_use_xml && job.xml_table != nullptr) {
+        if (_rewrite_xml) {
+            // Save a new document each time.
+            job.xml_doc.save(_xml_destination, 2);
+        }
+        else {
+            // Just move the table in the running doc, print and delete the XML table.
+            job.xml_table->reparent(_xml_doc.rootElement());
+            job.xml_table = nullptr;
+            _xml_doc.flush();
         }
-        if (_log_json_line) {
-            _report.info(_log_json_prefix + buildJSON(doc));
+    }
+
+    // Save table in JSON format.
+    if (_use_json && job.json_file != nullptr) {
+        // Save a new document each time.
+        job.json_file->save(_json_destination, 2, true, _report);
+    }
+    if (_use_json && job.json_root != nullptr && !_rewrite_json) {
+        // Query the first (and only) converted table and add it to the running document.
+        _json_doc.add(job.json_root->query(u"#nodes[0]"));
+    }
+
+    // Log table as a one-liner XML and/or JSON.
+    if (_log_xml_line && !job.xml_line.empty()) {
+        _report.info(_log_xml_prefix + job.xml_line);
+    }
+    if (_log_json_line && !job.json_line.empty()) {
+        _report.info(_log_json_prefix + job.json_line);
+    }
+
+    // Log table as a one-liner hexadecimal.
+    if (_log_hexa_line) {
+        UString line;
+        // Concatenate all sections in hexa.
+        for (size_t i = 0; i < job.table.sectionCount(); ++i) {
+            line.append(UString::Dump(job.table.sectionAt(i)->content(), job.table.sectionAt(i)->size(), UString::COMPACT));
         }
+        _report.info(_log_hexa_prefix + line);
+    }
+
+    // Send table in UDP message.
+    if (_use_udp) {
+        sendUDP(job);
     }
 }
 
@@ -898,13 +1009,13 @@ void ts::TablesLogger::logXMLJSON(const BinaryTable& table)
 // Send a complete table through UDP.
 //----------------------------------------------------------------------------
 
-void ts::TablesLogger::sendUDP(const ts::BinaryTable& table)
+void ts::TablesLogger::sendUDP(const FormatJob& job)
 {
+    const BinaryTable& table(job.table);
     if (_udp_format == SectionFormat::XML || _udp_format == SectionFormat::JSON) {
-        // Build an XML or JSON one liner. In both cases, it starts with an XML structure.
-        xml::Document doc(_report);
-        if (buildXML(doc, table)) {
-            const UString line(_udp_format == SectionFormat::XML ? doc.oneLiner() : buildJSON(doc));
+        // Send an XML or JSON one liner, if the table was successfully formatted.
+        const UString& line(_udp_format == SectionFormat::XML ? job.xml_line : job.json_line);
+        if (!line.empty()) {
             std::string utf8;
             line.toUTF8(utf8);
             _sock.send(utf8.data(), utf8.size(), _report);
@@ -25,6 +25,9 @@
 #include "tsxmlJSONConverter.h"
 #include "tsjsonRunningDocument.h"
 #include "tsDuckProtocol.h"
+#include "tsDuckContext.h"
+#include "tsMessageQueue.h"
+#include "tsThread.h"
 
 namespace ts {
     //!
@@ -198,6 +201,7 @@ namespace ts {
         bool                     _fill_eit = false;          // Add missing empty sections to incomplete EIT's before exiting.
         bool                     _use_current = true;        // Use tables with "current" flag.
         bool                     _use_next = false;          // Use tables with "next" flag.
+        size_t                   _threads = 1;               // Number of threads to format tables.
         xml::Tweaks              _xml_tweaks {};             // XML tweak options.
         PIDSet                   _initial_pids {};           // Initial PID's to filter.
         BinaryTable::XMLOptions  _xml_options {};            // XML conversion options.
@@ -226,23 +230,66 @@ namespace ts {
         TablesLoggerFilterVector _section_filters {};        // All registered section filters.
         duck::Protocol           _duck_protocol {};          // To generate UDP messages.
 
+        // A table to format and output, possibly in a worker thread (option --threads).
+        class FormatJob
+        {
+            TS_NOBUILD_NOCOPY(FormatJob);
+        public:
+            FormatJob(const BinaryTable& tab, Standards std, Report& report);
+            const BinaryTable table;           // Table to format, sections are shared.
+            const Standards   standards;       // Accumulated standards when the table was received.
+            xml::Document     xml_doc;         // XML document containing the table.
+            xml::Element*     xml_table = nullptr;  // Table element in xml_doc, null on error.
+            json::ValuePtr    json_root {};    // JSON conversion of xml_doc, always with "tsduck" root.
+            json::ValuePtr    json_file {};    // JSON conversion of xml_doc for --rewrite-json.
+            UString           xml_line {};     // XML one-liner.
+            UString           json_line {};    // JSON one-liner.
+            bool              done = false;    // Formatting completed, protected by _jobs_mutex.
+        };
+        using FormatJobPtr = std::shared_ptr<FormatJob>;
+
+        // A worker thread which formats tables, with its own TSDuck context.
+        class FormatThread: public Thread
+        {
+            TS_NOBUILD_NOCOPY(FormatThread);
+        public:
+            FormatThread(TablesLogger& logger, const DuckContext::SavedArgs& args);
+            virtual ~FormatThread() override;
+        private:
+            TablesLogger& _logger;
+            DuckContext   _duck;
+            virtual void main() override;
+        };
+
+        // Worker threads and ordered output stage (option --threads).
+        std::vector<std::shared_ptr<FormatThread>> _workers {};
+        MessageQueue<FormatJob>  _jobs_queue {};             // Jobs to format by worker threads.
+        std::deque<FormatJobPtr> _pending_jobs {};           // Jobs to output, in order of reception.
+        std::mutex               _jobs_mutex {};             // Protect the "done" flag of jobs.
+        std::condition_variable  _job_done {};               // Signaled when a job is formatted.
+        size_t                   _max_pending_jobs = 0;      // Max number of pending jobs before waiting for the oldest one.
+
+        // Start and stop the worker threads.
+        void startWorkers();
+        void stopWorkers();
+
+        // Format a table in XML and JSON, as required by the options. Can be called from a worker thread.
+        void formatTable(DuckContext& duck, FormatJob& job);
+
+        // Output a formatted table in XML and JSON files, log lines and UDP. Called from the demux thread.
+        void outputTable(FormatJob& job);
+
+        // Output all formatted tables in order. Wait for the oldest ones while there are more than max_pending jobs.
+        void outputJobs(size_t max_pending);
+
         // Create a binary file. On error, set _abort and return false.
         bool createBinaryFile(const fs::path& name);
 
         // Save a section in a binary file
         void saveBinarySection(const Section&);
 
-        // Build an XML document with one table.
-        bool buildXML(xml::Document& doc, const BinaryTable& table);
-
-        // Build a JSON one-liner from an XML document containing one table.
-        UString buildJSON(const xml::Document& doc);
-
-        // Log XML and/or JSON one-liners.
-        void logXMLJSON(const BinaryTable& table);
-
         // Send UDP table and section.
-        void sendUDP(const BinaryTable& table);
+        void sendUDP(const FormatJob& job);
         void sendUDP(const Section& section);
 
         // Pre/post-display of a table or section
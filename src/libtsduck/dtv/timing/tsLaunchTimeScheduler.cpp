@@ -0,0 +1,162 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsLaunchTimeScheduler.h"
+#include "tsNullReport.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor
+//----------------------------------------------------------------------------
+
+ts::LaunchTimeScheduler::LaunchTimeScheduler(Report* report, int log_level) :
+    _report(report == nullptr ? &NULLREP : report),
+    _log_level(log_level)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Set a new report.
+//----------------------------------------------------------------------------
+
+void ts::LaunchTimeScheduler::setReport(Report* report, int log_level)
+{
+    _report = report == nullptr ? &NULLREP : report;
+    _log_level = log_level;
+}
+
+
+//----------------------------------------------------------------------------
+// Set the PCR reference PID.
+//----------------------------------------------------------------------------
+
+void ts::LaunchTimeScheduler::setReferencePID(PID pid)
+{
+    _user_pid = pid;
+    if (pid != _pid) {
+        reset();
+        _pid = pid;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Re-initialize state.
+//----------------------------------------------------------------------------
+
+void ts::LaunchTimeScheduler::reset()
+{
+    _pid = _user_pid;
+    _started = false;
+    _pkt_count = 0;
+    _origin_pkt = 0;
+    _rate = 0;
+    _pcr_value = INVALID_PCR;
+    _pcr_bitrate = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Transmission time of a packet, extrapolated from the origin.
+//----------------------------------------------------------------------------
+
+ts::monotonic_time ts::LaunchTimeScheduler::extrapolate(PacketCounter index, const BitRate& bitrate) const
+{
+    if (bitrate <= 0) {
+        // Unknown bitrate, all packets at the same time.
+        return _origin_time;
+    }
+    else if (index >= _origin_pkt) {
+        return _origin_time + PacketInterval<cn::nanoseconds>(bitrate, index - _origin_pkt);
+    }
+    else {
+        return _origin_time - PacketInterval<cn::nanoseconds>(bitrate, _origin_pkt - index);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Compute the transmission time of the next group of packets.
+//----------------------------------------------------------------------------
+
+ts::monotonic_time ts::LaunchTimeScheduler::launchTime(const TSPacket* packets, size_t count, const BitRate& bitrate, monotonic_time now)
+{
+    if (!_started) {
+        _started = true;
+        _origin_pkt = _pkt_count;
+        _origin_time = now;
+    }
+
+    // The stream bitrate has precedence, the PCR bitrate is used when unknown.
+    const PacketCounter first = _pkt_count;
+    BitRate rate = bitrate > 0 ? bitrate : _pcr_bitrate;
+
+    // When the bitrate changes, the new bitrate applies from this group of packets only.
+    // Also avoid overflows in extrapolations on long streams without PCR.
+    if (rate != _rate || first > _origin_pkt + MAX_ORIGIN_DISTANCE) {
+        _origin_time = extrapolate(first, _rate);
+        _origin_pkt = first;
+    }
+
+    // Look for PCR's in the reference PID.
+    for (size_t i = 0; packets != nullptr && i < count; ++i) {
+        const TSPacket& pkt(packets[i]);
+        if (!pkt.hasPCR()) {
+            continue;
+        }
+        const PID pid = pkt.getPID();
+        if (_pid == PID_NULL) {
+            // Select first PID with PCR's when unspecified by user.
+            _pid = pid;
+            _report->log(_log_level, u"using PID %n for PCR reference", pid);
+        }
+        if (pid != _pid) {
+            continue;
+        }
+
+        const uint64_t pcr = pkt.getPCR();
+        const PacketCounter index = first + i;
+        const uint64_t diff = _pcr_value == INVALID_PCR ? 0 : (pcr >= _pcr_value ? pcr - _pcr_value : pcr + PCR_SCALE - _pcr_value);
+
+        if (diff > 0 && diff < MAX_PCR_INTERVAL && index > _pcr_pkt) {
+            // Consecutive PCR's, the transmission time of this packet is given by the PCR.
+            _pcr_time += cn::duration_cast<cn::nanoseconds>(PCR(diff));
+            _pcr_bitrate = BitRate((index - _pcr_pkt) * PKT_SIZE_BITS * SYSTEM_CLOCK_FREQ) / diff;
+            if (bitrate <= 0) {
+                rate = _pcr_bitrate;
+            }
+            // Extrapolate the next packets from this one.
+            _origin_pkt = index;
+            _origin_time = _pcr_time;
+        }
+        else {
+            // First PCR or discontinuity, the time of this packet can only be extrapolated.
+            if (_pcr_value != INVALID_PCR) {
+                _report->log(_log_level, u"PCR discontinuity on PID %n, resynchronizing", pid);
+            }
+            _pcr_time = extrapolate(index, rate);
+        }
+        _pcr_value = pcr;
+        _pcr_pkt = index;
+    }
+
+    monotonic_time launch = extrapolate(first, rate);
+    _pkt_count += count;
+    _rate = rate;
+
+    // When the stream is late, shift the schedule to now, including the PCR reference.
+    if (launch + _max_lag < now) {
+        const cn::nanoseconds shift = now - launch;
+        _report->log(_log_level, u"transmission is late by %s, shifting schedule", cn::duration_cast<cn::milliseconds>(shift));
+        _origin_time += shift;
+        _pcr_time += shift;
+        launch = now;
+    }
+    return launch;
+}
@@ -0,0 +1,125 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Compute the transmission time of groups of packets, based on PCR's or bitrate.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsReport.h"
+#include "tsTSPacket.h"
+
+namespace ts {
+    //!
+    //! Compute the transmission time of groups of packets, based on PCR's or bitrate.
+    //! @ingroup libtsduck mpeg
+    //! @see PCRRegulator
+    //! @see BitRateRegulator
+    //!
+    //! Unlike PCRRegulator and BitRateRegulator, this class never waits. It computes the
+    //! time at which each group of packets (typically a datagram) should be transmitted.
+    //! The actual pacing is delegated to another entity, typically the kernel, using
+    //! socket launch times (see UDPSocket::setTransmitTime()).
+    //!
+    //! When PCR's are present in the reference PID, the transmission time of each packet
+    //! containing a PCR is derived from the PCR value. Between PCR's, the transmission time
+    //! of packets is extrapolated using the stream bitrate or, if unknown, the bitrate
+    //! between the last two PCR's. Without PCR, the bitrate is used.
+    //!
+    //! When the packets are late (the stream is slower than its bitrate or PCR's), the
+    //! schedule is shifted to the current time, to avoid sending a burst of late packets.
+    //!
+    class TSDUCKDLL LaunchTimeScheduler
+    {
+        TS_NOCOPY(LaunchTimeScheduler);
+    public:
+        //!
+        //! Constructor.
+        //! @param [in,out] report Where to report errors.
+        //! @param [in] log_level Severity level for information messages.
+        //!
+        LaunchTimeScheduler(Report* report = nullptr, int log_level = Severity::Debug);
+
+        //!
+        //! Set a new report.
+        //! @param [in,out] report Where to report errors.
+        //! @param [in] log_level Severity level for information messages.
+        //!
+        void setReport(Report* report = nullptr, int log_level = Severity::Debug);
+
+        //!
+        //! Set the PCR reference PID.
+        //! @param [in] pid Reference PID. If PID_NULL, use the first PID containing PCR's.
+        //!
+        void setReferencePID(PID pid);
+
+        //!
+        //! Get the current PCR reference PID.
+        //! @return Current reference PID or PID_NULL if none was set or found.
+        //!
+        PID getReferencePID() const { return _pid; }
+
+        //!
+        //! Default maximum lateness of a transmission time, before shifting the schedule.
+        //!
+        static constexpr cn::milliseconds DEFAULT_MAX_LAG = cn::milliseconds(100);
+
+        //!
+        //! Set the maximum lateness of a transmission time, before shifting the schedule.
+        //! @param [in] lag Maximum lateness.
+        //!
+        void setMaxLag(cn::nanoseconds lag) { _max_lag = lag; }
+
+        //!
+        //! Re-initialize state. The schedule restarts at the next group of packets.
+        //!
+        void reset();
+
+        //!
+        //! Compute the transmission time of the next group of packets.
+        //! @param [in] packets Address of the packets in the group.
+        //! @param [in] count Number of packets in the group.
+        //! @param [in] bitrate Current bitrate of the stream. If zero, use the bitrate between PCR's.
+        //! @param [in] now Current time.
+        //! @return Transmission time of the first packet in the group.
+        //!
+        monotonic_time launchTime(const TSPacket* packets, size_t count, const BitRate& bitrate, monotonic_time now = monotonic_time::clock::now());
+
+        //!
+        //! Get the bitrate between the last two PCR's in the reference PID.
+        //! @return The bitrate between the last two PCR's or zero if unknown.
+        //!
+        BitRate pcrBitRate() const { return _pcr_bitrate; }
+
+    private:
+        // Maximum interval between two PCR's. Above, this is a discontinuity.
+        static constexpr uint64_t MAX_PCR_INTERVAL = SYSTEM_CLOCK_FREQ;
+
+        // Maximum distance in packets from the extrapolation origin, avoid overflows in computations.
+        static constexpr PacketCounter MAX_ORIGIN_DISTANCE = 100'000;
+
+        Report*         _report = nullptr;
+        int             _log_level = Severity::Debug;
+        PID             _user_pid = PID_NULL;      // User-specified reference PID.
+        PID             _pid = PID_NULL;           // Current reference PID.
+        cn::nanoseconds _max_lag {DEFAULT_MAX_LAG};
+        bool            _started = false;          // Schedule started.
+        PacketCounter   _pkt_count = 0;            // Index of next packet.
+        PacketCounter   _origin_pkt = 0;           // Index of the extrapolation origin packet.
+        monotonic_time  _origin_time {};           // Transmission time of the extrapolation origin packet.
+        BitRate         _rate = 0;                 // Bitrate for extrapolation after the origin.
+        PacketCounter   _pcr_pkt = 0;              // Index of the last packet with a PCR in the reference PID.
+        uint64_t        _pcr_value = INVALID_PCR;  // Last PCR value in the reference PID.
+        monotonic_time  _pcr_time {};              // Transmission time of the last packet with a PCR.
+        BitRate         _pcr_bitrate = 0;          // Bitrate between the last two PCR's.
+
+        // Transmission time of a packet, extrapolated from the origin.
+        monotonic_time extrapolate(PacketCounter index, const BitRate& bitrate) const;
+    };
+}
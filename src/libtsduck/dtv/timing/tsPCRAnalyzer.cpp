@@ -17,7 +17,8 @@
 
 ts::PCRAnalyzer::PCRAnalyzer(size_t min_pid, size_t min_pcr) :
     _min_pid(std::max<size_t>(1, min_pid)),
-    _min_pcr(std::max<size_t>(1, min_pcr))
+    _min_pcr(std::max<size_t>(1, min_pcr)),
+    _pcr_window(PCR_WINDOW_SIZE)
 {
     TS_ZERO(_pid);
 }
@@ -48,6 +49,18 @@ ts::UString ts::PCRAnalyzer::Status::toString() const
                            bitrate_valid, bitrate_188, packet_count, pcr_count, pcr_pids, discontinuities, instantaneous_bitrate_188);
 }
 
+ts::UString ts::PCRAnalyzer::PIDStatus::toString() const
+{
+    return UString::Format(u"packets: %'d, PCRs: %'d, interval min: %s, max: %s, avg: %s, jitter max: %s, avg: %s, drift: %.3f ppm",
+                           packet_count, pcr_count,
+                           cn::duration_cast<cn::microseconds>(min_interval),
+                           cn::duration_cast<cn::microseconds>(max_interval),
+                           cn::duration_cast<cn::microseconds>(avg_interval),
+                           cn::duration_cast<cn::nanoseconds>(max_jitter),
+                           cn::duration_cast<cn::nanoseconds>(avg_jitter),
+                           drift_ppm);
+}
+
 
 //----------------------------------------------------------------------------
 // Reset all collected information
@@ -84,7 +97,8 @@ void ts::PCRAnalyzer::reset()
         }
     }
 
-    _packet_pcr_index_map.clear();
+    _pcr_window_first = 0;
+    _pcr_window_count = 0;
 }
 
 
@@ -124,7 +138,8 @@ void ts::PCRAnalyzer::processDiscontinuity()
             _pid[i]->last_pcr_value = INVALID_PCR;
         }
     }
-    _packet_pcr_index_map.clear();
+    _pcr_window_first = 0;
+    _pcr_window_count = 0;
 }
 
 
@@ -200,6 +215,70 @@ void ts::PCRAnalyzer::getStatus(Status& stat) const
 }
 
 
+//----------------------------------------------------------------------------
+// Return the results of one PID.
+//----------------------------------------------------------------------------
+
+bool ts::PCRAnalyzer::getPIDStatus(PID pid, PIDStatus& stat) const
+{
+    stat = PIDStatus();
+    if (pid >= PID_MAX || _pid[pid] == nullptr) {
+        return false;
+    }
+    const PIDAnalysis& ps(*_pid[pid]);
+    stat.packet_count = ps.ts_pkt_cnt;
+    stat.pcr_count = ps.pcr_cnt;
+    stat.interval_count = ps.interval_cnt;
+    stat.accuracy_count = ps.accuracy_cnt;
+    if (ps.interval_cnt > 0) {
+        stat.min_interval = PCR(ps.min_interval);
+        stat.max_interval = PCR(ps.max_interval);
+        stat.avg_interval = PCR(ps.sum_interval / ps.interval_cnt);
+    }
+    if (ps.accuracy_cnt > 0) {
+        stat.max_jitter = PCR(ps.max_jitter);
+        stat.avg_jitter = PCR(ps.sum_jitter / ps.accuracy_cnt);
+        if (ps.sum_expected > 0) {
+            stat.drift_ppm = (1000000.0 * double(ps.sum_error)) / double(ps.sum_expected);
+        }
+    }
+    return ps.pcr_cnt > 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Update the per-PID statistics on a new PCR/DTS interval.
+//----------------------------------------------------------------------------
+
+void ts::PCRAnalyzer::updatePIDStatistics(PIDAnalysis& ps, uint64_t interval, uint64_t packets)
+{
+    // PCR_OI, overall interval.
+    if (ps.interval_cnt++ == 0) {
+        ps.min_interval = ps.max_interval = interval;
+    }
+    else {
+        ps.min_interval = std::min(ps.min_interval, interval);
+        ps.max_interval = std::max(ps.max_interval, interval);
+    }
+    ps.sum_interval += interval;
+
+    // PCR_AC, accuracy: compare the PCR with its expected value, based on the average TS bitrate.
+    if (_bitrate_valid) {
+        const BitRate bitrate(bitrate188());
+        if (bitrate > 0) {
+            const uint64_t expected = (BitRate(packets * PKT_SIZE_BITS * SYSTEM_CLOCK_FREQ) / bitrate).toInt();
+            const int64_t error = int64_t(interval) - int64_t(expected);
+            const uint64_t jitter = uint64_t(error < 0 ? -error : error);
+            ps.accuracy_cnt++;
+            ps.max_jitter = std::max(ps.max_jitter, jitter);
+            ps.sum_jitter += jitter;
+            ps.sum_error += error;
+            ps.sum_expected += expected;
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Feed the PCR analyzer with a new transport packet.
 // Return true if we have collected enough packet to evaluate TS bitrate.
@@ -285,18 +364,24 @@ bool ts::PCRAnalyzer::feedPacket(const TSPacket& pkt)
             BitRate ts_bitrate_204 = diff_values == 0 ? 0 :
                 BitRate((_ts_pkt_cnt - ps->last_pcr_packet) * SYSTEM_CLOCK_FREQ * PKT_RS_SIZE_BITS) / diff_values;
 
-            // Clear out values older than 1 second from _packet_pcr_index_map.
-            // Note that this is a map that covers PCR/DTS packets across all PIDs
+            // Per-PID jitter and interval statistics, when required.
+            if (_pid_stats) {
+                updatePIDStatistics(*ps, diff_values, _ts_pkt_cnt - ps->last_pcr_packet);
+            }
+
+            // Clear out values older than 1 second from the PCR window.
+            // Note that this window covers PCR/DTS packets across all PIDs
             // as long as the clocks used to generate the PCR/DTS values for different
             // programs is the same clock, there should be no issue, but if the PCR/DTS values
             // across the two programs are wildly different, then the following approach won't work.
-            while (!_packet_pcr_index_map.empty()) {
-                const uint64_t earliestPCR_DTS = _packet_pcr_index_map.begin()->first;
+            while (_pcr_window_count > 0) {
+                const uint64_t earliestPCR_DTS = _pcr_window[_pcr_window_first].pcr_dts;
                 diff_values = _use_dts ?
                     DiffPTS(earliestPCR_DTS, pcr_dts) * SYSTEM_CLOCK_SUBFACTOR :
                     DiffPCR(earliestPCR_DTS, pcr_dts);
                 if (diff_values > SYSTEM_CLOCK_FREQ) {
-                    _packet_pcr_index_map.erase(_packet_pcr_index_map.begin());
+                    _pcr_window_first = (_pcr_window_first + 1) % PCR_WINDOW_SIZE;
+                    _pcr_window_count--;
                 }
                 else {
                     break;
@@ -319,14 +404,15 @@ bool ts::PCRAnalyzer::feedPacket(const TSPacket& pkt)
 
             // Transport stream instantaneous statistics.
             // For instantaneous bit rates, these are the actual bit rates, and it doesn't use the "count" approach.
-            if (!_packet_pcr_index_map.empty()) {
+            if (_pcr_window_count > 0) {
+                const PCRIndex& earliest(_pcr_window[_pcr_window_first]);
                 diff_values = _use_dts ?
-                    DiffPTS(_packet_pcr_index_map.begin()->first, pcr_dts) * SYSTEM_CLOCK_SUBFACTOR :
-                    DiffPCR(_packet_pcr_index_map.begin()->first, pcr_dts);
+                    DiffPTS(earliest.pcr_dts, pcr_dts) * SYSTEM_CLOCK_SUBFACTOR :
+                    DiffPCR(earliest.pcr_dts, pcr_dts);
                 _inst_ts_bitrate_188 = diff_values == 0 ? 0 :
-                    BitRate((_ts_pkt_cnt - _packet_pcr_index_map.begin()->second) * SYSTEM_CLOCK_FREQ * PKT_SIZE_BITS) / diff_values;
+                    BitRate((_ts_pkt_cnt - earliest.packet) * SYSTEM_CLOCK_FREQ * PKT_SIZE_BITS) / diff_values;
                 _inst_ts_bitrate_204 = diff_values == 0 ? 0 :
-                    BitRate((_ts_pkt_cnt - _packet_pcr_index_map.begin()->second) * SYSTEM_CLOCK_FREQ * PKT_RS_SIZE_BITS) / diff_values;
+                    BitRate((_ts_pkt_cnt - earliest.packet) * SYSTEM_CLOCK_FREQ * PKT_RS_SIZE_BITS) / diff_values;
             }
 
             // Check if we got enough values for this PID
@@ -340,15 +426,17 @@ bool ts::PCRAnalyzer::feedPacket(const TSPacket& pkt)
         if (ps->last_pcr_value != pcr_dts) {
             ps->last_pcr_value = pcr_dts;
             ps->last_pcr_packet = _ts_pkt_cnt;
+            ps->pcr_cnt++;
 
-            // Also add PCR (or DTS)/packet index combo to map for use in instantaneous bit rate calculations.
-            _packet_pcr_index_map[pcr_dts] = _ts_pkt_cnt;
-
-            // Make sure that some crazy TS does not accumulate thousands of PCR values in the same second range.
-            while (_packet_pcr_index_map.size() > FOOLPROOF_MAP_LIMIT) {
-                // Erase older entries.
-                _packet_pcr_index_map.erase(_packet_pcr_index_map.begin());
+            // Also add PCR (or DTS)/packet index combo to the window for use in instantaneous bit rate calculations.
+            // When the window is full, overwrite the oldest entry.
+            if (_pcr_window_count == PCR_WINDOW_SIZE) {
+                _pcr_window_first = (_pcr_window_first + 1) % PCR_WINDOW_SIZE;
+                _pcr_window_count--;
             }
+            PCRIndex& last(_pcr_window[(_pcr_window_first + _pcr_window_count++) % PCR_WINDOW_SIZE]);
+            last.pcr_dts = pcr_dts;
+            last.packet = _ts_pkt_cnt;
         }
     }
 
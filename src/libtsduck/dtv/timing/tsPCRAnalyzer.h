@@ -174,6 +174,51 @@ namespace ts {
         //!
         void getStatus(Status& status) const;
 
+        //!
+        //! Enable or disable the computation of per-PID PCR statistics.
+        //! The statistics are computed incrementally, without memory allocation.
+        //! They are disabled by default. Changing this option does not reset the collected information.
+        //! @param [in] on When true, compute per-PID statistics.
+        //! @see getPIDStatus()
+        //!
+        void setPIDStatistics(bool on) { _pid_stats = on; }
+
+        //!
+        //! Structure containing the PCR analysis results of one PID.
+        //! When DTS are used instead of PCR, all values apply to DTS in PCR units.
+        //!
+        struct TSDUCKDLL PIDStatus: public StringifyInterface
+        {
+            PacketCounter packet_count = 0;   //!< The number of analyzed TS packets in the PID.
+            PacketCounter pcr_count = 0;      //!< The number of PCR's in the PID.
+            PacketCounter interval_count = 0; //!< The number of intervals between two valid consecutive PCR's.
+            PCR           min_interval {};    //!< Minimum interval between two consecutive PCR's (PCR_OI, overall interval).
+            PCR           max_interval {};    //!< Maximum interval between two consecutive PCR's (PCR_OI, overall interval).
+            PCR           avg_interval {};    //!< Average interval between two consecutive PCR's (PCR_OI, overall interval).
+            PacketCounter accuracy_count = 0; //!< The number of PCR's which were checked for accuracy.
+            PCR           max_jitter {};      //!< Maximum absolute difference between a PCR and its expected value (PCR_AC, accuracy).
+            PCR           avg_jitter {};      //!< Average absolute difference between a PCR and its expected value (PCR_AC, accuracy).
+            double        drift_ppm = 0.0;    //!< Drift of the PCR clock compared to the average TS bitrate, in parts per million.
+
+            // Implementation of StringifyInterface.
+            virtual UString toString() const override;
+        };
+
+        //!
+        //! Get the PCR analysis results of one PID.
+        //! The expected value of a PCR is computed from the previous PCR in the same PID,
+        //! the number of packets in between and the average TS bitrate. Thus, the PCR accuracy
+        //! and drift are available only after the TS bitrate is valid. The drift is the difference
+        //! between the PCR clock of the PID and the packet clock, as given by the average TS bitrate.
+        //! It is meaningful when several programs use distinct clocks.
+        //! @param [in] pid The PID to evaluate.
+        //! @param [out] status The returned PCR analysis results. Only the packet and PCR counts
+        //! are set when per-PID statistics are disabled.
+        //! @return True if the PID contains PCR's, false otherwise.
+        //! @see setPIDStatistics()
+        //!
+        bool getPIDStatus(PID pid, PIDStatus& status) const;
+
     private:
         // Process a discontinuity in the transport stream
         void processDiscontinuity();
@@ -188,13 +233,35 @@ namespace ts {
             BitRate  ts_bitrate_188 = 0;   // Sum of all computed TS bitrates (188-byte)
             BitRate  ts_bitrate_204 = 0;   // Sum of all computed TS bitrates (204-byte)
             uint64_t ts_bitrate_cnt = 0;   // Count of computed TS bitrates
+            // Incremental statistics, when _pid_stats is set.
+            uint64_t pcr_cnt = 0;          // Count of PCR/DTS
+            uint64_t interval_cnt = 0;     // Count of PCR intervals
+            uint64_t min_interval = 0;     // Minimum PCR interval, in PCR units
+            uint64_t max_interval = 0;     // Maximum PCR interval, in PCR units
+            uint64_t sum_interval = 0;     // Sum of PCR intervals, in PCR units
+            uint64_t accuracy_cnt = 0;     // Count of PCR accuracy measurements
+            uint64_t max_jitter = 0;       // Maximum absolute PCR error, in PCR units
+            uint64_t sum_jitter = 0;       // Sum of absolute PCR errors, in PCR units
+            int64_t  sum_error = 0;        // Sum of signed PCR errors, in PCR units
+            uint64_t sum_expected = 0;     // Sum of expected PCR intervals, in PCR units
         };
 
+        // An entry in the sliding window of PCR/DTS values across all PID's.
+        struct PCRIndex
+        {
+            uint64_t pcr_dts = 0;          // PCR or DTS value
+            uint64_t packet = 0;           // Packet index in TS
+        };
+
+        // Update the per-PID statistics on a new PCR/DTS interval.
+        void updatePIDStatistics(PIDAnalysis& ps, uint64_t interval, uint64_t packets);
+
         // Private members:
         bool     _use_dts = false;         // Use DTS instead of PCR
         bool     _ignore_errors = false;   // Ignore TS errors such as discontinuities.
         size_t   _min_pid {1};             // Min # of PID
         size_t   _min_pcr {1};             // Min # of PCR per PID
+        bool     _pid_stats = false;       // Compute per-PID statistics
         bool     _bitrate_valid = false;   // Bitrate evaluation is valid
         uint64_t _ts_pkt_cnt = 0;          // Total TS packets count
         BitRate  _ts_bitrate_188 = 0;      // Sum of all computed TS bitrates (188-byte)
@@ -206,7 +273,12 @@ namespace ts {
         size_t   _pcr_pids = 0;            // Number of PIDs with PCRs
         size_t   _discontinuities = 0;     // Number of discontinuities
         PIDAnalysis* _pid[PID_MAX] {};     // Per-PID stats
-        std::map<uint64_t, uint64_t> _packet_pcr_index_map {}; // Map of PCR/DTS to packet index across entire TS
-        static constexpr size_t FOOLPROOF_MAP_LIMIT = 1000;    // Max number of entries in the PCR map
+
+        // Sliding window of the PCR/DTS values of the last second across entire TS, in a ring buffer.
+        // Make sure that some crazy TS does not accumulate thousands of PCR values in the same second range.
+        static constexpr size_t PCR_WINDOW_SIZE = 1000;  // Max number of entries in the PCR window
+        std::vector<PCRIndex> _pcr_window {};            // Ring buffer of PCR_WINDOW_SIZE entries
+        size_t   _pcr_window_first = 0;                  // Index of oldest entry in _pcr_window
+        size_t   _pcr_window_count = 0;                  // Number of entries in _pcr_window
     };
 }
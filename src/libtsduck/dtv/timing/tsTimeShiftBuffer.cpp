@@ -7,8 +7,350 @@
 //----------------------------------------------------------------------------
 
 #include "tsTimeShiftBuffer.h"
+#include "tsResidentBuffer.h"
 #include "tsNullReport.h"
 #include "tsFileUtils.h"
+#include "tsSysUtils.h"
+#include "tsThread.h"
+
+#if !defined(TS_WINDOWS)
+    #include "tsBeforeStandardHeaders.h"
+    #include <sys/types.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
+
+namespace {
+    // Minimum number of segment buffers with asynchronous I/O: segment to read,
+    // prefetched segment, segment to write and at least one segment being written.
+    constexpr size_t MIN_SEGMENT_BUFFERS = 4;
+
+    // Segments are stored on disk in slots which are aligned on this size, for direct I/O.
+    constexpr size_t SLOT_ALIGNMENT = 4096;
+}
+
+
+//----------------------------------------------------------------------------
+// Backup file with asynchronous I/O on segments.
+//----------------------------------------------------------------------------
+
+class ts::TimeShiftBuffer::AsyncFile : private Thread
+{
+    TS_NOBUILD_NOCOPY(AsyncFile);
+public:
+    // Constructor and destructor.
+    AsyncFile(size_t segment_packets, size_t buffer_count);
+    virtual ~AsyncFile() override;
+
+    // Open and close the file.
+    bool open(const fs::path& filename, bool direct_io, Report& report);
+    bool close(Report& report);
+
+    // Access the packets and metadata in a segment buffer.
+    TSPacket* packets(size_t buffer) { return reinterpret_cast<TSPacket*>(_memory.base() + buffer * _slot_size + _mdata_size); }
+    TSPacketMetadata* metadata(size_t buffer) { return reinterpret_cast<TSPacketMetadata*>(_memory.base() + buffer * _slot_size); }
+
+    // Get a free buffer, wait until one is available. Return NPOS on I/O error.
+    size_t acquire(Report& report);
+
+    // Release a buffer which is no longer used.
+    void release(size_t buffer);
+
+    // Enqueue the write of a buffer in a segment. The buffer is released after the write.
+    bool write(size_t buffer, size_t segment, Report& report);
+
+    // Enqueue the read of a segment in a buffer.
+    bool read(size_t buffer, size_t segment, Report& report);
+
+    // Wait for the completion of the read in a buffer.
+    bool wait(size_t buffer, Report& report);
+
+private:
+    // State of a segment buffer.
+    enum class State {FREE, USED, WRITING, READING, LOADED};
+
+    // An I/O request.
+    struct Request {
+        bool   write;
+        size_t buffer;
+        size_t segment;
+    };
+
+    const size_t            _mdata_size;         // Size of metadata area at start of slot.
+    const size_t            _slot_size;          // Size of a segment buffer and a segment slot in the file.
+    ResidentBuffer<uint8_t> _memory;             // All segment buffers, page-aligned for direct I/O.
+#if defined(TS_WINDOWS)
+    ::HANDLE                _handle = INVALID_HANDLE_VALUE;
+#else
+    int                     _fd = -1;
+#endif
+    bool                    _is_open = false;
+    std::mutex              _mutex {};           // Protect all fields below.
+    std::condition_variable _cond {};            // Signaled when a request is submitted or completed.
+    std::vector<State>      _states {};          // State of each segment buffer.
+    std::deque<Request>     _requests {};        // Pending I/O requests, processed in order.
+    bool                    _terminate = false;  // Request to terminate the thread.
+    bool                    _failed = false;     // An I/O error occured.
+    bool                    _failed_write = false; // The I/O error occured on write.
+    size_t                  _failed_segment = 0; // Segment of the I/O error.
+    int                     _error_code = 0;     // Last I/O error code.
+    size_t                  _stalls = 0;         // Number of times the application waited for I/O.
+
+    // Report the I/O error, if any. Must be called with the mutex held.
+    bool checkError(Report& report);
+
+    // Read or write a segment slot.
+    bool transfer(const Request& req, int& error_code);
+
+    // Implementation of Thread.
+    virtual void main() override;
+};
+
+ts::TimeShiftBuffer::AsyncFile::AsyncFile(size_t segment_packets, size_t buffer_count) :
+    _mdata_size(segment_packets * sizeof(TSPacketMetadata)),
+    _slot_size(round_up(segment_packets * (sizeof(TSPacketMetadata) + PKT_SIZE), SLOT_ALIGNMENT)),
+    _memory(buffer_count * _slot_size),
+    _states(buffer_count, State::FREE)
+{
+    // Construct all packet metadata. The content of the buffers is raw data in the file.
+    for (size_t buf = 0; buf < buffer_count; ++buf) {
+        TSPacketMetadata* mdata = metadata(buf);
+        for (size_t i = 0; i < segment_packets; ++i) {
+            new (mdata + i) TSPacketMetadata();
+        }
+    }
+}
+
+ts::TimeShiftBuffer::AsyncFile::~AsyncFile()
+{
+    close(NULLREP);
+}
+
+
+//----------------------------------------------------------------------------
+// Open the backup file and start the I/O thread.
+//----------------------------------------------------------------------------
+
+bool ts::TimeShiftBuffer::AsyncFile::open(const fs::path& filename, bool direct_io, Report& report)
+{
+#if defined(TS_WINDOWS)
+
+    // The file is automatically deleted when closed.
+    const ::DWORD attrib = FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE | (direct_io ? FILE_FLAG_NO_BUFFERING : 0);
+    _handle = ::CreateFileW(filename.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, attrib, nullptr);
+    if (_handle == INVALID_HANDLE_VALUE) {
+        report.error(u"cannot create %s: %s", filename, SysErrorCodeMessage());
+        return false;
+    }
+
+#else
+
+    int flags = O_LARGEFILE | O_RDWR | O_CREAT | O_EXCL;
+#if defined(O_DIRECT)
+    if (direct_io) {
+        _fd = ::open(filename.c_str(), flags | O_DIRECT, 0600);
+        if (_fd < 0 && errno == EINVAL) {
+            // The file system does not support direct I/O, typically tmpfs.
+            report.warning(u"direct I/O not supported for %s, using system cache", filename);
+        }
+    }
+#endif
+    if (_fd < 0 && (_fd = ::open(filename.c_str(), flags, 0600)) < 0) {
+        report.error(u"cannot create %s: %s", filename, SysErrorCodeMessage());
+        return false;
+    }
+#if defined(F_NOCACHE)
+    if (direct_io && ::fcntl(_fd, F_NOCACHE, 1) < 0) {
+        report.warning(u"cannot disable system cache for %s: %s", filename, SysErrorCodeMessage());
+    }
+#endif
+    // Immediately delete the file. It remains accessible as long as the file is open.
+    ::unlink(filename.c_str());
+
+#endif
+
+    _is_open = true;
+    _terminate = _failed = false;
+    _stalls = 0;
+    return start();
+}
+
+
+//----------------------------------------------------------------------------
+// Stop the I/O thread and close the backup file.
+//----------------------------------------------------------------------------
+
+bool ts::TimeShiftBuffer::AsyncFile::close(Report& report)
+{
+    if (!_is_open) {
+        return false;
+    }
+
+    // Pending I/O are useless since the file is deleted.
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _requests.clear();
+        _terminate = true;
+        _cond.notify_all();
+    }
+    waitForTermination();
+    report.debug(u"time-shift file closed, I/O stalls: %'d", _stalls);
+
+#if defined(TS_WINDOWS)
+    ::CloseHandle(_handle);
+    _handle = INVALID_HANDLE_VALUE;
+#else
+    ::close(_fd);
+    _fd = -1;
+#endif
+    _is_open = false;
+    return !_failed;
+}
+
+
+//----------------------------------------------------------------------------
+// Management of segment buffers.
+//----------------------------------------------------------------------------
+
+bool ts::TimeShiftBuffer::AsyncFile::checkError(Report& report)
+{
+    if (_failed) {
+        report.error(u"error %s time-shift file at segment %d: %s", _failed_write ? u"writing" : u"reading", _failed_segment, SysErrorCodeMessage(_error_code));
+    }
+    return !_failed;
+}
+
+size_t ts::TimeShiftBuffer::AsyncFile::acquire(Report& report)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (bool waited = false;; waited = true) {
+        if (!checkError(report)) {
+            return NPOS;
+        }
+        for (size_t buf = 0; buf < _states.size(); ++buf) {
+            if (_states[buf] == State::FREE) {
+                _states[buf] = State::USED;
+                _stalls += waited;
+                return buf;
+            }
+        }
+        // No free buffer, wait for the completion of a write.
+        _cond.wait(lock);
+    }
+}
+
+void ts::TimeShiftBuffer::AsyncFile::release(size_t buffer)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _states[buffer] = State::FREE;
+}
+
+bool ts::TimeShiftBuffer::AsyncFile::write(size_t buffer, size_t segment, Report& report)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _states[buffer] = State::WRITING;
+    _requests.push_back({true, buffer, segment});
+    _cond.notify_all();
+    return checkError(report);
+}
+
+bool ts::TimeShiftBuffer::AsyncFile::read(size_t buffer, size_t segment, Report& report)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _states[buffer] = State::READING;
+    _requests.push_back({false, buffer, segment});
+    _cond.notify_all();
+    return checkError(report);
+}
+
+bool ts::TimeShiftBuffer::AsyncFile::wait(size_t buffer, Report& report)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_states[buffer] == State::READING && !_failed) {
+        _stalls++;
+        _cond.wait(lock, [this, buffer]() { return _states[buffer] != State::READING || _failed; });
+    }
+    return checkError(report);
+}
+
+
+//----------------------------------------------------------------------------
+// I/O thread.
+//----------------------------------------------------------------------------
+
+void ts::TimeShiftBuffer::AsyncFile::main()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        _cond.wait(lock, [this]() { return !_requests.empty() || _terminate; });
+        if (_terminate) {
+            break;
+        }
+        // Perform the first request without holding the mutex.
+        // The buffer is not accessed by the application while the request is pending.
+        const Request req(_requests.front());
+        lock.unlock();
+        int error_code = 0;
+        const bool success = transfer(req, error_code);
+        lock.lock();
+        if (!success && !_failed) {
+            _failed = true;
+            _failed_write = req.write;
+            _failed_segment = req.segment;
+            _error_code = error_code;
+        }
+        if (!_requests.empty()) {
+            _requests.pop_front();
+        }
+        _states[req.buffer] = req.write ? State::FREE : State::LOADED;
+        _cond.notify_all();
+    }
+}
+
+bool ts::TimeShiftBuffer::AsyncFile::transfer(const Request& req, int& error_code)
+{
+    // Always transfer complete slots, aligned for direct I/O.
+    uint8_t* data = _memory.base() + req.buffer * _slot_size;
+    uint64_t offset = uint64_t(req.segment) * _slot_size;
+    size_t remain = _slot_size;
+
+    while (remain > 0) {
+#if defined(TS_WINDOWS)
+        ::OVERLAPPED position {};
+        position.Offset = ::DWORD(offset & 0xFFFFFFFF);
+        position.OffsetHigh = ::DWORD(offset >> 32);
+        ::DWORD size = 0;
+        const bool ok = req.write ?
+            ::WriteFile(_handle, data, ::DWORD(remain), &size, &position) != 0 :
+            ::ReadFile(_handle, data, ::DWORD(remain), &size, &position) != 0;
+        if (!ok) {
+            error_code = LastSysErrorCode();
+            return false;
+        }
+#else
+        const ssize_t size = req.write ?
+            ::pwrite(_fd, data, remain, off_t(offset)) :
+            ::pread(_fd, data, remain, off_t(offset));
+        if (size < 0 && errno == EINTR) {
+            continue;
+        }
+        else if (size < 0) {
+            error_code = LastSysErrorCode();
+            return false;
+        }
+#endif
+        if (size == 0) {
+            // Unexpected end of file, should not happen since all slots are written before being read.
+            error_code = EIO;
+            return false;
+        }
+        data += size;
+        offset += size;
+        remain -= std::min<size_t>(remain, size);
+    }
+    return true;
+}
 
 
 //----------------------------------------------------------------------------
@@ -63,6 +405,39 @@ bool ts::TimeShiftBuffer::setBackupDirectory(const fs::path& directory)
     }
 }
 
+bool ts::TimeShiftBuffer::setAsyncIO(bool on)
+{
+    if (_is_open) {
+        return false;
+    }
+    else {
+        _async_io = on;
+        return true;
+    }
+}
+
+bool ts::TimeShiftBuffer::setSegmentPackets(size_t count)
+{
+    if (_is_open) {
+        return false;
+    }
+    else {
+        _segment_packets = std::max<size_t>(count, 1);
+        return true;
+    }
+}
+
+bool ts::TimeShiftBuffer::setDirectIO(bool on)
+{
+    if (_is_open) {
+        return false;
+    }
+    else {
+        _direct_io = on;
+        return true;
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Open the buffer.
@@ -84,31 +459,31 @@ bool ts::TimeShiftBuffer::open(Report& report)
     }
     else {
         // The buffer is backed up on disk.
-        // Get the name of a temporary file. If a directory is specified, we will use the base name only.
-        fs::path filename(TempFile());
-        if (!_directory.empty()) {
-            if (fs::is_directory(_directory)) {
-                filename = _directory + fs::path::preferred_separator + filename.filename();
-            }
-            else {
-                report.error(u"directory %s does not exist", _directory);
+        fs::path filename;
+        if (!backupFileName(filename, report)) {
+            return false;
+        }
+        if (_async_io) {
+            // Asynchronous I/O on large segments.
+            if (!openAsync(filename, report)) {
                 return false;
             }
         }
+        else {
+            // Create the backup file. The flag temporary means that it will be deleted on close.
+            // Use TSDuck proprietary format to save the packet metadata.
+            if (!_file.open(filename, TSFile::READ | TSFile::WRITE | TSFile::TEMPORARY, report, TSPacketFormat::DUCK)) {
+                return false;
+            }
 
-        // Create the backup file. The flag temporary means that it will be deleted on close.
-        // Use TSDuck proprietary format to save the packet metadata.
-        if (!_file.open(filename, TSFile::READ | TSFile::WRITE | TSFile::TEMPORARY, report, TSPacketFormat::DUCK)) {
-            return false;
+            // The read and write buffers use half of memory quota each.
+            // Since the size of the file is larger than the sum of the two,
+            // the read and write caches never overlap when the buffer is full.
+            _wcache.resize(_mem_packets / 2);
+            _wmdata.resize(_mem_packets / 2);
+            _rcache.resize(_mem_packets / 2);
+            _rmdata.resize(_mem_packets / 2);
         }
-
-        // The read and write buffers use half of memory quota each.
-        // Since the size of the file is larger than the sum of the two,
-        // the read and write caches never overlap when the buffer is full.
-        _wcache.resize(_mem_packets / 2);
-        _wmdata.resize(_mem_packets / 2);
-        _rcache.resize(_mem_packets / 2);
-        _rmdata.resize(_mem_packets / 2);
     }
 
     _cur_packets = 0;
@@ -119,6 +494,54 @@ bool ts::TimeShiftBuffer::open(Report& report)
 }
 
 
+//----------------------------------------------------------------------------
+// Get the name of the backup file.
+//----------------------------------------------------------------------------
+
+bool ts::TimeShiftBuffer::backupFileName(fs::path& filename, Report& report) const
+{
+    // Get the name of a temporary file. If a directory is specified, we will use the base name only.
+    filename = TempFile();
+    if (!_directory.empty()) {
+        if (fs::is_directory(_directory)) {
+            filename = _directory + fs::path::preferred_separator + filename.filename();
+        }
+        else {
+            report.error(u"directory %s does not exist", _directory);
+            return false;
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Open the backup file with asynchronous I/O.
+//----------------------------------------------------------------------------
+
+bool ts::TimeShiftBuffer::openAsync(const fs::path& filename, Report& report)
+{
+    // There must be at least two segments, so that the next segment to read can be prefetched.
+    // The last segment is shorter when the buffer size is not a multiple of the segment size.
+    _seg_size = std::min(_segment_packets, _total_packets / 2);
+    _seg_count = (_total_packets + _seg_size - 1) / _seg_size;
+    const size_t buffers = std::max(MIN_SEGMENT_BUFFERS, _mem_packets / _seg_size);
+
+    _async = std::make_unique<AsyncFile>(_seg_size, buffers);
+    if (!_async->open(filename, _direct_io, report)) {
+        _async.reset();
+        return false;
+    }
+    report.debug(u"time-shift file: %'d segments of %'d packets, %d buffers", _seg_count, _seg_size, buffers);
+
+    // While the buffer is filling, there is nothing to read. Start writing the first segment.
+    _seg_index = _seg_next = 0;
+    _seg_rbuf = _seg_pbuf = NPOS;
+    _seg_wbuf = _async->acquire(report);
+    return _seg_wbuf != NPOS;
+}
+
+
 //----------------------------------------------------------------------------
 // Close the buffer.
 //----------------------------------------------------------------------------
@@ -135,6 +558,11 @@ bool ts::TimeShiftBuffer::close(Report& report)
     _wmdata.clear();
     _rcache.clear();
     _rmdata.clear();
+    if (_async != nullptr) {
+        const bool success = _async->close(report);
+        _async.reset();
+        return success;
+    }
     return !_file.isOpen() || _file.close(report);
 }
 
@@ -175,6 +603,28 @@ bool ts::TimeShiftBuffer::shift(TSPacket& packet, TSPacketMetadata& mdata, Repor
         _wmdata[_next_write] = mdata;
         _next_write = (_next_write + 1) % _wcache.size();
     }
+    else if (_async != nullptr) {
+        // The buffer uses segments in a backup file with asynchronous I/O.
+        // The packet to read and the packet to write have the same index in the same segment.
+        assert(_seg_wbuf != NPOS);
+        if (was_full) {
+            // Buffer full: return oldest packet.
+            assert(_seg_rbuf != NPOS);
+            ret_packet = _async->packets(_seg_rbuf)[_seg_next];
+            ret_mdata = _async->metadata(_seg_rbuf)[_seg_next];
+        }
+        else {
+            // Buffer not full, increase the packet count.
+            _cur_packets++;
+        }
+        _async->packets(_seg_wbuf)[_seg_next] = packet;
+        _async->metadata(_seg_wbuf)[_seg_next] = mdata;
+        // Switch to next segment at end of current one.
+        const size_t seg_end = std::min(_seg_size, _total_packets - _seg_index * _seg_size);
+        if (++_seg_next >= seg_end && !nextSegment(report)) {
+            return false;
+        }
+    }
     else {
         // The buffer uses a backup file.
         if (!was_full) {
@@ -240,6 +690,51 @@ bool ts::TimeShiftBuffer::shift(TSPacket& packet, TSPacketMetadata& mdata, Repor
 }
 
 
+//----------------------------------------------------------------------------
+// Switch to next segment with asynchronous I/O.
+//----------------------------------------------------------------------------
+
+bool ts::TimeShiftBuffer::nextSegment(Report& report)
+{
+    // Write-behind of the segment which was just filled. The buffer is released after the write.
+    // Since I/O requests are processed in order, a subsequent read of the same segment gets these packets.
+    if (!_async->write(_seg_wbuf, _seg_index, report)) {
+        return false;
+    }
+    _seg_wbuf = NPOS;
+    _seg_next = 0;
+    _seg_index = (_seg_index + 1) % _seg_count;
+
+    if (!full()) {
+        // Still filling the buffer. When starting the last segment, the first one is
+        // already written and can be prefetched for the moment the buffer becomes full.
+        if (_seg_index == _seg_count - 1 && !prefetchSegment(0, report)) {
+            return false;
+        }
+    }
+    else {
+        // Switch to the prefetched segment and prefetch the next one.
+        if (_seg_rbuf != NPOS) {
+            _async->release(_seg_rbuf);
+        }
+        _seg_rbuf = _seg_pbuf;
+        _seg_pbuf = NPOS;
+        if (!_async->wait(_seg_rbuf, report) || !prefetchSegment((_seg_index + 1) % _seg_count, report)) {
+            return false;
+        }
+    }
+
+    _seg_wbuf = _async->acquire(report);
+    return _seg_wbuf != NPOS;
+}
+
+bool ts::TimeShiftBuffer::prefetchSegment(size_t index, Report& report)
+{
+    _seg_pbuf = _async->acquire(report);
+    return _seg_pbuf != NPOS && _async->read(_seg_pbuf, index, report);
+}
+
+
 //----------------------------------------------------------------------------
 // Seek in the backup file.
 //----------------------------------------------------------------------------
@@ -46,6 +46,10 @@ namespace ts {
         //! Default number of cached packets in memory.
         //!
         static constexpr size_t DEFAULT_MEMORY_PACKETS = 128;
+        //!
+        //! Default size in packets of a disk segment with asynchronous I/O.
+        //!
+        static constexpr size_t DEFAULT_SEGMENT_PACKETS = 16384;
 
         //!
         //! Constructor.
@@ -86,6 +90,44 @@ namespace ts {
         //!
         bool setBackupDirectory(const fs::path& directory);
 
+        //!
+        //! Use asynchronous I/O on large segments in the backup file.
+        //! Must be called before open().
+        //!
+        //! By default, the backup file is synchronously read and written by the thread which
+        //! calls shift(), using read and write caches of half the memory packets each.
+        //! With asynchronous I/O, the backup file is divided in large segments. A background
+        //! thread writes the filled segments (write-behind) and reads the next segment to
+        //! play (read-ahead), while shift() only works on memory buffers. The memory packets
+        //! are split in segment buffers, with a minimum of four segments.
+        //!
+        //! @param [in] on True to use asynchronous I/O.
+        //! @return True on success, false if already open.
+        //! @see setSegmentPackets()
+        //!
+        bool setAsyncIO(bool on);
+
+        //!
+        //! Set the size in packets of the disk segments with asynchronous I/O.
+        //! Must be called before open().
+        //! The segment size is reduced to half of the buffer size when necessary.
+        //! @param [in] count Number of packets per segment.
+        //! @return True on success, false if already open.
+        //! @see setAsyncIO()
+        //!
+        bool setSegmentPackets(size_t count);
+
+        //!
+        //! Bypass the system cache when accessing the backup file with asynchronous I/O.
+        //! Must be called before open().
+        //! This is @c O_DIRECT on Linux, @c F_NOCACHE on macOS and @c FILE_FLAG_NO_BUFFERING on Windows.
+        //! When the file system does not support direct I/O, the system cache is used.
+        //! @param [in] on True to use direct I/O.
+        //! @return True on success, false if already open.
+        //! @see setAsyncIO()
+        //!
+        bool setDirectIO(bool on);
+
         //!
         //! Open the buffer.
         //! @param [in,out] report Where to report errors.
@@ -171,6 +213,30 @@ namespace ts {
         TSPacketMetadataVector _wmdata {};  // Packet metadata for _wcache.
         TSPacketMetadataVector _rmdata {};  // Packet metadata for _rcache.
 
+        // Backup file with asynchronous I/O on segments, when setAsyncIO() is used. Defined in implementation.
+        class AsyncFile;
+        bool     _async_io = false;         // Use asynchronous I/O on segments.
+        bool     _direct_io = false;        // Bypass the system cache with asynchronous I/O.
+        size_t   _segment_packets = DEFAULT_SEGMENT_PACKETS; // Requested size of segments.
+        size_t   _seg_size = 0;             // Actual number of packets per segment.
+        size_t   _seg_count = 0;            // Number of segments in the backup file.
+        size_t   _seg_index = 0;            // Index of current segment, for read and write.
+        size_t   _seg_next = 0;             // Index of next packet to read and write in current segment.
+        size_t   _seg_rbuf = NPOS;          // Buffer containing the current segment to read.
+        size_t   _seg_wbuf = NPOS;          // Buffer receiving the current segment to write.
+        size_t   _seg_pbuf = NPOS;          // Buffer receiving the prefetched next segment to read.
+        std::unique_ptr<AsyncFile> _async {};
+
+        // Get the name of the backup file.
+        bool backupFileName(fs::path& filename, Report& report) const;
+
+        // Open the backup file with asynchronous I/O.
+        bool openAsync(const fs::path& filename, Report& report);
+
+        // Switch to next segment with asynchronous I/O.
+        bool nextSegment(Report& report);
+        bool prefetchSegment(size_t index, Report& report);
+
         // Seek, read, write in the backup file.
         bool seekFile(size_t index, Report& report);
         bool writeFile(size_t index, const TSPacket* buffer, const TSPacketMetadata* mdata, size_t count, Report& report);
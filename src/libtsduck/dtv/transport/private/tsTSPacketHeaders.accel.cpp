@@ -0,0 +1,112 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+// Extraction of TS packet headers using vector instructions, when available.
+// This module is compiled with special options to use optional instructions
+// for the target architecture. It may fail when these instructions are not
+// implemented in the current CPU. Consequently, this module shall not be
+// called when these instructions are not implemented.
+//
+// To avoid sharing inline functions with modules which are compiled without
+// these instructions, this module works on raw pointers only.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSPacketHeaders.h"
+#include "tsTSPacketAcceleration.h"
+
+// Check if Intel AVX2 instructions can be used.
+#if defined(__AVX2__) && !defined(TS_NO_AVX2_INSTRUCTIONS)
+    #define TS_AVX2_INSTRUCTIONS 1
+    #include <immintrin.h>
+#endif
+
+// "Hidden" exported bool to inform the TSPacketHeaders class that we have compiled accelerated instructions.
+extern const bool tsTSPacketHeadersIsAccelerated =
+#if defined(TS_AVX2_INSTRUCTIONS)
+    true;
+#else
+    false;
+#endif
+
+// Don't complain about assert(false) when acceleration is not implemented.
+TS_LLVM_NOWARNING(missing-noreturn)
+
+
+//----------------------------------------------------------------------------
+// Some AVX2 helpers.
+//----------------------------------------------------------------------------
+
+#if defined(TS_AVX2_INSTRUCTIONS)
+namespace {
+
+    // Pack two vectors of 8 x 32-bit values into one vector of 16 x 16-bit values, in order.
+    // The 256-bit pack instructions work inside each 128-bit lane, hence the permutation.
+    inline __m256i pack32to16(__m256i a, __m256i b)
+    {
+        return _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0xD8);
+    }
+
+    // Store a vector of 16 x 16-bit values, all below 256, as 16 bytes.
+    inline void store16to8(uint8_t* dest, __m256i a)
+    {
+        const __m256i p = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, a), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), _mm256_castsi256_si128(p));
+    }
+}
+#endif
+
+
+//----------------------------------------------------------------------------
+// Extraction of headers, accelerated version.
+//----------------------------------------------------------------------------
+
+size_t ts::TSPacketHeaders::LoadAccel(const uint8_t* pkt, size_t count, PID* pids, uint8_t* pusi, uint8_t* scrambling, uint8_t* cc)
+{
+#if defined(TS_AVX2_INSTRUCTIONS)
+
+    // The 4-byte header of 8 packets is loaded in one gather instruction.
+    // Since x86 is little endian, the fields of the header are located as follow in each 32-bit word:
+    // PID: bits 8-12 (MSB) and 16-23 (LSB), PUSI: bit 14, CC: bits 24-27, scrambling: bits 30-31.
+    // We process 16 packets per iteration, the remaining packets are left to the portable version.
+
+    static_assert(PKT_SIZE * 16 < 0x7FFFFFFF);
+    const __m256i offsets = _mm256_setr_epi32(0, PKT_SIZE, 2 * PKT_SIZE, 3 * PKT_SIZE, 4 * PKT_SIZE, 5 * PKT_SIZE, 6 * PKT_SIZE, 7 * PKT_SIZE);
+    const __m256i pid_msb_mask = _mm256_set1_epi32(0x00001F00);
+    const __m256i low_byte_mask = _mm256_set1_epi32(0x000000FF);
+    const __m256i pusi_mask = _mm256_set1_epi32(0x00000001);
+    const __m256i cc_mask = _mm256_set1_epi32(0x0000000F);
+
+    size_t done = 0;
+    for (; done + 16 <= count; done += 16, pkt += 16 * PKT_SIZE) {
+
+        const __m256i w0 = _mm256_i32gather_epi32(reinterpret_cast<const int*>(pkt), offsets, 1);
+        const __m256i w1 = _mm256_i32gather_epi32(reinterpret_cast<const int*>(pkt + 8 * PKT_SIZE), offsets, 1);
+
+        const __m256i pid0 = _mm256_or_si256(_mm256_and_si256(w0, pid_msb_mask), _mm256_and_si256(_mm256_srli_epi32(w0, 16), low_byte_mask));
+        const __m256i pid1 = _mm256_or_si256(_mm256_and_si256(w1, pid_msb_mask), _mm256_and_si256(_mm256_srli_epi32(w1, 16), low_byte_mask));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pids + done), pack32to16(pid0, pid1));
+
+        const __m256i pusi0 = _mm256_and_si256(_mm256_srli_epi32(w0, 14), pusi_mask);
+        const __m256i pusi1 = _mm256_and_si256(_mm256_srli_epi32(w1, 14), pusi_mask);
+        store16to8(pusi + done, pack32to16(pusi0, pusi1));
+
+        store16to8(scrambling + done, pack32to16(_mm256_srli_epi32(w0, 30), _mm256_srli_epi32(w1, 30)));
+
+        const __m256i cc0 = _mm256_and_si256(_mm256_srli_epi32(w0, 24), cc_mask);
+        const __m256i cc1 = _mm256_and_si256(_mm256_srli_epi32(w1, 24), cc_mask);
+        store16to8(cc + done, pack32to16(cc0, cc1));
+    }
+    return done;
+
+#else
+    // Shall not be called.
+    assert(false);
+    return 0;
+#endif
+}
@@ -0,0 +1,232 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Direct-indexed table of contexts per PID.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTS.h"
+
+namespace ts {
+    //!
+    //! Direct-indexed table of contexts per PID, with lazy allocation of the contexts.
+    //! @ingroup libtsduck mpeg
+    //!
+    //! This class is a replacement for @c std::map<PID,T> in contexts where a PID context
+    //! is searched for each TS packet. The lookup is a direct indexing in a table of 8192
+    //! entries instead of a search in a binary tree.
+    //!
+    //! The API is a subset of @c std::map<PID,T>: operator[] creates the context when it
+    //! does not exist yet, contains(), erase(), clear(), size(). Iterating over the
+    //! structure returns @c std::pair<const PID,T> elements in increasing order of PID.
+    //!
+    //! The table of 8192 entries is allocated on first insertion. The contexts are allocated
+    //! on demand. The storage of erased contexts is kept in a pool and reused for subsequent
+    //! allocations. The address of a context is stable until it is erased.
+    //!
+    //! @tparam T The type of the context per PID. Must be default-constructible.
+    //!
+    template <typename T>
+    class PIDArray
+    {
+        TS_NOCOPY(PIDArray);
+    public:
+        //!
+        //! Type of the elements, as returned by iterators.
+        //!
+        using value_type = std::pair<const PID, T>;
+
+        //!
+        //! Constructor.
+        //!
+        PIDArray() = default;
+
+        //!
+        //! Destructor.
+        //!
+        ~PIDArray();
+
+        //!
+        //! Get the number of allocated contexts.
+        //! @return The number of allocated contexts.
+        //!
+        size_t size() const { return _count; }
+
+        //!
+        //! Check if there is no allocated context.
+        //! @return True if there is no allocated context.
+        //!
+        bool empty() const { return _count == 0; }
+
+        //!
+        //! Check if the context for a PID exists.
+        //! @param [in] pid The PID to check.
+        //! @return True if the context for @a pid exists.
+        //!
+        bool contains(PID pid) const { return pid < _table.size() && _table[pid] != nullptr; }
+
+        //!
+        //! Get the context of a PID, allocating it when it does not exist yet.
+        //! @param [in] pid The PID to search. Must be lower than PID_MAX.
+        //! @return A reference to the context for @a pid.
+        //!
+        T& operator[](PID pid)
+        {
+            return pid < _table.size() && _table[pid] != nullptr ? _table[pid]->second : allocate(pid);
+        }
+
+        //!
+        //! Erase the context of a PID.
+        //! @param [in] pid The PID to erase.
+        //!
+        void erase(PID pid);
+
+        //!
+        //! Erase all contexts.
+        //!
+        void clear();
+
+        //!
+        //! Iterator over all allocated contexts, in increasing order of PID.
+        //! @tparam CONST When true, this is a const iterator.
+        //!
+        template <bool CONST>
+        class Iterator
+        {
+        public:
+            //! @cond nodoxygen
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = PIDArray::value_type;
+            using pointer = std::conditional_t<CONST, const value_type*, value_type*>;
+            using reference = std::conditional_t<CONST, const value_type&, value_type&>;
+
+            Iterator() = default;
+            reference operator*() const { return *_table[_pid]; }
+            pointer operator->() const { return _table[_pid]; }
+            Iterator& operator++() { _pid = next(_table, _pid + 1); return *this; }
+            Iterator operator++(int) { Iterator it(*this); ++*this; return it; }
+            bool operator==(const Iterator& other) const { return _pid == other._pid; }
+            //! @endcond
+        private:
+            friend class PIDArray;
+            value_type* const* _table = nullptr;
+            size_t _pid = PID_MAX;
+            Iterator(value_type* const* table, size_t pid) : _table(table), _pid(pid) {}
+        };
+
+        //! Iterator over all allocated contexts, in increasing order of PID.
+        using iterator = Iterator<false>;
+        //! Const iterator over all allocated contexts, in increasing order of PID.
+        using const_iterator = Iterator<true>;
+
+        //! Get an iterator to the first allocated context.
+        //! @return An iterator to the first allocated context.
+        iterator begin() { return iterator(data(), next(data(), 0)); }
+
+        //! Get an iterator after the last allocated context.
+        //! @return An iterator after the last allocated context.
+        iterator end() { return iterator(data(), PID_MAX); }
+
+        //! Get a const iterator to the first allocated context.
+        //! @return A const iterator to the first allocated context.
+        const_iterator begin() const { return const_iterator(data(), next(data(), 0)); }
+
+        //! Get a const iterator after the last allocated context.
+        //! @return A const iterator after the last allocated context.
+        const_iterator end() const { return const_iterator(data(), PID_MAX); }
+
+    private:
+        std::vector<value_type*> _table {};  // Context pointer per PID, PID_MAX entries once allocated.
+        std::vector<value_type*> _pool {};   // Storage of erased contexts, for reuse.
+        size_t _count = 0;                    // Number of allocated contexts.
+
+        // Address of the table of pointers, null if not yet allocated.
+        value_type* const* data() const { return _table.empty() ? nullptr : _table.data(); }
+
+        // Allocate the context of a PID.
+        T& allocate(PID pid);
+
+        // Find the index of the next allocated context, starting at pid. Return PID_MAX if there is none.
+        static size_t next(value_type* const* table, size_t pid);
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Template definitions.
+//----------------------------------------------------------------------------
+
+#if !defined(DOXYGEN)
+
+template <typename T>
+ts::PIDArray<T>::~PIDArray()
+{
+    clear();
+    std::allocator<value_type> alloc;
+    for (auto ptr : _pool) {
+        alloc.deallocate(ptr, 1);
+    }
+}
+
+template <typename T>
+T& ts::PIDArray<T>::allocate(PID pid)
+{
+    assert(pid < PID_MAX);
+    if (_table.empty()) {
+        _table.resize(PID_MAX, nullptr);
+    }
+    value_type* ptr = nullptr;
+    if (_pool.empty()) {
+        ptr = std::allocator<value_type>().allocate(1);
+    }
+    else {
+        ptr = _pool.back();
+        _pool.pop_back();
+    }
+    std::construct_at(ptr, std::piecewise_construct, std::forward_as_tuple(pid), std::forward_as_tuple());
+    _table[pid] = ptr;
+    _count++;
+    return ptr->second;
+}
+
+template <typename T>
+void ts::PIDArray<T>::erase(PID pid)
+{
+    if (contains(pid)) {
+        // Clear the entry before destroying the context, in case the destructor accesses this table.
+        value_type* ptr = _table[pid];
+        _table[pid] = nullptr;
+        _count--;
+        std::destroy_at(ptr);
+        _pool.push_back(ptr);
+    }
+}
+
+template <typename T>
+void ts::PIDArray<T>::clear()
+{
+    for (size_t pid = next(data(), 0); _count > 0 && pid < PID_MAX; pid = next(data(), pid + 1)) {
+        erase(PID(pid));
+    }
+}
+
+template <typename T>
+size_t ts::PIDArray<T>::next(value_type* const* table, size_t pid)
+{
+    if (table != nullptr) {
+        while (pid < PID_MAX && table[pid] == nullptr) {
+            pid++;
+        }
+    }
+    return table == nullptr ? PID_MAX : pid;
+}
+
+#endif
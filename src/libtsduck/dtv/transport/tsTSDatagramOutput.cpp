@@ -59,7 +59,8 @@ void ts::TSDatagramOutput::defineArgs(Args& args)
 
         args.option(u"pcr-pid", 0, Args::PIDVAL);
         args.help(u"pcr-pid",
-                  u"With --rtp, specify the PID containing the PCR's which are used as reference for RTP timestamps. "
+                  u"With --rtp or --kernel-pacing, specify the PID containing the PCR's which are used as reference "
+                  u"for RTP timestamps or launch times. "
                   u"By default, use the first PID containing PCR's.");
 
         args.option(u"start-sequence-number", 0, Args::UINT16);
@@ -112,6 +113,22 @@ void ts::TSDatagramOutput::defineArgs(Args& args)
                   u"declared, this option may transport multicast IP packets in unicast Ethernet frames "
                   u"to the gateway, preventing multicast reception on the local network (seen on Linux).");
 
+        args.option(u"kernel-pacing");
+        args.help(u"kernel-pacing",
+                  u"Let the kernel pace the transmission of datagrams (Linux only). "
+                  u"Each datagram is submitted with a launch time (socket option SO_TXTIME) which is computed from "
+                  u"the PCR's of the reference PID or from the bitrate. The plugin thread no longer waits between datagrams. "
+                  u"The network interface shall use the fq queuing discipline, for instance using the command "
+                  u"'tc qdisc replace dev <interface> root fq'. "
+                  u"With this option, it is not necessary to use the plugin regulate before this plugin.");
+
+        args.option<BitRate>(u"max-pacing-rate");
+        args.help(u"max-pacing-rate",
+                  u"Specify the maximum transmission bitrate in the kernel (socket option SO_MAX_PACING_RATE, Linux only). "
+                  u"The network interface shall use the fq queuing discipline. "
+                  u"This option can be used alone, to smooth the transmission of bursts of datagrams, "
+                  u"or with --kernel-pacing, to limit the output bitrate after late datagrams.");
+
         args.option(u"local-address", 'l', Args::IPADDR);
         args.help(u"local-address",
                   u"When the destination is a multicast address, specify the IP address "
@@ -166,6 +183,8 @@ bool ts::TSDatagramOutput::loadArgs(DuckContext& duck, Args& args)
         args.getIntValue(_send_bufsize, u"buffer-size", 0);
         _mc_loopback = !args.present(u"disable-multicast-loop");
         _force_mc_local = args.present(u"force-local-multicast-outgoing");
+        _kernel_pacing = args.present(u"kernel-pacing");
+        args.getValue(_max_pacing_rate, u"max-pacing-rate", 0);
     }
 
     if (bool(_flags & TSDatagramOutputOptions::ALLOW_RS204)) {
@@ -229,7 +248,9 @@ bool ts::TSDatagramOutput::open(Report& report)
             (_force_mc_local && _destination.isMulticast() && _local_addr.hasAddress() && !_sock.setOutgoingMulticast(_local_addr, report)) ||
             (_send_bufsize > 0 && !_sock.setSendBufferSize(_send_bufsize, report)) ||
             (_tos >= 0 && !_sock.setTOS(_tos, report)) ||
-            (_ttl > 0 && !_sock.setTTL(_ttl, report)))
+            (_ttl > 0 && !_sock.setTTL(_ttl, report)) ||
+            (_kernel_pacing && !_sock.setTransmitTime(true, report)) ||
+            (_max_pacing_rate > 0 && !_sock.setMaxPacingRate((_max_pacing_rate / 8).toInt(), report)))
         {
             _sock.close(report);
             return false;
@@ -243,6 +264,9 @@ bool ts::TSDatagramOutput::open(Report& report)
     _last_rtp_pcr_pkt = 0;
     _rtp_pcr_offset = 0;
     _pkt_count = 0;
+    _scheduler.setReport(&report);
+    _scheduler.setReferencePID(_pcr_user_pid);
+    _scheduler.reset();
 
     _is_open = true;
     return true;
@@ -353,6 +377,33 @@ bool ts::TSDatagramOutput::send(const TSPacket* pkt, const TSPacketMetadata* met
         }
     }
 
+    // In raw UDP mode without RTP header or RS204 trailer, the TS packets are directly sent
+    // from the global buffer. Send all complete bursts at once, with less system calls.
+    while (_output == this && !_use_rtp && !_rs204_format && packet_count >= 2 * _pkt_burst) {
+        size_t count = _pkt_burst * (packet_count / _pkt_burst);
+        if (_kernel_pacing) {
+            // Compute the launch time of each datagram. Do not send too many datagrams at
+            // once, to avoid queueing datagrams too far in advance in the kernel.
+            count = std::min(count, _pkt_burst * MAX_PACING_DATAGRAMS / 2);
+            const size_t dg_count = count / _pkt_burst;
+            const monotonic_time now = monotonic_time::clock::now();
+            _launch_times.resize(dg_count);
+            for (size_t i = 0; i < dg_count; ++i) {
+                _launch_times[i] = _scheduler.launchTime(pkt + i * _pkt_burst, _pkt_burst, bitrate, now);
+            }
+            limitLead(_launch_times.back(), bitrate);
+        }
+        if (!_sock.sendSegmentsAt(pkt, count * PKT_SIZE, _pkt_burst * PKT_SIZE, _kernel_pacing ? _launch_times.data() : nullptr, report)) {
+            return false;
+        }
+        if (metadata != nullptr) {
+            metadata += count;
+        }
+        pkt += count;
+        packet_count -= count;
+        _pkt_count += count;
+    }
+
     // Send subsequent packets from the global buffer.
     while (packet_count >= min_burst) {
         size_t count = std::min(packet_count, _pkt_burst);
@@ -382,6 +433,12 @@ bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, const TSPacketMetada
 {
     bool status = true;
 
+    // With --kernel-pacing, the launch time of the datagram is used by sendDatagram().
+    if (_kernel_pacing && _raw_udp) {
+        _launch_time = _scheduler.launchTime(pkt, packet_count, bitrate);
+        limitLead(_launch_time, bitrate);
+    }
+
     if (_use_rtp) {
         // RTP datagram are relatively trivial to build, except the time stamp.
         // We cannot use the wall clock time because the plugin is likely to burst its output.
@@ -503,5 +560,25 @@ bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, const TSPacketMetada
 
 bool ts::TSDatagramOutput::sendDatagram(const void* address, size_t size, Report& report)
 {
-    return _sock.send(address, size, report);
+    return _kernel_pacing ? _sock.sendAt(address, size, _launch_time, report) : _sock.send(address, size, report);
+}
+
+
+//----------------------------------------------------------------------------
+// With --kernel-pacing, wait when a launch time is too far ahead.
+//----------------------------------------------------------------------------
+
+void ts::TSDatagramOutput::limitLead(monotonic_time launch_time, const BitRate& bitrate)
+{
+    // Maximum lead: MAX_PACING_LEAD or MAX_PACING_DATAGRAMS, whichever comes first.
+    cn::nanoseconds max_lead = MAX_PACING_LEAD;
+    const BitRate rate = bitrate > 0 ? bitrate : _scheduler.pcrBitRate();
+    if (rate > 0) {
+        max_lead = std::min(max_lead, PacketInterval<cn::nanoseconds>(rate, MAX_PACING_DATAGRAMS * _pkt_burst));
+    }
+
+    // When waiting, wait until half of the maximum lead to avoid waiting for each datagram.
+    if (launch_time > monotonic_time::clock::now() + max_lead) {
+        std::this_thread::sleep_until(launch_time - max_lead / 2);
+    }
 }
@@ -16,6 +16,7 @@
 #include "tsTSPacket.h"
 #include "tsTSPacketMetadata.h"
 #include "tsUDPSocket.h"
+#include "tsLaunchTimeScheduler.h"
 #include "tsIPProtocols.h"
 #include "tsEnumUtils.h"
 
@@ -144,6 +145,8 @@ namespace ts {
         bool            _mc_loopback = true;         // Multicast loopback option
         bool            _force_mc_local = false;     // Force multicast outgoing local interface
         size_t          _send_bufsize = 0;           // Socket send buffer size.
+        bool            _kernel_pacing = false;      // Let the kernel pace the datagrams using launch times.
+        BitRate         _max_pacing_rate = 0;        // Maximum pacing rate in the kernel.
 
         // Working data.
         bool            _is_open = false;            // Currently in progress
@@ -159,6 +162,9 @@ namespace ts {
         TSPacketVector  _out_buffer {};              // Buffered packets for output with --enforce-burst
         TSPacketMetadataVector _out_buffer_rs {};    // Buffered RS trailers with --enforce-burst --rs204
         UDPSocket       _sock {};                    // Outgoing socket for raw UDP
+        LaunchTimeScheduler _scheduler {};           // Launch times of datagrams with --kernel-pacing
+        monotonic_time  _launch_time {};             // Launch time of next datagram with --kernel-pacing
+        std::vector<monotonic_time> _launch_times {}; // Launch times of a batch of datagrams with --kernel-pacing
 
         // Implementation of TSDatagramOutputHandlerInterface.
         // The object is its own handler in case of raw UDP output.
@@ -172,5 +178,13 @@ namespace ts {
 
         // Send contiguous packets in one single datagram.
         bool sendPackets(const TSPacket* packet, const TSPacketMetadata* metadata, size_t count, const BitRate& bitrate, Report& report);
+
+        // With --kernel-pacing, wait when a launch time is too far ahead.
+        void limitLead(monotonic_time launch_time, const BitRate& bitrate);
+
+        // With --kernel-pacing, do not queue datagrams too far in advance in the kernel.
+        // By default, the fq queuing discipline drops the datagrams of a flow above 100 queued datagrams.
+        static constexpr cn::milliseconds MAX_PACING_LEAD = cn::milliseconds(40);
+        static constexpr size_t MAX_PACING_DATAGRAMS = 64;
     };
 }
@@ -10,6 +10,8 @@
 #include "tsTSPacketMetadata.h"
 #include "tsNullReport.h"
 #include "tsSysUtils.h"
+#include "tsThread.h"
+#include "tsByteBlock.h"
 
 #if defined(TS_WINDOWS)
     #include "tsBeforeStandardHeaders.h"
@@ -19,11 +21,193 @@
     #include "tsBeforeStandardHeaders.h"
     #include <sys/types.h>
     #include <sys/stat.h>
+    #include <sys/mman.h>
     #include <unistd.h>
     #include "tsAfterStandardHeaders.h"
 #endif
 
 
+//----------------------------------------------------------------------------
+// Asynchronous writer thread.
+//----------------------------------------------------------------------------
+
+class ts::TSFile::AsyncWriter : private Thread
+{
+    TS_NOBUILD_NOCOPY(AsyncWriter);
+public:
+    // Constructor and destructor.
+    AsyncWriter(SysHandle handle, size_t queue_depth, size_t buffer_size);
+    virtual ~AsyncWriter() override;
+
+    // Enqueue data to write. Return false on previous write error.
+    bool write(const void* addr, size_t size, int& error_code);
+
+    // Wait for all enqueued data to be written. Return false on write error.
+    bool flush(int& error_code);
+
+    // Abort all pending and subsequent writes and close the file handle.
+    // When a write is in progress, the handle is closed by the thread after the write.
+    void abortAndClose();
+
+private:
+    const SysHandle         _handle;
+    std::vector<ByteBlock>  _buffers;            // Circular queue of buffers.
+    std::vector<size_t>     _sizes;              // Size of data in each buffer.
+    size_t                  _fill = 0;           // Index of the buffer which is filled by the application.
+    size_t                  _fill_size = 0;      // Size of data in the buffer which is filled by the application.
+    std::mutex              _mutex {};           // Protect all fields below.
+    std::condition_variable _cond {};            // Signaled when a buffer is submitted or released.
+    size_t                  _head = 0;           // Index of first buffer to write.
+    size_t                  _pending = 0;        // Number of buffers to write, starting at _head.
+    bool                    _writing = false;    // The thread is currently writing a buffer.
+    bool                    _close = false;      // The thread shall close the handle after the current write.
+    bool                    _terminate = false;  // Request to terminate the thread.
+    bool                    _aborted = false;    // All writes are aborted.
+    bool                    _failed = false;     // A write error occured.
+    int                     _error_code = 0;     // Last write error code.
+
+    // Submit the buffer which is filled by the application and wait for the next one.
+    bool submit(std::unique_lock<std::mutex>& lock, int& error_code);
+
+    // Close the file handle, ignore errors.
+    void closeHandle();
+
+    // Implementation of Thread.
+    virtual void main() override;
+};
+
+ts::TSFile::AsyncWriter::AsyncWriter(SysHandle handle, size_t queue_depth, size_t buffer_size) :
+    _handle(handle),
+    _buffers(std::max<size_t>(queue_depth, 2), ByteBlock(std::max<size_t>(buffer_size, PKT_SIZE))),
+    _sizes(_buffers.size(), 0)
+{
+    start();
+}
+
+ts::TSFile::AsyncWriter::~AsyncWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _terminate = true;
+        _cond.notify_all();
+    }
+    waitForTermination();
+}
+
+bool ts::TSFile::AsyncWriter::write(const void* addr, size_t size, int& error_code)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(addr);
+    while (size > 0) {
+        // The buffer which is filled is owned by the application, no need to lock.
+        ByteBlock& buf(_buffers[_fill]);
+        const size_t chunk = std::min(size, buf.size() - _fill_size);
+        MemCopy(buf.data() + _fill_size, data, chunk);
+        _fill_size += chunk;
+        data += chunk;
+        size -= chunk;
+        if (_fill_size == buf.size()) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (!submit(lock, error_code)) {
+                return false;
+            }
+        }
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    error_code = _error_code;
+    return !_failed && !_aborted;
+}
+
+bool ts::TSFile::AsyncWriter::flush(int& error_code)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_fill_size > 0 && !submit(lock, error_code)) {
+        return false;
+    }
+    _cond.wait(lock, [this]() { return _pending == 0 || _aborted; });
+    error_code = _error_code;
+    return !_failed && !_aborted;
+}
+
+void ts::TSFile::AsyncWriter::abortAndClose()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _aborted = true;
+    // The thread does not start a new write once aborted. If a write is in progress,
+    // the handle cannot be closed under its feet, the thread will close it later.
+    if (_writing) {
+        _close = true;
+    }
+    else {
+        closeHandle();
+    }
+    _cond.notify_all();
+}
+
+void ts::TSFile::AsyncWriter::closeHandle()
+{
+#if defined(TS_WINDOWS)
+    ::CloseHandle(_handle);
+#else
+    ::close(_handle);
+#endif
+}
+
+bool ts::TSFile::AsyncWriter::submit(std::unique_lock<std::mutex>& lock, int& error_code)
+{
+    _sizes[_fill] = _fill_size;
+    _fill = (_fill + 1) % _buffers.size();
+    _fill_size = 0;
+    _pending++;
+    _cond.notify_all();
+    // Wait until the next buffer is available.
+    _cond.wait(lock, [this]() { return _pending < _buffers.size() || _failed || _aborted; });
+    error_code = _error_code;
+    return !_failed && !_aborted;
+}
+
+void ts::TSFile::AsyncWriter::main()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        _cond.wait(lock, [this]() { return _pending > 0 || _terminate || _aborted; });
+        if (_aborted || _failed) {
+            // Drop all pending buffers.
+            _pending = 0;
+            _cond.notify_all();
+        }
+        if (_pending == 0) {
+            if (_terminate || _aborted) {
+                break;
+            }
+            continue;
+        }
+        // Write the first pending buffer without holding the mutex.
+        // The buffer remains owned by this thread until it is released.
+        const ByteBlock& buf(_buffers[_head]);
+        const size_t size = _sizes[_head];
+        _writing = true;
+        lock.unlock();
+        size_t written = 0;
+        int error_code = 0;
+        const bool success = WriteSystem(_handle, buf.data(), size, written, error_code);
+        lock.lock();
+        _writing = false;
+        if (_close) {
+            // The file was aborted during the write.
+            _close = false;
+            closeHandle();
+        }
+        if (!success) {
+            _failed = true;
+            _error_code = error_code;
+        }
+        _head = (_head + 1) % _buffers.size();
+        _pending--;
+        _cond.notify_all();
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Constructors and destructors.
 //----------------------------------------------------------------------------
@@ -51,14 +235,23 @@ ts::TSFile::TSFile(TSFile&& other) noexcept :
     _rewindable(other._rewindable),
     _regular(other._regular),
     _std_inout(other._std_inout),
+    _use_mmap(other._use_mmap),
+    _map_base(other._map_base),
+    _map_size(other._map_size),
+    _map_pos(other._map_pos),
+    _write_queue(other._write_queue),
+    _write_buffer_size(other._write_buffer_size),
 #if defined(TS_WINDOWS)
-    _handle(other._handle)
+    _handle(other._handle),
 #else
-    _fd(other._fd)
+    _fd(other._fd),
 #endif
+    _writer(std::move(other._writer))
 {
     // Mark other object as closed, just in case.
     other._is_open = false;
+    other._map_base = nullptr;
+    other._map_size = other._map_pos = 0;
 #if defined(TS_WINDOWS)
     other._handle = INVALID_HANDLE_VALUE;
 #else
@@ -106,6 +299,17 @@ void ts::TSFile::setStuffing(size_t initial, size_t final)
 }
 
 
+//----------------------------------------------------------------------------
+// Set the asynchronous write queue.
+//----------------------------------------------------------------------------
+
+void ts::TSFile::setWriteQueue(size_t queue_depth, size_t buffer_size)
+{
+    _write_queue = queue_depth;
+    _write_buffer_size = buffer_size;
+}
+
+
 //----------------------------------------------------------------------------
 // Open file for read in a rewindable mode.
 //----------------------------------------------------------------------------
@@ -308,6 +512,7 @@ bool ts::TSFile::openInternal(bool reopen, Report& report)
 
     // Close first if this is a reopen.
     if (reopen) {
+        unmapFile();
         ::close(_fd);
         _fd = -1;
     }
@@ -379,8 +584,22 @@ bool ts::TSFile::openInternal(bool reopen, Report& report)
         return false;
     }
 
+    // Map read-only regular files in memory when requested.
+    if (_use_mmap && read_only && _regular) {
+        mapFile(uint64_t(st.st_size), report);
+    }
+
 #endif
 
+    // Start the asynchronous writer thread when requested.
+    if (write_access && !read_access && _write_queue > 0 && _writer == nullptr) {
+#if defined(TS_WINDOWS)
+        _writer = std::make_unique<AsyncWriter>(_handle, _write_queue, _write_buffer_size);
+#else
+        _writer = std::make_unique<AsyncWriter>(_fd, _write_queue, _write_buffer_size);
+#endif
+    }
+
     // Reset counters only if not a reopen.
     if (!reopen) {
         _total_read = _total_write = 0;
@@ -401,6 +620,49 @@ bool ts::TSFile::openInternal(bool reopen, Report& report)
 }
 
 
+//----------------------------------------------------------------------------
+// Map or unmap the file in memory.
+//----------------------------------------------------------------------------
+
+void ts::TSFile::mapFile(uint64_t file_size, Report& report)
+{
+#if !defined(TS_WINDOWS)
+    // Empty files cannot be mapped. Files larger than the address space are read normally.
+    if (file_size == 0 || file_size > uint64_t(std::numeric_limits<size_t>::max())) {
+        return;
+    }
+    void* base = ::mmap(nullptr, size_t(file_size), PROT_READ, MAP_PRIVATE, _fd, 0);
+    if (base == MAP_FAILED) {
+        report.debug(u"cannot map %s in memory, using normal read: %s", getDisplayFileName(), SysErrorCodeMessage());
+        return;
+    }
+    ::madvise(base, size_t(file_size), MADV_SEQUENTIAL);
+    _map_base = reinterpret_cast<const uint8_t*>(base);
+    _map_size = size_t(file_size);
+    _map_pos = size_t(std::min<uint64_t>(_start_offset, file_size));
+
+    // With auto-detection, a memory-mapped file starting with two TS packets is a plain TS file.
+    // This is a fast path which enables the direct access to packets in the mapped memory.
+    const uint8_t* data = _map_base + _map_pos;
+    const size_t size = _map_size - _map_pos;
+    if (packetFormat() == TSPacketFormat::AUTODETECT && size >= PKT_SIZE && data[0] == SYNC_BYTE && (size == PKT_SIZE || data[PKT_SIZE] == SYNC_BYTE)) {
+        resetPacketStream(TSPacketFormat::TS, this, this);
+    }
+#endif
+}
+
+void ts::TSFile::unmapFile()
+{
+#if !defined(TS_WINDOWS)
+    if (_map_base != nullptr) {
+        ::munmap(const_cast<uint8_t*>(_map_base), _map_size);
+    }
+#endif
+    _map_base = nullptr;
+    _map_size = _map_pos = 0;
+}
+
+
 //----------------------------------------------------------------------------
 // Internal seek check. Return true when seeking is not required or possible.
 // Return false if seeking is required but not possible.
@@ -432,13 +694,33 @@ bool ts::TSFile::seekCheck(Report& report)
 
 bool ts::TSFile::seekInternal(uint64_t index, Report& report)
 {
+    // With asynchronous writes, all pending buffers must be written before moving the file pointer.
+    if (_writer != nullptr) {
+        int error_code = 0;
+        if (!_writer->flush(error_code)) {
+            if (error_code != 0) {
+                report.log(_severity, u"error writing %s: %s", getDisplayFileName(), SysErrorCodeMessage(error_code));
+            }
+            return false;
+        }
+    }
+
     // If seeking at the beginning and REOPEN is set, close and reopen the file.
     if (index == 0 && (_flags & REOPEN) != 0) {
+        // The writer thread, if any, is restarted on the new file handle.
+        _writer.reset();
         return openInternal(true, report);
     }
 
     report.debug(u"seeking %s at offset %'d", _filename, _start_offset + index);
 
+    // A memory-mapped file is just repositioned in memory.
+    if (_map_base != nullptr) {
+        _map_pos = size_t(std::min<uint64_t>(_start_offset + index, _map_size));
+        _at_eof = false;
+        return true;
+    }
+
 #if defined(TS_WINDOWS)
     // In Win32, LARGE_INTEGER is a 64-bit structure, not an integer type
     uint64_t where = _start_offset + index;
@@ -493,6 +775,19 @@ bool ts::TSFile::close(Report& report)
         writeStuffing(_close_null, report);
     }
 
+    // Wait for the completion of all asynchronous writes.
+    bool success = true;
+    if (_writer != nullptr) {
+        int error_code = 0;
+        success = _writer->flush(error_code);
+        if (!success && error_code != 0) {
+            report.log(_severity, u"error writing %s: %s", getDisplayFileName(), SysErrorCodeMessage(error_code));
+        }
+        _writer.reset();
+    }
+
+    unmapFile();
+
     if (!_std_inout) {
 #if defined(TS_WINDOWS)
         ::CloseHandle(_handle);
@@ -508,7 +803,7 @@ bool ts::TSFile::close(Report& report)
     _filename.clear();
     _std_inout = false;
 
-    return true;
+    return success;
 }
 
 
@@ -537,6 +832,14 @@ bool ts::TSFile::readStreamPartial(void* buffer, size_t request_size, size_t& re
         // Trivial case, successfully read zero bytes.
         return true;
     }
+    if (_map_base != nullptr) {
+        // Memory-mapped file.
+        read_size = std::min(request_size, _map_size - _map_pos);
+        MemCopy(buffer, _map_base + _map_pos, read_size);
+        _map_pos += read_size;
+        _at_eof = read_size == 0;
+        return read_size > 0;
+    }
 
 #if defined(TS_WINDOWS)
 
@@ -649,12 +952,48 @@ size_t ts::TSFile::readPackets(TSPacket* buffer, TSPacketMetadata* metadata, siz
 
 
 //----------------------------------------------------------------------------
-// Implementation of AbstractWriteStreamInterface
+// Get a direct access to the next TS packets in a memory-mapped file.
 //----------------------------------------------------------------------------
 
-bool ts::TSFile::writeStream(const void* buffer, size_t data_size, size_t& written_size, Report& report)
+size_t ts::TSFile::readMappedPackets(const TSPacket*& packets, size_t max_packets, Report& report)
+{
+    packets = nullptr;
+
+    if (!_is_open) {
+        report.log(_severity, u"not open");
+        return 0;
+    }
+    else if (_map_base == nullptr || packetFormat() != TSPacketFormat::TS) {
+        report.log(_severity, u"no direct access to packets in %s", getDisplayFileName());
+        return 0;
+    }
+
+    while (max_packets > 0 && !_at_eof) {
+        const size_t count = std::min(max_packets, (_map_size - _map_pos) / PKT_SIZE);
+        if (count > 0) {
+            packets = reinterpret_cast<const TSPacket*>(_map_base + _map_pos);
+            _map_pos += count * PKT_SIZE;
+            _total_read += count;
+            return count;
+        }
+        // End of file, ignore a truncated last packet. Rewind if the file is repeated.
+        _at_eof = true;
+        if ((_repeat == 0 || ++_counter < _repeat) && !seekInternal(0, report)) {
+            break;
+        }
+    }
+    return 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Write data to a system file.
+//----------------------------------------------------------------------------
+
+bool ts::TSFile::WriteSystem(SysHandle handle, const void* buffer, size_t data_size, size_t& written_size, int& error_code)
 {
     written_size = 0;
+    error_code = 0;
 
 #if defined(TS_WINDOWS)
 
@@ -666,7 +1005,7 @@ bool ts::TSFile::writeStream(const void* buffer, size_t data_size, size_t& writt
 
     // Loop on write until everything is gone
     while (remain > 0) {
-        if (::WriteFile(_handle, data, remain, &outsize, nullptr) != 0)  {
+        if (::WriteFile(handle, data, remain, &outsize, nullptr) != 0)  {
             // Normal case, some data were written
             outsize = std::min(outsize, remain);
             data += outsize;
@@ -682,7 +1021,7 @@ bool ts::TSFile::writeStream(const void* buffer, size_t data_size, size_t& writt
         }
         else {
             // Write error
-            report.log(_severity, u"error writing %s: %s", getDisplayFileName(), SysErrorCodeMessage(errcode));
+            error_code = int(errcode);
             return false;
         }
     }
@@ -697,7 +1036,7 @@ bool ts::TSFile::writeStream(const void* buffer, size_t data_size, size_t& writt
 
     // Loop on write until everything is gone
     while (remain > 0) {
-        outsize = ::write(_fd, data, remain);
+        outsize = ::write(handle, data, remain);
         if (outsize > 0) {
             // Normal case, some data were written
             outsize = std::min<ssize_t>(outsize, remain);
@@ -708,7 +1047,7 @@ bool ts::TSFile::writeStream(const void* buffer, size_t data_size, size_t& writt
         else if (errno != EINTR) {
             // Actual error (not an interrupt). Don't report error on broken pipe.
             if (errno != EPIPE) {
-                report.log(_severity, u"error writing %s: %s", getDisplayFileName(), SysErrorCodeMessage());
+                error_code = errno;
             }
             return false;
         }
@@ -719,6 +1058,35 @@ bool ts::TSFile::writeStream(const void* buffer, size_t data_size, size_t& writt
 }
 
 
+//----------------------------------------------------------------------------
+// Implementation of AbstractWriteStreamInterface
+//----------------------------------------------------------------------------
+
+bool ts::TSFile::writeStream(const void* buffer, size_t data_size, size_t& written_size, Report& report)
+{
+    int error_code = 0;
+    bool success = false;
+
+    if (_writer != nullptr) {
+        // Asynchronous write, the reported error may come from a previous write.
+        success = _writer->write(buffer, data_size, error_code);
+        written_size = success ? data_size : 0;
+    }
+    else {
+#if defined(TS_WINDOWS)
+        success = WriteSystem(_handle, buffer, data_size, written_size, error_code);
+#else
+        success = WriteSystem(_fd, buffer, data_size, written_size, error_code);
+#endif
+    }
+
+    if (!success && error_code != 0) {
+        report.log(_severity, u"error writing %s: %s", getDisplayFileName(), SysErrorCodeMessage(error_code));
+    }
+    return success;
+}
+
+
 //----------------------------------------------------------------------------
 // Read/write artificial stuffing.
 //----------------------------------------------------------------------------
@@ -758,12 +1126,20 @@ void ts::TSFile::abort()
         _aborted = true;
         _at_eof = true;
 
-        // Close pipe handle, ignore errors.
+        // Close pipe handle, ignore errors. With asynchronous writes, drop pending
+        // buffers and let the writer thread close the handle when it is not writing.
+        if (_writer != nullptr) {
+            _writer->abortAndClose();
+        }
 #if defined(TS_WINDOWS)
-        ::CloseHandle(_handle);
+        else {
+            ::CloseHandle(_handle);
+        }
         _handle = INVALID_HANDLE_VALUE;
 #else // UNIX
-        ::close(_fd);
+        else {
+            ::close(_fd);
+        }
         _fd = -1;
 #endif
     }
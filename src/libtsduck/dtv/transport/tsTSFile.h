@@ -151,6 +151,64 @@ namespace ts {
         //!
         void setStuffing(size_t initial, size_t final);
 
+        //!
+        //! Read input files through memory mapping.
+        //! This method shall be called before opening the file.
+        //! When a regular file is opened in read-only mode, the file is mapped in memory and the
+        //! data are read from the mapped memory instead of using read system calls. Packets which
+        //! are appended to the file after opening it are not seen. Memory mapping is silently
+        //! ignored on Windows, on non-regular files and when the file cannot be mapped.
+        //! Warning: the file must not be truncated by another process while it is mapped.
+        //! Accessing the removed part of the mapped memory raises a SIGBUS signal which
+        //! terminates the application.
+        //! @param [in] on True to use memory mapping when possible.
+        //! @see readMappedPackets()
+        //!
+        void setMemoryMapping(bool on) { _use_mmap = on; }
+
+        //!
+        //! Check if the file is currently mapped in memory.
+        //! @return True if the file is currently mapped in memory.
+        //! @see setMemoryMapping()
+        //!
+        bool isMemoryMapped() const { return _map_base != nullptr; }
+
+        //!
+        //! Get a direct access to the next TS packets in a memory-mapped file, without copy.
+        //! This is possible only when the file is mapped in memory and the file format is
+        //! plain TS, without header or trailer. File repetitions are applied as with
+        //! readPackets() but the artificial stuffing from setStuffing() is not returned.
+        //! The returned packets are read-only and remain valid until the file is closed.
+        //! If the file is truncated while mapped, accessing the returned packets beyond
+        //! the new end of file raises a SIGBUS signal.
+        //! @param [out] packets Address of the first returned packet in the mapped memory.
+        //! @param [in] max_packets Maximum number of packets to return.
+        //! @param [in,out] report Where to report errors.
+        //! @return The number of returned packets. Zero on end of file or error.
+        //!
+        size_t readMappedPackets(const TSPacket*& packets, size_t max_packets, Report& report);
+
+        //!
+        //! Write output files asynchronously.
+        //! This method shall be called before opening the file. Written packets are
+        //! accumulated into a queue of buffers which are written to the file by an
+        //! internal thread. The application only waits when all buffers are in use.
+        //! Since the actual I/O is delayed, write errors are reported by a subsequent
+        //! write or by close(). Closing the file or seeking waits for all pending buffers.
+        //! This is ignored on files which are opened for both read and write.
+        //! @param [in] queue_depth Number of buffers in the queue. Zero means synchronous
+        //! write (the default). The value 1 is the same as 2, the minimum to overlap the
+        //! application with the file I/O.
+        //! @param [in] buffer_size Size in bytes of each buffer.
+        //!
+        void setWriteQueue(size_t queue_depth, size_t buffer_size = DEFAULT_WRITE_BUFFER_SIZE);
+
+        //!
+        //! Default size in bytes of each buffer in the asynchronous write queue.
+        //! @see setWriteQueue()
+        //!
+        static constexpr size_t DEFAULT_WRITE_BUFFER_SIZE = 4096 * PKT_SIZE;
+
         //!
         //! Abort any currenly read/write operation in progress.
         //! The file is left in a broken state and can be only closed.
@@ -197,12 +255,24 @@ namespace ts {
         bool          _rewindable = false;   //!< Opened in rewindable mode
         bool          _regular = false;      //!< Is a regular file (ie. not a pipe or special device)
         bool          _std_inout = false;    //!< File is standard input or output.
+        bool          _use_mmap = false;     //!< Use memory mapping on input files.
+        const uint8_t* _map_base = nullptr;  //!< Base address of the memory-mapped file.
+        size_t        _map_size = 0;         //!< Size of the memory-mapped file.
+        size_t        _map_pos = 0;          //!< Current read position in the memory-mapped file.
+        size_t        _write_queue = 0;      //!< Number of buffers in the asynchronous write queue.
+        size_t        _write_buffer_size = DEFAULT_WRITE_BUFFER_SIZE; //!< Size of each buffer in the write queue.
 #if defined(TS_WINDOWS)
         ::HANDLE      _handle = INVALID_HANDLE_VALUE;
+        using SysHandle = ::HANDLE;
 #else
         int           _fd = -1;
+        using SysHandle = int;
 #endif
 
+        // Asynchronous writer thread, when setWriteQueue() is used. Defined in implementation.
+        class AsyncWriter;
+        std::unique_ptr<AsyncWriter> _writer {};
+
         // Implementation of AbstractReadStreamInterface
         virtual bool endOfStream() override;
         virtual bool readStreamPartial(void* addr, size_t max_size, size_t& ret_size, Report& report) override;
@@ -214,8 +284,13 @@ namespace ts {
         void readStuffing(TSPacket*& buffer, TSPacketMetadata*& metadata, size_t count, Report& report);
         bool writeStuffing(size_t count, Report& report);
 
+        // Write data to a system file. Return false on error, with a zero error code on broken pipe.
+        static bool WriteSystem(SysHandle handle, const void* addr, size_t size, size_t& written_size, int& error_code);
+
         // Internal methods
         bool openInternal(bool reopen, Report& report);
+        void mapFile(uint64_t file_size, Report& report);
+        void unmapFile();
         bool seekCheck(Report& report);
         bool seekInternal(uint64_t index, Report& report);
 
@@ -84,6 +84,7 @@ namespace ts {
         volatile bool       _aborted = true;          // Set when abortInput() is set.
         bool                _interleave = false;      // Read all files simultaneously with interleaving.
         bool                _first_terminate = false; // With _interleave, terminate when the first file terminates.
+        bool                _memory_map = false;      // Map input files in memory.
         size_t              _interleave_chunk = 0;    // Number of packets per chunk when _interleave.
         size_t              _interleave_remain = 0;   // Remaining packets to read in current chunk of current file.
         size_t              _current_filename = 0;    // Current file index in _filenames.
@@ -92,6 +92,14 @@ void ts::TSFileOutputArgs::defineArgs(Args& args)
               u"Then, the integer part is incremented. "
               u"Example: if the specified file name is foo-027.ts, the various files are named foo-027.ts, foo-028.ts, etc.\n\n"
               u"The options --max-duration and --max-size are mutually exclusive.");
+
+    args.option(u"write-queue", 0, Args::INTEGER, 0, 1, 2, 1024);
+    args.help(u"write-queue", u"count",
+              u"Write the output file asynchronously, using a queue of <count> buffers of " +
+              UString::Decimal(TSFile::DEFAULT_WRITE_BUFFER_SIZE) + u" bytes each. "
+              u"The disk I/O is performed by a separate thread, in parallel with the packet processing. "
+              u"Write errors are consequently reported later. "
+              u"By default, the output file is synchronously written.");
 }
 
 
@@ -108,6 +116,7 @@ bool ts::TSFileOutputArgs::loadArgs(DuckContext& duck, Args& args)
     args.getIntValue(_start_stuffing, u"add-start-stuffing", 0);
     args.getIntValue(_stop_stuffing, u"add-stop-stuffing", 0);
     args.getIntValue(_max_files, u"max-files", 0);
+    args.getIntValue(_write_queue, u"write-queue", 0);
     args.getIntValue(_max_size, u"max-size", 0);
     args.getChronoValue(_max_duration, u"max-duration", 0);
     _file_format = LoadTSPacketFormatOutputOption(args);
@@ -152,6 +161,7 @@ bool ts::TSFileOutputArgs::open(Report& report, AbortInterface* abort)
     _next_open_time = Time::CurrentUTC();
     _current_files.clear();
     _file.setStuffing(_start_stuffing, _stop_stuffing);
+    _file.setWriteQueue(_write_queue);
     size_t retry_allowed = _retry_max == 0 ? std::numeric_limits<size_t>::max() : _retry_max;
     return openAndRetry(false, retry_allowed, report, abort);
 }
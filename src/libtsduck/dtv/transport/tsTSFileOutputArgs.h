@@ -97,6 +97,7 @@ namespace ts {
         uint64_t          _max_size = 0;
         cn::seconds       _max_duration {0};
         size_t            _max_files = 0;
+        size_t            _write_queue = 0;
         bool              _multiple_files = false;
 
         // Working data:
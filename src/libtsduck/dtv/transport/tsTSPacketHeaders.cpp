@@ -0,0 +1,96 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSPacketHeaders.h"
+#include "tsTSPacketAcceleration.h"
+#include "tsSysInfo.h"
+
+// Runtime check once if accelerated instructions are supported on this CPU.
+volatile bool ts::TSPacketHeaders::_accel_checked = false;
+volatile bool ts::TSPacketHeaders::_accel_supported = false;
+
+
+//----------------------------------------------------------------------------
+// Check if vector instructions are used to extract the packet headers.
+//----------------------------------------------------------------------------
+
+bool ts::TSPacketHeaders::IsAccelerated()
+{
+    // Check once if acceleration is supported at runtime.
+    // Not thread-safe but the result is always the same.
+    if (!_accel_checked) {
+        _accel_supported = tsTSPacketHeadersIsAccelerated && SysInfo::Instance().avx2Instructions();
+        _accel_checked = true;
+    }
+    return _accel_supported;
+}
+
+
+//----------------------------------------------------------------------------
+// Extract the headers of a batch of TS packets.
+//----------------------------------------------------------------------------
+
+void ts::TSPacketHeaders::load(const TSPacket* pkt, size_t count)
+{
+    // Enlarge the side table when necessary, never shrink it.
+    if (_pids.size() < count) {
+        _pids.resize(count);
+        _pusi.resize(count);
+        _scrambling.resize(count);
+        _cc.resize(count);
+    }
+    _size = count;
+
+    if (count > 0) {
+        assert(pkt != nullptr);
+        const uint8_t* data = pkt->b;
+        const size_t done = IsAccelerated() ? LoadAccel(data, count, _pids.data(), _pusi.data(), _scrambling.data(), _cc.data()) : 0;
+        assert(done <= count);
+        LoadStd(data + done * PKT_SIZE, count - done, _pids.data() + done, _pusi.data() + done, _scrambling.data() + done, _cc.data() + done);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Portable version of headers extraction.
+//----------------------------------------------------------------------------
+
+void ts::TSPacketHeaders::LoadStd(const uint8_t* pkt, size_t count, PID* pids, uint8_t* pusi, uint8_t* scrambling, uint8_t* cc)
+{
+    for (size_t i = 0; i < count; ++i, pkt += PKT_SIZE) {
+        pids[i] = PID(((pkt[1] & 0x1F) << 8) | pkt[2]);
+        pusi[i] = (pkt[1] >> 6) & 0x01;
+        scrambling[i] = pkt[3] >> 6;
+        cc[i] = pkt[3] & 0x0F;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Select or count the packets of the batch with a PID in a given set.
+//----------------------------------------------------------------------------
+
+size_t ts::TSPacketHeaders::selectPIDs(std::vector<size_t>& indexes, const PIDSet& filter, size_t start) const
+{
+    indexes.clear();
+    for (size_t i = start; i < _size; ++i) {
+        if (filter[_pids[i]]) {
+            indexes.push_back(i);
+        }
+    }
+    return indexes.size();
+}
+
+size_t ts::TSPacketHeaders::countPIDs(const PIDSet& filter) const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < _size; ++i) {
+        count += filter[_pids[i]];
+    }
+    return count;
+}
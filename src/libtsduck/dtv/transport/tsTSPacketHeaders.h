@@ -0,0 +1,137 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Bulk extraction of the headers of a batch of TS packets.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSPacket.h"
+
+namespace ts {
+    //!
+    //! Bulk extraction of the headers of a batch of TS packets.
+    //! @ingroup libtsduck mpeg
+    //!
+    //! An instance of this class is a side table, in "structure of arrays" form,
+    //! of the main fields of the 4-byte headers of a contiguous array of TS packets:
+    //! PID, payload_unit_start_indicator, transport_scrambling_control and
+    //! continuity_counter.
+    //!
+    //! The extraction is performed in one pass over the packets. When the CPU
+    //! supports it, vector instructions are used to process several packets at a
+    //! time (currently AVX2 on Intel x86). Subsequent filtering operations on the
+    //! batch, typically PID filtering, work on the compact side table without
+    //! touching the packets again.
+    //!
+    //! An instance of this class is typically reused from one batch to another
+    //! to avoid memory reallocation.
+    //!
+    class TSDUCKDLL TSPacketHeaders
+    {
+        TS_NOCOPY(TSPacketHeaders);
+    public:
+        //!
+        //! Constructor.
+        //!
+        TSPacketHeaders() = default;
+
+        //!
+        //! Extract the headers of a batch of TS packets.
+        //! The previous content of the table is replaced.
+        //! @param [in] pkt Address of the first TS packet.
+        //! @param [in] count Number of contiguous TS packets.
+        //!
+        void load(const TSPacket* pkt, size_t count);
+
+        //!
+        //! Clear the content of the table.
+        //!
+        void clear() { _size = 0; }
+
+        //!
+        //! Get the number of packets in the table.
+        //! @return The number of packets in the table.
+        //!
+        size_t size() const { return _size; }
+
+        //!
+        //! Get the PID of a packet.
+        //! @param [in] index Index of the packet in the batch. Must be lower than size().
+        //! @return The PID of the packet.
+        //!
+        PID pid(size_t index) const { return _pids[index]; }
+
+        //!
+        //! Get the payload_unit_start_indicator of a packet.
+        //! @param [in] index Index of the packet in the batch. Must be lower than size().
+        //! @return The payload_unit_start_indicator of the packet.
+        //!
+        bool pusi(size_t index) const { return _pusi[index] != 0; }
+
+        //!
+        //! Get the transport_scrambling_control of a packet.
+        //! @param [in] index Index of the packet in the batch. Must be lower than size().
+        //! @return The transport_scrambling_control of the packet, from 0 to 3.
+        //!
+        uint8_t scrambling(size_t index) const { return _scrambling[index]; }
+
+        //!
+        //! Get the continuity_counter of a packet.
+        //! @param [in] index Index of the packet in the batch. Must be lower than size().
+        //! @return The continuity_counter of the packet, from 0 to 15.
+        //!
+        uint8_t cc(size_t index) const { return _cc[index]; }
+
+        //!
+        //! Get the address of the contiguous array of PID values.
+        //! @return The address of the array of size() PID values.
+        //!
+        const PID* pids() const { return _pids.data(); }
+
+        //!
+        //! Select the packets of the batch with a PID in a given set.
+        //! @param [out] indexes Receive the indexes of the matching packets in the batch, in increasing order.
+        //! @param [in] filter The set of PID's to match.
+        //! @param [in] start Index of the first packet to check in the batch.
+        //! @return The number of matching packets, same as @a indexes.size().
+        //!
+        size_t selectPIDs(std::vector<size_t>& indexes, const PIDSet& filter, size_t start = 0) const;
+
+        //!
+        //! Count the packets of the batch with a PID in a given set.
+        //! @param [in] filter The set of PID's to match.
+        //! @return The number of matching packets.
+        //!
+        size_t countPIDs(const PIDSet& filter) const;
+
+        //!
+        //! Check if vector instructions are used to extract the packet headers on this system.
+        //! @return True if the extraction is accelerated.
+        //!
+        static bool IsAccelerated();
+
+    private:
+        size_t               _size = 0;         // Number of packets in the table.
+        std::vector<PID>     _pids {};          // Capacity of vectors may be larger than _size.
+        std::vector<uint8_t> _pusi {};
+        std::vector<uint8_t> _scrambling {};
+        std::vector<uint8_t> _cc {};
+
+        // Runtime check once if accelerated instructions are supported on this CPU.
+        static volatile bool _accel_checked;
+        static volatile bool _accel_supported;
+
+        // Extraction of headers, portable and accelerated versions.
+        // The accelerated version works on raw pointers, in a separate module which is
+        // compiled with specialized instructions. Returns the number of extracted headers.
+        static void LoadStd(const uint8_t* pkt, size_t count, PID* pids, uint8_t* pusi, uint8_t* scrambling, uint8_t* cc);
+        static size_t LoadAccel(const uint8_t* pkt, size_t count, PID* pids, uint8_t* pusi, uint8_t* scrambling, uint8_t* cc);
+    };
+}
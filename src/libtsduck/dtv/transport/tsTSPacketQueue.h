@@ -13,7 +13,7 @@
 
 #pragma once
 #include "tsTSPacket.h"
-#include "tsTSPacketMetadata.h"
+#include "tsTSPacketRing.h"
 #include "tsPCRAnalyzer.h"
 
 namespace ts {
@@ -36,6 +36,9 @@ namespace ts {
     //!
     //! Termination conditions can be triggered on both sides.
     //!
+    //! The packets are exchanged through a TSPacketRing: there is no mutex on the
+    //! data path. The bitrate is only published to the reader thread when it changes.
+    //!
     class TSDUCKDLL TSPacketQueue
     {
         TS_NOCOPY(TSPacketQueue);
@@ -64,13 +67,13 @@ namespace ts {
         //! Get the size of the buffer in packets.
         //! @return The size of the buffer in packets.
         //!
-        size_t bufferSize() const;
+        size_t bufferSize() const { return _ring.bufferSize(); }
 
         //!
         //! Get the current number of packets in the buffer.
         //! @return The current number of packets in the buffer.
         //!
-        size_t currentSize() const;
+        size_t currentSize() const { return _ring.currentSize(); }
 
         //!
         //! Called by the writer thread to get a write buffer.
@@ -106,13 +109,13 @@ namespace ts {
         //!
         //! Called by the writer thread to report the end of input thread.
         //!
-        void setEOF();
+        void setEOF() { _ring.setEOF(); }
 
         //!
         //! Check if the reader thread has reported a stop condition.
         //! @return True if the reader thread has reported a stop condition.
         //!
-        bool stopped() const { return _stopped; }
+        bool stopped() const { return _ring.stopped(); }
 
         //!
         //! Called by the reader thread to get the next packet without waiting.
@@ -141,28 +144,35 @@ namespace ts {
         //! Check if the writer thread has reported an end of file condition.
         //! @return True if the writer thread has reported an end of file condition.
         //!
-        bool eof() const;
+        bool eof() const { return _ring.eof(); }
 
         //!
         //! Called by the reader thread to tell the writer thread to stop immediately.
         //!
-        void stop();
+        void stop() { _ring.stop(); }
 
     private:
-        volatile bool                   _eof = false;      // The writer thread has reported an end of file.
-        volatile bool                   _stopped = false;  // The read thread has reported a stop condition.
-        mutable std::mutex              _mutex {};         // Protect access to shared data.
-        mutable std::condition_variable _enqueued {};      // Signaled when packets are inserted.
-        mutable std::condition_variable _dequeued {};      // Signaled when packets were freed.
-        TSPacketVector         _pkt_buffer {};   // The packet buffer.
-        TSPacketMetadataVector _md_buffer {};    // The packet metadata buffer.
-        PCRAnalyzer            _pcr {1, 12};     // PCR analyzer to get the bitrate.
-        size_t                 _inCount = 0;     // Number of packets currently inside the buffer.
-        size_t                 _readIndex = 0;   // Index of next packet to read.
-        size_t                 _writeIndex = 0;  // Index of next packet to write.
-        BitRate                _bitrate = 0;     // Bitrate as set by the writer thread.
-
-        // Get bitrate, must be called with mutex held.
-        BitRate getBitrate() const;
+        TSPacketRing _ring;
+
+        // Writer thread only.
+        TSPacket*    _write_buffer = nullptr;  // Current write window.
+        PCRAnalyzer  _pcr {1, 12};             // PCR analyzer to get the bitrate.
+        BitRate      _bitrate = 0;             // Bitrate as set by the writer thread.
+        BitRate      _published_bitrate = 0;   // Last bitrate which was published to the reader thread.
+
+        // Bitrate publication, modified only when the bitrate changes.
+        std::mutex          _bitrate_mutex {};
+        BitRate             _shared_bitrate = 0;
+        std::atomic<size_t> _bitrate_version = 0;
+
+        // Reader thread only.
+        size_t       _reader_version = 0;
+        BitRate      _reader_bitrate = 0;
+
+        // Publish the current bitrate if it changed (writer thread).
+        void publishBitrate();
+
+        // Get the last published bitrate (reader thread).
+        BitRate getBitrate();
     };
 }
@@ -0,0 +1,288 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSPacketRing.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::TSPacketRing::TSPacketRing(size_t size) :
+    _size(std::max<size_t>(size, 1)), // at least one packet
+    _packets(_size),
+    _metadata(_size)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Reset and resize the ring.
+//----------------------------------------------------------------------------
+
+void ts::TSPacketRing::reset(size_t size)
+{
+    // Prevent the consumer from getting a read window.
+    acquireReading(true);
+
+    if (size != NPOS) {
+        _size = std::max<size_t>(size, 1); // at least one packet
+        _packets.resize(_size);
+        _metadata.resize(_size);
+    }
+    _write_count = 0;
+    _read_count = 0;
+    _eof = false;
+    _stopped = false;
+
+    _reading = false;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the current number of packets in the ring.
+//----------------------------------------------------------------------------
+
+size_t ts::TSPacketRing::currentSize() const
+{
+    // Load the consumer position first: the producer position can only be higher.
+    const size_t read_count = _read_count;
+    return _write_count - read_count;
+}
+
+
+//----------------------------------------------------------------------------
+// Waiting and waking up threads.
+//----------------------------------------------------------------------------
+
+template <class PRED>
+void ts::TSPacketRing::waitUntil(std::atomic_bool& waiting, std::condition_variable& cond, PRED ready)
+{
+    // Active polling first. Most of the time, the other side is busy
+    // with a batch of packets and is back in a few microseconds.
+    for (size_t i = 0; i < _spin_count; ++i) {
+        if (ready()) {
+            return;
+        }
+        if (i >= _spin_count / 2) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Then park on the condition variable. The other side publishes its position
+    // before checking the waiting flag. Since we set the waiting flag before checking
+    // the condition under the mutex, a notification cannot be lost.
+    std::unique_lock<std::mutex> lock(_mutex);
+    waiting = true;
+    while (!ready()) {
+        cond.wait(lock);
+    }
+    waiting = false;
+}
+
+void ts::TSPacketRing::wakeUp(std::atomic_bool& waiting, std::condition_variable& cond)
+{
+    if (waiting) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        cond.notify_all();
+    }
+}
+
+bool ts::TSPacketRing::acquireReading(bool wait)
+{
+    bool expected = false;
+    while (!_reading.compare_exchange_weak(expected, true)) {
+        if (!wait) {
+            return false;
+        }
+        expected = false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Set end of file and stop conditions.
+//----------------------------------------------------------------------------
+
+void ts::TSPacketRing::setEOF()
+{
+    _eof = true;
+    std::lock_guard<std::mutex> lock(_mutex);
+    _reader_cond.notify_all();
+}
+
+void ts::TSPacketRing::stop()
+{
+    _stopped = true;
+    std::lock_guard<std::mutex> lock(_mutex);
+    _writer_cond.notify_all();
+    _reader_cond.notify_all();
+}
+
+
+//----------------------------------------------------------------------------
+// Producer side.
+//----------------------------------------------------------------------------
+
+bool ts::TSPacketRing::lockWrite(TSPacket*& buffer, TSPacketMetadata*& mdata, size_t& count, size_t min_count, bool wait)
+{
+    // The producer position is only modified by this thread.
+    const size_t write_count = _write_count.load(std::memory_order_relaxed);
+    const size_t first = write_count % _size;
+    const size_t contiguous = _size - first;
+    const auto free_space = [this, write_count]() { return _size - (write_count - _read_count); };
+
+    // We cannot ask for more than the distance to the end of the ring.
+    min_count = std::max<size_t>(1, std::min(min_count, contiguous));
+
+    if (wait && !_stopped && free_space() < min_count) {
+        waitUntil(_writer_waiting, _writer_cond, [&]() { return _stopped || free_space() >= min_count; });
+    }
+
+    if (_stopped) {
+        count = 0;
+        return false;
+    }
+    buffer = &_packets[first];
+    mdata = &_metadata[first];
+    count = std::min(free_space(), contiguous);
+    return true;
+}
+
+void ts::TSPacketRing::commitWrite(size_t count)
+{
+    if (count > 0) {
+        const size_t write_count = _write_count.load(std::memory_order_relaxed);
+        assert(count <= _size - (write_count - _read_count));
+        assert(count <= _size - write_count % _size);
+        _write_count = write_count + count;
+        wakeUp(_reader_waiting, _reader_cond);
+    }
+}
+
+bool ts::TSPacketRing::write(const TSPacket* buffer, const TSPacketMetadata* mdata, size_t count)
+{
+    while (count > 0) {
+        TSPacket* pkt = nullptr;
+        TSPacketMetadata* md = nullptr;
+        size_t size = 0;
+        if (!lockWrite(pkt, md, size)) {
+            return false;
+        }
+        size = std::min(size, count);
+        TSPacket::Copy(pkt, buffer, size);
+        if (mdata != nullptr) {
+            TSPacketMetadata::Copy(md, mdata, size);
+            mdata += size;
+        }
+        else {
+            TSPacketMetadata::Reset(md, size);
+        }
+        commitWrite(size);
+        buffer += size;
+        count -= size;
+    }
+    return true;
+}
+
+size_t ts::TSPacketRing::dropOldest(size_t count)
+{
+    if (!acquireReading(false)) {
+        // The consumer is currently working on the oldest packets.
+        return 0;
+    }
+    const size_t read_count = _read_count;
+    count = std::min(count, _write_count.load(std::memory_order_relaxed) - read_count);
+    _read_count = read_count + count;
+    _reading = false;
+    return count;
+}
+
+bool ts::TSPacketRing::waitEmpty()
+{
+    waitUntil(_writer_waiting, _writer_cond, [this]() { return _stopped || currentSize() == 0; });
+    return !_stopped;
+}
+
+
+//----------------------------------------------------------------------------
+// Consumer side.
+//----------------------------------------------------------------------------
+
+bool ts::TSPacketRing::lockRead(TSPacket*& buffer, TSPacketMetadata*& mdata, size_t& count, bool wait)
+{
+    count = 0;
+    for (;;) {
+        // Check the end conditions before the producer position: the producer sets
+        // the end of file after committing the last packets.
+        bool end = _eof || _stopped;
+        if (wait && !end && currentSize() == 0) {
+            waitUntil(_reader_waiting, _reader_cond, [this]() { return _eof || _stopped || currentSize() > 0; });
+            end = _eof || _stopped;
+        }
+
+        // The producer cannot drop packets while we hold the read window.
+        acquireReading(true);
+        const size_t read_count = _read_count;
+        const size_t available = _write_count - read_count;
+
+        if (available > 0 || (!wait && !end)) {
+            const size_t first = read_count % _size;
+            buffer = &_packets[first];
+            mdata = &_metadata[first];
+            count = std::min(available, _size - first);
+            return true;
+        }
+
+        _reading = false;
+        if (end) {
+            return false;
+        }
+        // The packets were dropped by the producer in the meantime, wait again.
+    }
+}
+
+void ts::TSPacketRing::releaseRead(size_t count)
+{
+    assert(_reading);
+    if (count > 0) {
+        const size_t read_count = _read_count;
+        assert(count <= _write_count - read_count);
+        _read_count = read_count + count;
+    }
+    _reading = false;
+    wakeUp(_writer_waiting, _writer_cond);
+}
+
+bool ts::TSPacketRing::read(TSPacket* buffer, TSPacketMetadata* mdata, size_t max_count, size_t& ret_count, bool wait)
+{
+    ret_count = 0;
+
+    // At most two rounds: up to the end of the ring, then from the beginning.
+    while (ret_count < max_count) {
+        TSPacket* pkt = nullptr;
+        TSPacketMetadata* md = nullptr;
+        size_t count = 0;
+        if (!lockRead(pkt, md, count, wait && ret_count == 0)) {
+            return ret_count > 0;
+        }
+        count = std::min(count, max_count - ret_count);
+        TSPacket::Copy(buffer + ret_count, pkt, count);
+        if (mdata != nullptr) {
+            TSPacketMetadata::Copy(mdata + ret_count, md, count);
+        }
+        releaseRead(count);
+        ret_count += count;
+        if (count == 0) {
+            break;
+        }
+    }
+    return true;
+}
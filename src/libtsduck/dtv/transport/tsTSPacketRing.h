@@ -0,0 +1,233 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Single-producer single-consumer ring of TS packets.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSPacket.h"
+#include "tsTSPacketMetadata.h"
+
+namespace ts {
+
+    TS_PUSH_WARNING()
+    TS_MSC_NOWARNING(4324) // structure was padded due to alignment specifier
+
+    //!
+    //! Single-producer single-consumer ring of TS packets, with their metadata.
+    //! @ingroup libtsduck mpeg
+    //!
+    //! Exactly one producer thread writes packets and exactly one consumer thread
+    //! reads them. The fast path of both sides does not use any mutex: the producer
+    //! and consumer positions are atomic counters which are located in distinct
+    //! cache lines. A thread which must wait for the other side first spins for
+    //! a short time and then parks on a condition variable. The other side takes
+    //! the mutex only when it knows that a thread is parked.
+    //!
+    //! Both sides work in place, in a contiguous window of the ring:
+    //! - The producer gets a write window using lockWrite(), fills it and makes
+    //!   the packets visible using commitWrite(). Several batches can be written
+    //!   in the same window before committing them.
+    //! - The consumer gets a read window using lockRead(), processes the packets
+    //!   and frees them using releaseRead().
+    //!
+    //! The methods are documented with the thread which is allowed to call them.
+    //! The methods without mention can be called from any thread.
+    //!
+    class TSDUCKDLL TSPacketRing
+    {
+        TS_NOCOPY(TSPacketRing);
+    public:
+        //!
+        //! Default size in packets of the ring.
+        //!
+        static constexpr size_t DEFAULT_SIZE = 1000;
+
+        //!
+        //! Assumed size in bytes of a CPU cache line.
+        //! The producer and consumer positions are located in distinct cache lines.
+        //!
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+
+        //!
+        //! Default number of active polling iterations before parking a waiting thread.
+        //!
+        static constexpr size_t DEFAULT_SPIN_COUNT = 200;
+
+        //!
+        //! Constructor.
+        //! @param [in] size Size of the ring in packets.
+        //!
+        TSPacketRing(size_t size = DEFAULT_SIZE);
+
+        //!
+        //! Reset and resize the ring.
+        //! Must be called by the producer thread or when no thread uses the ring.
+        //! If the consumer thread currently holds a read window, wait until it is released.
+        //! All stop and end of file conditions are cleared.
+        //! @param [in] size New size of the ring in packets. By default, when set to NPOS,
+        //! reset the ring without resizing it.
+        //!
+        void reset(size_t size = NPOS);
+
+        //!
+        //! Set the number of active polling iterations before parking a waiting thread.
+        //! @param [in] count Number of polling iterations. Zero means always park immediately.
+        //!
+        void setSpinCount(size_t count) { _spin_count = count; }
+
+        //!
+        //! Get the size of the ring in packets.
+        //! @return The size of the ring in packets.
+        //!
+        size_t bufferSize() const { return _size; }
+
+        //!
+        //! Get the current number of packets in the ring.
+        //! This is a snapshot, the value can be modified at any time by the other side.
+        //! @return The current number of packets in the ring.
+        //!
+        size_t currentSize() const;
+
+        //!
+        //! Get a write window (producer thread).
+        //! @param [out] buffer Address of the packet write window.
+        //! @param [out] mdata Address of the packet metadata write window.
+        //! @param [out] count Size in packets of the write window. This is the contiguous free space
+        //! after the last written packet. It can be zero when @a wait is false.
+        //! @param [in] min_count Minimum number of free packets to wait for. This is just a hint.
+        //! The returned size can be smaller, when the write window is close to the end of the ring.
+        //! @param [in] wait If true, wait until at least @a min_count free packets are available.
+        //! @return True when the write window is available. False when a stop condition was set.
+        //!
+        bool lockWrite(TSPacket*& buffer, TSPacketMetadata*& mdata, size_t& count, size_t min_count = 1, bool wait = true);
+
+        //!
+        //! Make written packets visible to the consumer (producer thread).
+        //! The packets were written at the beginning of the window which was returned by lockWrite().
+        //! @param [in] count Number of packets which were written. Must be no greater than the
+        //! size of the write window.
+        //!
+        void commitWrite(size_t count);
+
+        //!
+        //! Copy packets into the ring (producer thread).
+        //! Wait until all packets are written or a stop condition is set.
+        //! @param [in] buffer Address of the packets to write.
+        //! @param [in] mdata Address of the packet metadata. If null, the metadata are reset.
+        //! @param [in] count Number of packets to write.
+        //! @return True when all packets were written, false when a stop condition was set.
+        //!
+        bool write(const TSPacket* buffer, const TSPacketMetadata* mdata, size_t count);
+
+        //!
+        //! Drop the oldest packets in the ring (producer thread).
+        //! This is used by lossy producers which want to make room for new packets.
+        //! Nothing is dropped if the consumer currently holds a read window.
+        //! @param [in] count Maximum number of packets to drop.
+        //! @return The number of dropped packets.
+        //!
+        size_t dropOldest(size_t count);
+
+        //!
+        //! Wait until all packets are consumed (producer thread).
+        //! @return True when the ring is empty, false when a stop condition was set.
+        //!
+        bool waitEmpty();
+
+        //!
+        //! Report that the producer has no more packets to write.
+        //! The consumer gets the remaining packets in the ring and then an end of file.
+        //!
+        void setEOF();
+
+        //!
+        //! Check if an end of file condition was reported and all packets were consumed.
+        //! @return True if an end of file condition was reported and all packets were consumed.
+        //!
+        bool eof() const { return _eof && currentSize() == 0; }
+
+        //!
+        //! Set a stop condition. All waiting threads are immediately released.
+        //! The producer can no longer write packets. The consumer can still get the remaining packets.
+        //!
+        void stop();
+
+        //!
+        //! Check if a stop condition was set.
+        //! @return True if a stop condition was set.
+        //!
+        bool stopped() const { return _stopped; }
+
+        //!
+        //! Get a read window (consumer thread).
+        //! When this method returns true, the read window shall be released using releaseRead(),
+        //! even when it is empty.
+        //! @param [out] buffer Address of the first packet to read.
+        //! @param [out] mdata Address of the packet metadata of the first packet to read.
+        //! @param [out] count Size in packets of the read window. This is the contiguous part of
+        //! the packets in the ring. It can be zero when @a wait is false.
+        //! @param [in] wait If true, wait until at least one packet is available.
+        //! @return True when the read window is locked. False when the ring is empty and an end
+        //! of file or stop condition was set. In that case, there is nothing to release.
+        //!
+        bool lockRead(TSPacket*& buffer, TSPacketMetadata*& mdata, size_t& count, bool wait = true);
+
+        //!
+        //! Release the read window and free the first packets in it (consumer thread).
+        //! @param [in] count Number of packets to free. Must be no greater than the size of the read window.
+        //!
+        void releaseRead(size_t count);
+
+        //!
+        //! Copy packets out of the ring (consumer thread).
+        //! @param [out] buffer Address of the packet buffer.
+        //! @param [out] mdata Address of the packet metadata buffer. Can be null.
+        //! @param [in] max_count Size of @a buffer in number of packets.
+        //! @param [out] ret_count Number of returned packets.
+        //! @param [in] wait If true, wait until at least one packet is available.
+        //! @return False when the ring is empty and an end of file or stop condition was set.
+        //!
+        bool read(TSPacket* buffer, TSPacketMetadata* mdata, size_t max_count, size_t& ret_count, bool wait = true);
+
+    private:
+        // Producer position. Total number of written packets.
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _write_count = 0;
+        std::atomic_bool        _writer_waiting = false;   // The producer is parked.
+
+        // Consumer position. Total number of freed packets.
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _read_count = 0;
+        std::atomic_bool        _reader_waiting = false;   // The consumer is parked.
+        std::atomic_bool        _reading = false;          // The consumer holds a read window, or the producer drops packets.
+
+        // Shared state, rarely modified.
+        alignas(CACHE_LINE_SIZE) std::atomic_bool _eof = false;
+        std::atomic_bool        _stopped = false;
+        size_t                  _size = 0;
+        size_t                  _spin_count = DEFAULT_SPIN_COUNT;
+        TSPacketVector          _packets {};
+        TSPacketMetadataVector  _metadata {};
+        std::mutex              _mutex {};                 // Only used to park waiting threads.
+        std::condition_variable _writer_cond {};
+        std::condition_variable _reader_cond {};
+
+        // Wait until a condition is true, spin first, then park.
+        template <class PRED>
+        void waitUntil(std::atomic_bool& waiting, std::condition_variable& cond, PRED ready);
+
+        // Wake up a parked thread, if any.
+        void wakeUp(std::atomic_bool& waiting, std::condition_variable& cond);
+
+        // Acquire the exclusive right to move the consumer position.
+        bool acquireReading(bool wait);
+    };
+
+    TS_POP_WARNING()
+}
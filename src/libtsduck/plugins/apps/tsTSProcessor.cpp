@@ -11,6 +11,9 @@
 #include "tstspOutputExecutor.h"
 #include "tstspProcessorExecutor.h"
 #include "tstspControlServer.h"
+#include "tstspMetricsServer.h"
+#include "tstspBatchController.h"
+#include "tsNUMA.h"
 #include "tsFatal.h"
 
 
@@ -36,13 +39,21 @@ ts::TSProcessor::~TSProcessor()
 
 void ts::TSProcessor::cleanupInternal()
 {
-    // Terminate and delete the control server.
-    // This must be done first since the control server accesses the plugin executors.
+    // Terminate and delete the control and metrics servers and the batch controller.
+    // This must be done first since these threads access the plugin executors.
     if (_control != nullptr) {
         // Deleting the object terminates the server thread.
         delete _control;
         _control = nullptr;
     }
+    if (_metrics != nullptr) {
+        delete _metrics;
+        _metrics = nullptr;
+    }
+    if (_batch_control != nullptr) {
+        delete _batch_control;
+        _batch_control = nullptr;
+    }
 
     // Abort and wait for threads to terminate
     tsp::PluginExecutor* proc = _input;
@@ -102,6 +113,21 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         // Clear errors on the report, used to check further initialisation errors.
         _report.resetErrors();
 
+        // With --low-latency, pin each plugin thread to a distinct CPU, in the NUMA node of the buffer if specified.
+        // Busy-polling threads must not share a CPU: don't pin anything when there are not enough CPU's.
+        std::vector<int> cpus;
+        if (_args.low_latency && GetProcessCPUs(cpus)) {
+            std::vector<int> node_cpus;
+            if (_args.numa_node >= 0 && GetNUMANodeCPUs(node_cpus, _args.numa_node)) {
+                std::erase_if(cpus, [&node_cpus](int cpu) { return std::find(node_cpus.begin(), node_cpus.end(), cpu) == node_cpus.end(); });
+            }
+            if (cpus.size() < _args.plugins.size() + 2) {
+                _report.verbose(u"tsp: %d plugins but only %d available CPU's, plugin threads are not pinned", _args.plugins.size() + 2, cpus.size());
+                cpus.clear();
+            }
+        }
+        const auto cpu = [&cpus](size_t index) { return index < cpus.size() ? cpus[index] : -1; };
+
         // Load all plugins and analyze their command line arguments.
         // The first plugin is always the input and the last one is the output.
         // The input thread has the highest priority to be always ready to load
@@ -109,10 +135,10 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         // plugin has a hight priority to make room in the buffer, but not as
         // high as the input which must remain the top-most priority?
 
-        _input = new tsp::InputExecutor(_args, *this, _args.input, ThreadAttributes().setPriority(ts::ThreadAttributes::GetMaximumPriority()), _global_mutex, &_report);
+        _input = new tsp::InputExecutor(_args, *this, _args.input, ThreadAttributes().setPriority(ts::ThreadAttributes::GetMaximumPriority()).setNUMANode(_args.numa_node).setCPU(cpu(0)), _global_mutex, &_report);
         CheckNonNull(_input);
 
-        _output = new tsp::OutputExecutor(_args, *this, _args.output, ThreadAttributes().setPriority(ts::ThreadAttributes::GetHighPriority()), _global_mutex, &_report);
+        _output = new tsp::OutputExecutor(_args, *this, _args.output, ThreadAttributes().setPriority(ts::ThreadAttributes::GetHighPriority()).setNUMANode(_args.numa_node).setCPU(cpu(_args.plugins.size() + 1)), _global_mutex, &_report);
         CheckNonNull(_output);
 
         _output->ringInsertAfter(_input);
@@ -121,7 +147,7 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         bool realtime = _args.realtime == Tristate::True || _input->isRealTime() || _output->isRealTime();
 
         for (size_t i = 0; i < _args.plugins.size(); ++i) {
-            tsp::PluginExecutor* p = new tsp::ProcessorExecutor(_args, *this, i, ThreadAttributes(), _global_mutex, &_report);
+            tsp::PluginExecutor* p = new tsp::ProcessorExecutor(_args, *this, i, ThreadAttributes().setNUMANode(_args.numa_node).setCPU(cpu(i + 1)), _global_mutex, &_report);
             CheckNonNull(p);
             p->ringInsertBefore(_output);
             realtime = realtime || p->isRealTime();
@@ -157,17 +183,28 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         } while ((proc = proc->ringNext<ts::tsp::PluginExecutor>()) != _input);
 
         // Allocate a memory-resident buffer of TS packets
-        _packet_buffer = new PacketBuffer(_args.ts_buffer_size / ts::PKT_SIZE);
+        _packet_buffer = new PacketBuffer(_args.ts_buffer_size / ts::PKT_SIZE, _args.huge_pages, _args.numa_node);
         CheckNonNull(_packet_buffer);
         if (!_packet_buffer->isLocked()) {
             _report.debug(u"tsp: buffer failed to lock into physical memory (%d: %s), risk of real-time issue",
                           _packet_buffer->lockErrorCode().value(), _packet_buffer->lockErrorCode().message());
         }
+        if (_args.huge_pages && !_packet_buffer->isHugePages()) {
+            if (_packet_buffer->isTransparentHugePages()) {
+                _report.verbose(u"tsp: no explicit huge page available for the packet buffer, using transparent huge pages");
+            }
+            else {
+                _report.verbose(u"tsp: huge pages not available for the packet buffer, using normal pages");
+            }
+        }
+        if (_args.numa_node >= 0 && _packet_buffer->numaNode() != _args.numa_node) {
+            _report.verbose(u"tsp: packet buffer could not be bound to NUMA node %d", _args.numa_node);
+        }
         _report.debug(u"tsp: buffer size: %'d TS packets, %'d bytes", _packet_buffer->count(), _packet_buffer->count() * ts::PKT_SIZE);
 
         // Buffer for the packet metadata.
         // A packet and its metadata have the same index in their respective buffer.
-        _metadata_buffer = new PacketMetadataBuffer(_packet_buffer->count());
+        _metadata_buffer = new PacketMetadataBuffer(_packet_buffer->count(), _args.huge_pages, _args.numa_node);
         CheckNonNull(_metadata_buffer);
 
         // End of locked section.
@@ -210,6 +247,16 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
     CheckNonNull(_control);
     _control->open();
 
+    // Create an execution metrics server thread. Display but ignore errors (not a fatal error).
+    _metrics = new tsp::MetricsServer(_args, _report, _global_mutex, _input);
+    CheckNonNull(_metrics);
+    _metrics->open();
+
+    // Create an adaptive batch size controller thread. Display but ignore errors (not a fatal error).
+    _batch_control = new tsp::BatchController(_args, _report, _global_mutex, _input);
+    CheckNonNull(_batch_control);
+    _batch_control->open();
+
     return true;
 }
 
@@ -263,6 +310,10 @@ void ts::TSProcessor::waitForTermination()
         // Make sure the control server thread is terminated before deleting plugins.
         _control->close();
 
+        // Write the final metrics, after termination of all plugins.
+        _metrics->close();
+        _batch_control->close();
+
         // Deallocate all plugins and plugin executor
         cleanupInternal();
     }
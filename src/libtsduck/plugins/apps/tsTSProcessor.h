@@ -24,6 +24,8 @@ namespace ts {
         class InputExecutor;
         class OutputExecutor;
         class ControlServer;
+        class MetricsServer;
+        class BatchController;
     }
     //! @endcond
 
@@ -94,6 +96,8 @@ namespace ts {
         tsp::InputExecutor*   _input = nullptr;            // Input processor execution thread.
         tsp::OutputExecutor*  _output = nullptr;           // Output processor execution thread.
         tsp::ControlServer*   _control = nullptr;          // TSP control command server thread.
+        tsp::MetricsServer*   _metrics = nullptr;          // TSP execution metrics server thread.
+        tsp::BatchController* _batch_control = nullptr;    // TSP adaptive batch size controller thread.
         PacketBuffer*         _packet_buffer = nullptr;    // Global TS packet buffer.
         PacketMetadataBuffer* _metadata_buffer = nullptr;  // Global packet metabata buffer.
 
@@ -13,6 +13,7 @@
 #define DEF_MAX_FLUSH_PKT_RT    1000  // packets
 #define DEF_MAX_INPUT_PKT_OFL      0  // packets
 #define DEF_MAX_INPUT_PKT_RT    1000  // packets
+#define DEF_MAX_PKT_LL             7  // packets, for all batches in low-latency mode
 
 
 //----------------------------------------------------------------------------
@@ -21,6 +22,17 @@
 
 void ts::TSProcessorArgs::defineArgs(Args& args)
 {
+    args.option(u"adaptive-batch");
+    args.help(u"adaptive-batch",
+              u"Adjust the number of packets per input operation and the number of processed packets "
+              u"before flush at runtime, based on the occupancy of the buffer and the wake-up frequency "
+              u"of the plugin threads. "
+              u"The initial values are given by --max-input-packets and --max-flushed-packets. "
+              u"By default, the batch sizes are increased to maximize the throughput when the plugin threads "
+              u"wake up too often. With --target-latency, the batch sizes are adjusted to keep the latency "
+              u"through the buffer below the target. "
+              u"Each adjustment is logged in verbose mode.");
+
     args.option(u"add-input-stuffing", 'a', Args::STRING);
     args.help(u"add-input-stuffing", u"nullpkt/inpkt",
               u"Specify that <nullpkt> null TS packets must be automatically inserted "
@@ -94,6 +106,15 @@ void ts::TSProcessorArgs::defineArgs(Args& args)
               u"Wait the specified duration after the last input packet. "
               u"Zero means wait forever.");
 
+    args.option(u"huge-pages");
+    args.help(u"huge-pages",
+              u"Allocate the global packet buffer and its metadata in huge pages, when supported by the system. "
+              u"This reduces the number of TLB misses with large buffers. "
+              u"Explicit huge pages are used when some are reserved in the system. "
+              u"Otherwise, transparent huge pages are requested. "
+              u"If huge pages are not available, normal pages are used. "
+              u"Currently, this option is implemented on Linux only.");
+
     args.option(u"ignore-joint-termination", 'i');
     args.help(u"ignore-joint-termination",
               u"Ignore all --joint-termination options in plugins. "
@@ -114,6 +135,13 @@ void ts::TSProcessorArgs::defineArgs(Args& args)
               u"a valid bitrate value from the beginning. "
               u"The default initial load is half the size of the global buffer.");
 
+    args.option(u"lock-free");
+    args.help(u"lock-free",
+              u"Pass packets between plugin threads without locking the global mutex. "
+              u"Each plugin thread owns an atomic view of its area in the packet buffer and "
+              u"a plugin thread is notified by its predecessor only when it is actually waiting. "
+              u"This reduces the contention when many plugins are chained at high bitrates.");
+
     args.option(u"log-plugin-index");
     args.help(u"log-plugin-index",
               u"In log messages, add the plugin index to the plugin name. "
@@ -126,6 +154,16 @@ void ts::TSProcessorArgs::defineArgs(Args& args)
               u"Equivalent to the same --receive-timeout options in some plugins. "
               u"By default, there is no input timeout.");
 
+    args.option(u"low-latency");
+    args.help(u"low-latency",
+              u"Minimize the latency of the packets through tsp, at the expense of CPU usage. "
+              u"Each plugin thread is pinned to a distinct CPU when there are enough CPU's. "
+              u"The plugin threads busy-poll the buffer instead of sleeping until packets are available: "
+              u"each plugin thread permanently uses 100% of a CPU. "
+              u"The packets are passed to the next plugin in small batches, by default " + UString::Decimal(DEF_MAX_PKT_LL) + u" packets "
+              u"for --max-input-packets, --max-flushed-packets and --initial-input-packets. "
+              u"This option implies --lock-free.");
+
     args.option(u"max-flushed-packets", 0, Args::POSITIVE);
     args.help(u"max-flushed-packets",
               u"Specify the maximum number of packets to be processed before flushing "
@@ -148,6 +186,43 @@ void ts::TSProcessorArgs::defineArgs(Args& args)
               u"This option is useful only when an output plugin or device has problems with large output requests. "
               u"This option forces multiple smaller send operations.");
 
+    args.option(u"metrics-file", 0, Args::FILENAME);
+    args.help(u"metrics-file", u"filename",
+              u"Periodically write the execution metrics of all plugins in the specified file, in OpenMetrics text format. "
+              u"The file is atomically replaced, using a temporary file and a rename. "
+              u"This is typically used with the textfile collector of Prometheus node exporter. "
+              u"See also --metrics-interval. "
+              u"The options --metrics-file and --metrics-port are mutually exclusive.");
+
+    args.option<cn::seconds>(u"metrics-interval");
+    args.help(u"metrics-interval",
+              u"With --metrics-file, specify the interval between two updates of the metrics file. "
+              u"The default is " + UString::Chrono(DEFAULT_METRICS_INTERVAL) + u".");
+
+    args.option(u"metrics-local", 0, Args::IPADDR);
+    args.help(u"metrics-local",
+              u"With --metrics-port, specify the IP address of the local interface on which to listen for metrics requests. "
+              u"It can be also a host name that translates to a local address. "
+              u"By default, listen on all local interfaces.");
+
+    args.option(u"metrics-port", 0, Args::UINT16);
+    args.help(u"metrics-port",
+              u"Specify the TCP port of a minimal HTTP server which returns the execution metrics of all plugins "
+              u"in OpenMetrics text format, for instance to be scraped by Prometheus. "
+              u"For each plugin, the metrics include the number of processed packets, the time which was spent "
+              u"in the plugin, the time which was spent waiting for packets or buffer space, the CPU time "
+              u"of the plugin thread and the number of packets which are waiting in the buffer for the plugin. "
+              u"The collection of the metrics is enabled only with --metrics-port or --metrics-file.");
+
+    args.option(u"numa-node", 0, Args::INTEGER, 0, 1, 0, 1023);
+    args.help(u"numa-node",
+              u"Bind the global packet buffer memory and all plugin threads to the specified NUMA node. "
+              u"On multi-socket systems, this avoids cross-node memory accesses when the packet buffer "
+              u"is shared between plugin threads running on different nodes. "
+              u"Select the node which is attached to the input or output network interface. "
+              u"If the binding fails, the memory and threads are not restricted. "
+              u"Currently, this option is implemented on Linux only.");
+
     args.option(u"realtime", 'r', Args::TRISTATE, 0, 1, -255, 256, true);
     args.help(u"realtime",
               u"Specifies if tsp and all plugins should use default values for real-time "
@@ -157,6 +232,13 @@ void ts::TSProcessorArgs::defineArgs(Args& args)
               u"are enforced. The explicit values 'no', 'false', 'off' are used to enforce "
               u"the offline defaults and the explicit values 'yes', 'true', 'on' are used "
               u"to enforce the real-time defaults.");
+
+    args.option<cn::milliseconds>(u"target-latency");
+    args.help(u"target-latency",
+              u"With --adaptive-batch, specify the target latency of the packets through the buffer, "
+              u"from input to output. The batch sizes are reduced when the latency is above the target "
+              u"and increased again when the latency is well below the target. "
+              u"This option implies --adaptive-batch.");
 }
 
 
@@ -168,12 +250,18 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
 {
     app_name = args.appName();
     log_plugin_index = args.present(u"log-plugin-index");
+    lock_free = args.present(u"lock-free");
+    low_latency = args.present(u"low-latency");
     ts_buffer_size = args.intValue<size_t>(u"buffer-size-mb", DEFAULT_BUFFER_SIZE);
+    huge_pages = args.present(u"huge-pages");
+    args.getIntValue(numa_node, u"numa-node", -1);
     args.getValue(fixed_bitrate, u"bitrate", 0);
     args.getChronoValue(bitrate_adj, u"bitrate-adjust-interval", DEFAULT_BITRATE_INTERVAL);
     args.getIntValue(max_flush_pkt, u"max-flushed-packets", 0);
     args.getIntValue(max_input_pkt, u"max-input-packets", 0);
     args.getIntValue(max_output_pkt, u"max-output-packets", NPOS); // unlimited by default
+    args.getChronoValue(target_latency, u"target-latency");
+    adaptive_batch = args.present(u"adaptive-batch") || target_latency > cn::milliseconds::zero();
     args.getIntValue(init_input_pkt, u"initial-input-packets", 0);
     args.getIntValue(instuff_start, u"add-start-stuffing", 0);
     args.getIntValue(instuff_stop, u"add-stop-stuffing", 0);
@@ -185,6 +273,14 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
     args.getIntValue(control_port, u"control-port", 0);
     args.getChronoValue(control_timeout, u"control-timeout", DEFAULT_CONTROL_TIMEOUT);
     control_reuse = args.present(u"control-reuse-port");
+    args.getIPValue(metrics_local, u"metrics-local");
+    args.getIntValue(metrics_port, u"metrics-port", 0);
+    args.getPathValue(metrics_file, u"metrics-file");
+    args.getChronoValue(metrics_interval, u"metrics-interval", DEFAULT_METRICS_INTERVAL);
+
+    if (metrics_port != 0 && !metrics_file.empty()) {
+        args.error(u"--metrics-port and --metrics-file are mutually exclusive");
+    }
 
     // Convert MB in MiB for buffer size for compatibility with original versions.
     ts_buffer_size = size_t((uint64_t(ts_buffer_size) * 1024 * 1024) / 1000000);
@@ -235,6 +331,19 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
 
 void ts::TSProcessorArgs::applyDefaults(bool rt)
 {
+    if (low_latency) {
+        // Busy-polling is implemented in lock-free mode only. Use small batches, including the initial load.
+        lock_free = true;
+        if (max_flush_pkt == 0) {
+            max_flush_pkt = DEF_MAX_PKT_LL;
+        }
+        if (max_input_pkt == 0) {
+            max_input_pkt = DEF_MAX_PKT_LL;
+        }
+        if (init_input_pkt == 0) {
+            init_input_pkt = DEF_MAX_PKT_LL;
+        }
+    }
     if (max_flush_pkt == 0) {
         max_flush_pkt = rt ? DEF_MAX_FLUSH_PKT_RT : DEF_MAX_FLUSH_PKT_OFL;
     }
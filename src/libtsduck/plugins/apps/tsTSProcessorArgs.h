@@ -30,10 +30,16 @@ namespace ts {
         UString           app_name {};              //!< Application name, for help messages.
         bool              ignore_jt = false;        //!< Ignore "joint termination" options in plugins.
         bool              log_plugin_index = false; //!< Log plugin index with plugin name.
+        bool              lock_free = false;        //!< Pass packets between plugin threads without the global mutex.
+        bool              low_latency = false;      //!< Pin plugin threads to CPU's, busy-poll the buffer and use small batches. Implies @a lock_free.
         size_t            ts_buffer_size = DEFAULT_BUFFER_SIZE; //!< Size in bytes of the global TS packet buffer.
+        bool              huge_pages = false;       //!< Allocate the global TS packet buffer in huge pages.
+        int               numa_node = -1;           //!< NUMA node for the packet buffer and plugin threads, negative means any.
         size_t            max_flush_pkt = 0;        //!< Max processed packets before flush.
         size_t            max_input_pkt = 0;        //!< Max packets per input operation.
         size_t            max_output_pkt = NPOS;    //!< Max packets per outsput operation. NPOS means unlimited.
+        bool              adaptive_batch = false;   //!< Adjust the input and flush batch sizes at runtime.
+        cn::milliseconds  target_latency {};        //!< With @a adaptive_batch, target latency through the buffer. Zero means target throughput.
         size_t            init_input_pkt = 0;       //!< Initial number of input packets to read before starting the processing (zero means default).
         size_t            instuff_nullpkt = 0;      //!< Add input stuffing: add @a instuff_nullpkt null packets every @a instuff_inpkt input packets.
         size_t            instuff_inpkt = 0;        //!< Add input stuffing: add @a instuff_nullpkt null packets every @a instuff_inpkt input packets.
@@ -50,6 +56,10 @@ namespace ts {
         bool              control_reuse = false;    //!< Set the 'reuse port' socket option on the control TCP server port.
         IPAddressVector   control_sources {};       //!< Remote IP addresses which are allowed to send control commands.
         cn::milliseconds  control_timeout = DEFAULT_CONTROL_TIMEOUT; //!< Reception timeout in milliseconds for control commands.
+        uint16_t          metrics_port = 0;         //!< TCP port of the HTTP server for the execution metrics.
+        IPAddress         metrics_local {};         //!< Local interface on which to listen for execution metrics requests.
+        fs::path          metrics_file {};          //!< File where the execution metrics are periodically written.
+        cn::seconds       metrics_interval = DEFAULT_METRICS_INTERVAL; //!< Interval between updates of the metrics file.
         DuckContext::SavedArgs duck_args {};        //!< Default TSDuck context options for all plugins. Each plugin can override them in its context.
         PluginOptions          input {};            //!< Input plugin description.
         PluginOptionsVector    plugins {};          //!< Packet processor plugins descriptions.
@@ -60,6 +70,7 @@ namespace ts {
         static constexpr PacketCounter DEFAULT_INIT_BITRATE_PKT_INTERVAL = 1000;  //!< Default initial bitrate reevaluation interval, in packets.
         static constexpr cn::milliseconds DEFAULT_BITRATE_INTERVAL = cn::milliseconds(5000);  //!< Default bitrate adjustment interval, in milliseconds.
         static constexpr cn::milliseconds DEFAULT_CONTROL_TIMEOUT = cn::milliseconds(5000);   //!< Default control command reception timeout, in milliseconds.
+        static constexpr cn::seconds DEFAULT_METRICS_INTERVAL = cn::seconds(5);               //!< Default interval between updates of the metrics file.
 
         //!
         //! Constructor.
@@ -86,5 +97,11 @@ namespace ts {
         //! @param [in] realtime If true, apply real-time defaults. If false, apply offline defaults.
         //!
         void applyDefaults(bool realtime);
+
+        //!
+        //! Check if the execution metrics of the plugins shall be collected.
+        //! @return True if the execution metrics are exported through HTTP or a file.
+        //!
+        bool metricsEnabled() const { return metrics_port != 0 || !metrics_file.empty(); }
     };
 }
@@ -0,0 +1,244 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSProcessorPipe.h"
+#include "tsArgsWithPlugins.h"
+#include "tsPluginEventContext.h"
+#include "tsPluginEventData.h"
+#include "tsDuckContext.h"
+
+
+//----------------------------------------------------------------------------
+// Destructor.
+//----------------------------------------------------------------------------
+
+ts::TSProcessorPipe::~TSProcessorPipe()
+{
+    if (_processor != nullptr) {
+        close(_processor->report());
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Start the pipeline.
+//----------------------------------------------------------------------------
+
+bool ts::TSProcessorPipe::open(const UString& command, Direction direction, size_t queue_size, Report& report)
+{
+    if (_processor != nullptr) {
+        report.error(u"tsp pipeline already started");
+        return false;
+    }
+
+    // Analyze the tsp command line. The leading "tsp" is optional.
+    UStringVector words;
+    command.fromQuotedLine(words);
+    if (!words.empty() && words.front() == u"tsp") {
+        words.erase(words.begin());
+    }
+
+    // The plugin which is connected to the application is implicit.
+    const bool read = direction == READ_OUTPUT;
+    ArgsWithPlugins args(0, read ? 1 : 0, 0, Args::UNLIMITED_COUNT, 0, read ? 0 : 1, u"In-process tsp pipeline", u"[tsp-options]",
+                         Args::NO_EXIT_ON_ERROR | Args::NO_EXIT_ON_HELP | Args::NO_EXIT_ON_VERSION);
+    args.delegateReport(&report);
+    DuckContext duck(&report);
+    duck.defineArgsForCAS(args);
+    duck.defineArgsForCharset(args);
+    duck.defineArgsForHFBand(args);
+    duck.defineArgsForPDS(args);
+    duck.defineArgsForTimeReference(args);
+    duck.defineArgsForStandards(args);
+    TSProcessorArgs tsp_args;
+    tsp_args.defineArgs(args);
+    if (!args.analyze(u"tsp", words, false) || !duck.loadArgs(args) || !tsp_args.loadArgs(duck, args)) {
+        return false;
+    }
+    if (read) {
+        tsp_args.output.set(u"memory");
+    }
+    else {
+        tsp_args.input.set(u"memory");
+    }
+
+    // Start the pipeline. When the application writes the input, this is done in the terminator thread.
+    _direction = direction;
+    _args = tsp_args;
+    _queue.reset(queue_size);
+    _processor = std::make_unique<TSProcessor>(report);
+    _processor->registerEventHandler(this, read ? PluginType::OUTPUT : PluginType::INPUT);
+    if (read && !_processor->start(_args)) {
+        _processor.reset();
+        return false;
+    }
+
+    // Start the thread which waits for the termination of the pipeline.
+    _terminator = std::make_unique<Terminator>(*this);
+    _terminator->start();
+    _is_open = true;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Terminate the pipeline.
+//----------------------------------------------------------------------------
+
+bool ts::TSProcessorPipe::close(Report& report)
+{
+    if (_processor == nullptr) {
+        return true;
+    }
+    report.debug(u"closing in-process tsp pipeline");
+    _is_open = false;
+
+    if (_direction == WRITE_INPUT) {
+        // Let the pipeline complete the processing of the written packets.
+        _queue.setEOF();
+    }
+    else {
+        // Unblock the output plugin of the pipeline and abort the input plugin.
+        _queue.stop();
+        _processor->abort();
+    }
+
+    // Deallocating the terminator waits for the termination of the pipeline.
+    _terminator.reset();
+    _processor.reset();
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Read TS packets from the output of the pipeline.
+//----------------------------------------------------------------------------
+
+size_t ts::TSProcessorPipe::readPackets(TSPacket* buffer, TSPacketMetadata* metadata, size_t max_packets, Report& report)
+{
+    if (_direction != READ_OUTPUT) {
+        report.error(u"tsp pipeline not open for reading");
+        return 0;
+    }
+    if (!_is_open) {
+        // Closed in the meantime, this is an end of stream.
+        return 0;
+    }
+    size_t count = 0;
+    BitRate bitrate;
+    _queue.waitPackets(buffer, metadata, max_packets, count, bitrate);
+    return count;
+}
+
+
+//----------------------------------------------------------------------------
+// Write TS packets to the input of the pipeline.
+//----------------------------------------------------------------------------
+
+bool ts::TSProcessorPipe::writePackets(const TSPacket* buffer, const TSPacketMetadata* metadata, size_t packet_count, Report& report)
+{
+    if (!_is_open || _direction != WRITE_INPUT) {
+        report.error(u"tsp pipeline not open for writing");
+        return false;
+    }
+    while (packet_count > 0) {
+        TSPacket* qbuffer = nullptr;
+        TSPacketMetadata* qmdata = nullptr;
+        size_t qsize = 0;
+        if (!_queue.lockWriteBuffer(qbuffer, qmdata, qsize)) {
+            // The pipeline has terminated.
+            return false;
+        }
+        const size_t count = std::min(qsize, packet_count);
+        TSPacket::Copy(qbuffer, buffer, count);
+        if (metadata != nullptr) {
+            TSPacketMetadata::Copy(qmdata, metadata, count);
+            metadata += count;
+        }
+        _queue.releaseWriteBuffer(count);
+        buffer += count;
+        packet_count -= count;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Invoked by the "memory" plugins of the pipeline.
+//----------------------------------------------------------------------------
+
+void ts::TSProcessorPipe::handlePluginEvent(const PluginEventContext& context)
+{
+    PluginEventData* data = dynamic_cast<PluginEventData*>(context.pluginData());
+    if (data == nullptr) {
+        return;
+    }
+
+    if (_direction == READ_OUTPUT) {
+        // Output plugin: move the output packets of the pipeline into the queue.
+        const TSPacket* packets = reinterpret_cast<const TSPacket*>(data->data());
+        size_t packet_count = data->size() / PKT_SIZE;
+        while (packet_count > 0) {
+            TSPacket* qbuffer = nullptr;
+            TSPacketMetadata* qmdata = nullptr;
+            size_t qsize = 0;
+            if (!_queue.lockWriteBuffer(qbuffer, qmdata, qsize)) {
+                // The application has closed the pipe, abort the pipeline.
+                data->setError(true);
+                return;
+            }
+            const size_t count = std::min(qsize, packet_count);
+            TSPacket::Copy(qbuffer, packets, count);
+            TSPacketMetadata::Reset(qmdata, count);
+            _queue.releaseWriteBuffer(count);
+            packets += count;
+            packet_count -= count;
+        }
+    }
+    else if (data->outputData() != nullptr) {
+        // Input plugin: wait for packets from the application. Returning no packet means end of input.
+        size_t count = 0;
+        BitRate bitrate;
+        _queue.waitPackets(reinterpret_cast<TSPacket*>(data->outputData()), nullptr, data->maxSize() / PKT_SIZE, count, bitrate);
+        data->updateSize(count * PKT_SIZE);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// The thread which waits for the termination of the pipeline.
+//----------------------------------------------------------------------------
+
+ts::TSProcessorPipe::Terminator::Terminator(TSProcessorPipe& pipe) :
+    Thread(ThreadAttributes().setStackSize(128 * 1024)),
+    _pipe(pipe)
+{
+}
+
+ts::TSProcessorPipe::Terminator::~Terminator()
+{
+    waitForTermination();
+}
+
+void ts::TSProcessorPipe::Terminator::main()
+{
+    if (_pipe._direction == WRITE_INPUT && !_pipe._processor->start(_pipe._args)) {
+        // The application can no longer write packets.
+        _pipe._queue.stop();
+        return;
+    }
+    _pipe._processor->waitForTermination();
+    if (_pipe._direction == READ_OUTPUT) {
+        // The application reads the remaining packets, then gets an end of stream.
+        _pipe._queue.setEOF();
+    }
+    else {
+        // The application can no longer write packets.
+        _pipe._queue.stop();
+    }
+}
@@ -0,0 +1,138 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  A tsp pipeline running inside the current process, used as a pipe.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSProcessor.h"
+#include "tsTSPacketQueue.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsThread.h"
+
+namespace ts {
+    //!
+    //! A tsp pipeline running inside the current process, used as a pipe.
+    //! @ingroup libtsduck plugin
+    //!
+    //! This class is an in-process alternative to TSForkPipe when the created process is a
+    //! @c tsp command. Instead of creating a process and exchanging packets over a system pipe,
+    //! the @c tsp plugin chain is built from the same plugin repository and runs in threads of
+    //! the current process. The packets are exchanged through an internal packet queue, without
+    //! system calls and without the serialization of the pipe.
+    //!
+    //! The command line is a @c tsp command line, with or without the leading @c tsp.
+    //! When the application reads packets from the pipeline, the command shall not specify an
+    //! output plugin. When the application writes packets to the pipeline, the command shall
+    //! not specify an input plugin. The missing plugin is internally replaced with a "memory"
+    //! plugin which is connected to the packet queue.
+    //!
+    class TSDUCKDLL TSProcessorPipe: private PluginEventHandlerInterface
+    {
+        TS_NOCOPY(TSProcessorPipe);
+    public:
+        //!
+        //! Direction of the packets between the application and the pipeline.
+        //!
+        enum Direction {
+            READ_OUTPUT,  //!< The application reads the output of the pipeline.
+            WRITE_INPUT,  //!< The application writes the input of the pipeline.
+        };
+
+        //!
+        //! Default constructor.
+        //!
+        TSProcessorPipe() = default;
+
+        //!
+        //! Destructor.
+        //!
+        virtual ~TSProcessorPipe() override;
+
+        //!
+        //! Start the pipeline.
+        //! With WRITE_INPUT, the plugins are started in the background because the input plugin
+        //! waits for the first packets from the application. A plugin initialization error is
+        //! then reported by a subsequent writePackets().
+        //! @param [in] command The @c tsp command line.
+        //! @param [in] direction Direction of the packets.
+        //! @param [in] queue_size Size in packets of the queue between the application and the pipeline.
+        //! @param [in,out] report Where to report errors. Also used by the pipeline plugins.
+        //! Shall remain valid until close() and shall be thread-safe.
+        //! @return True on success, false on error.
+        //!
+        bool open(const UString& command, Direction direction, size_t queue_size, Report& report);
+
+        //!
+        //! Check if the pipeline is started.
+        //! @return True if the pipeline is started.
+        //!
+        bool isOpen() const { return _is_open; }
+
+        //!
+        //! Terminate the pipeline.
+        //! With WRITE_INPUT, the pipeline receives an end of input and completes its processing
+        //! of the already written packets. With READ_OUTPUT, the pipeline is aborted.
+        //! In all cases, the method waits for the termination of the pipeline.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool close(Report& report);
+
+        //!
+        //! Read TS packets from the output of the pipeline (READ_OUTPUT only).
+        //! Wait until at least one packet is available or the pipeline terminates.
+        //! @param [out] buffer Address of the buffer for incoming packets.
+        //! @param [in,out] metadata Optional packet metadata. If the pointer is not null, it should point
+        //! to an array of packet metadata. If a metadata buffer is provided, it must have the same size as
+        //! the packet buffer. The metadata are reset when the pipeline does not transmit them.
+        //! @param [in] max_packets Size of @a buffer in number of packets.
+        //! @param [in,out] report Where to report errors.
+        //! @return The actual number of read packets. Returning zero means error or end of stream.
+        //!
+        size_t readPackets(TSPacket* buffer, TSPacketMetadata* metadata, size_t max_packets, Report& report);
+
+        //!
+        //! Write TS packets to the input of the pipeline (WRITE_INPUT only).
+        //! Wait until there is enough space in the queue.
+        //! @param [in] buffer Address of first packet to write.
+        //! @param [in] metadata Optional packet metadata. The pipeline does not receive them.
+        //! @param [in] packet_count Number of packets to write.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false if the pipeline has terminated.
+        //!
+        bool writePackets(const TSPacket* buffer, const TSPacketMetadata* metadata, size_t packet_count, Report& report);
+
+    private:
+        // A thread which waits for the termination of the pipeline and unblocks the application.
+        // When the application writes the input of the pipeline, the thread also starts the pipeline
+        // because the initial load of the input plugin waits for packets from the application.
+        class Terminator: public Thread
+        {
+            TS_NOBUILD_NOCOPY(Terminator);
+        public:
+            Terminator(TSProcessorPipe& pipe);
+            virtual ~Terminator() override;
+        private:
+            TSProcessorPipe& _pipe;
+            virtual void main() override;
+        };
+
+        Direction                     _direction = READ_OUTPUT;
+        std::atomic_bool              _is_open = false;
+        TSPacketQueue                 _queue {};
+        TSProcessorArgs               _args {};
+        std::unique_ptr<TSProcessor>  _processor {};
+        std::unique_ptr<Terminator>   _terminator {};
+
+        // Invoked by the "memory" plugins of the pipeline.
+        virtual void handlePluginEvent(const PluginEventContext& context) override;
+    };
+}
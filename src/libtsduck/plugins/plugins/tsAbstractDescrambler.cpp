@@ -452,7 +452,7 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
     // If there is a user-specified list of PID's, we don't manage a service
     // and there is nothing else to do.
     if (_pids.any()) {
-        return !_pids.test(pid) || _scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+        return !_pids.test(pid) || descramblePacket(_scrambling, pkt) ? TSP_OK : TSP_END;
     }
 
     // Filter sections to locate the service and grab ECM's.
@@ -474,7 +474,7 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
 
     // Without ECM's, we descramble using fixed control words.
     if (!_need_ecm) {
-        return _scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+        return descramblePacket(_scrambling, pkt) ? TSP_OK : TSP_END;
     }
 
     // Get PID context. If the PID is not known as a scrambled PID,
@@ -504,6 +504,11 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
     if ((scv == SC_EVEN_KEY && pecm->new_cw_even) || (scv == SC_ODD_KEY && pecm->new_cw_odd)) {
 
         // A new CW was deciphered.
+        // Queued packets must be descrambled with the previous CW first.
+        if (!flushPackets()) {
+            return TSP_END;
+        }
+
         // In asynchronous mode, the CW are accessed under mutex protection.
         if (!_synchronous) {
             _mutex.lock();
@@ -527,5 +532,72 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
     }
 
     // Descramble the packet payload.
-    return pecm->scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+    return descramblePacket(pecm->scrambling, pkt) ? TSP_OK : TSP_END;
+}
+
+
+//----------------------------------------------------------------------------
+// Packet window processing: the packets are individually analyzed but the
+// descrambling is performed on groups of packets, which is faster with
+// DVB-CSA2 since its implementation processes many packets in parallel.
+//----------------------------------------------------------------------------
+
+size_t ts::AbstractDescrambler::getPacketWindowSize()
+{
+    return WINDOW_SIZE;
+}
+
+size_t ts::AbstractDescrambler::processPacketWindow(TSPacketWindow& win)
+{
+    _window_mode = true;
+
+    TSPacket* pkt = nullptr;
+    TSPacketMetadata* pkt_data = nullptr;
+    size_t index = 0;
+
+    for (; index < win.size(); ++index) {
+        if (win.get(index, pkt, pkt_data)) {
+            const Status status = processPacket(*pkt, *pkt_data);
+            if (status == TSP_END) {
+                break;
+            }
+            else if (status == TSP_NULL) {
+                win.nullify(index);
+            }
+            else if (status == TSP_DROP) {
+                win.drop(index);
+            }
+        }
+    }
+
+    // Descramble all remaining queued packets before returning the window.
+    _window_mode = false;
+    // In case of descrambling error, terminate before this window.
+    return flushPackets() ? index : 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Descramble a packet, immediately or later in packet window mode.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractDescrambler::descramblePacket(TSScrambling& scrambling, TSPacket& pkt)
+{
+    if (!_window_mode) {
+        return scrambling.decrypt(pkt);
+    }
+    if (&scrambling != _queued_scrambling && !flushPackets()) {
+        return false;
+    }
+    _queued_scrambling = &scrambling;
+    _queued_packets.push_back(&pkt);
+    return true;
+}
+
+bool ts::AbstractDescrambler::flushPackets()
+{
+    const bool ok = _queued_packets.empty() || _queued_scrambling->decrypt(_queued_packets.data(), _queued_packets.size());
+    _queued_packets.clear();
+    _queued_scrambling = nullptr;
+    return ok;
 }
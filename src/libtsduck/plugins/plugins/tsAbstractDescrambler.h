@@ -37,6 +37,8 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t getPacketWindowSize() override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     protected:
         //!
@@ -160,6 +162,10 @@ namespace ts {
         virtual void handleSection(SectionDemux& demux, const Section& section) override;
 
     private:
+        // Number of packets in a packet window. The scrambled packets of a window are descrambled
+        // together. This is a trade-off between the efficiency of parallel descrambling and latency.
+        static constexpr size_t WINDOW_SIZE = 8 * DVBCSA2::PARALLEL_COUNT;
+
         // Description of a scrambled stream with its possible ECM PID's.
         // Each elementary stream in the service can be potentially scrambled.
         // Each of them has an entry in _scrambled_streams with the list of valid ECM PID's.
@@ -234,6 +240,13 @@ namespace ts {
         // Analyze a list of descriptors from the PMT, looking for ECM PID's
         void analyzeDescriptors(const DescriptorList& dlist, std::set<PID>& ecm_pids, uint8_t& scrambling);
 
+        // Descramble a packet. In packet window mode, the packet is only queued and will be
+        // descrambled later with other packets. Return false on error.
+        bool descramblePacket(TSScrambling& scrambling, TSPacket& pkt);
+
+        // Descramble all queued packets. Return false on error.
+        bool flushPackets();
+
         // Abstract descrambler private data.
         bool                    _use_service = false;         // Descramble a service (ie. not a specific list of PID's).
         bool                    _need_ecm = false;            // We need to get control words from ECM's.
@@ -250,6 +263,9 @@ namespace ts {
         std::mutex              _mutex {};                    // Exclusive access to protected areas
         std::condition_variable _ecm_to_do {};                // Notify thread to process ECM.
         ECMThread               _ecm_thread {this};           // Thread which deciphers ECM's.
+        bool                    _window_mode = false;         // Currently processing a packet window.
+        TSScrambling*           _queued_scrambling = nullptr; // Descrambling of queued packets.
+        std::vector<TSPacket*>  _queued_packets {};           // Packets to descramble in packet window mode.
         // -- start of protected area --
         bool                    _stop_thread = false;         // Terminate ECM processing thread
         // -- end of protected area --
@@ -27,6 +27,14 @@ ts::ForkOutputPlugin::ForkOutputPlugin(TSP* tsp_) :
     option(u"buffered-packets", 'b', POSITIVE);
     help(u"buffered-packets", u"Windows only: Specifies the pipe buffer size in number of TS packets.");
 
+    option(u"in-process");
+    help(u"in-process",
+         u"The command is a tsp command line which is executed inside the current process, "
+         u"in its own threads, instead of creating a new process. "
+         u"The leading \"tsp\" is optional and the command shall not specify an input plugin. "
+         u"The packets are directly passed in memory, without pipe. "
+         u"The options --format and --nowait are ignored.");
+
     option(u"nowait", 'n');
     help(u"nowait", u"Do not wait for child process termination at end of input.");
 }
@@ -42,6 +50,7 @@ bool ts::ForkOutputPlugin::getOptions()
     getValue(_command, u"");
     getIntValue(_buffer_size, u"buffered-packets", 0);
     _nowait = present(u"nowait");
+    _in_process = present(u"in-process");
     _format = LoadTSPacketFormatOutputOption(*this);
     return true;
 }
@@ -49,6 +58,11 @@ bool ts::ForkOutputPlugin::getOptions()
 
 bool ts::ForkOutputPlugin::start()
 {
+    // With --in-process, run the tsp pipeline in the same process.
+    if (_in_process) {
+        return _branch.open(_command, TSProcessorPipe::WRITE_INPUT, std::max<size_t>(_buffer_size, 1000), *this);
+    }
+
     // Create pipe & process.
     return _pipe.open(_command,
                       _nowait ? ForkPipe::ASYNCHRONOUS : ForkPipe::SYNCHRONOUS,
@@ -61,10 +75,13 @@ bool ts::ForkOutputPlugin::start()
 
 bool ts::ForkOutputPlugin::stop()
 {
-    return _pipe.close(*this);
+    return _in_process ? _branch.close(*this) : _pipe.close(*this);
 }
 
 bool ts::ForkOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata* pkt_data, size_t packet_count)
 {
+    if (_in_process) {
+        return _branch.writePackets(buffer, pkt_data, packet_count, *this);
+    }
     return _pipe.writePackets(buffer, pkt_data, packet_count, *this);
 }
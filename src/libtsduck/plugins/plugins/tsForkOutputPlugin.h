@@ -15,6 +15,7 @@
 #pragma once
 #include "tsOutputPlugin.h"
 #include "tsTSForkPipe.h"
+#include "tsTSProcessorPipe.h"
 
 namespace ts {
     //!
@@ -35,8 +36,10 @@ namespace ts {
     private:
         UString        _command {};       // The command to run.
         bool           _nowait = false;   // Don't wait for children termination.
+        bool           _in_process = false; // Run the command as a tsp pipeline in the same process.
         TSPacketFormat _format = TSPacketFormat::TS;  // Packet format on the pipe
         size_t         _buffer_size = 0;  // Pipe buffer size in packets.
         TSForkPipe     _pipe {};          // The pipe device.
+        TSProcessorPipe _branch {};       // The in-process tsp pipeline, with --in-process.
     };
 }
@@ -20,12 +20,14 @@ ts::ForkPacketPlugin::ForkPacketPlugin(TSP* tsp_) :
     ProcessorPlugin(tsp_, u"Fork a process and send TS packets to its standard input", u"[options] 'command'"),
     _command(),
     _nowait(false),
+    _in_process(false),
     _format(TSPacketFormat::TS),
     _buffer_size(0),
     _buffer_count(0),
     _buffer(),
     _mdata(),
-    _pipe()
+    _pipe(),
+    _branch()
 {
     DefineTSPacketFormatOutputOption(*this);
 
@@ -44,6 +46,14 @@ ts::ForkPacketPlugin::ForkPacketPlugin(TSP* tsp_) :
          u"Ignore early termination of child process. By default, if the child "
          u"process aborts and no longer reads the packets, tsp also aborts.");
 
+    option(u"in-process");
+    help(u"in-process",
+         u"The command is a tsp command line which is executed inside the current process, "
+         u"in its own threads, instead of creating a new process. "
+         u"The leading \"tsp\" is optional and the command shall not specify an input plugin. "
+         u"The packets are directly passed in memory, without pipe. "
+         u"The options --format and --nowait are ignored.");
+
     option(u"nowait", 'n');
     help(u"nowait", u"Do not wait for child process termination at end of input.");
 }
@@ -60,6 +70,7 @@ bool ts::ForkPacketPlugin::getOptions()
     getValue(_command, u"");
     getIntValue(_buffer_size, u"buffered-packets", tsp->realtime() ? 500 : 1000);
     _nowait = present(u"nowait");
+    _in_process = present(u"in-process");
     _format = LoadTSPacketFormatOutputOption(*this);
     _pipe.setIgnoreAbort(present(u"ignore-abort"));
 
@@ -76,6 +87,11 @@ bool ts::ForkPacketPlugin::start()
     // Reset buffer usage.
     _buffer_count = 0;
 
+    // With --in-process, run the tsp pipeline in the same process.
+    if (_in_process) {
+        return _branch.open(_command, TSProcessorPipe::WRITE_INPUT, std::max<size_t>(_buffer_size, 1000), *this);
+    }
+
     // Create pipe & process.
     return _pipe.open(_command,
                       _nowait ? ForkPipe::ASYNCHRONOUS : ForkPipe::SYNCHRONOUS,
@@ -91,11 +107,11 @@ bool ts::ForkPacketPlugin::stop()
 {
     // Flush buffered packets.
     if (_buffer_count > 0) {
-        _pipe.writePackets(_buffer.data(), _mdata.data(), _buffer_count, *this);
+        writePackets(_buffer.data(), _mdata.data(), _buffer_count);
     }
 
     // Close the pipe
-    return _pipe.close(*this);
+    return _in_process ? _branch.close(*this) : _pipe.close(*this);
 }
 
 
@@ -103,7 +119,7 @@ ts::ProcessorPlugin::Status ts::ForkPacketPlugin::processPacket(TSPacket& pkt, T
 {
     // If packets are sent one by one, just send it.
     if (_buffer_size == 0) {
-        return _pipe.writePackets(&pkt, &pkt_data, 1, *this) ? TSP_OK : TSP_END;
+        return writePackets(&pkt, &pkt_data, 1) ? TSP_OK : TSP_END;
     }
 
     // Add the packet to the buffer
@@ -114,8 +130,14 @@ ts::ProcessorPlugin::Status ts::ForkPacketPlugin::processPacket(TSPacket& pkt, T
     // Flush the buffer when full
     if (_buffer_count == _buffer.size()) {
         _buffer_count = 0;
-        return _pipe.writePackets(_buffer.data(), _mdata.data(), _buffer.size(), *this) ? TSP_OK : TSP_END;
+        return writePackets(_buffer.data(), _mdata.data(), _buffer.size()) ? TSP_OK : TSP_END;
     }
 
     return TSP_OK;
 }
+
+
+bool ts::ForkPacketPlugin::writePackets(const TSPacket* packets, const TSPacketMetadata* mdata, size_t count)
+{
+    return _in_process ? _branch.writePackets(packets, mdata, count, *this) : _pipe.writePackets(packets, mdata, count, *this);
+}
@@ -15,6 +15,7 @@
 #pragma once
 #include "tsProcessorPlugin.h"
 #include "tsTSForkPipe.h"
+#include "tsTSProcessorPipe.h"
 
 namespace ts {
     //!
@@ -35,11 +36,16 @@ namespace ts {
     private:
         UString                _command {};        // The command to run.
         bool                   _nowait = false;    // Don't wait for children termination.
+        bool                   _in_process = false; // Run the command as a tsp pipeline in the same process.
         TSPacketFormat         _format = TSPacketFormat::TS;  // Packet format on the pipe
         size_t                 _buffer_size = 0;   // Max number of packets in buffer.
         size_t                 _buffer_count = 0;  // Number of packets currently in buffer.
         TSPacketVector         _buffer {};         // Packet buffer.
         TSPacketMetadataVector _mdata {};          // Metadata for packets in buffer.
         TSForkPipe             _pipe {};           // The pipe device.
+        TSProcessorPipe        _branch {};         // The in-process tsp pipeline, with --in-process.
+
+        // Send packets to the pipe or the pipeline.
+        bool writePackets(const TSPacket*, const TSPacketMetadata*, size_t);
     };
 }
@@ -81,16 +81,46 @@ ts::ProcessorPlugin::Status ts::ProcessorPlugin::processPacket(TSPacket& pkt, TS
 }
 
 
+//----------------------------------------------------------------------------
+// Default implementations of packet batch processing interface.
+//----------------------------------------------------------------------------
+
+size_t ts::ProcessorPlugin::processPackets(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    // Same dirty hack as in processPacketWindow(): the packet counters are updated
+    // by the plugin executor after returning from processPackets(). When processPacket()
+    // is called for each packet, the counters must be incremented after each packet.
+    const PacketCounter saved_total_packets = tsp->_total_packets;
+    const PacketCounter saved_plugin_packets = tsp->_plugin_packets;
+
+    size_t processed_packets = 0;
+    while (processed_packets < count) {
+        status[processed_packets] = processPacket(pkt[processed_packets], pkt_data[processed_packets]);
+        tsp->_plugin_packets++;
+        tsp->_total_packets++;
+        if (status[processed_packets++] == TSP_END) {
+            break;
+        }
+    }
+
+    // Restore hacked values.
+    tsp->_total_packets = saved_total_packets;
+    tsp->_plugin_packets = saved_plugin_packets;
+
+    return processed_packets;
+}
+
+
 //----------------------------------------------------------------------------
 // Default implementations of packet window processing interface.
 //----------------------------------------------------------------------------
 
 size_t ts::ProcessorPlugin::processPacketWindow(TSPacketWindow& win)
 {
-    // The default implementation calls processPacket() for each packet.
+    // The default implementation calls processPackets() for each packet.
     // Thus, if a plugin accidentally returns a non-zero window size without
     // overriding processPacketWindow(), the packet processing still applies
-    // with the default method.
+    // with the default method. The default processPackets() calls processPacket().
 
     // Warning: dirty hack :(
     // The values for tsp->pluginPackets() and tsp->totalPacketsInThread()
@@ -108,7 +138,8 @@ size_t ts::ProcessorPlugin::processPacketWindow(TSPacketWindow& win)
 
     while (processed_packets < win.size()) {
         if (win.get(processed_packets, pkt, mdata)) {
-            const Status status = processPacket(*pkt, *mdata);
+            Status status = TSP_OK;
+            processPackets(pkt, mdata, &status, 1);
             if (status == TSP_NULL) {
                 win.nullify(processed_packets);
             }
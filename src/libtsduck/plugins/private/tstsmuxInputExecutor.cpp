@@ -59,37 +59,9 @@ void ts::tsmux::InputExecutor::terminate()
 
 bool ts::tsmux::InputExecutor::getPackets(TSPacket* pkt, TSPacketMetadata* mdata, size_t max_count, size_t& ret_count, bool blocking)
 {
-    // In blocking mode, loop until there is some packet in the buffer.
-    std::unique_lock<std::recursive_mutex> lock(_mutex);
-    while (!_terminate && blocking && _packets_count == 0) {
-        _got_packets.wait(lock);
-    }
-
+    // In blocking mode, wait until there is some packet in the buffer.
     // Return error if the input is terminated _and_ there is no more packet to read.
-    if (_terminate && _packets_count == 0) {
-        ret_count = 0;
-        return false;
-    }
-
-    // Fill what can be filled from the buffer. We are still under the mutex protection.
-    assert(_packets_count <= _buffer_size);
-
-    // Number of packets to copy from the buffer:
-    ret_count = std::min(std::min(max_count, _packets_count), _buffer_size - _packets_first);
-
-    // Copy packets if there are some.
-    if (ret_count > 0) {
-        TSPacket::Copy(pkt, &_packets[_packets_first], ret_count);
-        TSPacketMetadata::Copy(mdata, &_metadata[_packets_first], ret_count);
-        _packets_first = (_packets_first + ret_count) % _buffer_size;
-        _packets_count -= ret_count;
-
-        // Signal that there are some free space.
-        // The mutex was initially locked for the _got_packets condition because we needed to wait
-        // for that condition but we can also use it to signal the _got_freespace condition.
-        _got_freespace.notify_all();
-    }
-    return true;
+    return _ring.read(pkt, mdata, max_count, ret_count, blocking);
 }
 
 
@@ -104,39 +76,28 @@ void ts::tsmux::InputExecutor::main()
     // Loop until we are instructed to stop.
     while (!_terminate) {
 
-        // Wait for free space to be available in the input buffer.
-        size_t first = 0;
-        size_t count = 0;
-        {
-            std::unique_lock<std::recursive_mutex> lock(_mutex);
-            // In case of lossy input, drop oldest packets when the buffer is full.
-            if (_opt.lossyInput && _packets_count >= _buffer_size) {
-                const size_t dropped = std::min(_opt.lossyReclaim, _buffer_size);
-                _packets_first = (_packets_first + dropped) % _buffer_size;
-                _packets_count -= dropped;
-            }
-            // Wait for free space in the buffer.
-            while (!_terminate && _packets_count >= _buffer_size) {
-                _got_freespace.wait(lock);
-            }
-            // We can use this contiguous free area at the end of already received packets.
-            first = (_packets_first + _packets_count) % _buffer_size;
-            count = std::min(_buffer_size - _packets_count, _buffer_size - first);
+        // In case of lossy input, drop oldest packets when the buffer is full.
+        if (_opt.lossyInput && _ring.currentSize() >= _buffer_size) {
+            _ring.dropOldest(std::min(_opt.lossyReclaim, _buffer_size));
         }
 
+        // Wait for free space in the buffer. We can use this contiguous free area at the end of already received packets.
+        TSPacket* pkt = nullptr;
+        TSPacketMetadata* mdata = nullptr;
+        size_t count = 0;
+
         // Read some packets.
-        if (!_terminate) {
-            count = _input->receive(&_packets[first], &_metadata[first], std::min(count, _opt.maxInputPackets));
+        if (_ring.lockWrite(pkt, mdata, count) && !_terminate) {
+            count = _input->receive(pkt, mdata, std::min(count, _opt.maxInputPackets));
             if (count > 0) {
-                // Packets successfully received.
-                std::unique_lock<std::recursive_mutex> lock(_mutex);
-                _packets_count += count;
-                // Signal that there are some new packets in the buffer.
-                _got_packets.notify_all();
+                // Packets successfully received, signal that there are some new packets in the buffer.
+                _ring.commitWrite(count);
             }
             else if (_opt.inputOnce) {
                 // Terminates when the input plugin terminates or fails.
+                // The remaining packets in the buffer can still be read.
                 _terminate = true;
+                _ring.stop();
             }
             else {
                 // Restart when the plugin terminates or fails.
@@ -84,9 +84,7 @@ void ts::tsmux::PluginExecutor::signalPluginEvent(uint32_t event_code, Object* p
 
 void ts::tsmux::PluginExecutor::terminate()
 {
-    // Locked the mutex on behalf of the two conditions.
-    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    // Release the producer and consumer threads if they are waiting.
     _terminate = true;
-    _got_packets.notify_all();
-    _got_freespace.notify_all();
+    _ring.stop();
 }
@@ -15,8 +15,7 @@
 #include "tsPluginThread.h"
 #include "tsMuxerArgs.h"
 #include "tsPluginEventHandlerRegistry.h"
-#include "tsTSPacket.h"
-#include "tsTSPacketMetadata.h"
+#include "tsTSPacketRing.h"
 
 namespace ts {
     namespace tsmux {
@@ -65,15 +64,9 @@ namespace ts {
 
         protected:
             const MuxerArgs&       _opt;                     //!< Command line options.
-            std::recursive_mutex   _mutex {};                //!< Protects modifications in the buffer.
-            std::condition_variable_any _got_packets {};     //!< Wake-up condition: there are new packets in the buffer.
-            std::condition_variable_any _got_freespace {};   //!< Wake-up condition: there are more free packets in the buffer.
-            volatile bool          _terminate = false;       //!< Termination request, sometimes accessed outside mutex, goes from false to true only once.
-            size_t                 _packets_first = 0;       //!< Index in the buffer of the first packet.
-            size_t                 _packets_count = 0;       //!< Number of packets to output.
+            std::atomic_bool       _terminate = false;       //!< Termination request, goes from false to true only once.
             const size_t           _buffer_size;             //!< Size of the packet buffer.
-            TSPacketVector         _packets {_buffer_size};  //!< Input or output packet circular buffer.
-            TSPacketMetadataVector _metadata {_buffer_size}; //!< Input or output metadata circular buffer.
+            TSPacketRing           _ring {_buffer_size};     //!< Input or output packet circular buffer, single producer, single consumer.
 
         private:
             const PluginEventHandlerRegistry& _handlers;  //!< Registry of event handlers.
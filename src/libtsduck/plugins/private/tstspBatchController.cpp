@@ -0,0 +1,204 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tstspBatchController.h"
+
+namespace {
+    // Interval between two adjustments of the batch size.
+    constexpr cn::milliseconds ADJUST_INTERVAL = cn::milliseconds(500);
+
+    // Minimum batch size, in packets (the content of one UDP datagram).
+    constexpr size_t MIN_BATCH = 7;
+
+    // Number of wake-ups per second and per thread above which the batches are considered too small.
+    constexpr uint64_t HIGH_WAKEUP_RATE = 1000;
+
+    // Buffer occupancy, in percent, above which the output is the bottleneck (backpressure).
+    constexpr size_t HIGH_OCCUPANCY = 75;
+}
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::tsp::BatchController::BatchController(const TSProcessorArgs& options, Report& log, std::recursive_mutex& global_mutex, InputExecutor* input) :
+    _options(options),
+    _log(log.maxSeverity(), u"adaptive batch: ", &log)
+{
+    // Collect all plugins, from input to output.
+    if (input != nullptr) {
+        std::lock_guard<std::recursive_mutex> lock(global_mutex);
+        PluginExecutor* proc = input;
+        do {
+            _plugins.push_back(proc);
+        } while ((proc = proc->ringNext<PluginExecutor>()) != input);
+    }
+
+    // Bounds and initial value of the batch size. The largest batch is a quarter of the buffer.
+    _max_batch = std::max(MIN_BATCH, _options.ts_buffer_size / PKT_SIZE / 4);
+    _batch = std::clamp(_options.max_flush_pkt, MIN_BATCH, _max_batch);
+    _unlimited_input = _options.max_input_pkt == 0;
+}
+
+ts::tsp::BatchController::~BatchController()
+{
+    // Terminate the thread and wait for actual thread termination.
+    close();
+    waitForTermination();
+}
+
+
+//----------------------------------------------------------------------------
+// Start/stop the controller.
+//----------------------------------------------------------------------------
+
+bool ts::tsp::BatchController::open()
+{
+    if (!_options.adaptive_batch || _plugins.empty()) {
+        // No adaptive batch size, do nothing.
+        return true;
+    }
+    else if (_is_open) {
+        _log.error(u"tsp batch controller already started");
+        return false;
+    }
+    else {
+        _is_open = true;
+        return start();
+    }
+}
+
+void ts::tsp::BatchController::close()
+{
+    if (_is_open) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _terminate = true;
+            _wake.notify_one();
+        }
+        waitForTermination();
+        _is_open = false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Invoked in the context of the controller thread.
+//----------------------------------------------------------------------------
+
+void ts::tsp::BatchController::main()
+{
+    _log.debug(u"controller thread started, target %s, batch size: %'d packets, max: %'d",
+               _options.target_latency > cn::milliseconds::zero() ? UString::Chrono(_options.target_latency) : UString(u"throughput"), _batch, _max_batch);
+
+    _previous.resize(_plugins.size());
+    for (size_t i = 0; i < _plugins.size(); ++i) {
+        _plugins[i]->getMetrics(_previous[i]);
+    }
+    _previous_time = monotonic_time::clock::now();
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_wake.wait_for(lock, ADJUST_INTERVAL, [this]() { return bool(_terminate); })) {
+                break;
+            }
+        }
+        adjust();
+    }
+    _log.debug(u"controller thread completed, batch size: %'d packets", _batch);
+}
+
+
+//----------------------------------------------------------------------------
+// Collect the metrics and adjust the batch size.
+//----------------------------------------------------------------------------
+
+void ts::tsp::BatchController::adjust()
+{
+    // Get a snapshot of all plugins.
+    std::vector<PluginExecutor::Metrics> metrics(_plugins.size());
+    for (size_t i = 0; i < _plugins.size(); ++i) {
+        _plugins[i]->getMetrics(metrics[i]);
+    }
+    const monotonic_time now = monotonic_time::clock::now();
+    const uint64_t elapsed_ms = std::max<uint64_t>(1, cn::duration_cast<cn::milliseconds>(now - _previous_time).count());
+
+    // Packets which were output during the interval and number of thread wake-ups.
+    const uint64_t output_packets = metrics.back().total_packets - _previous.back().total_packets;
+    uint64_t waits = 0;
+    for (size_t i = 0; i < metrics.size(); ++i) {
+        waits += metrics[i].wait_count - _previous[i].wait_count;
+    }
+    _previous.swap(metrics);
+    _previous_time = now;
+
+    // Packets in the buffer between the input and the output. The buffer area of the input plugin is the free space.
+    size_t in_flight = 0;
+    for (size_t i = 1; i < _previous.size(); ++i) {
+        in_flight += _previous[i].buffer_packets;
+    }
+
+    // Nothing can be evaluated when no packet flows through the chain.
+    if (output_packets == 0) {
+        return;
+    }
+
+    const uint64_t rate = output_packets * 1000 / elapsed_ms;                    // packets per second
+    const uint64_t latency_ms = in_flight * 1000 / std::max<uint64_t>(1, rate);  // latency through the buffer
+    const uint64_t wakeup_rate = waits * 1000 / elapsed_ms / _plugins.size();    // wake-ups per second and per thread
+    const size_t occupancy = 100 * in_flight / std::max<size_t>(1, _options.ts_buffer_size / PKT_SIZE);
+
+    _log.debug(u"rate: %'d packets/s, in buffer: %'d packets, latency: %'d ms, wake-ups: %'d/s", rate, in_flight, latency_ms, wakeup_rate);
+
+    const size_t previous = _batch;
+    const UChar* reason = u"";
+    if (_options.target_latency > cn::milliseconds::zero()) {
+        // Latency objective: quickly reduce the batch size when the latency is too high,
+        // slowly increase it again when there is enough margin and the threads wake up too often.
+        const uint64_t target_ms = _options.target_latency.count();
+        if (latency_ms > target_ms) {
+            _batch = std::max(MIN_BATCH, _batch / 2);
+            reason = u"latency above target";
+        }
+        else if (latency_ms < target_ms / 4 && wakeup_rate > HIGH_WAKEUP_RATE) {
+            _batch = std::min(_max_batch, _batch + std::max<size_t>(1, _batch / 4));
+            reason = u"latency well below target";
+        }
+    }
+    else if (wakeup_rate > HIGH_WAKEUP_RATE && occupancy < HIGH_OCCUPANCY) {
+        // Throughput objective: increase the batch size when the threads wake up too often.
+        // When the buffer is almost full, the output is the bottleneck and larger batches would not help.
+        _batch = std::min(_max_batch, 2 * _batch);
+        reason = u"frequent wake-ups";
+    }
+
+    if (_batch != previous) {
+        _log.verbose(u"%s, batch size: %'d -> %'d packets (rate: %'d packets/s, latency: %'d ms, wake-ups: %'d/s, buffer: %d%%)",
+                     reason, previous, _batch, rate, latency_ms, wakeup_rate, occupancy);
+        apply();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Apply the batch size to the input and packet processor plugins.
+//----------------------------------------------------------------------------
+
+void ts::tsp::BatchController::apply()
+{
+    // With a throughput objective, never limit input operations which were initially unlimited.
+    const bool limit_input = !_unlimited_input || _options.target_latency > cn::milliseconds::zero();
+
+    for (size_t i = 0; i + 1 < _plugins.size(); ++i) {
+        if (i > 0 || limit_input) {
+            _plugins[i]->setBatchLimit(_batch);
+        }
+    }
+}
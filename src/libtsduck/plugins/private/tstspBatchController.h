@@ -0,0 +1,83 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Transport stream processor adaptive batch size controller.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSProcessorArgs.h"
+#include "tstspInputExecutor.h"
+#include "tstspPluginExecutor.h"
+#include "tsThread.h"
+
+namespace ts {
+    namespace tsp {
+        //!
+        //! Transport stream processor adaptive batch size controller.
+        //! The execution metrics of all plugins are periodically sampled. The maximum number of packets
+        //! per input operation and the maximum number of processed packets before flush are adjusted
+        //! to reach a target latency through the buffer or to reduce the wake-up frequency of the threads.
+        //! This class is internal to the TSDuck library and cannot be called by applications.
+        //! @ingroup libtsduck plugin
+        //!
+        class BatchController : private Thread
+        {
+            TS_NOBUILD_NOCOPY(BatchController);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] options Command line options for tsp.
+            //! @param [in,out] log Log report.
+            //! @param [in,out] global_mutex Global mutex to synchronize access to the packet buffer.
+            //! @param [in] input Input plugin executor (start of plugin chain).
+            //!
+            BatchController(const TSProcessorArgs& options, Report& log, std::recursive_mutex& global_mutex, InputExecutor* input);
+
+            //!
+            //! Destructor.
+            //!
+            virtual ~BatchController() override;
+
+            //!
+            //! Start the batch size controller.
+            //! @return True on success, false on error.
+            //!
+            bool open();
+
+            //!
+            //! Stop the batch size controller.
+            //!
+            void close();
+
+        private:
+            volatile bool                 _is_open = false;
+            volatile bool                 _terminate = false;
+            const TSProcessorArgs&        _options;
+            Report                        _log;
+            std::mutex                    _mutex {};            // Protect _wake.
+            std::condition_variable       _wake {};             // Wake up the controller thread.
+            std::vector<PluginExecutor*>  _plugins {};          // All plugins, from input to output.
+            std::vector<PluginExecutor::Metrics> _previous {};  // Metrics at previous adjustment, same index as _plugins.
+            monotonic_time                _previous_time {};    // Time of previous adjustment.
+            size_t                        _batch = 0;           // Current batch size.
+            size_t                        _max_batch = 0;       // Maximum batch size.
+            bool                          _unlimited_input = false; // Input operations were initially unlimited.
+
+            // Implementation of Thread.
+            virtual void main() override;
+
+            // Collect the metrics and adjust the batch size.
+            void adjust();
+
+            // Apply the batch size to the input and packet processor plugins.
+            void apply();
+        };
+    }
+}
@@ -232,7 +232,9 @@ size_t ts::tsp::InputExecutor::receiveAndValidate(size_t index, size_t max_packe
     if (_use_watchdog) {
         _watchdog.restart();
     }
+    const monotonic_time start(metricsStart());
     size_t count = _input->receive(pkt, data, max_packets);
+    addBusyTime(start);
     _plugin_completed = _plugin_completed || count == 0;
     if (_use_watchdog) {
         _watchdog.suspend();
@@ -432,9 +434,10 @@ void ts::tsp::InputExecutor::main()
             break;
         }
 
-        // Do not read more packets than request by --max-input-packets
-        if (_options.max_input_pkt > 0 && pkt_max > _options.max_input_pkt) {
-            pkt_max = _options.max_input_pkt;
+        // Do not read more packets than request by --max-input-packets (or its adaptive value).
+        const size_t max_input = batchLimit();
+        if (max_input > 0 && pkt_max > max_input) {
+            pkt_max = max_input;
         }
 
         // Now read at most the specified number of packets (pkt_max).
@@ -489,6 +492,9 @@ void ts::tsp::InputExecutor::main()
 
     } while (!input_end);
 
+    // Publish the final packet counters.
+    publishMetrics(true);
+
     // Close the input processor.
     debug(u"stopping the input plugin");
     _input->stop();
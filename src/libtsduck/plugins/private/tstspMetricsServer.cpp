@@ -0,0 +1,333 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tstspMetricsServer.h"
+#include "tsErrCodeReport.h"
+#include "tsNullReport.h"
+#include "tsReportBuffer.h"
+
+namespace {
+    // Timeout for the reception of an HTTP request.
+    constexpr cn::milliseconds REQUEST_TIMEOUT = cn::seconds(5);
+
+    // Maximum number of header lines in an HTTP request.
+    constexpr size_t MAX_HEADER_LINES = 100;
+
+    // Content type of the OpenMetrics text format.
+    const std::string CONTENT_TYPE("application/openmetrics-text; version=1.0.0; charset=utf-8");
+
+    // Format a duration in seconds, with nanosecond precision, independently of the locale.
+    std::string Seconds(cn::nanoseconds value)
+    {
+        const auto ns = std::max<cn::nanoseconds::rep>(0, value.count());
+        std::string frac(std::to_string(ns % 1'000'000'000));
+        frac.insert(0, 9 - frac.size(), '0');
+        return std::to_string(ns / 1'000'000'000) + '.' + frac;
+    }
+
+    // Escape a label value.
+    std::string LabelValue(const ts::UString& value)
+    {
+        std::string result;
+        for (char c : value.toUTF8()) {
+            if (c == '\\' || c == '"') {
+                result.push_back('\\');
+                result.push_back(c);
+            }
+            else if (c == '\n') {
+                result.append("\\n");
+            }
+            else {
+                result.push_back(c);
+            }
+        }
+        return result;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::tsp::MetricsServer::MetricsServer(const TSProcessorArgs& options, Report& log, std::recursive_mutex& global_mutex, InputExecutor* input) :
+    _options(options),
+    _log(log.maxSeverity(), u"metrics: ", &log)
+{
+    // Collect all plugins, from input to output, and the constant part of their labels.
+    if (input != nullptr) {
+        std::lock_guard<std::recursive_mutex> lock(global_mutex);
+        PluginExecutor* proc = input;
+        do {
+            const PluginType type = proc->plugin()->type();
+            const char* const type_name = type == PluginType::INPUT ? "input" : (type == PluginType::OUTPUT ? "output" : "processor");
+            _names.push_back("{index=\"" + std::to_string(_plugins.size()) + "\",type=\"" + type_name + "\",name=\"" + LabelValue(proc->pluginName()) + "\"");
+            _plugins.push_back(proc);
+        } while ((proc = proc->ringNext<PluginExecutor>()) != input);
+    }
+}
+
+ts::tsp::MetricsServer::~MetricsServer()
+{
+    // Terminate the thread and wait for actual thread termination.
+    close();
+    waitForTermination();
+}
+
+
+//----------------------------------------------------------------------------
+// Start/stop the metrics server.
+//----------------------------------------------------------------------------
+
+bool ts::tsp::MetricsServer::open()
+{
+    if (!_options.metricsEnabled()) {
+        // No metrics server, do nothing.
+        return true;
+    }
+    else if (_is_open) {
+        _log.error(u"tsp metrics server already started");
+        return false;
+    }
+    else if (_options.metrics_port != 0) {
+        // Open the TCP server.
+        const IPSocketAddress addr(_options.metrics_local, _options.metrics_port);
+        if (!_server.open(_options.metrics_local.generation(), _log) ||
+            !_server.bind(addr, _log) ||
+            !_server.listen(5, _log))
+        {
+            _server.close(NULLREP);
+            _log.error(u"error starting TCP server for execution metrics");
+            return false;
+        }
+    }
+
+    // Start the thread.
+    _is_open = true;
+    return start();
+}
+
+void ts::tsp::MetricsServer::close()
+{
+    if (_is_open) {
+        // Close the TCP server or wake up the file update. This will force the server thread to terminate.
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _terminate = true;
+            _wake.notify_one();
+        }
+        if (_options.metrics_port != 0) {
+            _server.close(NULLREP);
+        }
+
+        // Wait for the termination of the thread.
+        waitForTermination();
+        _is_open = false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Invoked in the context of the server thread.
+//----------------------------------------------------------------------------
+
+void ts::tsp::MetricsServer::main()
+{
+    _log.debug(u"metrics thread started");
+    if (_options.metrics_port != 0) {
+        serveHTTP();
+    }
+    else {
+        updateFile();
+    }
+    _log.debug(u"metrics thread completed");
+}
+
+
+//----------------------------------------------------------------------------
+// Serve HTTP requests until the server is closed.
+//----------------------------------------------------------------------------
+
+void ts::tsp::MetricsServer::serveHTTP()
+{
+    // Get accept errors in a buffer since some errors are normal.
+    ReportBuffer<ThreadSafety::None> error(_log.maxSeverity());
+
+    // Client address and connection.
+    IPSocketAddress source;
+    TelnetConnection conn;
+
+    // Loop on incoming connections. The requests are short, treat only one at a time.
+    while (_server.accept(conn, source, error)) {
+        _log.debug(u"metrics request from %s", source);
+        if (conn.setReceiveTimeout(REQUEST_TIMEOUT, _log)) {
+            processRequest(conn);
+        }
+        conn.closeWriter(NULLREP);
+        conn.close(NULLREP);
+    }
+
+    // If termination was requested, receive error is not an error.
+    if (!_terminate && !error.empty()) {
+        _log.error(error.messages());
+    }
+}
+
+void ts::tsp::MetricsServer::processRequest(TelnetConnection& conn)
+{
+    // Get the request line, then skip the headers until an empty line.
+    std::string request;
+    std::string line;
+    if (!conn.receiveLine(request, nullptr, _log)) {
+        return;
+    }
+    for (size_t count = 0; count < MAX_HEADER_LINES && conn.receiveLine(line, nullptr, NULLREP) && !line.empty(); ++count) {
+    }
+
+    // Request line: method, target, version.
+    const size_t sp1 = request.find(' ');
+    const size_t sp2 = sp1 == std::string::npos ? sp1 : request.find(' ', sp1 + 1);
+    const std::string method(request.substr(0, sp1));
+    const std::string target(sp1 == std::string::npos ? std::string() : request.substr(sp1 + 1, sp2 - sp1 - 1));
+
+    std::string status;
+    std::string body;
+    std::string type("text/plain; charset=utf-8");
+    if (method != "GET" && method != "HEAD") {
+        status = "405 Method Not Allowed";
+        body = "method not allowed\n";
+    }
+    else if (target != "/" && target != "/metrics" && !target.starts_with("/metrics?")) {
+        status = "404 Not Found";
+        body = "not found, use /metrics\n";
+    }
+    else {
+        formatMetrics();
+        status = "200 OK";
+        type = CONTENT_TYPE;
+    }
+    const std::string& content(status.starts_with("200") ? _text : body);
+
+    std::string header("HTTP/1.0 " + status + "\r\n");
+    header.append("Content-Type: " + type + "\r\n");
+    header.append("Content-Length: " + std::to_string(content.size()) + "\r\n");
+    header.append("Connection: close\r\n\r\n");
+    if (conn.send(header, _log) && method != "HEAD") {
+        conn.send(content, _log);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Periodically update the metrics file until the server is closed.
+//----------------------------------------------------------------------------
+
+void ts::tsp::MetricsServer::updateFile()
+{
+    const cn::seconds interval = _options.metrics_interval > cn::seconds::zero() ? _options.metrics_interval : TSProcessorArgs::DEFAULT_METRICS_INTERVAL;
+    for (;;) {
+        writeFile();
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_wake.wait_for(lock, interval, [this]() { return bool(_terminate); })) {
+            break;
+        }
+    }
+    // Final metrics, after termination of the plugins.
+    writeFile();
+}
+
+void ts::tsp::MetricsServer::writeFile()
+{
+    formatMetrics();
+
+    // Write a temporary file, then rename it, so that a reader never sees a partial file.
+    fs::path tmp(_options.metrics_file);
+    tmp += ".tmp";
+    std::ofstream file(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file) {
+        _log.error(u"error creating %s", tmp);
+        return;
+    }
+    file.write(_text.data(), std::streamsize(_text.size()));
+    file.close();
+    if (!file) {
+        _log.error(u"error writing %s", tmp);
+        return;
+    }
+    fs::rename(tmp, _options.metrics_file, &ErrCodeReport(_log, u"error creating", _options.metrics_file));
+}
+
+
+//----------------------------------------------------------------------------
+// Generate the metrics text.
+//----------------------------------------------------------------------------
+
+void ts::tsp::MetricsServer::formatMetrics()
+{
+    // Get a snapshot of all plugins first, to keep all metric families consistent.
+    std::vector<PluginExecutor::Metrics> metrics(_plugins.size());
+    for (size_t i = 0; i < _plugins.size(); ++i) {
+        _plugins[i]->getMetrics(metrics[i]);
+    }
+
+    // The counters of a plugin restart from zero after a restart, as a new series with a new "restart" label.
+    _labels.resize(metrics.size());
+    _label_restarts.resize(metrics.size());
+    for (size_t i = 0; i < metrics.size(); ++i) {
+        if (_labels[i].empty() || _label_restarts[i] != metrics[i].restarts) {
+            _label_restarts[i] = metrics[i].restarts;
+            _labels[i] = _names[i] + ",restart=\"" + std::to_string(metrics[i].restarts) + "\"}";
+        }
+    }
+
+    // Generate one metric family, with one sample per plugin.
+    const auto family = [this, &metrics](const char* name, const char* type, const char* unit, const char* help, auto value) {
+        _text.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+        if (unit != nullptr) {
+            _text.append("# UNIT ").append(name).append(" ").append(unit).append("\n");
+        }
+        _text.append("# HELP ").append(name).append(" ").append(help).append("\n");
+        const bool counter = std::string(type) == "counter";
+        for (size_t i = 0; i < metrics.size(); ++i) {
+            _text.append(name);
+            if (counter) {
+                _text.append("_total");
+            }
+            _text.append(_labels[i]).append(" ").append(value(metrics[i])).append("\n");
+        }
+    };
+
+    _text.clear();
+    _text.append("# TYPE tsp_buffer_packets gauge\n");
+    _text.append("# HELP tsp_buffer_packets Size of the global packet buffer, in packets.\n");
+    _text.append("tsp_buffer_packets ").append(std::to_string(_options.ts_buffer_size / PKT_SIZE)).append("\n");
+
+    family("tsp_plugin_packets", "counter", nullptr,
+           "Packets processed by the plugin since its last restart.",
+           [](const PluginExecutor::Metrics& m) { return std::to_string(m.plugin_packets); });
+    family("tsp_plugin_thread_packets", "counter", nullptr,
+           "Packets which went through the plugin thread, including packets which were not submitted to the plugin.",
+           [](const PluginExecutor::Metrics& m) { return std::to_string(m.total_packets); });
+    family("tsp_plugin_buffer_packets", "gauge", nullptr,
+           "Packets waiting in the buffer for the plugin.",
+           [](const PluginExecutor::Metrics& m) { return std::to_string(m.buffer_packets); });
+    family("tsp_plugin_busy_seconds", "counter", "seconds",
+           "Time spent in the plugin, receiving, processing or sending packets.",
+           [](const PluginExecutor::Metrics& m) { return Seconds(m.busy_time); });
+    family("tsp_plugin_wait_seconds", "counter", "seconds",
+           "Time spent waiting for packets from the previous plugin or for free buffer space.",
+           [](const PluginExecutor::Metrics& m) { return Seconds(m.wait_time); });
+    family("tsp_plugin_waits", "counter", nullptr,
+           "Number of times the plugin thread waited for packets or free buffer space.",
+           [](const PluginExecutor::Metrics& m) { return std::to_string(m.wait_count); });
+    family("tsp_plugin_cpu_seconds", "counter", "seconds",
+           "CPU time of the plugin thread.",
+           [](const PluginExecutor::Metrics& m) { return Seconds(m.cpu_time); });
+
+    _text.append("# EOF\n");
+}
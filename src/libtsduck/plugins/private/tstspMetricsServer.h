@@ -0,0 +1,90 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Transport stream processor execution metrics server.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSProcessorArgs.h"
+#include "tstspInputExecutor.h"
+#include "tstspPluginExecutor.h"
+#include "tsTelnetConnection.h"
+#include "tsThread.h"
+#include "tsTCPServer.h"
+
+namespace ts {
+    namespace tsp {
+        //!
+        //! Transport stream processor execution metrics server.
+        //! The execution metrics of all plugins are exported in OpenMetrics text format,
+        //! either through a minimal HTTP server or in a periodically updated file.
+        //! This class is internal to the TSDuck library and cannot be called by applications.
+        //! @ingroup libtsduck plugin
+        //!
+        class MetricsServer : private Thread
+        {
+            TS_NOBUILD_NOCOPY(MetricsServer);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] options Command line options for tsp.
+            //! @param [in,out] log Log report.
+            //! @param [in,out] global_mutex Global mutex to synchronize access to the packet buffer.
+            //! @param [in] input Input plugin executor (start of plugin chain).
+            //!
+            MetricsServer(const TSProcessorArgs& options, Report& log, std::recursive_mutex& global_mutex, InputExecutor* input);
+
+            //!
+            //! Destructor.
+            //!
+            virtual ~MetricsServer() override;
+
+            //!
+            //! Open and start the metrics server.
+            //! @return True on success, false on error.
+            //!
+            bool open();
+
+            //!
+            //! Stop and close the metrics server.
+            //! With a metrics file, the file is updated one last time.
+            //!
+            void close();
+
+        private:
+            volatile bool              _is_open = false;
+            volatile bool              _terminate = false;
+            const TSProcessorArgs&     _options;
+            Report                     _log;
+            TCPServer                  _server {};
+            std::mutex                 _mutex {};            // Protect _wake.
+            std::condition_variable    _wake {};             // Wake up the file update thread.
+            std::vector<PluginExecutor*> _plugins {};        // All plugins, from input to output.
+            std::vector<std::string>   _names {};            // Constant part of the OpenMetrics labels of each plugin, same index as _plugins.
+            std::vector<std::string>   _labels {};           // Complete OpenMetrics labels of each plugin, rebuilt after a plugin restart.
+            std::vector<uint64_t>      _label_restarts {};   // Number of plugin restarts in _labels.
+            std::string                _text {};             // Last generated metrics text, memory is reused.
+
+            // Implementation of Thread.
+            virtual void main() override;
+
+            // Serve HTTP requests until the server is closed.
+            void serveHTTP();
+            void processRequest(TelnetConnection& conn);
+
+            // Periodically update the metrics file until the server is closed.
+            void updateFile();
+            void writeFile();
+
+            // Generate the metrics text in _text.
+            void formatMetrics();
+        };
+    }
+}
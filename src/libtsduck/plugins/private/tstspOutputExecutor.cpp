@@ -126,15 +126,20 @@ void ts::tsp::OutputExecutor::main()
                     // Don't output packet when the plugin is suspended.
                     addNonPluginPackets(out_subcnt);
                 }
-                else if (_output->send(pkt, data, out_subcnt)) {
-                    // Packet successfully sent.
-                    addPluginPackets(out_subcnt);
-                    output_packets += out_subcnt;
-                }
                 else {
-                    // Send error.
-                    aborted = true;
-                    break;
+                    const monotonic_time start(metricsStart());
+                    const bool sent = _output->send(pkt, data, out_subcnt);
+                    addBusyTime(start);
+                    if (sent) {
+                        // Packet successfully sent.
+                        addPluginPackets(out_subcnt);
+                        output_packets += out_subcnt;
+                    }
+                    else {
+                        // Send error.
+                        aborted = true;
+                        break;
+                    }
                 }
                 pkt += out_subcnt;
                 data += out_subcnt;
@@ -149,6 +154,9 @@ void ts::tsp::OutputExecutor::main()
 
     } while (!aborted);
 
+    // Publish the final packet counters.
+    publishMetrics(true);
+
     // Close the output processor.
     debug(u"stopping the output plugin");
     _output->stop();
@@ -8,6 +8,17 @@
 
 #include "tstspPluginExecutor.h"
 #include "tsPluginRepository.h"
+#include "tsSysUtils.h"
+
+// Hint the CPU that the thread is busy-polling (option --low-latency).
+#if defined(TS_X86_64) || defined(TS_I386)
+    #include <immintrin.h>
+    #define TS_SPIN_PAUSE() _mm_pause()
+#elif defined(TS_ARM64) && defined(TS_GCC)
+    #define TS_SPIN_PAUSE() __asm__ __volatile__("yield")
+#else
+    #define TS_SPIN_PAUSE() do {} while (false)
+#endif
 
 
 //----------------------------------------------------------------------------
@@ -23,7 +34,8 @@ ts::tsp::PluginExecutor::PluginExecutor(const TSProcessorArgs& options,
                                         Report* report) :
 
     JointTermination(options, type, pl_options, attributes, global_mutex, report),
-    _handlers(handlers)
+    _handlers(handlers),
+    _metrics(options.metricsEnabled() || options.adaptive_batch)
 {
     // Preset common default options.
     if (plugin() != nullptr) {
@@ -67,7 +79,7 @@ void ts::tsp::PluginExecutor::setAbort()
 {
     std::lock_guard<std::recursive_mutex> lock(_global_mutex);
     _tsp_aborting = true;
-    ringPrevious<PluginExecutor>()->_to_do.notify_one();
+    ringPrevious<PluginExecutor>()->notifyWork();
 }
 
 
@@ -81,6 +93,50 @@ bool ts::tsp::PluginExecutor::isRealTime() const
 }
 
 
+//----------------------------------------------------------------------------
+// Execution metrics.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::getMetrics(Metrics& metrics) const
+{
+    metrics.plugin_packets = _published_plugin_packets.load(std::memory_order_relaxed);
+    metrics.total_packets = _published_total_packets.load(std::memory_order_relaxed);
+    metrics.buffer_packets = _pkt_cnt.load(std::memory_order_relaxed);
+    metrics.wait_count = _wait_count.load(std::memory_order_relaxed);
+    metrics.wait_time = cn::nanoseconds(_wait_ns.load(std::memory_order_relaxed));
+    metrics.busy_time = cn::nanoseconds(_busy_ns.load(std::memory_order_relaxed));
+    metrics.cpu_time = cn::nanoseconds(_cpu_ns.load(std::memory_order_relaxed));
+    metrics.restarts = _restarts.load(std::memory_order_relaxed);
+}
+
+void ts::tsp::PluginExecutor::publishMetrics(bool force_cpu)
+{
+    if (_metrics) {
+        _published_plugin_packets.store(pluginPackets(), std::memory_order_relaxed);
+        _published_total_packets.store(totalPacketsInThread(), std::memory_order_relaxed);
+        // Reading the CPU time of a thread is a system call on most systems, don't do it for each batch of packets.
+        if (force_cpu || _cpu_sample_countdown == 0) {
+            _cpu_ns.store(GetThreadCpuTime().count(), std::memory_order_relaxed);
+            _cpu_sample_countdown = 16;
+        }
+        else {
+            _cpu_sample_countdown--;
+        }
+    }
+}
+
+void ts::tsp::PluginExecutor::addWaitTime(const monotonic_time& start)
+{
+    if (_metrics) {
+        addMetric(_wait_ns, cn::duration_cast<cn::nanoseconds>(monotonic_time::clock::now() - start).count());
+        addMetric<uint64_t>(_wait_count, 1);
+        // The thread was suspended, the cost of a CPU time sample is negligible. But we may hold
+        // the global mutex here, so defer the sample to the next publication, outside the mutex.
+        _cpu_sample_countdown = 0;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Set the initial state of the buffer.
 // Executed in synchronous environment, before starting all executor threads.
@@ -103,10 +159,39 @@ void ts::tsp::PluginExecutor::initBuffer(PacketBuffer*         buffer,
     _pkt_cnt = pkt_cnt;
     _input_end = input_end;
     _tsp_aborting = aborted;
-    _bitrate = bitrate;
-    _br_confidence = br_confidence;
+    _bitrate = _cur_bitrate = _passed_bitrate = bitrate;
+    _br_confidence = _cur_br_confidence = _passed_br_confidence = br_confidence;
+    _bitrate_changed = false;
     _tsp_bitrate = bitrate;
     _tsp_bitrate_confidence = br_confidence;
+
+    // Initial batch size limit, may be later adjusted with --adaptive-batch.
+    const PluginType type = plugin()->type();
+    _batch_limit = type == PluginType::INPUT ? _options.max_input_pkt : (type == PluginType::PROCESSOR ? _options.max_flush_pkt : 0);
+}
+
+
+//----------------------------------------------------------------------------
+// Notify the thread of this executor that there is something to do.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::notifyWork()
+{
+    if (!_options.lock_free) {
+        // Legacy mode, we are under the protection of the global mutex.
+        _to_do.notify_one();
+    }
+    else {
+        // Lock-free mode: the caller has updated the state of this executor. The fence orders this update
+        // before reading _parked. Symmetrically, waitWorkLockFree() sets _parked before checking its state.
+        // So, either the thread sees the new state or we see it parked. The mutex is acquired only when
+        // the thread is actually parked, in which case it is already waiting on the condition.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_parked.load()) {
+            std::lock_guard<std::mutex> lock(_park_mutex);
+            _park_cond.notify_one();
+        }
+    }
 }
 
 
@@ -120,6 +205,10 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
 
     log(10, u"passPackets(count = %'d, bitrate = %'d, input_end = %s, aborted = %s)", count, bitrate, input_end, aborted);
 
+    if (_options.lock_free) {
+        return passPacketsLockFree(count, bitrate, br_confidence, input_end, aborted);
+    }
+
     // We access data under the protection of the global mutex.
     std::lock_guard<std::recursive_mutex> lock(_global_mutex);
 
@@ -138,7 +227,7 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
 
     // Wake the next processor when there is some new input data or end of input.
     if (count > 0 || input_end) {
-        next->_to_do.notify_one();
+        next->notifyWork();
     }
 
     // Force to abort our processor when the next one is aborting. Already done in waitWork() but force immediately.
@@ -150,7 +239,60 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
     // Wake the previous processor when we abort (propagate abort conditions backward).
     if (aborted) {
         _tsp_aborting = true; // volatile bool in TSP superclass
-        ringPrevious<PluginExecutor>()->_to_do.notify_one();
+        ringPrevious<PluginExecutor>()->notifyWork();
+    }
+
+    // Return false when the current processor shall stop.
+    return !input_end && !aborted;
+}
+
+
+//----------------------------------------------------------------------------
+// Lock-free version of passPackets().
+//----------------------------------------------------------------------------
+
+bool ts::tsp::PluginExecutor::passPacketsLockFree(size_t count, const BitRate& bitrate, BitRateConfidence br_confidence, bool input_end, bool aborted)
+{
+    PluginExecutor* next = ringNext<PluginExecutor>();
+
+    // Update our buffer: we remove the first 'count' packets from the beginning of our slice of the buffer.
+    // Only this thread modifies _pkt_first. The previous executor may concurrently increase _pkt_cnt.
+    _pkt_first = (_pkt_first + count) % _buffer->count();
+    _pkt_cnt -= count;
+
+    // Propagate the bitrate to next processor, only when modified.
+    if (bitrate != _passed_bitrate || br_confidence != _passed_br_confidence) {
+        _passed_bitrate = bitrate;
+        _passed_br_confidence = br_confidence;
+        std::lock_guard<std::mutex> lock(next->_park_mutex);
+        next->_bitrate = bitrate;
+        next->_br_confidence = br_confidence;
+        next->_bitrate_changed = true;
+    }
+
+    // Update next processor's buffer: add 'count' packets at the end of its slice of the buffer.
+    // The atomic update also publishes the content of the packets to the next thread.
+    next->_pkt_cnt += count;
+
+    // Propagate end of input flag to next processor, after the last packets.
+    if (input_end) {
+        next->_input_end = true;
+    }
+
+    // Wake the next processor when there is some new input data or end of input.
+    if (count > 0 || input_end) {
+        next->notifyWork();
+    }
+
+    // Force to abort our processor when the next one is aborting (same as legacy mode).
+    if (plugin()->type() != PluginType::OUTPUT) {
+        aborted = aborted || next->_tsp_aborting;
+    }
+
+    // Wake the previous processor when we abort (propagate abort conditions backward).
+    if (aborted) {
+        _tsp_aborting = true; // volatile bool in TSP superclass
+        ringPrevious<PluginExecutor>()->notifyWork();
     }
 
     // Return false when the current processor shall stop.
@@ -167,6 +309,7 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
                                        bool& input_end, bool& aborted, bool &timeout)
 {
     log(10, u"waitWork(min_pkt_cnt = %'d, ...)", min_pkt_cnt);
+    publishMetrics(false);
 
     // Cannot allocate more than the buffer size.
     if (min_pkt_cnt > _buffer->count()) {
@@ -174,6 +317,11 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
         min_pkt_cnt = _buffer->count();
     }
 
+    if (_options.lock_free) {
+        waitWorkLockFree(min_pkt_cnt, pkt_first, pkt_cnt, bitrate, br_confidence, input_end, aborted, timeout);
+        return;
+    }
+
     // We access data under the protection of the global mutex.
     std::unique_lock<std::recursive_mutex> lock(_global_mutex);
 
@@ -187,6 +335,7 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
         // '_to_do' and, once we get it, implicitely relock the mutex.
         // We loop on this until packets are actually available.
         // If there is a timeout in the packet reception, call the plugin handler.
+        const monotonic_time start(metricsStart());
         if (_tsp_timeout.count() < 0) {
             // No timeout.
             _to_do.wait(lock);
@@ -194,6 +343,7 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
         else {
             timeout = _to_do.wait_for(lock, _tsp_timeout) == std::cv_status::timeout && !plugin()->handlePacketTimeout();
         }
+        addWaitTime(start);
     }
 
     // The number of returned packets is limited up to the wrap-up point of the circular buffer,
@@ -204,7 +354,7 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
     }
     else if (_pkt_first + min_pkt_cnt <= _buffer->count()) {
         // Return up to the wrap-up point. This will satisfy the requested minimum.
-        pkt_cnt = std::min(_pkt_cnt, _buffer->count() - _pkt_first);
+        pkt_cnt = std::min<size_t>(_pkt_cnt, _buffer->count() - _pkt_first);
     }
     else {
         // The requested minimum does not fit into a contiguous area.
@@ -226,6 +376,108 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
 }
 
 
+//----------------------------------------------------------------------------
+// Lock-free version of waitWork().
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::waitWorkLockFree(size_t min_pkt_cnt, size_t& pkt_first, size_t& pkt_cnt,
+                                               BitRate& bitrate, BitRateConfidence& br_confidence,
+                                               bool& input_end, bool& aborted, bool &timeout)
+{
+    PluginExecutor* next = ringNext<PluginExecutor>();
+    timeout = false;
+
+    // Check if there is something to do, without lock.
+    const auto has_work = [this, next, min_pkt_cnt]() {
+        return _pkt_cnt >= min_pkt_cnt || _input_end || next->_tsp_aborting;
+    };
+
+    // With --low-latency, busy-poll the buffer area without ever parking the thread.
+    // Since _parked is never set, the previous executor never needs to notify the condition.
+    // Periodically yield the CPU, in case the threads are not pinned and share a CPU.
+    if (_options.low_latency && !has_work()) {
+        const monotonic_time start(metricsStart());
+        monotonic_time poll_start(_tsp_timeout.count() < 0 ? monotonic_time() : monotonic_time::clock::now());
+        uint32_t spin = 0;
+        do {
+            if (++spin % 1024 == 0) {
+                std::this_thread::yield();
+            }
+            else {
+                TS_SPIN_PAUSE();
+            }
+            if (_tsp_timeout.count() >= 0 && !has_work() && monotonic_time::clock::now() - poll_start >= _tsp_timeout) {
+                timeout = !plugin()->handlePacketTimeout();
+                poll_start = monotonic_time::clock::now();
+            }
+        } while (!has_work() && !timeout);
+        addWaitTime(start);
+    }
+
+    // Loop until enough packets are available (or some error condition).
+    while (!has_work() && !timeout) {
+        // Park the thread. Set _parked before checking the state again. See comments in notifyWork().
+        std::unique_lock<std::mutex> lock(_park_mutex);
+        _parked = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!has_work()) {
+            const monotonic_time start(metricsStart());
+            if (_tsp_timeout.count() < 0) {
+                // No timeout.
+                _park_cond.wait(lock);
+            }
+            else if (_park_cond.wait_for(lock, _tsp_timeout) == std::cv_status::timeout) {
+                // Call the plugin timeout handler without holding the mutex.
+                _parked = false;
+                lock.unlock();
+                timeout = !has_work() && !plugin()->handlePacketTimeout();
+            }
+            addWaitTime(start);
+        }
+        _parked = false;
+    }
+
+    // Get a snapshot of the packet area. The number of packets can only increase after this point.
+    // The end of input is set after the last packets are added. Read it first: when set, all packets are there.
+    const bool end = _input_end;
+    const size_t cnt = _pkt_cnt;
+
+    // The number of returned packets is limited up to the wrap-up point of the circular buffer,
+    // if allowed by the requested minimum number of packets.
+    if (timeout) {
+        // Nothing returned.
+        pkt_cnt = 0;
+    }
+    else if (_pkt_first + min_pkt_cnt <= _buffer->count()) {
+        // Return up to the wrap-up point. This will satisfy the requested minimum.
+        pkt_cnt = std::min(cnt, _buffer->count() - _pkt_first);
+    }
+    else {
+        // The requested minimum does not fit into a contiguous area.
+        pkt_cnt = cnt;
+    }
+
+    // Get the new input bitrate if modified by the previous executor.
+    if (_bitrate_changed.exchange(false)) {
+        std::lock_guard<std::mutex> lock(_park_mutex);
+        _cur_bitrate = _bitrate;
+        _cur_br_confidence = _br_confidence;
+    }
+
+    pkt_first = _pkt_first;
+    bitrate = _cur_bitrate;
+    br_confidence = _cur_br_confidence;
+
+    input_end = end && pkt_cnt == cnt;
+
+    // Force to abort our processor when the next one is aborting (same as legacy mode).
+    aborted = plugin()->type() != PluginType::OUTPUT && next->_tsp_aborting;
+
+    log(10, u"waitWork(min_pkt_cnt = %'d, pkt_first = %'d, pkt_cnt = %'d, bitrate = %'d, input_end = %s, aborted = %s, timeout = %s)",
+        min_pkt_cnt, pkt_first, pkt_cnt, bitrate, input_end, aborted, timeout);
+}
+
+
 //----------------------------------------------------------------------------
 // Description of a restart operation (constructor).
 //----------------------------------------------------------------------------
@@ -273,7 +525,7 @@ void ts::tsp::PluginExecutor::restart(const RestartDataPtr& rd)
         _restart = true;
 
         // Signal the plugin thread that there is something to do.
-        _to_do.notify_one();
+        notifyWork();
     }
 
     // Now wait for the restart operation to complete.
@@ -288,6 +540,10 @@ void ts::tsp::PluginExecutor::restart(const RestartDataPtr& rd)
 
 bool ts::tsp::PluginExecutor::pendingRestart()
 {
+    // Fast path without locking the global mutex, _restart is set under the global mutex.
+    if (!_restart) {
+        return false;
+    }
     std::lock_guard<std::recursive_mutex> lock(_global_mutex);
     return _restart && _restart_data != nullptr;
 }
@@ -299,6 +555,13 @@ bool ts::tsp::PluginExecutor::pendingRestart()
 
 bool ts::tsp::PluginExecutor::processPendingRestart(bool& restarted)
 {
+    // Fast path without locking the global mutex. This method is called very often, for each packet
+    // in some executors. The global mutex is required only when a restart is pending.
+    if (!_restart) {
+        restarted = false;
+        return true;
+    }
+
     // Run under the protection of the global mutex.
     // To avoid deadlocks, always acquire the global mutex first, then a RestartData mutex.
     // Need improvement: the global mutex remains locked during the complete restart operation.
@@ -326,6 +589,7 @@ bool ts::tsp::PluginExecutor::processPendingRestart(bool& restarted)
 
     // Inform the TSP layer to reset plugin session accounting.
     restartPluginSession();
+    addMetric<uint64_t>(_restarts, 1);
 
     // Reset the execution context to cleanup previous plugin-specific options or accumulated data.
     plugin()->resetContext(_options.duck_args);
@@ -120,6 +120,47 @@ namespace ts {
             //!
             void restart(Report& report);
 
+            //!
+            //! Get the current batch size limit of the plugin executor.
+            //! For the input plugin, this is the maximum number of packets per input operation.
+            //! For a packet processor plugin, this is the maximum number of processed packets before flush.
+            //! @return The current batch size limit in packets. Zero means unlimited.
+            //!
+            size_t batchLimit() const { return _batch_limit.load(std::memory_order_relaxed); }
+
+            //!
+            //! Set the batch size limit of the plugin executor.
+            //! This method can be called from any thread. The new limit is used from the next batch of packets.
+            //! @param [in] limit New batch size limit in packets. Zero means unlimited.
+            //!
+            void setBatchLimit(size_t limit) { _batch_limit.store(limit, std::memory_order_relaxed); }
+
+            //!
+            //! Snapshot of the execution metrics of a plugin executor.
+            //! The metrics are collected only when TSProcessorArgs::metricsEnabled() is true
+            //! or when the batch sizes are adaptive (TSProcessorArgs::adaptive_batch).
+            //!
+            class Metrics
+            {
+            public:
+                PacketCounter   plugin_packets = 0;  //!< Packets processed by the plugin since its last restart.
+                PacketCounter   total_packets = 0;   //!< Packets which went through the plugin thread, including the ones which were not submitted to the plugin.
+                size_t          buffer_packets = 0;  //!< Packets which are currently waiting in the buffer area of the plugin.
+                uint64_t        wait_count = 0;      //!< Number of times the plugin thread waited in waitWork().
+                cn::nanoseconds wait_time {};        //!< Total time the plugin thread waited in waitWork().
+                cn::nanoseconds busy_time {};        //!< Total time spent in the plugin, in receive(), processPacket() or send().
+                cn::nanoseconds cpu_time {};         //!< CPU time of the plugin thread.
+                uint64_t        restarts = 0;        //!< Number of times the plugin was restarted.
+            };
+
+            //!
+            //! Get a snapshot of the execution metrics of the plugin executor.
+            //! This method can be called from any thread. The packet counters and the CPU time
+            //! are published by the plugin thread when it looks for more work to do.
+            //! @param [out] metrics Receive the execution metrics.
+            //!
+            void getMetrics(Metrics& metrics) const;
+
             // Implementation of TSP virtual methods.
             virtual size_t pluginCount() const override;
             virtual void signalPluginEvent(uint32_t event_code, Object* plugin_data = nullptr) const override;
@@ -178,6 +219,32 @@ namespace ts {
                           BitRate& bitrate, BitRateConfidence& br_confidence,
                           bool& input_end, bool& aborted, bool &timeout);
 
+            //!
+            //! Get the start time of a plugin operation, when execution metrics are collected.
+            //! @return The current monotonic time or the clock epoch when metrics are not collected.
+            //!
+            monotonic_time metricsStart() const { return _metrics ? monotonic_time::clock::now() : monotonic_time(); }
+
+            //!
+            //! Account the time which was spent in the plugin since metricsStart().
+            //! Must be called from the plugin thread only.
+            //! @param [in] start Value which was returned by metricsStart().
+            //!
+            void addBusyTime(const monotonic_time& start)
+            {
+                if (_metrics) {
+                    addMetric(_busy_ns, cn::duration_cast<cn::nanoseconds>(monotonic_time::clock::now() - start).count());
+                }
+            }
+
+            //!
+            //! Publish the packet counters and CPU time of the plugin thread for the metrics.
+            //! This is automatically done in waitWork(). Must be called from the plugin thread only.
+            //! @param [in] force_cpu If true, always sample the CPU time of the thread. If false,
+            //! the CPU time is sampled every few calls only.
+            //!
+            void publishMetrics(bool force_cpu);
+
             //!
             //! Check if there is a pending restart operation (but do not execute it).
             //! @return True if there is a pending restart operation.
@@ -201,17 +268,64 @@ namespace ts {
             using RestartDataPtr = std::shared_ptr<RestartData>;
 
             // The following private data must be accessed exclusively under the protection of the global mutex.
-            // Implementation details: see the file src/docs/developing-plugins.dox.
+            // Implementation details: see the file doc/developer/104-05-tsp-design.adoc.
             // [*] After initialization, these fields are read/written only in passPackets() and waitWork().
+            // [L] In lock-free mode (option --lock-free), these fields are accessed without the global mutex.
             std::condition_variable_any _to_do {}; // Notify the processor thread to do something.
-            size_t            _pkt_first = 0;      // Starting index of packets area [*]
-            size_t            _pkt_cnt = 0;        // Size of packets area [*]
-            bool              _input_end = false;  // No more packet after current ones [*]
+            size_t              _pkt_first = 0;    // Starting index of packets area, written by this thread only [*] [L]
+            std::atomic<size_t> _pkt_cnt {0};      // Size of packets area [*] [L]
+            std::atomic<bool>   _input_end {false}; // No more packet after current ones [*] [L]
             BitRate           _bitrate = 0;        // Input bitrate (set by previous plugin) [*]
             BitRateConfidence _br_confidence = BitRateConfidence::LOW;  // Input bitrate confidence (set by previous plugin) [*]
-            bool              _restart = false;    // Restart the plugin asap using _restart_data
+            std::atomic<bool> _restart {false};    // Restart the plugin asap using _restart_data
             RestartDataPtr    _restart_data {};    // How to restart the plugin
 
+            // Current batch size limit, initially --max-input-packets or --max-flushed-packets, adjusted with --adaptive-batch.
+            std::atomic<size_t> _batch_limit {0};
+
+            // Lock-free handoff between executors (option --lock-free).
+            // The thread parks on its own condition only when it has nothing to do. The previous executor
+            // notifies the condition only when _parked is set. The input bitrate is rarely modified and is
+            // transmitted under the protection of _park_mutex, only when it changes.
+            std::mutex              _park_mutex {};            // Protect _park_cond, _bitrate and _br_confidence in lock-free mode.
+            std::condition_variable _park_cond {};             // Notify a parked thread.
+            std::atomic<bool>       _parked {false};           // The thread is waiting on _park_cond.
+            std::atomic<bool>       _bitrate_changed {false};  // Set by previous executor when _bitrate was modified.
+            BitRate                 _cur_bitrate = 0;          // Last input bitrate, as seen by this thread.
+            BitRateConfidence       _cur_br_confidence = BitRateConfidence::LOW;  // Last input bitrate confidence, as seen by this thread.
+            BitRate                 _passed_bitrate = 0;       // Last bitrate passed to the next executor.
+            BitRateConfidence       _passed_br_confidence = BitRateConfidence::LOW;  // Last bitrate confidence passed to the next executor.
+
+            // Execution metrics (options --metrics-port, --metrics-file, --adaptive-batch). The atomic fields are written
+            // by the plugin thread only and read by the metrics server thread. A relaxed load and store is
+            // enough to update them, without the cost of an atomic read-modify-write instruction.
+            const bool                 _metrics;                  // Collect execution metrics.
+            uint32_t                   _cpu_sample_countdown = 0; // Number of publishMetrics() before next CPU time sample.
+            std::atomic<int64_t>       _busy_ns {0};              // Time in the plugin, in nanoseconds.
+            std::atomic<int64_t>       _wait_ns {0};              // Time in waitWork(), in nanoseconds.
+            std::atomic<int64_t>       _cpu_ns {0};               // Thread CPU time, in nanoseconds.
+            std::atomic<uint64_t>      _wait_count {0};           // Number of waits in waitWork().
+            std::atomic<uint64_t>      _restarts {0};             // Number of plugin restarts.
+            std::atomic<PacketCounter> _published_plugin_packets {0};
+            std::atomic<PacketCounter> _published_total_packets {0};
+
+            // Add a value to a metric, from the plugin thread only.
+            template <typename INT>
+            static void addMetric(std::atomic<INT>& metric, INT value) { metric.store(metric.load(std::memory_order_relaxed) + value, std::memory_order_relaxed); }
+
+            // Account the time which was spent waiting in waitWork() since metricsStart().
+            void addWaitTime(const monotonic_time& start);
+
+            // Notify the thread of this executor that there is something to do.
+            // In legacy mode, must be called under the protection of the global mutex.
+            void notifyWork();
+
+            // Lock-free versions of passPackets() and waitWork().
+            bool passPacketsLockFree(size_t count, const BitRate& bitrate, BitRateConfidence br_confidence, bool input_end, bool aborted);
+            void waitWorkLockFree(size_t min_pkt_cnt, size_t& pkt_first, size_t& pkt_cnt,
+                                  BitRate& bitrate, BitRateConfidence& br_confidence,
+                                  bool& input_end, bool& aborted, bool &timeout);
+
             // Description of a restart operation.
             class RestartData
             {
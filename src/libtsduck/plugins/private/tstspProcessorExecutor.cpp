@@ -77,6 +77,9 @@ void ts::tsp::ProcessorExecutor::main()
         processPacketWindows(window_size);
     }
 
+    // Publish the final packet counters.
+    publishMetrics(true);
+
     // Close the packet processor.
     debug(u"stopping the plugin");
     _processor->stop();
@@ -139,12 +142,12 @@ void ts::tsp::ProcessorExecutor::processIndividualPackets()
         // Now process the packets.
         size_t pkt_done = 0;
         size_t pkt_flush = 0;
+        const size_t max_flush = batchLimit();
 
         while (pkt_done < pkt_cnt && !aborted) {
 
             TSPacket* const pkt = _buffer->base() + pkt_first + pkt_done;
             TSPacketMetadata* const pkt_data = _metadata->base() + pkt_first + pkt_done;
-            bool got_new_bitrate = false;
 
             // Process restart requests.
             bool restarted = false;
@@ -158,83 +161,115 @@ void ts::tsp::ProcessorExecutor::processIndividualPackets()
                 _processor->getOnlyExceptLabelOption(only_labels, except_labels);
             }
 
-            pkt_done++;
-            pkt_flush++;
+            // Build the largest batch of consecutive packets to submit to the plugin.
+            // Don't go beyond the next flush point, as required by --max-flushed-packets (or its adaptive value).
+            size_t batch_max = pkt_cnt - pkt_done;
+            if (max_flush > 0) {
+                batch_max = std::min(batch_max, max_flush - pkt_flush);
+            }
+            if (_batch_status.size() < batch_max) {
+                _batch_status.resize(batch_max);
+                _batch_was_null.resize(batch_max);
+            }
+            size_t batch_size = 0;
+            const bool suspended = _suspended;
+            while (batch_size < batch_max &&
+                   pkt[batch_size].b[0] != 0 &&
+                   !suspended &&
+                   (only_labels.none() || pkt_data[batch_size].hasAnyLabel(only_labels)) &&
+                   !pkt_data[batch_size].hasAnyLabel(except_labels))
+            {
+                _batch_was_null[batch_size] = pkt[batch_size].getPID() == PID_NULL;
+                pkt_data[batch_size].setFlush(false);
+                pkt_data[batch_size].setBitrateChanged(false);
+                _batch_status[batch_size] = ProcessorPlugin::TSP_OK;
+                batch_size++;
+            }
 
-            if (pkt->b[0] == 0) {
-                // The packet has already been dropped by a previous packet processor.
-                addNonPluginPackets(1);
+            // Apply the processing routine to the batch of packets.
+            // If the first packet is not for the plugin, the batch is empty and only this packet is passed.
+            size_t processed = 1;
+            if (batch_size > 0) {
+                const monotonic_time start(metricsStart());
+                processed = _processor->processPackets(pkt, pkt_data, _batch_status.data(), batch_size);
+                addBusyTime(start);
+                // Protect against invalid returned values, at least one packet is always processed.
+                processed = std::max<size_t>(1, std::min(processed, batch_size));
+                addPluginPackets(processed);
             }
-            else {
-                // Apply the processing routine to the packet
-                const bool was_null = pkt->getPID() == PID_NULL;
-                pkt_data->setFlush(false);
-                pkt_data->setBitrateChanged(false);
-                ProcessorPlugin::Status status = ProcessorPlugin::TSP_OK;
-                if (!_suspended && (only_labels.none() || pkt_data->hasAnyLabel(only_labels)) && !pkt_data->hasAnyLabel(except_labels)) {
-                    // Packet not excluded by --only-label or --except-label => process it.
-                    status = _processor->processPacket(*pkt, *pkt_data);
-                    addPluginPackets(1);
-                }
-                else {
-                    // The plugin is suspended or some --only-label was specified but the packet does
-                    // not have any required label. Pass the packet without submitting it to the plugin.
-                    addNonPluginPackets(1);
-                }
 
-                // Use the returned status
-                switch (status) {
-                    case ProcessorPlugin::TSP_OK:
-                        // Normal case, pass packet
+            // Use the returned status of each packet.
+            for (size_t i = 0; i < processed && !aborted; ++i) {
+
+                bool got_new_bitrate = false;
+                pkt_done++;
+                pkt_flush++;
+
+                if (batch_size == 0) {
+                    // The packet has already been dropped by a previous packet processor, or the plugin
+                    // is suspended, or some --only-label was specified but the packet does not have any
+                    // required label. Pass the packet without submitting it to the plugin.
+                    addNonPluginPackets(1);
+                    if (pkt->b[0] != 0) {
+                        pkt_data->setFlush(false);
+                        pkt_data->setBitrateChanged(false);
                         passed_packets++;
-                        break;
-                    case ProcessorPlugin::TSP_NULL:
-                        // Replace the packet with a complete null packet
-                        *pkt = NullPacket;
-                        break;
-                    case ProcessorPlugin::TSP_DROP:
-                        // Drop this packet.
-                        pkt->b[0] = 0;
-                        dropped_packets++;
-                        break;
-                    case ProcessorPlugin::TSP_END:
-                        // Signal end of input to successors and abort to predecessors
-                        debug(u"plugin requests termination");
-                        input_end = aborted = true;
-                        pkt_done--;
-                        pkt_flush--;
-                        pkt_cnt = pkt_done;
-                        break;
-                    default:
-                        // Invalid status, report error and accept packet.
-                        error(u"invalid packet processing status %d", status);
-                        break;
+                    }
                 }
+                else {
+                    switch (_batch_status[i]) {
+                        case ProcessorPlugin::TSP_OK:
+                            // Normal case, pass packet
+                            passed_packets++;
+                            break;
+                        case ProcessorPlugin::TSP_NULL:
+                            // Replace the packet with a complete null packet
+                            pkt[i] = NullPacket;
+                            break;
+                        case ProcessorPlugin::TSP_DROP:
+                            // Drop this packet.
+                            pkt[i].b[0] = 0;
+                            dropped_packets++;
+                            break;
+                        case ProcessorPlugin::TSP_END:
+                            // Signal end of input to successors and abort to predecessors
+                            debug(u"plugin requests termination");
+                            input_end = aborted = true;
+                            pkt_done--;
+                            pkt_flush--;
+                            pkt_cnt = pkt_done;
+                            break;
+                        default:
+                            // Invalid status, report error and accept packet.
+                            error(u"invalid packet processing status %d", _batch_status[i]);
+                            break;
+                    }
 
-                // Detect if the packet was nullified by the plugin, either by returning TSP_NULL or by overwriting the packet.
-                if (!was_null && pkt->getPID() == PID_NULL) {
-                    pkt_data->setNullified(true);
-                    nullified_packets++;
-                }
+                    // Detect if the packet was nullified by the plugin, either by returning TSP_NULL or by overwriting the packet.
+                    if (!_batch_was_null[i] && pkt[i].getPID() == PID_NULL) {
+                        pkt_data[i].setNullified(true);
+                        nullified_packets++;
+                    }
 
-                // If the packet processor has signaled a new bitrate, get it.
-                if (pkt_data->getBitrateChanged()) {
-                    const BitRate new_bitrate = _processor->getBitrate();
-                    if (new_bitrate != 0) {
-                        bitrate_never_modified = false;
-                        got_new_bitrate = new_bitrate != output_bitrate;
-                        output_bitrate = new_bitrate;
-                        br_confidence = _processor->getBitrateConfidence();
+                    // If the packet processor has signaled a new bitrate, get it.
+                    if (pkt_data[i].getBitrateChanged()) {
+                        const BitRate new_bitrate = _processor->getBitrate();
+                        if (new_bitrate != 0) {
+                            bitrate_never_modified = false;
+                            got_new_bitrate = new_bitrate != output_bitrate;
+                            output_bitrate = new_bitrate;
+                            br_confidence = _processor->getBitrateConfidence();
+                        }
                     }
                 }
-            }
 
-            // Do not wait to process pkt_cnt packets before notifying the next processor.
-            // Perform periodic flush to avoid waiting too long before two output operations.
-            // Also propagate new bitrate values immediately.
-            if (pkt_data->getFlush() || got_new_bitrate || pkt_done == pkt_cnt || (_options.max_flush_pkt > 0 && pkt_flush >= _options.max_flush_pkt)) {
-                aborted = !passPackets(pkt_flush, output_bitrate, br_confidence, pkt_done == pkt_cnt && input_end, aborted);
-                pkt_flush = 0;
+                // Do not wait to process pkt_cnt packets before notifying the next processor.
+                // Perform periodic flush to avoid waiting too long before two output operations.
+                // Also propagate new bitrate values immediately.
+                if (pkt_data[i].getFlush() || got_new_bitrate || pkt_done == pkt_cnt || (max_flush > 0 && pkt_flush >= max_flush)) {
+                    aborted = !passPackets(pkt_flush, output_bitrate, br_confidence, pkt_done == pkt_cnt && input_end, aborted);
+                    pkt_flush = 0;
+                }
             }
         }
 
@@ -278,10 +313,11 @@ void ts::tsp::ProcessorExecutor::processPacketWindows(size_t window_size)
         //   of the the additional packets may be excluded. So, restart again and again
         //   until we get 'window_size' usable packets.
         // - Don't use too many packets: We limit the number of buffer packets per window
-        //   to _options.max_flush_pkt (option --max-flushed-packets). Unless of course
+        //   to batchLimit() (option --max-flushed-packets). Unless of course
         //   we need more to get 'window_size' usable packets.
 
         TSPacketWindow win;
+        const size_t max_flush = batchLimit();
         size_t request_packets = window_size;  // number of packets to request in the buffer.
         size_t first_packet_index = 0;         // index of first allocated packet in the global buffer.
         size_t allocated_packets = 0;          // number of allocated packet from the global buffer.
@@ -337,7 +373,7 @@ void ts::tsp::ProcessorExecutor::processPacketWindows(size_t window_size)
 
                 // If --max-flushed-packets is set and we have enough packets for both the window size
                 // and --max-flushed-packets, stop building the window now.
-                if (_options.max_flush_pkt > 0 && pkt_offset + 1 >= _options.max_flush_pkt && win.size() >= window_size && pkt_offset + 1 < allocated_packets) {
+                if (max_flush > 0 && pkt_offset + 1 >= max_flush && win.size() >= window_size && pkt_offset + 1 < allocated_packets) {
                     // Will use only the first part of the allocated packets.
                     // When we call passPackets() later, we pass only this part.
                     // The remaining part (unused for now) will be returned again by waitWork().
@@ -358,7 +394,9 @@ void ts::tsp::ProcessorExecutor::processPacketWindows(size_t window_size)
         }
 
         // Let the plugin process the packet window.
+        const monotonic_time start(metricsStart());
         const size_t processed_packets = _processor->processPacketWindow(win);
+        addBusyTime(start);
 
         // If not all packets from the window were processed, the plugin want to terminate the stream processing.
         if (processed_packets < win.size()) {
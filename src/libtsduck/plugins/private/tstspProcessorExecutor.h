@@ -53,6 +53,8 @@ namespace ts {
         private:
             ProcessorPlugin* _processor = nullptr;
             const size_t _plugin_index;
+            std::vector<ProcessorPlugin::Status> _batch_status {};  // Packet status in a batch.
+            std::vector<bool> _batch_was_null {};                   // Packet was a null packet before processing.
 
             // Inherited from Thread
             virtual void main() override;
@@ -24,8 +24,7 @@ ts::tsswitch::InputExecutor::InputExecutor(const InputSwitcherArgs& opt,
     PluginExecutor(opt, handlers, PluginType::INPUT, opt.inputs[index], ThreadAttributes().setPriority(ThreadAttributes::GetHighPriority()), core, log),
     _input(dynamic_cast<InputPlugin*>(PluginThread::plugin())),
     _pluginIndex(index),
-    _buffer(opt.bufferedPackets),
-    _metadata(opt.bufferedPackets)
+    _ring(opt.bufferedPackets)
 {
     // Make sure that the input plugins display their index.
     setLogName(UString::Format(u"%s[%d]", pluginName(), _pluginIndex));
@@ -74,6 +73,7 @@ void ts::tsswitch::InputExecutor::stopInput()
     std::lock_guard<std::recursive_mutex> lock(_mutex);
     _startRequest = false;
     _stopRequest = true;
+    _ring.stop();
     _todo.notify_one();
 }
 
@@ -107,6 +107,7 @@ void ts::tsswitch::InputExecutor::terminateInput()
 {
     std::lock_guard<std::recursive_mutex> lock(_mutex);
     _terminated = true;
+    _ring.stop();
     _todo.notify_one();
 }
 
@@ -118,12 +119,16 @@ void ts::tsswitch::InputExecutor::terminateInput()
 
 void ts::tsswitch::InputExecutor::getOutputArea(ts::TSPacket*& first, TSPacketMetadata*& data, size_t& count)
 {
-    std::lock_guard<std::recursive_mutex> lock(_mutex);
-    first = &_buffer[_outFirst];
-    data = &_metadata[_outFirst];
-    count = std::min(_outCount, _buffer.size() - _outFirst);
-    _outputInUse = count > 0;
-    _todo.notify_one();
+    // The output plugin is the consumer of the ring, there is no need to lock the mutex.
+    assert(!_outputLocked);
+    count = 0;
+    if (_ring.lockRead(first, data, count, false)) {
+        _outputLocked = count > 0;
+        if (!_outputLocked) {
+            // Nothing to output, release the empty read window.
+            _ring.releaseRead(0);
+        }
+    }
 }
 
 
@@ -134,12 +139,10 @@ void ts::tsswitch::InputExecutor::getOutputArea(ts::TSPacket*& first, TSPacketMe
 
 void ts::tsswitch::InputExecutor::freeOutput(size_t count)
 {
-    std::lock_guard<std::recursive_mutex> lock(_mutex);
-    assert(count <= _outCount);
-    _outFirst = (_outFirst + count) % _buffer.size();
-    _outCount -= count;
-    _outputInUse = false;
-    _todo.notify_one();
+    if (_outputLocked) {
+        _outputLocked = false;
+        _ring.releaseRead(count);
+    }
 }
 
 
@@ -158,9 +161,6 @@ void ts::tsswitch::InputExecutor::main()
         debug(u"waiting for input session");
         {
             std::unique_lock<std::recursive_mutex> lock(_mutex);
-            // Reset input buffer.
-            _outFirst = 0;
-            _outCount = 0;
             // Wait for start or terminate.
             while (!_startRequest && !_terminated) {
                 _todo.wait(lock);
@@ -172,6 +172,8 @@ void ts::tsswitch::InputExecutor::main()
             // At this point, start is requested, reset trigger.
             _startRequest = false;
             _stopRequest = false;
+            // Reset input buffer, clear previous stop condition.
+            _ring.reset();
             // Inform the TSP layer to reset plugin session accounting.
             restartPluginSession();
         }
@@ -192,51 +194,45 @@ void ts::tsswitch::InputExecutor::main()
         // Loop on incoming packets.
         for (;;) {
 
-            // Input area (first packet index and packet count).
-            size_t inFirst = 0;
+            // Input area (first packet and packet count).
+            TSPacket* inPackets = nullptr;
+            TSPacketMetadata* inMetadata = nullptr;
             size_t inCount = 0;
 
-            // Initial sequence under mutex protection.
-            {
-                // Wait for free buffer or stop.
-                std::unique_lock<std::recursive_mutex> lock(_mutex);
-                while (_outCount >= _buffer.size() && !_stopRequest && !_terminated) {
-                    if (_isCurrent || !_opt.fastSwitch) {
-                        // This is the current input, we must not lose packet.
-                        // Wait for the output thread to free some packets.
-                        _todo.wait(lock);
-                    }
-                    else {
-                        // Not the current input plugin in --fast-switch mode.
-                        // Drop older packets, free at most --max-input-packets.
-                        assert(_outFirst < _buffer.size());
-                        const size_t freeCount = std::min(_opt.maxInputPackets, _buffer.size() - _outFirst);
-                        assert(freeCount <= _outCount);
-                        _outFirst = (_outFirst + freeCount) % _buffer.size();
-                        _outCount -= freeCount;
-                    }
+            // Wait for free buffer or stop.
+            bool ok = true;
+            while (ok && inCount == 0) {
+                if (_isCurrent || !_opt.fastSwitch) {
+                    // This is the current input, we must not lose packet.
+                    // Wait for the output thread to free some packets.
+                    ok = _ring.lockWrite(inPackets, inMetadata, inCount);
                 }
-                // Exit input when termination is requested.
-                if (_stopRequest || _terminated) {
-                    debug(u"exiting session: stop request: %s, terminated: %s", _stopRequest, _terminated);
-                    break;
+                else {
+                    // Not the current input plugin in --fast-switch mode. When the buffer is full,
+                    // drop older packets, free at most --max-input-packets. If the output plugin
+                    // still uses the older packets, wait for the output thread to free them.
+                    ok = _ring.lockWrite(inPackets, inMetadata, inCount, 1, false);
+                    if (ok && inCount == 0 && _ring.dropOldest(_opt.maxInputPackets) == 0) {
+                        ok = _ring.lockWrite(inPackets, inMetadata, inCount);
+                    }
                 }
-                // There is some free buffer, compute first index and size of receive area.
-                // The receive area is limited by end of buffer and max input size.
-                inFirst = (_outFirst + _outCount) % _buffer.size();
-                inCount = std::min(_opt.maxInputPackets, std::min(_buffer.size() - _outCount, _buffer.size() - inFirst));
             }
 
-            assert(inFirst < _buffer.size());
-            assert(inFirst + inCount <= _buffer.size());
+            // Exit input when termination is requested.
+            if (!ok) {
+                std::lock_guard<std::recursive_mutex> lock(_mutex);
+                debug(u"exiting session: stop request: %s, terminated: %s", _stopRequest, _terminated);
+                break;
+            }
+
+            // The receive area is limited by end of buffer and max input size.
+            inCount = std::min(inCount, _opt.maxInputPackets);
 
             // Reset packet metadata.
-            for (size_t n = inFirst; n < inFirst + inCount; ++n) {
-                _metadata[n].reset();
-            }
+            TSPacketMetadata::Reset(inMetadata, inCount);
 
             // Receive packets.
-            if ((inCount = _input->receive(&_buffer[inFirst], &_metadata[inFirst], inCount)) == 0) {
+            if ((inCount = _input->receive(inPackets, inMetadata, inCount)) == 0) {
                 // End of input.
                 debug(u"received end of input from plugin");
                 break;
@@ -245,34 +241,26 @@ void ts::tsswitch::InputExecutor::main()
 
             // Fill input time stamps with monotonic clock if none was provided by the input plugin.
             // Only check the first returned packet. Assume that the input plugin generates time stamps for all or none.
-            if (!_metadata[inFirst].hasInputTimeStamp()) {
+            if (!inMetadata[0].hasInputTimeStamp()) {
                 const cn::nanoseconds current = monotonic_time::clock::now() - _start_time;
                 for (size_t n = 0; n < inCount; ++n) {
-                    _metadata[inFirst + n].setInputTimeStamp(current, TimeSource::TSP);
+                    inMetadata[n].setInputTimeStamp(current, TimeSource::TSP);
                 }
             }
 
             // Signal the presence of received packets.
-            {
-                std::lock_guard<std::recursive_mutex> lock(_mutex);
-                _outCount += inCount;
-            }
+            _ring.commitWrite(inCount);
             _core.inputReceived(_pluginIndex);
         }
 
         // At end of session, make sure that the output buffer is not in use by the output plugin.
-        {
-            // Wait for the output plugin to release the buffer.
-            // In case of normal end of input (no stop, no terminate), wait for all output to be gone.
-            std::unique_lock<std::recursive_mutex> lock(_mutex);
-            while (_outputInUse || (_outCount > 0 && !_stopRequest && !_terminated)) {
-                debug(u"input terminated, waiting for output plugin to release the buffer");
-                _todo.wait(lock);
-            }
-            // And reset the output part of the buffer.
-            _outFirst = 0;
-            _outCount = 0;
+        // In case of normal end of input (no stop, no terminate), wait for all output to be gone.
+        if (!_ring.stopped()) {
+            debug(u"input terminated, waiting for output plugin to release the buffer");
+            _ring.waitEmpty();
         }
+        // And reset the output part of the buffer, after the output plugin releases it.
+        _ring.reset();
 
         // End of input session.
         debug(u"stopping input plugin");
@@ -15,6 +15,7 @@
 #include "tstsswitchPluginExecutor.h"
 #include "tsInputSwitcherArgs.h"
 #include "tsInputPlugin.h"
+#include "tsTSPacketRing.h"
 
 namespace ts {
     namespace tsswitch {
@@ -102,17 +103,14 @@ namespace ts {
         private:
             InputPlugin*           _input;                // Plugin API.
             const size_t           _pluginIndex;          // Index of this input plugin.
-            TSPacketVector         _buffer;               // Packet buffer.
-            TSPacketMetadataVector _metadata;             // Packet metadata.
+            TSPacketRing           _ring;                 // Packet buffer, the output plugin is the consumer.
+            bool                   _outputLocked = false; // The output plugin holds a read window (accessed by output thread only).
             std::recursive_mutex   _mutex {};             // Mutex to protect all subsequent fields.
             std::condition_variable_any _todo {};         // Condition to signal something to do.
-            bool                   _isCurrent = false;    // This plugin is the current input one.
-            bool                   _outputInUse = false;  // The output part of the buffer is currently in use by the output plugin.
+            std::atomic_bool       _isCurrent = false;    // This plugin is the current input one.
             bool                   _startRequest = false; // Start input requested.
             bool                   _stopRequest = false;  // Stop input requested.
             bool                   _terminated = false;   // Terminate thread.
-            size_t                 _outFirst = 0;         // Index of first packet to output in _buffer.
-            size_t                 _outCount = 0;         // Number of packets to output, not always contiguous, may wrap up.
             monotonic_time         _start_time {monotonic_time::clock::now()}; // Creation time, initialized with current system time.
 
             // Implementation of Thread.
@@ -27,7 +27,7 @@ namespace ts {
         // Implementation of plugin API
         virtual bool getOptions() override;
         virtual bool start() override;
-        virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPackets(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     private:
         // Command line options.
@@ -136,8 +136,11 @@ bool ts::ContinuityPlugin::start()
 // Packet processing method
 //----------------------------------------------------------------------------
 
-ts::ProcessorPlugin::Status ts::ContinuityPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+size_t ts::ContinuityPlugin::processPackets(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
 {
-    _cc_analyzer.feedPacket(pkt);
-    return TSP_OK;
+    for (size_t i = 0; i < count; ++i) {
+        _cc_analyzer.feedPacket(pkt[i]);
+        status[i] = TSP_OK;
+    }
+    return count;
 }
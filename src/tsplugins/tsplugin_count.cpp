@@ -29,7 +29,7 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual bool stop() override;
-        virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPackets(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     private:
         // This structure is used at each --interval.
@@ -59,6 +59,9 @@ namespace ts {
         IntervalReport _last_report {};          // Last report content
         PacketCounter  _counters[PID_MAX] {};    // Packet counter per PID
 
+        // Count one packet with intermediate reports, packet_index is the index of the packet in the plugin.
+        void countPacket(const TSPacket& pkt, PacketCounter packet_index);
+
         // Report a line
         template <class... Args>
         void report(const UChar* fmt, Args&&... args)
@@ -224,7 +227,30 @@ bool ts::CountPlugin::stop()
 // Packet processing method
 //----------------------------------------------------------------------------
 
-ts::ProcessorPlugin::Status ts::CountPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+size_t ts::CountPlugin::processPackets(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    if (_report_interval == 0 && !_report_all) {
+        // Fast path, simply count packets.
+        for (size_t i = 0; i < count; ++i) {
+            const PID pid = pkt[i].getPID();
+            if (_pids[pid] != _negate) {
+                _counters[pid]++;
+            }
+            status[i] = TSP_OK;
+        }
+    }
+    else {
+        // Process intermediate reports.
+        const PacketCounter first_index = tsp->pluginPackets();
+        for (size_t i = 0; i < count; ++i) {
+            countPacket(pkt[i], first_index + i);
+            status[i] = TSP_OK;
+        }
+    }
+    return count;
+}
+
+void ts::CountPlugin::countPacket(const TSPacket& pkt, PacketCounter packet_index)
 {
     // Check if the packet must be counted
     const PID pid = pkt.getPID();
@@ -235,18 +261,18 @@ ts::ProcessorPlugin::Status ts::CountPlugin::processPacket(TSPacket& pkt, TSPack
 
     // Process reporting intervals.
     if (_report_interval > 0) {
-        if (tsp->pluginPackets() == 0) {
+        if (packet_index == 0) {
             // Set initial interval
             _last_report.start = Time::CurrentUTC();
             _last_report.counted_packets = 0;
             _last_report.total_packets = 0;
         }
-        else if (tsp->pluginPackets() % _report_interval == 0) {
+        else if (packet_index % _report_interval == 0) {
             // It is time to produce a report.
             // Get current state.
             IntervalReport now;
             now.start = Time::CurrentUTC();
-            now.total_packets = tsp->pluginPackets();
+            now.total_packets = packet_index;
             now.counted_packets = 0;
             for (size_t p = 0; p < PID_MAX; p++) {
                 now.counted_packets += _counters[p];
@@ -272,14 +298,12 @@ ts::ProcessorPlugin::Status ts::CountPlugin::processPacket(TSPacket& pkt, TSPack
     if (ok) {
         if (_report_all) {
             if (_brief_report) {
-                report(u"%d %d", tsp->pluginPackets(), pid);
+                report(u"%d %d", packet_index, pid);
             }
             else {
-                report(u"%spacket: %10'd, PID: %4d (0x%04X)", _tag, tsp->pluginPackets(), pid, pid);
+                report(u"%spacket: %10'd, PID: %4d (0x%04X)", _tag, packet_index, pid, pid);
             }
         }
         _counters[pid]++;
     }
-
-    return TSP_OK;
 }
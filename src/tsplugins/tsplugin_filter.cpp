@@ -13,6 +13,7 @@
 
 #include "tsPluginRepository.h"
 #include "tsSignalizationDemux.h"
+#include "tsTSPacketHeaders.h"
 #include "tsISDBTInformation.h"
 #include "tsAlgorithm.h"
 #include "tsMemory.h"
@@ -31,7 +32,7 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual bool stop() override;
-        virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPackets(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     private:
         // Packet intervals and list of them.
@@ -42,6 +43,7 @@ namespace ts {
         Status             _drop_status = TSP_DROP;     // Return status for unselected packets
         int                _scrambling_ctrl = 0;        // Scrambling control value (<0: no filter)
         bool               _need_demux = false;         // Need the help of the signalization demux.
+        bool               _pid_only = false;           // Select packets on explicit PID values only.
         bool               _with_payload = false;       // Packets with payload
         bool               _with_af = false;            // Packets with adaptation field
         bool               _with_pes = false;           // Packets with clear PES headers
@@ -90,6 +92,13 @@ namespace ts {
         PIDSet             _stream_id_pid {};           // PID values selected from stream ids
         std::set<uint16_t> _all_service_ids {};         // All service ids to filter, after service name resolution
         SignalizationDemux _demux {duck};               // Full signalization demux
+        TSPacketHeaders    _headers {};                 // Headers of a batch of packets, when _pid_only
+
+        // Filter one packet, packet_index is the index of the packet in the plugin.
+        Status filterPacket(TSPacket& pkt, TSPacketMetadata& pkt_data, PacketCounter packet_index);
+
+        // Apply the selection of one packet, return the packet status.
+        Status selectPacket(bool ok, TSPacketMetadata& pkt_data);
 
         // Implementation of SignalizationHandlerInterface
         virtual void handleService(uint16_t ts_id, const Service& service, const PMT& pmt, bool removed) override;
@@ -432,6 +441,14 @@ bool ts::FilterPlugin::getOptions()
         _audio || _video || _subtitles || _ecm || _emm || _psi || _intra_frame ||
         _codec != CodecType::UNDEFINED || !_service_ids.empty() || !_service_names.empty();
 
+    // When packets are selected on explicit PID values only, a batch of packets can be
+    // selected from the bulk extraction of their headers, without looking at each packet.
+    _pid_only = !_need_demux && _scrambling_ctrl < 0 && !_with_payload && !_with_af && !_with_pes && !_with_pcr &&
+        !_with_splice && !_unit_start && !_nullified && !_input_stuffing && !_valid &&
+        _min_payload < 0 && _max_payload < 0 && _min_af < 0 && _max_af < 0 &&
+        _splice < -128 && _min_splice < -128 && _max_splice < -128 && _every_packets == 0 &&
+        _labels.none() && _stream_ids.empty() && _isdb_layers.empty() && _pattern.empty() && _ranges.empty();
+
     // If we look for service names, we also need to be notified of changes in service list.
     _demux.setHandler(_service_names.empty() ? nullptr : this);
 
@@ -468,7 +485,25 @@ bool ts::FilterPlugin::stop()
 // Packet processing method
 //----------------------------------------------------------------------------
 
-ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+size_t ts::FilterPlugin::processPackets(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    const PacketCounter first_index = tsp->pluginPackets();
+    if (_pid_only) {
+        _headers.load(pkt, count);
+        for (size_t i = 0; i < count; ++i) {
+            // Pass initial packets without filtering.
+            status[i] = first_index + i < _after_packets ? TSP_OK : selectPacket(_explicit_pid[_headers.pid(i)], pkt_data[i]);
+        }
+    }
+    else {
+        for (size_t i = 0; i < count; ++i) {
+            status[i] = filterPacket(pkt[i], pkt_data[i], first_index + i);
+        }
+    }
+    return count;
+}
+
+ts::ProcessorPlugin::Status ts::FilterPlugin::filterPacket(TSPacket& pkt, TSPacketMetadata& pkt_data, PacketCounter packet_index)
 {
     const PID pid = pkt.getPID();
 
@@ -478,8 +513,7 @@ ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPac
     }
 
     // Pass initial packets without filtering.
-    const PacketCounter packetIndex = tsp->pluginPackets();
-    if (packetIndex < _after_packets) {
+    if (packet_index < _after_packets) {
         return TSP_OK;
     }
 
@@ -521,7 +555,7 @@ ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPac
         (int(pkt.getPayloadSize()) <= _max_payload) ||
         (_min_af >= 0 && int(pkt.getAFSize()) >= _min_af) ||
         (int(pkt.getAFSize()) <= _max_af) ||
-        (_every_packets > 0 && (tsp->pluginPackets() - _after_packets) % _every_packets == 0) ||
+        (_every_packets > 0 && (packet_index - _after_packets) % _every_packets == 0) ||
         (_with_pes && pkt.startPES());
 
     // Get ISDB layer if required.
@@ -546,9 +580,14 @@ ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPac
 
     // Search if packet is in one selected range.
     for (auto it = _ranges.begin(); !ok && it != _ranges.end(); ++it) {
-        ok = packetIndex >= it->first && packetIndex <= it->second;
+        ok = packet_index >= it->first && packet_index <= it->second;
     }
 
+    return selectPacket(ok, pkt_data);
+}
+
+ts::ProcessorPlugin::Status ts::FilterPlugin::selectPacket(bool ok, TSPacketMetadata& pkt_data)
+{
     // Reverse selection criteria with --negate.
     if (_negate) {
         ok = !ok;
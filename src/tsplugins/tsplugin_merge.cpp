@@ -19,6 +19,7 @@
 #include "tsPCRMerger.h"
 #include "tsPSIMerger.h"
 #include "tsTSForkPipe.h"
+#include "tsTSProcessorPipe.h"
 #include "tsTSPacketQueue.h"
 #include "tsPacketInsertionController.h"
 #include "tsThread.h"
@@ -50,6 +51,7 @@ namespace ts {
         size_t           _max_queue = DEFAULT_MAX_QUEUED_PACKETS;           // Maximum number of queued packets.
         size_t           _accel_threshold = DEFAULT_MAX_QUEUED_PACKETS / 2; // Queue threshold after which insertion is accelerated.
         bool             _no_wait = false;              // Do not wait for command completion.
+        bool             _in_process = false;           // Run the command as a tsp pipeline in the same process.
         bool             _merge_psi = false;            // Merge PSI/SI information.
         bool             _pcr_restamp = false;          // Restamp PCR from the merged stream.
         bool             _incremental_pcr = false;      // Use incremental method to restamp PCR's.
@@ -66,6 +68,7 @@ namespace ts {
 
         // The ForkPipe is dynamically allocated to avoid reusing the same object when the command is restarted.
         using TSForkPipePtr = std::shared_ptr<TSForkPipe>;
+        using TSProcessorPipePtr = std::shared_ptr<TSProcessorPipe>;
 
         // Working data.
         bool          _got_eof = false;    // Got end of merged stream.
@@ -74,6 +77,7 @@ namespace ts {
         PacketCounter _hold_count = 0;     // Number of times we didn't try to merge to perform smoothing insertion.
         PacketCounter _empty_count = 0;    // Number of times we could merge but there was no packet to merge.
         TSForkPipePtr _pipe {};            // Executed command.
+        TSProcessorPipePtr _branch {};     // In-process tsp pipeline, with --in-process.
         TSPacketQueue _queue {};           // TS packet queue from merge to main.
         PIDSet        _main_pids {};       // Set of detected PID's in main stream.
         PIDSet        _merge_pids {};      // Set of detected PID's in merged stream that we pass in main stream.
@@ -151,6 +155,14 @@ ts::MergePlugin::MergePlugin(TSP* tsp_) :
          u"bitrate (CBR) streams. The incremental method gives better results on "
          u"variable bitrate (VBR) streams. See also option --no-pcr-restamp.");
 
+    option(u"in-process");
+    help(u"in-process",
+         u"The command is a tsp command line which is executed inside the current process, "
+         u"in its own threads, instead of creating a new process. "
+         u"The leading \"tsp\" is optional and the command shall not specify an output plugin. "
+         u"The packets are directly passed in memory, without pipe. "
+         u"The options --format and --no-wait are ignored.");
+
     option(u"joint-termination", 'j');
     help(u"joint-termination",
         u"Perform a \"joint termination\" when the merged stream is terminated. "
@@ -252,6 +264,7 @@ bool ts::MergePlugin::getOptions()
 {
     getValue(_command);
     _no_wait = present(u"no-wait");
+    _in_process = present(u"in-process");
     const bool transparent = present(u"transparent");
     getIntValue(_max_queue, u"max-queue", DEFAULT_MAX_QUEUED_PACKETS);
     getIntValue(_accel_threshold, u"acceleration-threshold", _max_queue / 2);
@@ -316,8 +329,14 @@ bool ts::MergePlugin::startStopCommand(bool do_close, bool do_restart)
     // ensure that all calls are valid.
 
     if (do_close) {
-        debug(u"closing merge process pipe");
-        _pipe->close(*this);
+        if (_in_process) {
+            debug(u"closing merge pipeline");
+            _branch->close(*this);
+        }
+        else {
+            debug(u"closing merge process pipe");
+            _pipe->close(*this);
+        }
     }
 
     if (_stopping || !do_restart) {
@@ -334,6 +353,13 @@ bool ts::MergePlugin::startStopCommand(bool do_close, bool do_restart)
         info(u"restarting merge command");
     }
 
+    // With --in-process, run the tsp pipeline in the same process.
+    if (_in_process) {
+        _branch = std::make_shared<TSProcessorPipe>();
+        CheckNonNull(_branch.get());
+        return _branch->open(_command, TSProcessorPipe::READ_OUTPUT, DEFAULT_MAX_QUEUED_PACKETS, *this);
+    }
+
     // Allocate the new object. Atomically swap the safe pointer. This action
     // will synchronously deallocate the previous object.
     _pipe = std::make_shared<TSForkPipe>();
@@ -460,7 +486,12 @@ void ts::MergePlugin::main()
             // in the meantime (when the plugin stops) but no one will restart it.
             // So, the object which is pointed to by _pipe does not change.
 
-            pkt_count = _pipe->readPackets(buffer, mdata, max_pkt_count, *this);
+            if (_in_process) {
+                pkt_count = _branch->readPackets(buffer, mdata, max_pkt_count, *this);
+            }
+            else {
+                pkt_count = _pipe->readPackets(buffer, mdata, max_pkt_count, *this);
+            }
             success = pkt_count > 0;
 
             if (!success) {
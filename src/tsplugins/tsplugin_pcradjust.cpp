@@ -64,7 +64,7 @@ namespace ts {
         // Implementation of plugin API
         virtual bool getOptions() override;
         virtual bool start() override;
-        virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPackets(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     private:
         // Description of PID's. Map of safe pointers to PID contexts, indexed by PID.
@@ -88,6 +88,9 @@ namespace ts {
         // Get the context for a PID. Create one when necessary.
         PIDContextPtr getContext(PID pid);
 
+        // Process one packet at the given packet index, using the given reference bitrate.
+        void adjustPacket(TSPacket& pkt, PacketCounter current_packet, const BitRate& bitrate);
+
         // Description of one PID. One structure is created per PID in the TS.
         class PIDContext
         {
@@ -338,7 +341,20 @@ void ts::PCRAdjustPlugin::handleTable(SectionDemux& demux, const BinaryTable& ta
 // Packet processing method
 //----------------------------------------------------------------------------
 
-ts::ProcessorPlugin::Status ts::PCRAdjustPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+size_t ts::PCRAdjustPlugin::processPackets(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    // Get reference bitrate value (cannot do anything if zero).
+    const BitRate bitrate = _user_bitrate != 0 ? _user_bitrate : tsp->bitrate();
+    const PacketCounter first_index = tsp->pluginPackets();
+
+    for (size_t i = 0; i < count; ++i) {
+        adjustPacket(pkt[i], first_index + i, bitrate);
+        status[i] = TSP_OK;
+    }
+    return count;
+}
+
+void ts::PCRAdjustPlugin::adjustPacket(TSPacket& pkt, PacketCounter current_packet, const BitRate& bitrate)
 {
     // Pass all packets to the demux.
     _demux.feedPacket(pkt);
@@ -346,7 +362,6 @@ ts::ProcessorPlugin::Status ts::PCRAdjustPlugin::processPacket(TSPacket& pkt, TS
     // Get PID context.
     const PID pid = pkt.getPID();
     const PIDContextPtr ctx(getContext(pid));
-    const PacketCounter current_packet = tsp->pluginPackets();
 
     // Keep track of scrambled PID's (or which contain at least one scrambled packet).
     if (pkt.isScrambled()) {
@@ -356,9 +371,6 @@ ts::ProcessorPlugin::Status ts::PCRAdjustPlugin::processPacket(TSPacket& pkt, TS
     // Keep track of last continuity counter in case we have to create an empty packet with PCR later.
     ctx->last_cc = pkt.getCC();
 
-    // Get reference bitrate value (cannot do anything if zero).
-    const BitRate bitrate = _user_bitrate != 0 ? _user_bitrate : tsp->bitrate();
-
     // Only process packets from selected PID's (all by default).
     if (bitrate != 0 && _pids.test(pid) && (!ctx->scrambled || !_ignore_scrambled)) {
 
@@ -434,6 +446,4 @@ ts::ProcessorPlugin::Status ts::PCRAdjustPlugin::processPacket(TSPacket& pkt, TS
             pcr_ctx->last_created_packet = current_packet;
         }
     }
-
-    return TSP_OK;
 }
@@ -14,6 +14,7 @@
 #include "tsAbstractDuplicateRemapPlugin.h"
 #include "tsPluginRepository.h"
 #include "tsSectionDemux.h"
+#include "tsTSPacketHeaders.h"
 #include "tsCyclingPacketizer.h"
 #include "tsPAT.h"
 #include "tsCAT.h"
@@ -33,16 +34,19 @@ namespace ts {
         // Implementation of plugin API
         virtual bool getOptions() override;
         virtual bool start() override;
-        virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPackets(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     private:
         using CyclingPacketizerPtr = std::shared_ptr<CyclingPacketizer>;
         using PacketizerMap = std::map<PID, CyclingPacketizerPtr>;
 
-        bool          _update_psi = false;  // Update all PSI
-        bool          _pmt_ready = false;   // All PMT PID's are known
-        SectionDemux  _demux {duck, this};  // Section demux
-        PacketizerMap _pzer {};             // Packetizer for sections
+        bool                _update_psi = false;  // Update all PSI
+        bool                _pmt_ready = false;   // All PMT PID's are known
+        SectionDemux        _demux {duck, this};  // Section demux
+        PacketizerMap       _pzer {};             // Packetizer for sections
+        PIDSet              _active_pids {};      // Input PID's to process when PSI are not updated
+        TSPacketHeaders     _headers {};          // Headers of a batch of packets
+        std::vector<size_t> _selected {};         // Indexes of packets to process in a batch
 
         // Invoked by the demux when a complete table is available.
         virtual void handleTable(SectionDemux&, const BinaryTable&) override;
@@ -50,6 +54,9 @@ namespace ts {
         // Get the remapped value of a PID (or same PID if not remapped)
         PID remap(PID);
 
+        // Process one packet.
+        Status remapPacket(TSPacket& pkt, TSPacketMetadata& pkt_data);
+
         // Get the packetizer for one PID, create it if necessary and "create"
         CyclingPacketizerPtr getPacketizer(PID pid, bool create);
 
@@ -111,6 +118,15 @@ bool ts::RemapPlugin::start()
     // Do not care about PMT if no need to update PSI
     _pmt_ready = !_update_psi;
 
+    // Without PSI update, only the remapped PID's and the PID's to check for conflicts need processing.
+    _active_pids.reset();
+    for (const auto& it : _pidMap) {
+        _active_pids.set(it.first);
+    }
+    if (!_unchecked) {
+        _active_pids |= _newPIDs;
+    }
+
     verbose(u"%d PID's remapped", _pidMap.size());
     return true;
 }
@@ -227,7 +243,30 @@ void ts::RemapPlugin::handleTable(SectionDemux& demux, const BinaryTable& table)
 // Packet processing method
 //----------------------------------------------------------------------------
 
-ts::ProcessorPlugin::Status ts::RemapPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+size_t ts::RemapPlugin::processPackets(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    // Without PSI update, select the packets to process from the bulk extraction of their PID's.
+    if (!_update_psi) {
+        _headers.load(pkt, count);
+        _headers.selectPIDs(_selected, _active_pids);
+        std::fill(status, status + count, TSP_OK);
+        for (size_t i : _selected) {
+            if ((status[i] = remapPacket(pkt[i], pkt_data[i])) == TSP_END) {
+                return i + 1;
+            }
+        }
+        return count;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if ((status[i] = remapPacket(pkt[i], pkt_data[i])) == TSP_END) {
+            return i + 1;
+        }
+    }
+    return count;
+}
+
+ts::ProcessorPlugin::Status ts::RemapPlugin::remapPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
 {
     const PID pid = pkt.getPID();
     const PID new_pid = remap(pid);
@@ -82,8 +82,14 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t getPacketWindowSize() override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     private:
+        // Number of packets in a packet window. The packets to scramble in a window are scrambled
+        // together. This is a trade-off between the efficiency of parallel scrambling and latency.
+        static constexpr size_t WINDOW_SIZE = 8 * DVBCSA2::PARALLEL_COUNT;
+
         // Description of a crypto-period.
         // Each CryptoPeriod object points to its ScramblerPlugin parent object.
         // In case of error in a CryptoPeriod object, the _abort volatile flag
@@ -181,6 +187,8 @@ namespace ts {
         size_t            _current_cw = 0;              // Index to current CW (current crypto period)
         size_t            _current_ecm = 0;             // Index to current ECM (ECM being broadcast)
         TSScrambling      _scrambling {*this};          // Scrambler
+        bool              _window_mode = false;         // Currently processing a packet window.
+        std::vector<TSPacket*> _queued_packets {};      // Packets to scramble in packet window mode.
         CyclingPacketizer _pzer_pmt {duck};             // Packetizer for modified PMT
 
         // Initialize ECM and CP scheduling.
@@ -196,6 +204,13 @@ namespace ts {
         bool changeCW();
         void changeECM();
 
+        // Scramble a packet. In packet window mode, the packet is only queued and will be
+        // scrambled later with other packets. Return false on error.
+        bool scramblePacket(TSPacket& pkt);
+
+        // Scramble all queued packets. Return false on error.
+        bool flushPackets();
+
         // Check if we are in degraded mode or if we enter degraded mode
         bool inDegradedMode();
 
@@ -680,6 +695,11 @@ bool ts::ScramblerPlugin::tryExitDegradedMode()
 
 bool ts::ScramblerPlugin::changeCW()
 {
+    // Queued packets must be scrambled with the previous CW first.
+    if (!flushPackets()) {
+        return false;
+    }
+
     if (_scrambling.hasFixedCW()) {
         // A list of fixed CW was loaded from a file.
 
@@ -849,7 +869,7 @@ ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacket(TSPacket& pkt, TS
     }
 
     // Scramble the packet payload.
-    if (!_scrambling.encrypt(pkt)) {
+    if (!scramblePacket(pkt)) {
         return TSP_END;
     }
     _scrambled_count++;
@@ -858,6 +878,70 @@ ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacket(TSPacket& pkt, TS
 }
 
 
+//----------------------------------------------------------------------------
+// Packet window processing: the packets are individually analyzed but the
+// scrambling is performed on groups of packets, which is faster with
+// DVB-CSA2 since its implementation processes many packets in parallel.
+//----------------------------------------------------------------------------
+
+size_t ts::ScramblerPlugin::getPacketWindowSize()
+{
+    return WINDOW_SIZE;
+}
+
+size_t ts::ScramblerPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    _window_mode = true;
+
+    TSPacket* pkt = nullptr;
+    TSPacketMetadata* pkt_data = nullptr;
+    size_t index = 0;
+
+    for (; index < win.size(); ++index) {
+        if (win.get(index, pkt, pkt_data)) {
+            const Status status = processPacket(*pkt, *pkt_data);
+            if (status == TSP_END) {
+                break;
+            }
+            else if (status == TSP_NULL) {
+                win.nullify(index);
+            }
+            else if (status == TSP_DROP) {
+                win.drop(index);
+            }
+        }
+    }
+
+    // Scramble all remaining queued packets before returning the window.
+    // In case of scrambling error, terminate before this window.
+    _window_mode = false;
+    return flushPackets() ? index : 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Scramble a packet, immediately or later in packet window mode.
+//----------------------------------------------------------------------------
+
+bool ts::ScramblerPlugin::scramblePacket(TSPacket& pkt)
+{
+    if (_window_mode) {
+        _queued_packets.push_back(&pkt);
+        return true;
+    }
+    else {
+        return _scrambling.encrypt(pkt);
+    }
+}
+
+bool ts::ScramblerPlugin::flushPackets()
+{
+    const bool ok = _queued_packets.empty() || _scrambling.encrypt(_queued_packets.data(), _queued_packets.size());
+    _queued_packets.clear();
+    return ok;
+}
+
+
 //----------------------------------------------------------------------------
 // Initialize first crypto period.
 //----------------------------------------------------------------------------
@@ -51,6 +51,21 @@ TS_REGISTER_PROCESSOR_PLUGIN(u"timeshift", ts::TimeShiftPlugin);
 ts::TimeShiftPlugin::TimeShiftPlugin (TSP* tsp_) :
     ProcessorPlugin(tsp_, u"Delay transmission by a fixed amount of packets", u"[options]")
 {
+    option(u"asynchronous-io", 'a');
+    help(u"asynchronous-io",
+         u"Use a background thread to read and write the temporary buffer file in large segments. "
+         u"Filled segments are written in the background and the next segment to output is read in advance, "
+         u"so that the plugin thread does not wait for disk I/O. "
+         u"This is recommended for very large buffers, for instance delaying a full multiplex by hours. "
+         u"With this option, the memory cache (see --memory-packets) is split in segment buffers, "
+         u"with a minimum of four segments.");
+
+    option(u"direct-io");
+    help(u"direct-io",
+         u"With --asynchronous-io, bypass the system cache when accessing the temporary buffer file. "
+         u"This avoids evicting other data from the system cache with packets which will not be read before a long time. "
+         u"When the file system does not support direct I/O, the system cache is used.");
+
     option(u"directory", 0, DIRECTORY);
     help(u"directory",
          u"Specify a directory where the temporary buffer file is created. "
@@ -76,6 +91,11 @@ ts::TimeShiftPlugin::TimeShiftPlugin (TSP* tsp_) :
          u"Specify the size of the time-shift buffer in packets. "
          u"There is no default, the size of the buffer shall be specified either using --packets or --time.");
 
+    option(u"segment-packets", 's', UNSIGNED);
+    help(u"segment-packets",
+         u"With --asynchronous-io, specify the number of packets in each segment of the temporary buffer file. "
+         u"The default is " + UString::Decimal(TimeShiftBuffer::DEFAULT_SEGMENT_PACKETS) + u" packets.");
+
     option<cn::milliseconds>(u"time", 't');
     help(u"time",
          u"Specify the size of the time-shift buffer in milliseconds. "
@@ -97,6 +117,14 @@ bool ts::TimeShiftPlugin::getOptions()
     const size_t packets = intValue<size_t>(u"packets", 0);
     _buffer.setBackupDirectory(value(u"directory"));
     _buffer.setMemoryPackets(intValue<size_t>(u"memory-packets", TimeShiftBuffer::DEFAULT_MEMORY_PACKETS));
+    _buffer.setAsyncIO(present(u"asynchronous-io"));
+    _buffer.setDirectIO(present(u"direct-io"));
+    _buffer.setSegmentPackets(intValue<size_t>(u"segment-packets", TimeShiftBuffer::DEFAULT_SEGMENT_PACKETS));
+
+    if (!present(u"asynchronous-io") && (present(u"direct-io") || present(u"segment-packets"))) {
+        error(u"--direct-io and --segment-packets require --asynchronous-io");
+        return false;
+    }
 
     if ((packets > 0 && _time_shift_ms > cn::milliseconds::zero()) || (packets == 0 && _time_shift_ms == cn::milliseconds::zero())) {
         error(u"specify exactly one of --packets and --time for time-shift buffer sizing");
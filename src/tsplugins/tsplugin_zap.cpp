@@ -36,7 +36,7 @@ namespace ts {
         // Implementation of plugin API
         virtual bool getOptions() override;
         virtual bool start() override;
-        virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPackets(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     private:
         // Each service to keep is described by one structure.
@@ -108,6 +108,9 @@ namespace ts {
         void handleSDT(SDT&);
         void handleVCT(VCT&);
 
+        // Process one packet.
+        Status zapPacket(TSPacket& pkt);
+
         // Send a new PAT.
         void sendNewPAT();
 
@@ -807,7 +810,17 @@ bool ts::ZapPlugin::keepComponent(PID pid, const DescriptorList& descs, const US
 // Packet processing method
 //----------------------------------------------------------------------------
 
-ts::ProcessorPlugin::Status ts::ZapPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+size_t ts::ZapPlugin::processPackets(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        if ((status[i] = zapPacket(pkt[i])) == TSP_END) {
+            return i + 1;
+        }
+    }
+    return count;
+}
+
+ts::ProcessorPlugin::Status ts::ZapPlugin::zapPacket(TSPacket& pkt)
 {
     const PID pid = pkt.getPID();
 
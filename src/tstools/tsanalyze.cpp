@@ -16,6 +16,8 @@
 #include "tsTSFile.h"
 #include "tsPagerArgs.h"
 #include "tsDuckContext.h"
+#include "tsReport.h"
+#include "tsThread.h"
 TS_MAIN(MainCode);
 
 
@@ -34,6 +36,7 @@ namespace {
         ts::BitRate           bitrate = 0;         // Expected bitrate (188-byte packets)
         fs::path              infile {};           // Input file name
         ts::TSPacketFormat    format = ts::TSPacketFormat::AUTODETECT; // Input file format.
+        size_t                threads = 1;         // Number of analysis threads.
         ts::TSAnalyzerOptions analysis {};         // Analysis options.
         ts::PagerArgs         pager {true, true};  // Output paging options.
     };
@@ -60,6 +63,14 @@ Options::Options(int argc, char *argv[]) :
          u"(based on 188-byte packets). By default, the bitrate is "
          u"evaluated using the PCR in the transport stream.");
 
+    option(u"threads", 0, INTEGER, 0, 1, 1, 64);
+    help(u"threads", u"count",
+         u"Analyze the input file in parallel using the specified number of threads. "
+         u"The file is split in contiguous segments which are analyzed independently and the results are merged. "
+         u"This option is ignored when the input is not a regular file. "
+         u"Continuity errors and leaps in PCR, PTS and DTS are not detected at the boundaries between segments. "
+         u"By default, the file is analyzed sequentially.");
+
     analyze(argc, argv);
 
     // Define all standard analysis options.
@@ -69,12 +80,188 @@ Options::Options(int argc, char *argv[]) :
 
     getPathValue(infile, u"");
     getValue(bitrate, u"bitrate");
+    getIntValue(threads, u"threads", 1);
     format = ts::LoadTSPacketFormatInputOption(*this);
 
     exitOnError();
 }
 
 
+//----------------------------------------------------------------------------
+//  Analyze a segment of the input file.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Minimum number of packets per segment in a parallel analysis.
+    constexpr ts::PacketCounter MIN_SEGMENT_PACKETS = 10'000;
+
+    // Number of packets at start of file to collect the PSI/SI before a parallel analysis.
+    constexpr ts::PacketCounter PSI_PACKETS = 100'000;
+
+    // Number of packets per read operation.
+    constexpr size_t READ_PACKETS = 1024;
+
+    // Analyze a segment of a file, starting at a byte offset, with a maximum number of packets.
+    bool AnalyzeFile(ts::TSAnalyzer& analyzer, const fs::path& infile, ts::TSPacketFormat format, uint64_t start_offset, ts::PacketCounter max_packets, ts::Report& report)
+    {
+        ts::TSFile file;
+        if (!file.openRead(infile, 1, start_offset, report, format)) {
+            return false;
+        }
+        ts::TSPacketVector pkt(READ_PACKETS);
+        ts::TSPacketMetadataVector mdata(READ_PACKETS);
+        ts::PacketCounter count = 0;
+        size_t ret = 0;
+        while (count < max_packets && (ret = file.readPackets(pkt.data(), mdata.data(), size_t(std::min<ts::PacketCounter>(READ_PACKETS, max_packets - count)), report)) > 0) {
+            for (size_t i = 0; i < ret; ++i) {
+                analyzer.feedPacket(pkt[i], mdata[i]);
+            }
+            count += ret;
+        }
+        file.close(report);
+        return true;
+    }
+
+    // A log of messages with their severity, replayed after the analysis of a segment.
+    class SegmentLog: public ts::Report
+    {
+        TS_NOCOPY(SegmentLog);
+    public:
+        SegmentLog(int max_severity) : ts::Report(max_severity) {}
+
+        // Log all messages on another report, with their original severity.
+        void replay(ts::Report& report) const
+        {
+            for (const auto& it : _messages) {
+                report.log(it.first, it.second);
+            }
+        }
+
+    protected:
+        virtual void writeLog(int severity, const ts::UString& message) override
+        {
+            _messages.push_back(std::make_pair(severity, message));
+        }
+
+    private:
+        std::list<std::pair<int, ts::UString>> _messages {};
+    };
+
+    // A thread which analyzes one segment of the input file, with its own context.
+    class SegmentAnalyzer: public ts::Thread
+    {
+        TS_NOBUILD_NOCOPY(SegmentAnalyzer);
+    public:
+        SegmentAnalyzer(const Options& opt, ts::TSPacketFormat format, uint64_t start_offset, ts::PacketCounter max_packets, const ts::BinaryTablePtrVector& psi);
+        virtual ~SegmentAnalyzer() override;
+
+        SegmentLog         log;
+        ts::DuckContext    duck {&log};
+        ts::TSAnalyzer     analyzer;
+        bool               success = false;
+
+    private:
+        const fs::path           _infile;
+        const ts::TSPacketFormat _format;
+        const uint64_t           _start_offset;
+        const ts::PacketCounter  _max_packets;
+
+        virtual void main() override;
+    };
+}
+
+SegmentAnalyzer::SegmentAnalyzer(const Options& opt, ts::TSPacketFormat format, uint64_t start_offset, ts::PacketCounter max_packets, const ts::BinaryTablePtrVector& psi) :
+    log(opt.maxSeverity()),
+    analyzer(duck, opt.bitrate, ts::BitRateConfidence::OVERRIDE),
+    _infile(opt.infile),
+    _format(format),
+    _start_offset(start_offset),
+    _max_packets(max_packets)
+{
+    ts::DuckContext::SavedArgs args;
+    opt.duck.saveArgs(args);
+    duck.restoreArgs(args);
+    analyzer.setMinErrorCountBeforeSuspect(opt.analysis.suspect_min_error_count);
+    analyzer.setMaxConsecutiveSuspectCount(opt.analysis.suspect_max_consecutive);
+    analyzer.loadPSI(psi);
+}
+
+SegmentAnalyzer::~SegmentAnalyzer()
+{
+    waitForTermination();
+}
+
+void SegmentAnalyzer::main()
+{
+    success = AnalyzeFile(analyzer, _infile, _format, _start_offset, _max_packets, log);
+}
+
+
+//----------------------------------------------------------------------------
+//  Analyze the input file in parallel. Return false if not possible.
+//----------------------------------------------------------------------------
+
+namespace {
+    bool AnalyzeParallel(Options& opt, ts::TSAnalyzer& analyzer, bool& success)
+    {
+        // Only regular files can be split.
+        std::error_code err;
+        if (opt.threads < 2 || opt.infile.empty() || !fs::is_regular_file(opt.infile, err)) {
+            return false;
+        }
+        const uint64_t file_size = fs::file_size(opt.infile, err);
+        if (err) {
+            return false;
+        }
+
+        // Detect the packet format and collect the PSI/SI at the start of the file.
+        ts::TSAnalyzer psi(opt.duck);
+        psi.setPSICapture(true);
+        ts::TSFile file;
+        ts::TSPacket pkt;
+        ts::TSPacketMetadata mdata;
+        if (!file.openRead(opt.infile, 1, 0, opt, opt.format) || file.readPackets(&pkt, &mdata, 1, opt) == 0) {
+            return false;
+        }
+        const ts::TSPacketFormat format = file.packetFormat();
+        const size_t packet_size = file.packetHeaderSize() + ts::PKT_SIZE + file.packetTrailerSize();
+        psi.feedPacket(pkt, mdata);
+        for (ts::PacketCounter count = 1; count < PSI_PACKETS && file.readPackets(&pkt, &mdata, 1, opt) > 0; ++count) {
+            psi.feedPacket(pkt, mdata);
+        }
+        file.close(opt);
+        ts::BinaryTablePtrVector tables;
+        psi.getPSI(tables);
+
+        // Split the file in segments of contiguous packets.
+        const ts::PacketCounter total = file_size / packet_size;
+        const size_t count = size_t(std::min<ts::PacketCounter>(opt.threads, total / MIN_SEGMENT_PACKETS));
+        if (count < 2) {
+            return false;
+        }
+        opt.verbose(u"analyzing %'d packets using %d threads", total, count);
+
+        // The first segment does not need the PSI/SI, it starts with the stream.
+        const ts::PacketCounter seg_packets = (total + count - 1) / count;
+        std::vector<std::unique_ptr<SegmentAnalyzer>> segments;
+        for (size_t i = 0; i < count; ++i) {
+            segments.push_back(std::make_unique<SegmentAnalyzer>(opt, format, i * seg_packets * packet_size, seg_packets, i == 0 ? ts::BinaryTablePtrVector() : tables));
+            segments.back()->start();
+        }
+
+        // Merge the results in the order of the segments.
+        success = true;
+        for (auto& seg : segments) {
+            seg->waitForTermination();
+            seg->log.replay(opt);
+            success = success && seg->success && !seg->log.gotErrors();
+            analyzer.merge(seg->analyzer);
+        }
+        return true;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 //  Program entry point
 //----------------------------------------------------------------------------
@@ -88,19 +275,15 @@ int MainCode(int argc, char *argv[])
     ts::TSAnalyzerReport analyzer(opt.duck, opt.bitrate, ts::BitRateConfidence::OVERRIDE);
     analyzer.setAnalysisOptions(opt.analysis);
 
-    // Open the TS file.
-    ts::TSFile file;
-    if (!file.openRead(opt.infile, 1, 0, opt, opt.format)) {
-        return EXIT_FAILURE;
+    // Analyze all packets in the file, in parallel or sequentially.
+    bool success = true;
+    if (!AnalyzeParallel(opt, analyzer, success)) {
+        success = AnalyzeFile(analyzer, opt.infile, opt.format, 0, std::numeric_limits<ts::PacketCounter>::max(), opt);
     }
 
-    // Analyze all packets in the file.
-    ts::TSPacket pkt;
-    ts::TSPacketMetadata mdata;
-    while (file.readPackets(&pkt, &mdata, 1, opt) > 0) {
-        analyzer.feedPacket(pkt, mdata);
+    if (!success) {
+        return EXIT_FAILURE;
     }
-    file.close(opt);
 
     // Display analysis results.
     analyzer.report(opt.pager.output(opt), opt.analysis, opt);
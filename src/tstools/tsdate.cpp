@@ -114,6 +114,11 @@ private:
 
 void TableHandler::handleTable(ts::SectionDemux&, const ts::BinaryTable& table)
 {
+    // Packets are demuxed by batches, ignore tables which come after completion.
+    if (completed()) {
+        return;
+    }
+
     switch (table.tableId()) {
 
         case ts::TID_TDT: {
@@ -196,10 +201,12 @@ int MainCode(int argc, char *argv[])
         return EXIT_FAILURE;
     }
 
-    // Read all packets in the file until the date is found.
-    ts::TSPacket pkt;
-    while (!handler.completed() && file.readPackets(&pkt, nullptr, 1, opt) > 0 ) {
-        demux.feedPacket(pkt);
+    // Read all packets in the file, by batches, until the date is found.
+    constexpr size_t BUFFER_PACKETS = 512;
+    ts::TSPacketVector buffer(BUFFER_PACKETS);
+    size_t count = 0;
+    while (!handler.completed() && (count = file.readPackets(buffer.data(), nullptr, buffer.size(), opt)) > 0) {
+        demux.feedPackets(buffer.data(), count);
     }
     file.close(opt);
 
@@ -181,13 +181,16 @@ ts::FileCleaner::FileCleaner(FileCleanOptions& opt, const fs::path& infile_name)
     }
     _opt.verbose(u"cleaning %s -> %s", infile_name, outfile_name);
 
-    // Open the input file in rewindable mode.
+    // Open the input file in rewindable mode. Map it in memory since it is read twice, packet by packet.
+    _in_file.setMemoryMapping(true);
     if (!_in_file.openRead(infile_name, 0, _opt)) {
         errorCleanup();
         return;
     }
 
     // Create output file before first pass to avoid spending time on first pass in case of error when creating output.
+    // The output file is written asynchronously, in parallel with the second pass.
+    _out_file.setWriteQueue(4);
     if (!_out_file.open(outfile_name, TSFile::WRITE, _opt)) {
         errorCleanup();
         return;
@@ -11,6 +11,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsCRC32.h"
+#include "tsByteBlock.h"
 #include "tsunit.h"
 #include "utestTSUnitBenchmark.h"
 
@@ -22,6 +23,7 @@
 class CRC32Test: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(CRC);
+    TSUNIT_DECLARE_TEST(CheckMany);
 };
 
 TSUNIT_REGISTER(CRC32Test);
@@ -160,3 +162,42 @@ TSUNIT_DEFINE_TEST(CRC)
 
     bench.report(u"CRC32Test::testCRC");
 }
+
+TSUNIT_DEFINE_TEST(CheckMany)
+{
+    // Build data areas with their CRC32 at end, use each test data twice, corrupt some of them.
+    std::vector<ts::ByteBlock> areas;
+    std::vector<bool> expected;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (const auto* data = all_data; data->data_size != 0; ++data) {
+            areas.emplace_back(data->data, data->data_size);
+            areas.back().appendUInt32(data->crc);
+            expected.push_back(true);
+            if (areas.size() % 3 == 0) {
+                areas.back()[areas.back().size() / 2] ^= 0x10;
+                expected.back() = false;
+            }
+        }
+    }
+
+    // An area which is too short to contain a CRC32.
+    areas.emplace_back(2, 0);
+    expected.push_back(false);
+
+    const size_t count = areas.size();
+    std::vector<const void*> addresses(count);
+    std::vector<size_t> sizes(count);
+    size_t valid_count = 0;
+    for (size_t i = 0; i < count; ++i) {
+        addresses[i] = areas[i].data();
+        sizes[i] = areas[i].size();
+        valid_count += expected[i];
+    }
+
+    bool valid[64];
+    TSUNIT_ASSERT(count <= sizeof(valid));
+    TSUNIT_EQUAL(valid_count, ts::CRC32::CheckMany(addresses.data(), sizes.data(), valid, count));
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_EQUAL(bool(expected[i]), valid[i]);
+    }
+}
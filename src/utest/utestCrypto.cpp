@@ -62,6 +62,7 @@ class CryptoTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(AES_CTS3);
     TSUNIT_DECLARE_TEST(AES_CTS4);
     TSUNIT_DECLARE_TEST(AES_DVS042);
+    TSUNIT_DECLARE_TEST(AES_MultiBlocks);
     TSUNIT_DECLARE_TEST(DES);
     TSUNIT_DECLARE_TEST(TDES);
     TSUNIT_DECLARE_TEST(TDES_CBC);
@@ -489,6 +490,64 @@ TSUNIT_DEFINE_TEST(AES_DVS042)
     testChainingSizes(aes256, 16, 17, 23, 31, 32, 33, 45, 64, 67, 184, 12345, 0);
 }
 
+// Chaining modes process independent blocks by groups. Check them against block-per-block references.
+TSUNIT_DEFINE_TEST(AES_MultiBlocks)
+{
+    constexpr size_t bsize = ts::AES128::BLOCK_SIZE;
+    constexpr size_t count = 3 * ts::BlockCipher::MULTI_BLOCKS + 5;
+    constexpr size_t size = count * bsize;
+
+    ts::SystemRandomGenerator prng;
+    ts::ByteBlock key(ts::AES128::KEY_SIZE);
+    ts::ByteBlock iv(bsize);
+    ts::ByteBlock plain(size);
+    TSUNIT_ASSERT(prng.read(key.data(), key.size()));
+    TSUNIT_ASSERT(prng.read(iv.data(), iv.size()));
+    TSUNIT_ASSERT(prng.read(plain.data(), plain.size()));
+
+    ts::AES128 aes;
+    TSUNIT_ASSERT(aes.setKey(key.data(), key.size()));
+
+    // CTR: key stream is the encryption of a 64-bit big-endian counter in the second half of the IV.
+    ts::CTR<ts::AES128> ctr;
+    ts::ByteBlock cipher(size);
+    TSUNIT_ASSERT(ctr.setKey(key.data(), key.size(), iv.data(), iv.size()));
+    TSUNIT_ASSERT(ctr.encrypt(plain.data(), size, cipher.data(), size));
+    ts::ByteBlock counter(iv);
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t stream[bsize];
+        TSUNIT_ASSERT(aes.encrypt(counter.data(), bsize, stream, bsize));
+        ts::MemXor(stream, stream, plain.data() + i * bsize, bsize);
+        TSUNIT_ASSERT(ts::MemEqual(stream, cipher.data() + i * bsize, bsize));
+        ts::PutUInt64(counter.data() + 8, ts::GetUInt64(counter.data() + 8) + 1);
+    }
+
+    // DVS042 on complete blocks is CBC: decryption must match the system library CBC.
+    ts::CBC<ts::AES128> cbc;
+    ts::DVS042<ts::AES128> dvs;
+    TSUNIT_ASSERT(cbc.setKey(key.data(), key.size(), iv.data(), iv.size()));
+    TSUNIT_ASSERT(dvs.setKey(key.data(), key.size(), iv.data(), iv.size()));
+    TSUNIT_ASSERT(cbc.encrypt(plain.data(), size, cipher.data(), size));
+    ts::ByteBlock decipher(size);
+    TSUNIT_ASSERT(dvs.decrypt(cipher.data(), size, decipher.data(), size));
+    TSUNIT_ASSERT(decipher == plain);
+    decipher = cipher;
+    TSUNIT_ASSERT(dvs.decrypt(decipher.data(), size, decipher.data(), size));
+    TSUNIT_ASSERT(decipher == plain);
+
+    // CTS3 encrypts all blocks but the last two in ECB mode.
+    ts::CTS3<ts::AES128> cts3;
+    TSUNIT_ASSERT(cts3.setKey(key.data(), key.size()));
+    TSUNIT_ASSERT(cts3.encrypt(plain.data(), size - 3, cipher.data(), size));
+    for (size_t i = 0; i + 2 < count; ++i) {
+        uint8_t block[bsize];
+        TSUNIT_ASSERT(aes.encrypt(plain.data() + i * bsize, bsize, block, bsize));
+        TSUNIT_ASSERT(ts::MemEqual(block, cipher.data() + i * bsize, bsize));
+    }
+    TSUNIT_ASSERT(cts3.decrypt(cipher.data(), size - 3, decipher.data(), size));
+    TSUNIT_ASSERT(ts::MemEqual(plain.data(), decipher.data(), size - 3));
+}
+
 TSUNIT_DEFINE_TEST(DES)
 {
     ts::DES des;
@@ -23,7 +23,9 @@
 #include "tsBAT.h"
 #include "tsTOT.h"
 #include "tsTDT.h"
+#include "tsTSAnalyzer.h"
 #include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
 
 #include "tables/psi_bat_cplus_packets.h"
 #include "tables/psi_bat_cplus_sections.h"
@@ -66,6 +68,9 @@ class DemuxTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(TDT);
     TSUNIT_DECLARE_TEST(TOT);
     TSUNIT_DECLARE_TEST(HEVC);
+    TSUNIT_DECLARE_TEST(ManyPIDs);
+    TSUNIT_DECLARE_TEST(Recycle);
+    TSUNIT_DECLARE_TEST(SkipUnchanged);
 
 private:
     // Compare a table with the list of reference sections
@@ -76,6 +81,9 @@ private:
 
     // Unitary test for one table.
     void testTable(const char* name, const uint8_t* ref_packets, size_t ref_packets_size, const uint8_t* ref_sections, size_t ref_sections_size);
+
+    // Packetize one table alone and append its packets to a vector.
+    static void appendTable(ts::DuckContext& duck, ts::OneShotPacketizer& pzer, const ts::AbstractTable& table, ts::TSPacketVector& packets);
 };
 
 TSUNIT_REGISTER(DemuxTest);
@@ -167,6 +175,17 @@ bool DemuxTest::checkPackets(const char* test_name, const char* table_name, cons
     return true;
 }
 
+// Packetize one table alone and append its packets to a vector.
+void DemuxTest::appendTable(ts::DuckContext& duck, ts::OneShotPacketizer& pzer, const ts::AbstractTable& table, ts::TSPacketVector& packets)
+{
+    // The packetizer accumulates tables, remove them after packetization.
+    ts::TSPacketVector pkts;
+    pzer.addTable(duck, table);
+    pzer.getPackets(pkts);
+    pzer.removeAll();
+    packets.insert(packets.end(), pkts.begin(), pkts.end());
+}
+
 // Unitary test for one table.
 void DemuxTest::testTable(const char* name, const uint8_t* ref_packets, size_t ref_packets_size, const uint8_t* ref_sections, size_t ref_sections_size)
 {
@@ -434,3 +453,139 @@ TSUNIT_DEFINE_TEST(HEVC)
 {
     TEST_TABLE("PMT with HEVC descriptor", pmt_hevc);
 }
+
+// A multiplex of many PID's, each carrying one TDT per packet.
+TSUNIT_DEFINE_TEST(ManyPIDs)
+{
+    constexpr size_t pid_count = 300;
+    constexpr size_t rounds = 16;
+
+    TSUNIT_EQUAL(ts::PKT_SIZE, sizeof(psi_tdt_tnt_packets));
+    ts::TSPacketVector packets(pid_count * rounds);
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i].copyFrom(psi_tdt_tnt_packets);
+        packets[i].setPID(ts::PID(0x0100 + 17 * (i % pid_count)));
+        packets[i].setCC(uint8_t(i / pid_count));
+    }
+
+    class Handler: public ts::TableHandlerInterface
+    {
+    public:
+        size_t count = 0;
+        virtual void handleTable(ts::SectionDemux&, const ts::BinaryTable&) override { count++; }
+    };
+
+    ts::DuckContext duck;
+    Handler handler;
+    ts::SectionDemux demux(duck, &handler, nullptr, ts::AllPIDs());
+    ts::TSAnalyzer analyzer(duck);
+    const ts::TSPacketMetadata mdata;
+
+    utest::TSUnitBenchmark bench(u"TSUNIT_DEMUX_ITERATIONS");
+    bench.start();
+    for (size_t iter = 0; iter < bench.iterations; ++iter) {
+        demux.reset();
+        analyzer.reset();
+        handler.count = 0;
+        demux.feedPackets(packets.data(), packets.size());
+        for (const auto& pkt : packets) {
+            analyzer.feedPacket(pkt, mdata);
+        }
+    }
+    bench.stop();
+    bench.report(u"DemuxTest::ManyPIDs");
+
+    TSUNIT_EQUAL(pid_count * rounds, handler.count);
+    std::vector<ts::PID> pids;
+    analyzer.getPIDs(pids);
+    TSUNIT_EQUAL(pid_count, pids.size());
+    TSUNIT_EQUAL(0x0100, pids.front());
+    TSUNIT_EQUAL(0x0100 + 17 * (pid_count - 1), pids.back());
+    TSUNIT_ASSERT(std::is_sorted(pids.begin(), pids.end()));
+}
+
+// Successive versions of a table, check that recycled sections do not alter previous ones.
+TSUNIT_DEFINE_TEST(Recycle)
+{
+    constexpr size_t table_count = 100;
+
+    ts::DuckContext duck;
+    ts::TSPacketVector packets;
+    ts::OneShotPacketizer pzer(duck, ts::PID_PAT);
+    for (size_t i = 0; i < table_count; ++i) {
+        ts::PAT pat(uint8_t(i % 32), true, uint16_t(i));
+        pat.pmts[uint16_t(i + 1)] = ts::PID(0x0100 + i);
+        appendTable(duck, pzer, pat, packets);
+    }
+
+    class Handler: public ts::TableHandlerInterface, public ts::SectionHandlerInterface
+    {
+    public:
+        std::vector<uint16_t> tables {};
+        ts::SectionPtrVector sections {};
+        virtual void handleTable(ts::SectionDemux&, const ts::BinaryTable& table) override { tables.push_back(table.tableIdExtension()); }
+        virtual void handleSection(ts::SectionDemux&, const ts::Section& section) override { sections.push_back(std::make_shared<ts::Section>(section, ts::ShareMode::SHARE)); }
+    };
+
+    Handler handler;
+    ts::SectionDemux demux(duck, &handler, &handler, ts::PIDSet().set(ts::PID_PAT));
+    demux.feedPackets(packets.data(), packets.size());
+
+    TSUNIT_EQUAL(table_count, handler.tables.size());
+    TSUNIT_EQUAL(table_count, handler.sections.size());
+    for (size_t i = 0; i < table_count; ++i) {
+        TSUNIT_EQUAL(i, handler.tables[i]);
+        TSUNIT_ASSERT(handler.sections[i]->isValid());
+        TSUNIT_EQUAL(i, handler.sections[i]->tableIdExtension());
+        TSUNIT_EQUAL(i % 32, handler.sections[i]->version());
+    }
+}
+
+// Cycled versions of a table, check that unchanged repetitions are skipped.
+TSUNIT_DEFINE_TEST(SkipUnchanged)
+{
+    // Five repetitions of PAT version 0, then version 1, then version 0 again.
+    ts::DuckContext duck;
+    ts::TSPacketVector packets;
+    ts::OneShotPacketizer pzer(duck, ts::PID_PAT);
+    for (uint8_t version : {0, 1, 0}) {
+        ts::PAT pat(version, true, 1);
+        pat.pmts[version + 1] = ts::PID(0x0100 + version);
+        for (size_t i = 0; i < 5; ++i) {
+            appendTable(duck, pzer, pat, packets);
+        }
+    }
+
+    class Handler: public ts::TableHandlerInterface, public ts::SectionHandlerInterface
+    {
+    public:
+        size_t tables = 0;
+        std::vector<uint8_t> versions {};
+        virtual void handleTable(ts::SectionDemux&, const ts::BinaryTable&) override { tables++; }
+        virtual void handleSection(ts::SectionDemux&, const ts::Section& section) override { versions.push_back(section.version()); }
+    };
+
+    // By default, all sections are reported.
+    Handler handler;
+    ts::SectionDemux demux(duck, &handler, &handler, ts::PIDSet().set(ts::PID_PAT));
+    demux.feedPackets(packets.data(), packets.size());
+    TSUNIT_EQUAL(3, handler.tables);
+    TSUNIT_EQUAL(15, handler.versions.size());
+    TSUNIT_EQUAL(0, ts::SectionDemux::Status(demux).unchanged);
+
+    // Skip unchanged sections, the previous version is reported again after an update.
+    handler.tables = 0;
+    handler.versions.clear();
+    demux.reset();
+    demux.setSkipUnchangedSections(true);
+    demux.feedPackets(packets.data(), packets.size());
+    TSUNIT_EQUAL(3, handler.tables);
+    TSUNIT_EQUAL(3, handler.versions.size());
+    TSUNIT_EQUAL(0, handler.versions[0]);
+    TSUNIT_EQUAL(1, handler.versions[1]);
+    TSUNIT_EQUAL(0, handler.versions[2]);
+
+    ts::SectionDemux::Status status(demux);
+    TSUNIT_EQUAL(12, status.unchanged);
+    TSUNIT_ASSERT(!status.hasErrors());
+}
@@ -17,6 +17,7 @@
 #include "tsjsonObject.h"
 #include "tsjsonArray.h"
 #include "tsjsonRunningDocument.h"
+#include "tsjsonWriter.h"
 #include "tsFileUtils.h"
 #include "tsErrCodeReport.h"
 #include "tsIntegerUtils.h"
@@ -39,6 +40,7 @@ class JsonTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(RunningDocumentEmpty);
     TSUNIT_DECLARE_TEST(RunningDocument);
     TSUNIT_DECLARE_TEST(Issue1353);
+    TSUNIT_DECLARE_TEST(Writer);
 
 public:
     virtual void beforeTest() override;
@@ -886,3 +888,52 @@ TSUNIT_DEFINE_TEST(Issue1353)
                  "\"f5\": 1.2e-5, \"f6\": 1.2e-6, \"f7\": 1.2e-7, \"f8\": 1.2e-8, \"f9\": 1.2e-9 }",
                  root.oneLiner(CERR));
 }
+
+TSUNIT_DEFINE_TEST(Writer)
+{
+    // Reference JSON tree.
+    ts::json::Object root;
+    root.add(u"a", -12);
+    root.query(u"b", true, ts::json::Type::Array).set(1);
+    root.query(u"b", true, ts::json::Type::Array).set(u"x\u00E9\"y");
+    root.query(u"c", true);
+    root.query(u"d.e", true).add(u"f", ts::json::Bool(true));
+    root.query(u"d.e", true).add(u"g", 9'223'372'036'854'775'807);
+    root.query(u"h", true, ts::json::Type::Array);
+    root.add(u"i", ts::json::Bool(false));
+
+    // Same document, with optional empty containers which are omitted.
+    ts::json::Writer js;
+    for (int pass = 0; pass < 2; ++pass) {
+        const bool one_line = pass > 0;
+        js.reset(one_line);
+        js.beginObject();
+        js.addInteger(u"a", -12);
+        js.beginArray(u"b");
+        js.setInteger(1);
+        js.setString(u"x\u00E9\"y");
+        js.end();
+        js.beginObject(u"c");
+        js.end();
+        js.beginObject(u"d");
+        js.beginArray(u"d0", true);
+        js.end();
+        js.beginObject(u"e", true);
+        js.addBoolean(u"f", true);
+        js.addInteger(u"g", 9'223'372'036'854'775'807);
+        js.end();
+        js.end();
+        js.beginArray(u"h");
+        js.end();
+        js.beginObject(u"h0", true);
+        js.beginObject(u"h1", true);
+        js.end();
+        js.end();
+        js.addBoolean(u"i", false);
+        js.end();
+        TSUNIT_ASSERT(js.isComplete());
+        TSUNIT_EQUAL(one_line ? root.oneLiner(CERR) : root.printed(), ts::UString::FromUTF8(js.text()));
+    }
+    TSUNIT_EQUAL(u"{ \"a\": -12, \"b\": [ 1, \"x\\u00E9\\\"y\" ], \"c\": { }, \"d\": { \"e\": { \"f\": true, \"g\": 9223372036854775807 } }, \"h\": [ ], \"i\": false }",
+                 ts::UString::FromUTF8(js.text()));
+}
@@ -0,0 +1,132 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::LaunchTimeScheduler
+//
+//----------------------------------------------------------------------------
+
+#include "tsLaunchTimeScheduler.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class LaunchTimeSchedulerTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(BitRate);
+    TSUNIT_DECLARE_TEST(PCR);
+    TSUNIT_DECLARE_TEST(Late);
+};
+
+TSUNIT_REGISTER(LaunchTimeSchedulerTest);
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+namespace {
+    // With this bitrate, one packet lasts exactly one millisecond.
+    const ts::BitRate ONE_PACKET_PER_MS = ts::PKT_SIZE_BITS * 1000;
+
+    // Build a group of packets, with a PCR in the first one when pcr is valid.
+    ts::TSPacketVector Packets(size_t count, uint64_t pcr = ts::INVALID_PCR)
+    {
+        ts::TSPacketVector pkts(count);
+        for (auto& pkt : pkts) {
+            pkt.init(100);
+        }
+        if (pcr != ts::INVALID_PCR) {
+            pkts[0].setPCR(pcr, true);
+        }
+        return pkts;
+    }
+
+    // Distance in nanoseconds between two times.
+    cn::nanoseconds::rep Distance(ts::monotonic_time t0, ts::monotonic_time t1)
+    {
+        return cn::duration_cast<cn::nanoseconds>(t1 - t0).count();
+    }
+}
+
+TSUNIT_DEFINE_TEST(BitRate)
+{
+    const ts::monotonic_time t0 = ts::monotonic_time::clock::now();
+    const ts::TSPacketVector pkts(Packets(7));
+    ts::LaunchTimeScheduler sched;
+
+    // The packets are scheduled from the first call, whatever the current time.
+    TSUNIT_EQUAL(0, Distance(t0, sched.launchTime(pkts.data(), pkts.size(), ONE_PACKET_PER_MS, t0)));
+    TSUNIT_EQUAL(7'000'000, Distance(t0, sched.launchTime(pkts.data(), pkts.size(), ONE_PACKET_PER_MS, t0)));
+    TSUNIT_EQUAL(14'000'000, Distance(t0, sched.launchTime(pkts.data(), pkts.size(), ONE_PACKET_PER_MS, t0 + cn::milliseconds(10))));
+
+    // Twice the bitrate, half the interval, starting after the last group.
+    TSUNIT_EQUAL(21'000'000, Distance(t0, sched.launchTime(pkts.data(), pkts.size(), 2 * ONE_PACKET_PER_MS, t0)));
+    TSUNIT_EQUAL(24'500'000, Distance(t0, sched.launchTime(pkts.data(), pkts.size(), 2 * ONE_PACKET_PER_MS, t0)));
+    TSUNIT_ASSERT(sched.pcrBitRate() == 0);
+    TSUNIT_EQUAL(ts::PID_NULL, sched.getReferencePID());
+
+    // Restart the schedule.
+    sched.reset();
+    const ts::monotonic_time t1 = t0 + cn::seconds(1);
+    TSUNIT_EQUAL(0, Distance(t1, sched.launchTime(pkts.data(), pkts.size(), ONE_PACKET_PER_MS, t1)));
+}
+
+TSUNIT_DEFINE_TEST(PCR)
+{
+    const ts::monotonic_time t0 = ts::monotonic_time::clock::now();
+    ts::LaunchTimeScheduler sched;
+
+    // Without bitrate, the first group is sent immediately.
+    ts::TSPacketVector pkts(Packets(10, 1'000'000));
+    TSUNIT_EQUAL(0, Distance(t0, sched.launchTime(pkts.data(), pkts.size(), 0, t0)));
+    TSUNIT_EQUAL(100, sched.getReferencePID());
+    TSUNIT_ASSERT(sched.pcrBitRate() == 0);
+
+    // Next PCR, 10 ms later, 10 packets later.
+    pkts = Packets(10, 1'000'000 + 10 * ts::SYSTEM_CLOCK_FREQ / 1000);
+    TSUNIT_EQUAL(10'000'000, Distance(t0, sched.launchTime(pkts.data(), pkts.size(), 0, t0)));
+    TSUNIT_ASSERT(sched.pcrBitRate() == ONE_PACKET_PER_MS);
+
+    // No PCR, extrapolated from the PCR bitrate.
+    pkts = Packets(10);
+    TSUNIT_EQUAL(20'000'000, Distance(t0, sched.launchTime(pkts.data(), pkts.size(), 0, t0)));
+
+    // Next PCR, 25 ms after the previous one, 22 packets later: the PCR has precedence over the bitrate.
+    pkts = Packets(5);
+    pkts[2].setPCR(1'000'000 + 35 * ts::SYSTEM_CLOCK_FREQ / 1000, true);
+    TSUNIT_EQUAL(33'000'000, Distance(t0, sched.launchTime(pkts.data(), pkts.size(), ONE_PACKET_PER_MS, t0)));
+    pkts = Packets(3);
+    TSUNIT_EQUAL(38'000'000, Distance(t0, sched.launchTime(pkts.data(), pkts.size(), ONE_PACKET_PER_MS, t0)));
+
+    // PCR discontinuity, extrapolated from the bitrate.
+    pkts = Packets(4, 0);
+    TSUNIT_EQUAL(41'000'000, Distance(t0, sched.launchTime(pkts.data(), pkts.size(), ONE_PACKET_PER_MS, t0)));
+    pkts = Packets(4);
+    TSUNIT_EQUAL(45'000'000, Distance(t0, sched.launchTime(pkts.data(), pkts.size(), ONE_PACKET_PER_MS, t0)));
+}
+
+TSUNIT_DEFINE_TEST(Late)
+{
+    const ts::monotonic_time t0 = ts::monotonic_time::clock::now();
+    const ts::TSPacketVector pkts(Packets(7));
+    ts::LaunchTimeScheduler sched;
+    sched.setMaxLag(cn::milliseconds(50));
+
+    TSUNIT_EQUAL(0, Distance(t0, sched.launchTime(pkts.data(), pkts.size(), ONE_PACKET_PER_MS, t0)));
+
+    // Late by less than the maximum lag: keep the schedule.
+    TSUNIT_EQUAL(7'000'000, Distance(t0, sched.launchTime(pkts.data(), pkts.size(), ONE_PACKET_PER_MS, t0 + cn::milliseconds(40))));
+
+    // Late by more than the maximum lag: shift the schedule to now.
+    const ts::monotonic_time t1 = t0 + cn::seconds(1);
+    TSUNIT_EQUAL(0, Distance(t1, sched.launchTime(pkts.data(), pkts.size(), ONE_PACKET_PER_MS, t1)));
+    TSUNIT_EQUAL(7'000'000, Distance(t1, sched.launchTime(pkts.data(), pkts.size(), ONE_PACKET_PER_MS, t1)));
+}
@@ -11,6 +11,8 @@
 //----------------------------------------------------------------------------
 
 #include "tsMemory.h"
+#include "tsByteBlock.h"
+#include "utestTSUnitBenchmark.h"
 #include "tsunit.h"
 
 
@@ -72,6 +74,8 @@ class MemoryTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(PutIntVarLE);
     TSUNIT_DECLARE_TEST(LocatePattern);
     TSUNIT_DECLARE_TEST(LocateZeroZero);
+    TSUNIT_DECLARE_TEST(LocateZeroZeroBatch);
+    TSUNIT_DECLARE_TEST(LocateZeroZeroBenchmark);
     TSUNIT_DECLARE_TEST(Xor);
 };
 
@@ -472,6 +476,121 @@ TSUNIT_DEFINE_TEST(LocateZeroZero)
     TSUNIT_ASSERT(ts::LocateZeroZero(data2, sizeof(data2) - 1, 12) == nullptr);
 }
 
+namespace {
+    // Reference implementation of LocateZeroZeroBatch(), byte per byte.
+    std::vector<size_t> NaiveZeroZero(const uint8_t* area, size_t size, uint8_t max_third)
+    {
+        std::vector<size_t> result;
+        for (size_t i = 0; i + 3 <= size; ++i) {
+            if (area[i] == 0 && area[i + 1] == 0 && area[i + 2] <= max_third) {
+                result.push_back(i);
+            }
+        }
+        return result;
+    }
+
+    // Get all offsets with LocateZeroZeroBatch(), using batches of a given size.
+    std::vector<size_t> BatchZeroZero(const uint8_t* area, size_t size, uint8_t max_third, size_t batch_size)
+    {
+        std::vector<size_t> result;
+        std::vector<size_t> batch(batch_size);
+        size_t start = 0;
+        for (;;) {
+            const size_t count = ts::LocateZeroZeroBatch(area + start, size - start, max_third, batch.data(), batch.size());
+            for (size_t i = 0; i < count; ++i) {
+                result.push_back(start + batch[i]);
+            }
+            if (count < batch.size()) {
+                return result;
+            }
+            start = result.back() + 1;
+        }
+    }
+
+    // Build a H.264-like elementary stream: random NALunits with emulation prevention, separated by start codes.
+    ts::ByteBlock SyntheticES(size_t size)
+    {
+        // Deterministic pseudo-random generator, reproducible results.
+        uint32_t seed = 1234;
+        auto gen = [&seed]() { return seed = seed * 1664525 + 1013904223; };
+        ts::ByteBlock es;
+        es.reserve(size + 4);
+        while (es.size() < size) {
+            es.appendUInt32(0x00000001);
+            const size_t nal_size = 16 + (gen() >> 8) % 4000;
+            for (size_t i = 0; i < nal_size; ++i) {
+                // Increase the density of zeroes, as in real video payloads.
+                const uint8_t b = (gen() >> 16) % 4 == 0 ? 0x00 : uint8_t(gen() >> 24);
+                if (es.size() >= 2 && es[es.size() - 1] == 0 && es[es.size() - 2] == 0 && b <= 0x03) {
+                    es.push_back(0x03);
+                }
+                es.push_back(b);
+            }
+        }
+        return es;
+    }
+}
+
+TSUNIT_DEFINE_TEST(LocateZeroZeroBatch)
+{
+    // Overlapping sequences and sequences at the end of the area.
+    static const uint8_t data[] = {0x00, 0x00, 0x00, 0x01, 0x47, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00};
+    size_t offsets[8];
+    TSUNIT_EQUAL(3, ts::LocateZeroZeroBatch(data, sizeof(data), 0x01, offsets, 8));
+    TSUNIT_EQUAL(0, offsets[0]);
+    TSUNIT_EQUAL(1, offsets[1]);
+    TSUNIT_EQUAL(8, offsets[2]);
+    TSUNIT_EQUAL(4, ts::LocateZeroZeroBatch(data, sizeof(data), 0x02, offsets, 8));
+    TSUNIT_EQUAL(5, offsets[2]);
+    TSUNIT_EQUAL(2, ts::LocateZeroZeroBatch(data, sizeof(data), 0x02, offsets, 2));
+    TSUNIT_EQUAL(0, ts::LocateZeroZeroBatch(data, 2, 0x02, offsets, 8));
+    TSUNIT_EQUAL(0, ts::LocateZeroZeroBatch(data, sizeof(data), 0x02, offsets, 0));
+    TSUNIT_EQUAL(2, ts::LocateZeroZeroBatch(data2, sizeof(data2), 12, offsets, 8));
+    TSUNIT_EQUAL(0, offsets[0]);
+    TSUNIT_EQUAL(61, offsets[1]);
+
+    // Compare with the reference implementation, all area sizes around the vector sizes and all alignments.
+    const ts::ByteBlock es(SyntheticES(20'000));
+    for (size_t start = 0; start < 16; ++start) {
+        for (size_t size = 0; size < 70; ++size) {
+            for (size_t pos = 0; pos + start + size <= 300; pos += 37) {
+                const uint8_t* area = es.data() + pos + start;
+                TSUNIT_ASSERT(NaiveZeroZero(area, size, 0x01) == BatchZeroZero(area, size, 0x01, 4));
+            }
+        }
+    }
+    const auto ref(NaiveZeroZero(es.data(), es.size(), 0x01));
+    TSUNIT_ASSERT(ref.size() > 10);
+    TSUNIT_ASSERT(ref == BatchZeroZero(es.data(), es.size(), 0x01, 1));
+    TSUNIT_ASSERT(ref == BatchZeroZero(es.data(), es.size(), 0x01, 32));
+    TSUNIT_ASSERT(NaiveZeroZero(es.data(), es.size(), 0x03) == BatchZeroZero(es.data(), es.size(), 0x03, 32));
+}
+
+TSUNIT_DEFINE_TEST(LocateZeroZeroBenchmark)
+{
+    const ts::ByteBlock es(SyntheticES(1'000'000));
+    utest::TSUnitBenchmark naive_bench(u"TSUNIT_MEMORY_ITERATIONS");
+    utest::TSUnitBenchmark batch_bench(u"TSUNIT_MEMORY_ITERATIONS");
+    std::vector<size_t> naive;
+    std::vector<size_t> batch;
+
+    naive_bench.start();
+    for (size_t iter = 0; iter < naive_bench.iterations; ++iter) {
+        naive = NaiveZeroZero(es.data(), es.size(), 0x01);
+    }
+    naive_bench.stop();
+
+    batch_bench.start();
+    for (size_t iter = 0; iter < batch_bench.iterations; ++iter) {
+        batch = BatchZeroZero(es.data(), es.size(), 0x01, 32);
+    }
+    batch_bench.stop();
+
+    TSUNIT_ASSERT(naive == batch);
+    naive_bench.report(u"MemoryTest::LocateZeroZeroBenchmark (naive)");
+    batch_bench.report(u"MemoryTest::LocateZeroZeroBenchmark (batch)");
+}
+
 TSUNIT_DEFINE_TEST(Xor)
 {
     static const uint8_t src1[] = {
@@ -48,6 +48,7 @@ class NamesTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(DID);
     TSUNIT_DECLARE_TEST(XDID);
     TSUNIT_DECLARE_TEST(StreamType);
+    TSUNIT_DECLARE_TEST(SectionCache);
     TSUNIT_DECLARE_TEST(PDS);
     TSUNIT_DECLARE_TEST(REGID);
     TSUNIT_DECLARE_TEST(CASFamily);
@@ -322,6 +323,24 @@ TSUNIT_DEFINE_TEST(SharedTID)
     TSUNIT_EQUAL(u"TVCT (ATSC)", ts::TIDName(duck, ts::TID_TVCT));
 }
 
+TSUNIT_DEFINE_TEST(SectionCache)
+{
+    // Repeated lookups, possibly with different forms of section name, return the same section.
+    const ts::NamesPtr sec1(ts::Names::GetSection(u"dtv", u"StreamType", false));
+    const ts::NamesPtr sec2(ts::Names::GetSection(u"dtv", u"StreamType", false));
+    const ts::NamesPtr sec3(ts::Names::GetSection(u"dtv", u" streamtype ", false));
+    const ts::NamesPtr sec4(ts::Names::GetSection(u"", u"STREAMTYPE", false));
+    TSUNIT_ASSERT(sec1 != nullptr);
+    TSUNIT_ASSERT(sec1 == sec2);
+    TSUNIT_ASSERT(sec1 == sec3);
+    TSUNIT_ASSERT(sec1 == sec4);
+    TSUNIT_EQUAL(u"MPEG-4 Video", sec1->name(ts::ST_MPEG4_VIDEO));
+
+    // Unknown sections are not created when not requested.
+    TSUNIT_ASSERT(ts::Names::GetSection(u"dtv", u"NonExistentSection", false) == nullptr);
+    TSUNIT_ASSERT(ts::Names::GetSection(u"dtv", u"NonExistentSection", false) == nullptr);
+}
+
 TSUNIT_DEFINE_TEST(PDS)
 {
     const ts::UString tdfRef = ts::UString(u"T") + ts::LATIN_SMALL_LETTER_E_WITH_ACUTE + ts::UString(u"l") + ts::LATIN_SMALL_LETTER_E_WITH_ACUTE + ts::UString(u"diffusion de France (TDF)");
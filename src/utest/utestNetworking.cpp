@@ -46,6 +46,8 @@ class NetworkingTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(IPv6SocketAddress);
     TSUNIT_DECLARE_TEST(TCPSocket);
     TSUNIT_DECLARE_TEST(UDPSocket);
+    TSUNIT_DECLARE_TEST(UDPSegments);
+    TSUNIT_DECLARE_TEST(UDPTransmitTime);
     TSUNIT_DECLARE_TEST(IPHeader);
     TSUNIT_DECLARE_TEST(IPProtocol);
     TSUNIT_DECLARE_TEST(TCPPacket);
@@ -883,6 +885,105 @@ TSUNIT_DEFINE_TEST(UDPSocket)
     CERR.debug(u"UDPSocketTest: main thread: reply sent");
 }
 
+TSUNIT_DEFINE_TEST(UDPSegments)
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    const uint16_t portNumber = 12346;
+
+    // Receive messages by batches of 8 (when supported).
+    ts::UDPSocket server;
+    server.setReceiveBatch(8, 1024);
+    TSUNIT_ASSERT(server.open(ts::IP::v4, CERR));
+    TSUNIT_ASSERT(server.reusePort(true, CERR));
+    TSUNIT_ASSERT(server.bind(ts::IPSocketAddress(ts::IPAddress::LocalHost4, portNumber), CERR));
+
+    // Send 20 messages in one call, the last one is shorter.
+    uint8_t data[1950];
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = uint8_t(i / 100);
+    }
+    ts::UDPSocket client(true, ts::IP::v4);
+    TSUNIT_ASSERT(client.isOpen());
+    TSUNIT_ASSERT(client.setDefaultDestination(ts::IPSocketAddress(ts::IPAddress::LocalHost4, portNumber), CERR));
+    TSUNIT_ASSERT(client.sendSegments(data, sizeof(data), 100, CERR));
+
+    for (size_t i = 0; i < 20; ++i) {
+        ts::IPSocketAddress sender;
+        ts::IPSocketAddress destination;
+        uint8_t buffer[1024];
+        size_t size = 0;
+        TSUNIT_ASSERT(server.receive(buffer, sizeof(buffer), size, sender, destination, nullptr, CERR));
+        TSUNIT_EQUAL(i < 19 ? 100 : 50, size);
+        TSUNIT_EQUAL(i, buffer[0]);
+        TSUNIT_EQUAL(i, buffer[size - 1]);
+        TSUNIT_ASSERT(ts::IPAddress(sender) == ts::IPAddress::LocalHost4);
+    }
+}
+
+// Jitter measurement of datagrams which are paced by the kernel. This test only checks
+// the delivery of the datagrams: on the loopback interface, the launch times are ignored,
+// unless the fq queuing discipline is set (tc qdisc replace dev lo root fq).
+TSUNIT_DEFINE_TEST(UDPTransmitTime)
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    const uint16_t portNumber = 12347;
+    constexpr size_t count = 20;
+    constexpr cn::microseconds interval = cn::microseconds(2000);
+
+    ts::UDPSocket client(true, ts::IP::v4);
+    TSUNIT_ASSERT(client.isOpen());
+    if (!client.setTransmitTime(true, NULLREP)) {
+        debug() << "NetworkingTest::UDPTransmitTime: launch times not supported, skipped" << std::endl;
+        return;
+    }
+
+    ts::UDPSocket server;
+    TSUNIT_ASSERT(server.open(ts::IP::v4, CERR));
+    TSUNIT_ASSERT(server.reusePort(true, CERR));
+    TSUNIT_ASSERT(server.bind(ts::IPSocketAddress(ts::IPAddress::LocalHost4, portNumber), CERR));
+    TSUNIT_ASSERT(server.setReceiveTimestamps(true, CERR));
+    TSUNIT_ASSERT(client.setDefaultDestination(ts::IPSocketAddress(ts::IPAddress::LocalHost4, portNumber), CERR));
+
+    // Send all datagrams at once, half of them one by one, half of them in one call.
+    uint8_t data[count * 100];
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = uint8_t(i / 100);
+    }
+    std::vector<ts::monotonic_time> launch(count);
+    launch[0] = ts::monotonic_time::clock::now() + interval;
+    for (size_t i = 1; i < count; ++i) {
+        launch[i] = launch[i - 1] + interval;
+    }
+    for (size_t i = 0; i < count / 2; ++i) {
+        TSUNIT_ASSERT(client.sendAt(data + i * 100, 100, launch[i], CERR));
+    }
+    TSUNIT_ASSERT(client.sendSegmentsAt(data + count * 50, count * 50, 100, &launch[count / 2], CERR));
+
+    // Receive the datagrams and compute the jitter of their inter-arrival times.
+    cn::microseconds previous(-1);
+    cn::microseconds::rep max_jitter = 0;
+    for (size_t i = 0; i < count; ++i) {
+        ts::IPSocketAddress sender;
+        ts::IPSocketAddress destination;
+        uint8_t buffer[1024];
+        size_t size = 0;
+        cn::microseconds timestamp(-1);
+        TSUNIT_ASSERT(server.receive(buffer, sizeof(buffer), size, sender, destination, nullptr, CERR, &timestamp));
+        TSUNIT_EQUAL(100, size);
+        TSUNIT_EQUAL(i, buffer[0]);
+        if (timestamp < cn::microseconds::zero()) {
+            timestamp = cn::duration_cast<cn::microseconds>(ts::monotonic_time::clock::now().time_since_epoch());
+        }
+        if (previous >= cn::microseconds::zero()) {
+            max_jitter = std::max(max_jitter, std::abs((timestamp - previous - interval).count()));
+        }
+        previous = timestamp;
+    }
+    debug() << "NetworkingTest::UDPTransmitTime: interval: " << interval.count() << " us, max jitter: " << max_jitter << " us" << std::endl;
+}
+
 TSUNIT_DEFINE_TEST(IPHeader)
 {
     static const uint8_t reference_header[] = {
@@ -0,0 +1,130 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::PCRAnalyzer
+//
+//----------------------------------------------------------------------------
+
+#include "tsPCRAnalyzer.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class PCRAnalyzerTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(BitRate);
+    TSUNIT_DECLARE_TEST(Window);
+    TSUNIT_DECLARE_TEST(Jitter);
+};
+
+TSUNIT_REGISTER(PCRAnalyzerTest);
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Feed an analyzer with a constant bitrate stream, one PCR every 'pcr_distance' packets on PID 100.
+    // The other packets are in PID 200. An optional jitter is alternatively added and subtracted to PCR's.
+    void Feed(ts::PCRAnalyzer& zer, size_t packet_count, size_t pcr_distance, const ts::BitRate& bitrate, uint64_t jitter = 0)
+    {
+        uint8_t cc100 = 0;
+        uint8_t cc200 = 0;
+        size_t pcr_count = 0;
+        for (size_t i = 0; i < packet_count; ++i) {
+            ts::TSPacket pkt;
+            if (i % pcr_distance == 0) {
+                pkt.init(100, cc100++ & 0x0F);
+                uint64_t pcr = 1'000'000 + (ts::BitRate(i * ts::PKT_SIZE_BITS * ts::SYSTEM_CLOCK_FREQ) / bitrate).toInt();
+                pcr = pcr_count++ % 2 == 0 ? pcr + jitter : pcr - jitter;
+                pkt.setPCR(pcr, true);
+            }
+            else {
+                pkt.init(200, cc200++ & 0x0F);
+            }
+            zer.feedPacket(pkt);
+        }
+    }
+}
+
+TSUNIT_DEFINE_TEST(BitRate)
+{
+    // One packet per millisecond, one PCR every 10 ms.
+    const ts::BitRate bitrate = ts::PKT_SIZE_BITS * 1000;
+    ts::PCRAnalyzer zer(1, 16);
+    zer.setPIDStatistics(true);
+    Feed(zer, 3000, 10, bitrate);
+
+    TSUNIT_ASSERT(zer.bitrateIsValid());
+    TSUNIT_ASSERT(zer.bitrate188() == bitrate);
+    TSUNIT_ASSERT(zer.instantaneousBitrate188() == bitrate);
+
+    ts::PCRAnalyzer::Status status(zer);
+    TSUNIT_EQUAL(3000, status.packet_count);
+    TSUNIT_EQUAL(299, status.pcr_count);
+    TSUNIT_EQUAL(1, status.pcr_pids);
+
+    ts::PCRAnalyzer::PIDStatus pid_status;
+    TSUNIT_ASSERT(!zer.getPIDStatus(200, pid_status));
+    TSUNIT_EQUAL(2700, pid_status.packet_count);
+    TSUNIT_ASSERT(zer.getPIDStatus(100, pid_status));
+    TSUNIT_EQUAL(300, pid_status.packet_count);
+    TSUNIT_EQUAL(300, pid_status.pcr_count);
+    TSUNIT_EQUAL(299, pid_status.interval_count);
+    TSUNIT_ASSERT(pid_status.min_interval == cn::milliseconds(10));
+    TSUNIT_ASSERT(pid_status.max_interval == cn::milliseconds(10));
+    TSUNIT_ASSERT(pid_status.avg_interval == cn::milliseconds(10));
+    TSUNIT_ASSERT(pid_status.accuracy_count > 0);
+    TSUNIT_EQUAL(0, pid_status.max_jitter.count());
+    TSUNIT_EQUAL(0, pid_status.avg_jitter.count());
+    TSUNIT_ASSERT(std::abs(pid_status.drift_ppm) < 0.001);
+    debug() << "PCRAnalyzerTest::BitRate: " << pid_status << std::endl;
+}
+
+TSUNIT_DEFINE_TEST(Window)
+{
+    // One PCR per packet, ten packets per millisecond: more than the window size in the last second.
+    const ts::BitRate bitrate = ts::PKT_SIZE_BITS * 10'000;
+    ts::PCRAnalyzer zer(1, 16);
+    Feed(zer, 30'000, 1, bitrate);
+
+    TSUNIT_ASSERT(zer.bitrateIsValid());
+    TSUNIT_ASSERT(zer.bitrate188() == bitrate);
+    TSUNIT_ASSERT(zer.instantaneousBitrate188() == bitrate);
+
+    // Per-PID statistics are disabled by default.
+    ts::PCRAnalyzer::PIDStatus pid_status;
+    TSUNIT_ASSERT(zer.getPIDStatus(100, pid_status));
+    TSUNIT_EQUAL(30'000, pid_status.pcr_count);
+    TSUNIT_EQUAL(0, pid_status.interval_count);
+    TSUNIT_EQUAL(0, pid_status.accuracy_count);
+}
+
+TSUNIT_DEFINE_TEST(Jitter)
+{
+    // One packet per millisecond, one PCR every 10 ms, +/- 27 PCR units (1 microsecond).
+    const ts::BitRate bitrate = ts::PKT_SIZE_BITS * 1000;
+    ts::PCRAnalyzer zer(1, 16);
+    zer.setPIDStatistics(true);
+    Feed(zer, 3000, 10, bitrate, 27);
+
+    ts::PCRAnalyzer::PIDStatus pid_status;
+    TSUNIT_ASSERT(zer.getPIDStatus(100, pid_status));
+    TSUNIT_ASSERT(pid_status.min_interval == cn::milliseconds(10) - ts::PCR(54));
+    TSUNIT_ASSERT(pid_status.max_interval == cn::milliseconds(10) + ts::PCR(54));
+    TSUNIT_ASSERT(pid_status.accuracy_count > 0);
+    TSUNIT_ASSERT(pid_status.max_jitter >= ts::PCR(50));
+    TSUNIT_ASSERT(pid_status.max_jitter <= ts::PCR(60));
+    TSUNIT_ASSERT(pid_status.avg_jitter >= ts::PCR(50));
+    TSUNIT_ASSERT(std::abs(pid_status.drift_ppm) < 1.0);
+    debug() << "PCRAnalyzerTest::Jitter: " << pid_status << std::endl;
+}
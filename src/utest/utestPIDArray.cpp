@@ -0,0 +1,98 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::PIDArray
+//
+//----------------------------------------------------------------------------
+
+#include "tsPIDArray.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class PIDArrayTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Access);
+    TSUNIT_DECLARE_TEST(Iterate);
+};
+
+TSUNIT_REGISTER(PIDArrayTest);
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(Access)
+{
+    ts::PIDArray<ts::UString> arr;
+    TSUNIT_ASSERT(arr.empty());
+    TSUNIT_EQUAL(0, arr.size());
+    TSUNIT_ASSERT(!arr.contains(100));
+    TSUNIT_ASSERT(arr.begin() == arr.end());
+
+    arr[100] = u"foo";
+    arr[ts::PID_NULL] = u"null";
+    TSUNIT_EQUAL(2, arr.size());
+    TSUNIT_ASSERT(arr.contains(100));
+    TSUNIT_ASSERT(arr.contains(ts::PID_NULL));
+    TSUNIT_ASSERT(!arr.contains(101));
+    TSUNIT_ASSERT(!arr.contains(0xFFFF));
+    TSUNIT_EQUAL(u"foo", arr[100]);
+
+    // Contexts have stable addresses.
+    const ts::UString* addr = &arr[100];
+    arr[200] = u"bar";
+    TSUNIT_ASSERT(addr == &arr[100]);
+
+    // Erased contexts are recreated in their default state.
+    arr.erase(100);
+    arr.erase(101);
+    TSUNIT_EQUAL(2, arr.size());
+    TSUNIT_ASSERT(!arr.contains(100));
+    TSUNIT_ASSERT(arr[100].empty());
+    TSUNIT_EQUAL(3, arr.size());
+
+    arr.clear();
+    TSUNIT_ASSERT(arr.empty());
+    TSUNIT_ASSERT(!arr.contains(200));
+    TSUNIT_ASSERT(arr.begin() == arr.end());
+}
+
+TSUNIT_DEFINE_TEST(Iterate)
+{
+    ts::PIDArray<int> arr;
+    arr[300] = 3;
+    arr[0] = 1;
+    arr[8191] = 4;
+    arr[20] = 2;
+
+    std::vector<ts::PID> pids;
+    int sum = 0;
+    for (auto& it : arr) {
+        pids.push_back(it.first);
+        sum += it.second;
+        it.second *= 10;
+    }
+    TSUNIT_EQUAL(4, pids.size());
+    TSUNIT_EQUAL(0, pids[0]);
+    TSUNIT_EQUAL(20, pids[1]);
+    TSUNIT_EQUAL(300, pids[2]);
+    TSUNIT_EQUAL(8191, pids[3]);
+    TSUNIT_EQUAL(10, sum);
+
+    const ts::PIDArray<int>& carr(arr);
+    sum = 0;
+    for (const auto& it : carr) {
+        sum += it.second;
+    }
+    TSUNIT_EQUAL(100, sum);
+}
@@ -21,6 +21,7 @@
 class ResidentBufferTest: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(ResidentBuffer);
+    TSUNIT_DECLARE_TEST(HugePages);
 };
 
 TSUNIT_REGISTER(ResidentBufferTest);
@@ -54,3 +55,30 @@ TSUNIT_DEFINE_TEST(ResidentBuffer)
 
     TSUNIT_ASSERT(buf.count() >= buf_size);
 }
+
+TSUNIT_DEFINE_TEST(HugePages)
+{
+    const size_t buf_size = 3 * 1024 * 1024;
+
+    // Huge pages and NUMA binding are optional, the buffer must be usable in all cases.
+    ts::ResidentBuffer<uint32_t> buf(buf_size, true, 0);
+
+    debug() << "ResidentBufferTest: isHugePages() = " << buf.isHugePages() << ", isTransparentHugePages() = " << buf.isTransparentHugePages()
+            << ", numaNode() = " << buf.numaNode() << ", isLocked() = " << buf.isLocked() << ", count() = " << buf.count() << std::endl;
+
+    TSUNIT_ASSERT(buf.base() != nullptr);
+    TSUNIT_ASSERT(buf.count() >= buf_size);
+    TSUNIT_EQUAL(0, size_t(buf.base()) % ts::SysInfo::Instance().memoryPageSize());
+    TSUNIT_ASSERT(!buf.isHugePages() || !buf.isTransparentHugePages());
+    if (buf.isHugePages() || buf.isTransparentHugePages()) {
+        // Huge pages are always aligned on 2 MB.
+        TSUNIT_EQUAL(0, size_t(buf.base()) % (2 * 1024 * 1024));
+    }
+    TSUNIT_ASSERT(buf.numaNode() == -1 || buf.numaNode() == 0);
+
+    for (size_t i = 0; i < buf_size; ++i) {
+        buf.base()[i] = uint32_t(i);
+    }
+    TSUNIT_EQUAL(0, buf.base()[0]);
+    TSUNIT_EQUAL(buf_size - 1, buf.base()[buf_size - 1]);
+}
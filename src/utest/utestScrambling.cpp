@@ -11,8 +11,10 @@
 //----------------------------------------------------------------------------
 
 #include "tsDVBCSA2.h"
+#include "tsTSScrambling.h"
 #include "tsTSPacket.h"
 #include "tsNames.h"
+#include "tsNullReport.h"
 #include "tsunit.h"
 
 
@@ -23,6 +25,8 @@
 class ScramblingTest: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(Scrambling);
+    TSUNIT_DECLARE_TEST(ScramblingMany);
+    TSUNIT_DECLARE_TEST(TSScramblingMany);
 };
 
 TSUNIT_REGISTER(ScramblingTest);
@@ -166,3 +170,138 @@ TSUNIT_DEFINE_TEST(Scrambling)
         TSUNIT_EQUAL(0, ts::MemCompare(pkt.b + header_size, vec->cipher.b + header_size, payload_size));
     }
 }
+
+TSUNIT_DEFINE_TEST(ScramblingMany)
+{
+    // Use more packets than processed in parallel, with a partial last group.
+    constexpr size_t count = 2 * ts::DVBCSA2::PARALLEL_COUNT + 11;
+    ts::DVBCSA2 scrambler;
+
+    // Test vectors, all packets use the same key.
+    for (const auto& vec : scrambling_test_vectors) {
+        const size_t header_size = vec.plain.getHeaderSize();
+        const size_t payload_size = vec.plain.getPayloadSize();
+        const bool even = vec.cipher.getScrambling() == ts::SC_EVEN_KEY;
+        TSUNIT_ASSERT(scrambler.setKey(even ? vec.cw_even : vec.cw_odd, sizeof(vec.cw_even)));
+
+        std::vector<ts::TSPacket> packets(count, vec.cipher);
+        std::vector<uint8_t*> data(count);
+        std::vector<size_t> size(count, payload_size);
+        for (size_t i = 0; i < count; ++i) {
+            data[i] = packets[i].b + header_size;
+        }
+
+        TSUNIT_EQUAL(count, scrambler.decryptMany(data.data(), size.data(), count));
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_EQUAL(0, ts::MemCompare(packets[i].b + header_size, vec.plain.b + header_size, payload_size));
+        }
+
+        TSUNIT_EQUAL(count, scrambler.encryptMany(data.data(), size.data(), count));
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_EQUAL(0, ts::MemCompare(packets[i].b + header_size, vec.cipher.b + header_size, payload_size));
+        }
+    }
+
+    // Pseudo-random data of all sizes, including short data and residues, compared with one-by-one processing.
+    const uint8_t key[ts::DVBCSA2::KEY_SIZE] {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF};
+    TSUNIT_ASSERT(scrambler.setKey(key, sizeof(key)));
+
+    std::vector<ts::ByteBlock> plain(count);
+    std::vector<ts::ByteBlock> cipher(count);
+    std::vector<uint8_t*> data(count);
+    std::vector<size_t> size(count);
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0; i < count; ++i) {
+        plain[i].resize(1 + i % ts::DVBCSA2::MAX_DATA_SIZE);
+        for (auto& b : plain[i]) {
+            seed = seed * 1103515245 + 12345;
+            b = uint8_t(seed >> 16);
+        }
+        cipher[i] = plain[i];
+        TSUNIT_ASSERT(scrambler.encrypt(plain[i].data(), plain[i].size(), cipher[i].data(), cipher[i].size()));
+    }
+
+    std::vector<ts::ByteBlock> work(plain);
+    for (size_t i = 0; i < count; ++i) {
+        data[i] = work[i].data();
+        size[i] = work[i].size();
+    }
+    TSUNIT_EQUAL(count, scrambler.encryptMany(data.data(), size.data(), count));
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_ASSERT(work[i] == cipher[i]);
+    }
+    TSUNIT_EQUAL(count, scrambler.decryptMany(data.data(), size.data(), count));
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_ASSERT(work[i] == plain[i]);
+    }
+
+    // Invalid data size.
+    size[count - 5] = ts::DVBCSA2::MAX_DATA_SIZE + 1;
+    TSUNIT_EQUAL(count - 5, scrambler.decryptMany(data.data(), size.data(), count));
+}
+
+TSUNIT_DEFINE_TEST(TSScramblingMany)
+{
+    const ts::ByteBlock cw_even({0xC0, 0xB1, 0xF0, 0x61, 0xA6, 0xED, 0x71, 0x04});
+    const ts::ByteBlock cw_odd({0xB2, 0x92, 0xD3, 0x17, 0x7C, 0xCC, 0xCE, 0x16});
+
+    ts::TSScrambling single(NULLREP);
+    ts::TSScrambling many(NULLREP);
+    TSUNIT_ASSERT(single.setCW(cw_even, ts::SC_EVEN_KEY));
+    TSUNIT_ASSERT(single.setCW(cw_odd, ts::SC_ODD_KEY));
+    TSUNIT_ASSERT(many.setCW(cw_even, ts::SC_EVEN_KEY));
+    TSUNIT_ASSERT(many.setCW(cw_odd, ts::SC_ODD_KEY));
+
+    // Reference: scramble packets one by one, switching parity every 50 packets.
+    // Some packets have an adaptation field, some are not scrambled.
+    constexpr size_t count = 150;
+    std::vector<ts::TSPacket> plain(count);
+    std::vector<ts::TSPacket> cipher(count);
+    for (size_t i = 0; i < count; ++i) {
+        plain[i].init(ts::PID(100 + i % 3), uint8_t(i % 16));
+        for (size_t j = 4; j < ts::PKT_SIZE; ++j) {
+            plain[i].b[j] = uint8_t(i + j);
+        }
+        if (i % 7 == 0) {
+            plain[i].setPayloadSize(i % 150);
+        }
+        cipher[i] = plain[i];
+        if (i % 11 != 0) {
+            TSUNIT_ASSERT(single.setEncryptParity(int(i / 50)));
+            TSUNIT_ASSERT(single.encrypt(cipher[i]));
+        }
+    }
+
+    // Descramble all packets at once, with parity changes.
+    std::vector<ts::TSPacket> packets(cipher);
+    std::vector<ts::TSPacket*> ptr(count);
+    for (size_t i = 0; i < count; ++i) {
+        ptr[i] = &packets[i];
+    }
+    TSUNIT_ASSERT(many.decrypt(ptr.data(), count));
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_ASSERT(packets[i] == plain[i]);
+    }
+
+    // Scramble the packets of each crypto-period at once.
+    for (size_t i = 0; i < count; ++i) {
+        packets[i] = plain[i];
+    }
+    std::vector<ts::TSPacket*> cp;
+    for (size_t start = 0; start < count; start += 50) {
+        TSUNIT_ASSERT(many.setEncryptParity(int(start / 50)));
+        cp.clear();
+        for (size_t i = start; i < start + 50; ++i) {
+            if (i % 11 != 0) {
+                cp.push_back(&packets[i]);
+            }
+        }
+        TSUNIT_ASSERT(many.encrypt(cp.data(), cp.size()));
+    }
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_ASSERT(packets[i] == cipher[i]);
+    }
+
+    // Already scrambled packets cannot be scrambled again.
+    TSUNIT_ASSERT(!many.encrypt(cp.data(), cp.size()));
+}
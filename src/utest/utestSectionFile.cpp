@@ -727,6 +727,13 @@ TSUNIT_DEFINE_TEST(Memory)
     TSUNIT_EQUAL(87, sf1.saveBuffer(out2, sizeof(out2)));
     TSUNIT_EQUAL(0, ts::MemCompare(out2, psi_pat1_sections, sizeof(psi_pat1_sections)));
     TSUNIT_EQUAL(0, ts::MemCompare(out2 + 32, psi_pmt_scte35_sections, sizeof(psi_pmt_scte35_sections)));
+
+    // Corrupted CRC32 in the first section: only the second one is loaded.
+    input[5 + 10] ^= 0x01;
+    ts::SectionFile sf2(duck);
+    TSUNIT_ASSERT(!sf2.loadBuffer(input, 5, 87));
+    TSUNIT_EQUAL(1, sf2.sectionsCount());
+    TSUNIT_EQUAL(ts::TID_PMT, sf2.sections()[0]->tableId());
 }
 
 TSUNIT_DEFINE_TEST(Attribute)
@@ -0,0 +1,324 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::TSAnalyzer
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSAnalyzerReport.h"
+#include "tsCyclingPacketizer.h"
+#include "tsCADescriptor.h"
+#include "tsISO639LanguageDescriptor.h"
+#include "tsPAT.h"
+#include "tsPMT.h"
+#include "tsTDT.h"
+#include "tsTOT.h"
+#include "tsDuckContext.h"
+#include "tsReportBuffer.h"
+#include "tsArgs.h"
+#include "utestTSUnitBenchmark.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSAnalyzerTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Merge);
+    TSUNIT_DECLARE_TEST(JSONStream);
+    TSUNIT_DECLARE_TEST(JSONBenchmark);
+};
+
+TSUNIT_REGISTER(TSAnalyzerTest);
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Make analysis results public.
+    class Analyzer: public ts::TSAnalyzer
+    {
+    public:
+        Analyzer(ts::DuckContext& duck) : ts::TSAnalyzer(duck) {}
+        using ts::TSAnalyzer::recomputeStatistics;
+        using ts::TSAnalyzer::_ts_pkt_cnt;
+        using ts::TSAnalyzer::_ts_bitrate;
+        using ts::TSAnalyzer::_pcr_pid_cnt;
+        using ts::TSAnalyzer::_pids;
+        using ts::TSAnalyzer::_services;
+    };
+
+    // A stream of 10,000 packets, one packet per millisecond: service 1 with PMT PID 100 and video PID 200.
+    // A PAT and a PMT every 100 packets, a PCR in the video PID every 10 packets.
+    ts::TSPacketVector Stream(ts::DuckContext& duck)
+    {
+        ts::PAT pat(0, true, 10);
+        pat.pmts[1] = 100;
+        ts::PMT pmt(0, true, 1, 200);
+        pmt.streams[200].stream_type = ts::ST_MPEG2_VIDEO;
+
+        ts::CyclingPacketizer pat_pzer(duck, ts::PID_PAT);
+        ts::CyclingPacketizer pmt_pzer(duck, 100);
+        pat_pzer.addTable(duck, pat);
+        pmt_pzer.addTable(duck, pmt);
+
+        ts::TSPacketVector pkts(10'000);
+        uint8_t cc = 0;
+        for (size_t i = 0; i < pkts.size(); ++i) {
+            if (i % 100 == 0) {
+                pat_pzer.getNextPacket(pkts[i]);
+            }
+            else if (i % 100 == 1) {
+                pmt_pzer.getNextPacket(pkts[i]);
+            }
+            else {
+                pkts[i].init(200, cc++ & 0x0F);
+                if (i % 10 == 2) {
+                    pkts[i].setPCR(i * ts::SYSTEM_CLOCK_FREQ / 1000, true);
+                }
+            }
+        }
+        return pkts;
+    }
+
+    void Feed(ts::TSAnalyzer& zer, const ts::TSPacketVector& pkts, size_t start, size_t count)
+    {
+        const ts::TSPacketMetadata mdata;
+        for (size_t i = start; i < start + count; ++i) {
+            zer.feedPacket(pkts[i], mdata);
+        }
+    }
+
+    // Feed an analyzer with a stream using most reported features: 2,000 packets, one packet per millisecond,
+    // two versions of the PAT, scrambled service 1 with ECM, video and audio with languages, TDT and TOT,
+    // all packets in ISDB-T layers A and B.
+    void FeedAllFeatures(ts::TSAnalyzer& zer, ts::DuckContext& duck)
+    {
+        duck.addStandards(ts::Standards::ISDB);
+
+        ts::PAT pat(0, true, 10);
+        pat.pmts[1] = 100;
+        ts::PMT pmt(0, true, 1, 200);
+        pmt.descs.add(duck, ts::CADescriptor(0x0100, 300));
+        pmt.streams[200].stream_type = ts::ST_MPEG2_VIDEO;
+        pmt.streams[201].stream_type = ts::ST_MPEG1_AUDIO;
+        ts::ISO639LanguageDescriptor langs;
+        langs.entries.push_back(ts::ISO639LanguageDescriptor::Entry(u"eng", 0));
+        langs.entries.push_back(ts::ISO639LanguageDescriptor::Entry(u"fra", 0));
+        pmt.streams[201].descs.add(duck, langs);
+        ts::TDT tdt(ts::Time(2025, 6, 1, 12, 0, 0));
+        ts::TOT tot(ts::Time(2025, 6, 1, 12, 0, 1));
+        ts::TOT::Region region;
+        region.country = u"FRA";
+        region.time_offset = cn::minutes(120);
+        tot.regions.push_back(region);
+
+        ts::CyclingPacketizer pat_pzer(duck, ts::PID_PAT);
+        ts::CyclingPacketizer pmt_pzer(duck, 100);
+        ts::CyclingPacketizer tdt_pzer(duck, ts::PID_TDT);
+        pat_pzer.addTable(duck, pat);
+        pmt_pzer.addTable(duck, pmt);
+        tdt_pzer.addTable(duck, tdt);
+        tdt_pzer.addTable(duck, tot);
+
+        ts::TSPacket pkt;
+        ts::TSPacketMetadata mdata;
+        uint8_t cc[3] {0, 0, 0};
+        for (size_t i = 0; i < 2'000; ++i) {
+            if (i == 1'000) {
+                pat.version = 1;
+                pat_pzer.removeAll();
+                pat_pzer.addTable(duck, pat);
+            }
+            if (i % 100 == 0) {
+                pat_pzer.getNextPacket(pkt);
+            }
+            else if (i % 100 == 1) {
+                pmt_pzer.getNextPacket(pkt);
+            }
+            else if (i % 100 == 2 || i % 100 == 3) {
+                tdt_pzer.getNextPacket(pkt);
+            }
+            else if (i % 100 == 4) {
+                pkt.init(300, cc[0]++ & 0x0F);
+            }
+            else if (i % 10 == 5) {
+                pkt.init(201, cc[1]++ & 0x0F);
+                pkt.setScrambling(ts::SC_EVEN_KEY);
+            }
+            else {
+                pkt.init(200, cc[2]++ & 0x0F);
+                pkt.setScrambling(ts::SC_ODD_KEY);
+                if (i % 10 == 6) {
+                    pkt.setPCR(i * ts::SYSTEM_CLOCK_FREQ / 1000, true);
+                }
+            }
+            // ISDB-T information in the 16-byte trailer: alternate layers A and B.
+            const uint8_t isdbt[8] {0x00, uint8_t((1 + i % 2) << 4), 0x80, 0x00, 0xFF, 0xFF, 0xFF, 0xFF};
+            mdata.setAuxData(isdbt, sizeof(isdbt));
+            zer.feedPacket(pkt, mdata);
+        }
+    }
+
+    // Load analysis options from a command line.
+    void LoadOptions(ts::TSAnalyzerOptions& opt, ts::DuckContext& duck, const ts::UStringVector& options)
+    {
+        ts::Args args(u"test", u"", ts::Args::NO_EXIT_ON_ERROR);
+        opt.defineArgs(args);
+        TSUNIT_ASSERT(args.analyze(u"test", options));
+        TSUNIT_ASSERT(opt.loadArgs(duck, args));
+    }
+}
+
+TSUNIT_DEFINE_TEST(Merge)
+{
+    ts::DuckContext duck;
+    const ts::TSPacketVector pkts(Stream(duck));
+
+    // Reference sequential analysis.
+    Analyzer full(duck);
+    Feed(full, pkts, 0, pkts.size());
+    full.recomputeStatistics();
+
+    // Collect the PSI in the first segment.
+    Analyzer psi(duck);
+    psi.setPSICapture(true);
+    Feed(psi, pkts, 0, 1000);
+    ts::BinaryTablePtrVector tables;
+    psi.getPSI(tables);
+    TSUNIT_EQUAL(2, tables.size());
+    TSUNIT_EQUAL(ts::TID_PAT, tables[0]->tableId());
+    TSUNIT_EQUAL(ts::TID_PMT, tables[1]->tableId());
+
+    // Analyze two segments, the boundary is in the middle of two PCR's.
+    Analyzer seg0(duck);
+    Analyzer seg1(duck);
+    Feed(seg0, pkts, 0, 4995);
+    seg1.loadPSI(tables);
+    TSUNIT_ASSERT(seg1._pids.contains(200));
+    Feed(seg1, pkts, 4995, pkts.size() - 4995);
+
+    // Merge the two segments into an empty analyzer.
+    Analyzer merged(duck);
+    merged.merge(seg0);
+    merged.merge(seg1);
+    merged.recomputeStatistics();
+
+    TSUNIT_EQUAL(full._ts_pkt_cnt, merged._ts_pkt_cnt);
+    TSUNIT_ASSERT(full._ts_bitrate == merged._ts_bitrate);
+    TSUNIT_ASSERT(merged._ts_bitrate == ts::PKT_SIZE_BITS * 1000);
+    TSUNIT_EQUAL(1, merged._pcr_pid_cnt);
+    TSUNIT_EQUAL(1, merged._services.size());
+    TSUNIT_EQUAL(100, merged._services[1]->pmt_pid);
+    TSUNIT_EQUAL(200, merged._services[1]->pcr_pid);
+    TSUNIT_EQUAL(2, merged._services[1]->pid_cnt);
+
+    for (ts::PID pid : {ts::PID(ts::PID_PAT), ts::PID(100), ts::PID(200)}) {
+        const auto& ref(*full._pids[pid]);
+        const auto& pc(*merged._pids[pid]);
+        TSUNIT_EQUAL(ref.description, pc.description);
+        TSUNIT_EQUAL(ref.ts_pkt_cnt, pc.ts_pkt_cnt);
+        TSUNIT_EQUAL(ref.pmt_cnt, pc.pmt_cnt);
+        TSUNIT_EQUAL(ref.pcr_cnt, pc.pcr_cnt);
+        TSUNIT_EQUAL(ref.first_pcr, pc.first_pcr);
+        TSUNIT_EQUAL(ref.last_pcr, pc.last_pcr);
+        TSUNIT_EQUAL(0, pc.unexp_discont);
+        TSUNIT_EQUAL(ref.sections.size(), pc.sections.size());
+        for (const auto& it : ref.sections) {
+            const auto& xref(*it.second);
+            const auto& xc(*pc.sections.at(it.first));
+            TSUNIT_EQUAL(xref.table_count, xc.table_count);
+            TSUNIT_EQUAL(xref.section_count, xc.section_count);
+            TSUNIT_EQUAL(xref.repetition_ts, xc.repetition_ts);
+            TSUNIT_EQUAL(xref.min_repetition_ts, xc.min_repetition_ts);
+            TSUNIT_EQUAL(xref.max_repetition_ts, xc.max_repetition_ts);
+        }
+    }
+    TSUNIT_EQUAL(1, merged._pids[100]->pmt_cnt);
+    TSUNIT_EQUAL(100, merged._pids[ts::PID_PAT]->sections.begin()->second->repetition_ts);
+}
+
+TSUNIT_DEFINE_TEST(JSONStream)
+{
+    ts::DuckContext duck;
+    ts::TSAnalyzerReport zer(duck);
+    FeedAllFeatures(zer, duck);
+
+    // The title contains characters to escape.
+    ts::UStringVector options {u"--json", u"--json-line", u"--deterministic", u"--title", u"Test \"\u00E9t\u00E9\"\t"};
+    ts::TSAnalyzerOptions tree_opt;
+    LoadOptions(tree_opt, duck, options);
+    options.push_back(u"--json-stream");
+    ts::TSAnalyzerOptions stream_opt;
+    LoadOptions(stream_opt, duck, options);
+    TSUNIT_ASSERT(!tree_opt.json_stream);
+    TSUNIT_ASSERT(stream_opt.json_stream);
+
+    // Both methods must generate identical JSON files and lines.
+    ts::ReportBuffer<ts::ThreadSafety::None> tree_log;
+    ts::ReportBuffer<ts::ThreadSafety::None> stream_log;
+    const ts::UString tree(zer.reportToString(tree_opt, tree_log));
+    const ts::UString stream(zer.reportToString(stream_opt, stream_log));
+    debug() << "TSAnalyzerTest::JSONStream: " << stream << std::endl;
+
+    TSUNIT_ASSERT(tree.starts_with(u"{\n  \"pids\": ["));
+    TSUNIT_ASSERT(tree.contains(u"\"title\": \"Test \\\"\\u00E9t\\u00E9\\\"\\t\""));
+    TSUNIT_ASSERT(tree.contains(u"\"isdbt-layers\": [\n"));
+    TSUNIT_ASSERT(tree.contains(u"\"cas\": 256,"));
+    TSUNIT_ASSERT(tree.contains(u"\"language\": \"eng\","));
+    TSUNIT_ASSERT(tree.contains(u"\"languages\": [\n"));
+    TSUNIT_ASSERT(tree.contains(u"\"last-version\": 1,"));
+    TSUNIT_ASSERT(tree.contains(u"\"versions\": [\n"));
+    TSUNIT_ASSERT(tree.contains(u"\"tdt\": {\n"));
+    TSUNIT_ASSERT(tree.contains(u"\"tot\": {\n"));
+    TSUNIT_ASSERT(tree.contains(u"\"country\": \"FRA\","));
+    TSUNIT_EQUAL(tree, stream);
+    TSUNIT_ASSERT(tree_log.messages().starts_with(u"{ \"pids\": [ {"));
+    TSUNIT_EQUAL(tree_log.messages(), stream_log.messages());
+}
+
+TSUNIT_DEFINE_TEST(JSONBenchmark)
+{
+    ts::DuckContext duck;
+    const ts::TSPacketVector pkts(Stream(duck));
+    ts::TSAnalyzerReport zer(duck);
+    Feed(zer, pkts, 0, pkts.size());
+
+    ts::TSAnalyzerOptions tree_opt;
+    ts::TSAnalyzerOptions stream_opt;
+    LoadOptions(tree_opt, duck, {u"--json"});
+    LoadOptions(stream_opt, duck, {u"--json", u"--json-stream"});
+
+    // Compare the generation of a JSON report with and without JSON tree.
+    utest::TSUnitBenchmark tree_bench(u"TSUNIT_TSANALYZER_ITERATIONS");
+    utest::TSUnitBenchmark stream_bench(u"TSUNIT_TSANALYZER_ITERATIONS");
+    std::stringstream stm;
+
+    tree_bench.start();
+    for (size_t iter = 0; iter < tree_bench.iterations; ++iter) {
+        stm.str(std::string());
+        zer.reportJSON(tree_opt, stm);
+    }
+    tree_bench.stop();
+    const std::string tree(stm.str());
+
+    stream_bench.start();
+    for (size_t iter = 0; iter < stream_bench.iterations; ++iter) {
+        stm.str(std::string());
+        zer.reportJSON(stream_opt, stm);
+    }
+    stream_bench.stop();
+
+    TSUNIT_EQUAL(tree, stm.str());
+    tree_bench.report(u"TSAnalyzerTest::JSONBenchmark (tree)");
+    stream_bench.report(u"TSAnalyzerTest::JSONBenchmark (stream)");
+}
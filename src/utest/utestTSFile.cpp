@@ -14,6 +14,7 @@
 #include "tsTSPacket.h"
 #include "tsTSPacketMetadata.h"
 #include "tsCerrReport.h"
+#include "tsNullReport.h"
 #include "tsFileUtils.h"
 #include "tsErrCodeReport.h"
 #include "tsunit.h"
@@ -30,6 +31,10 @@ class TSFileTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(Duck);
     TSUNIT_DECLARE_TEST(StuffingRead);
     TSUNIT_DECLARE_TEST(StuffingWrite);
+    TSUNIT_DECLARE_TEST(MemoryMap);
+    TSUNIT_DECLARE_TEST(WriteQueue);
+    TSUNIT_DECLARE_TEST(WriteQueueSeek);
+    TSUNIT_DECLARE_TEST(WriteQueueAbort);
 
 public:
     virtual void beforeTest() override;
@@ -358,3 +363,129 @@ TSUNIT_DEFINE_TEST(StuffingWrite)
     TSUNIT_EQUAL(184, packets[5].getPayloadSize());
     TSUNIT_EQUAL(0xFF, packets[5].getPayload()[0]);
 }
+
+TSUNIT_DEFINE_TEST(MemoryMap)
+{
+    ts::TSFile file;
+    ts::TSPacketVector packets(50);
+
+    TSUNIT_ASSERT(!fs::exists(_tempFileName));
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR));
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i].init(ts::PID(100 + i));
+    }
+    TSUNIT_ASSERT(file.writePackets(packets.data(), nullptr, packets.size(), CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+    TSUNIT_ASSERT(!file.isMemoryMapped());
+
+    // Read the file twice with memory mapping, mixing direct access and copy.
+    file.setMemoryMapping(true);
+    TSUNIT_ASSERT(file.openRead(_tempFileName, 2, 0, CERR));
+#if defined(TS_WINDOWS)
+    TSUNIT_ASSERT(!file.isMemoryMapped());
+#else
+    TSUNIT_ASSERT(file.isMemoryMapped());
+    TSUNIT_EQUAL(ts::TSPacketFormat::TS, file.packetFormat());
+
+    const ts::TSPacket* pkt = nullptr;
+    TSUNIT_EQUAL(30, file.readMappedPackets(pkt, 30, CERR));
+    TSUNIT_ASSERT(pkt != nullptr);
+    TSUNIT_EQUAL(100, pkt[0].getPID());
+    TSUNIT_EQUAL(129, pkt[29].getPID());
+    TSUNIT_EQUAL(20, file.readMappedPackets(pkt, 30, CERR));
+    TSUNIT_EQUAL(130, pkt[0].getPID());
+    TSUNIT_EQUAL(149, pkt[19].getPID());
+#endif
+
+    ts::TSPacketVector inpackets(100);
+    const size_t expected = file.isMemoryMapped() ? 50 : 100;
+    TSUNIT_EQUAL(expected, file.readPackets(inpackets.data(), nullptr, inpackets.size(), CERR));
+    for (size_t i = 0; i < expected; ++i) {
+        TSUNIT_EQUAL(100 + i % 50, inpackets[i].getPID());
+    }
+    TSUNIT_EQUAL(0, file.readPackets(inpackets.data(), nullptr, inpackets.size(), CERR));
+    TSUNIT_EQUAL(100, file.readPacketsCount());
+    TSUNIT_ASSERT(file.close(CERR));
+    TSUNIT_ASSERT(!file.isMemoryMapped());
+}
+
+TSUNIT_DEFINE_TEST(WriteQueue)
+{
+    ts::TSFile file;
+    ts::TSPacketVector packets(1000);
+
+    // Use small buffers which are not a multiple of the packet size.
+    TSUNIT_ASSERT(!fs::exists(_tempFileName));
+    file.setWriteQueue(3, 10 * ts::PKT_SIZE + 7);
+    file.setStuffing(2, 3);
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR));
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i].init(ts::PID(i % ts::PID_NULL));
+    }
+    for (size_t i = 0; i < packets.size(); i += 100) {
+        TSUNIT_ASSERT(file.writePackets(&packets[i], nullptr, 100, CERR));
+    }
+    TSUNIT_ASSERT(file.close(CERR));
+    TSUNIT_EQUAL(1005, file.writePacketsCount());
+    TSUNIT_EQUAL(1005 * 188, fs::file_size(_tempFileName, &ts::ErrCodeReport(CERR)));
+
+    ts::TSFile file2;
+    ts::TSPacketVector inpackets(1010);
+    TSUNIT_ASSERT(file2.open(_tempFileName, ts::TSFile::READ, CERR));
+    TSUNIT_EQUAL(1005, file2.readPackets(inpackets.data(), nullptr, inpackets.size(), CERR));
+    TSUNIT_ASSERT(file2.close(CERR));
+    TSUNIT_EQUAL(ts::PID_NULL, inpackets[0].getPID());
+    TSUNIT_EQUAL(ts::PID_NULL, inpackets[1].getPID());
+    for (size_t i = 0; i < packets.size(); ++i) {
+        TSUNIT_ASSERT(inpackets[i + 2] == packets[i]);
+    }
+    TSUNIT_EQUAL(ts::PID_NULL, inpackets[1002].getPID());
+    TSUNIT_EQUAL(ts::PID_NULL, inpackets[1004].getPID());
+}
+
+TSUNIT_DEFINE_TEST(WriteQueueSeek)
+{
+    ts::TSFile file;
+    ts::TSPacketVector packets(100);
+
+    // Seeking must wait for all queued buffers to be written first.
+    TSUNIT_ASSERT(!fs::exists(_tempFileName));
+    file.setWriteQueue(4, 7 * ts::PKT_SIZE);
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR));
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i].init(ts::PID(100 + i));
+    }
+    TSUNIT_ASSERT(file.writePackets(packets.data(), nullptr, packets.size(), CERR));
+    TSUNIT_ASSERT(file.seek(10, CERR));
+    for (size_t i = 0; i < 5; ++i) {
+        packets[i].init(ts::PID(500 + i));
+    }
+    TSUNIT_ASSERT(file.writePackets(packets.data(), nullptr, 5, CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+    TSUNIT_EQUAL(100 * 188, fs::file_size(_tempFileName, &ts::ErrCodeReport(CERR)));
+
+    ts::TSPacketVector inpackets(110);
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::READ, CERR));
+    TSUNIT_EQUAL(100, file.readPackets(inpackets.data(), nullptr, inpackets.size(), CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+    for (size_t i = 0; i < 100; ++i) {
+        TSUNIT_EQUAL(i >= 10 && i < 15 ? 490 + i : 100 + i, inpackets[i].getPID());
+    }
+}
+
+TSUNIT_DEFINE_TEST(WriteQueueAbort)
+{
+    ts::TSFile file;
+    ts::TSPacketVector packets(100);
+
+    // After abort, pending buffers are dropped and the file can only be closed.
+    TSUNIT_ASSERT(!fs::exists(_tempFileName));
+    file.setWriteQueue(2, 10 * ts::PKT_SIZE);
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR));
+    TSUNIT_ASSERT(file.writePackets(packets.data(), nullptr, packets.size(), CERR));
+    file.abort();
+    TSUNIT_ASSERT(!file.writePackets(packets.data(), nullptr, packets.size(), NULLREP));
+    file.close(NULLREP);
+    TSUNIT_ASSERT(!file.isOpen());
+    TSUNIT_ASSERT(fs::file_size(_tempFileName, &ts::ErrCodeReport(CERR)) <= 100 * 188);
+}
@@ -0,0 +1,103 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::TSPacketHeaders
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSPacketHeaders.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSPacketHeadersTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Load);
+    TSUNIT_DECLARE_TEST(Select);
+};
+
+TSUNIT_REGISTER(TSPacketHeadersTest);
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(Load)
+{
+    debug() << "TSPacketHeadersTest::Load: accelerated: " << ts::UString::YesNo(ts::TSPacketHeaders::IsAccelerated()) << std::endl;
+
+    // Use a number of packets which is not a multiple of the vector size.
+    constexpr size_t count = 53;
+    ts::TSPacket packets[count];
+    for (size_t i = 0; i < count; ++i) {
+        packets[i].init(ts::PID((i * 0x0123) % ts::PID_MAX), uint8_t(i % 16));
+        packets[i].setPUSI(i % 3 == 0);
+        packets[i].setScrambling(uint8_t(i % 4));
+    }
+
+    ts::TSPacketHeaders headers;
+    TSUNIT_EQUAL(0, headers.size());
+
+    headers.load(packets, count);
+    TSUNIT_EQUAL(count, headers.size());
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_EQUAL(packets[i].getPID(), headers.pid(i));
+        TSUNIT_EQUAL(packets[i].getPID(), headers.pids()[i]);
+        TSUNIT_EQUAL(packets[i].getPUSI(), headers.pusi(i));
+        TSUNIT_EQUAL(packets[i].getScrambling(), headers.scrambling(i));
+        TSUNIT_EQUAL(packets[i].getCC(), headers.cc(i));
+    }
+
+    // Reload a smaller batch, starting in the middle.
+    headers.load(packets + 20, 17);
+    TSUNIT_EQUAL(17, headers.size());
+    for (size_t i = 0; i < 17; ++i) {
+        TSUNIT_EQUAL(packets[20 + i].getPID(), headers.pid(i));
+        TSUNIT_EQUAL(packets[20 + i].getCC(), headers.cc(i));
+    }
+
+    headers.clear();
+    TSUNIT_EQUAL(0, headers.size());
+}
+
+TSUNIT_DEFINE_TEST(Select)
+{
+    constexpr size_t count = 40;
+    ts::TSPacket packets[count];
+    for (size_t i = 0; i < count; ++i) {
+        packets[i].init(ts::PID(100 + i % 5));
+    }
+
+    ts::PIDSet filter;
+    filter.set(101);
+    filter.set(104);
+
+    ts::TSPacketHeaders headers;
+    headers.load(packets, count);
+    TSUNIT_EQUAL(16, headers.countPIDs(filter));
+
+    std::vector<size_t> indexes;
+    TSUNIT_EQUAL(16, headers.selectPIDs(indexes, filter));
+    TSUNIT_EQUAL(16, indexes.size());
+    TSUNIT_EQUAL(1, indexes[0]);
+    TSUNIT_EQUAL(4, indexes[1]);
+    TSUNIT_EQUAL(6, indexes[2]);
+    TSUNIT_EQUAL(39, indexes[15]);
+
+    TSUNIT_EQUAL(3, headers.selectPIDs(indexes, filter, 32));
+    TSUNIT_EQUAL(34, indexes[0]);
+    TSUNIT_EQUAL(36, indexes[1]);
+    TSUNIT_EQUAL(39, indexes[2]);
+
+    TSUNIT_EQUAL(0, headers.selectPIDs(indexes, ts::PIDSet()));
+    TSUNIT_ASSERT(indexes.empty());
+}
@@ -0,0 +1,273 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for classes ts::TSPacketRing and ts::TSPacketQueue
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSPacketRing.h"
+#include "tsTSPacketQueue.h"
+#include "tsunit.h"
+#include "utestTSUnitThread.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSPacketRingTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Ring);
+    TSUNIT_DECLARE_TEST(Drop);
+    TSUNIT_DECLARE_TEST(Threads);
+    TSUNIT_DECLARE_TEST(Queue);
+};
+
+TSUNIT_REGISTER(TSPacketRingTest);
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Number the packets in their payload.
+    void SetIndex(ts::TSPacket& pkt, uint32_t index)
+    {
+        pkt = ts::NullPacket;
+        ts::PutUInt32(pkt.b + 4, index);
+    }
+    uint32_t GetIndex(const ts::TSPacket& pkt)
+    {
+        return ts::GetUInt32(pkt.b + 4);
+    }
+}
+
+TSUNIT_DEFINE_TEST(Ring)
+{
+    ts::TSPacketRing ring(10);
+    TSUNIT_EQUAL(10, ring.bufferSize());
+    TSUNIT_EQUAL(0, ring.currentSize());
+    TSUNIT_ASSERT(!ring.eof());
+    TSUNIT_ASSERT(!ring.stopped());
+
+    ts::TSPacket* pkt = nullptr;
+    ts::TSPacketMetadata* mdata = nullptr;
+    size_t count = 0;
+
+    // Empty ring, non-blocking read.
+    TSUNIT_ASSERT(ring.lockRead(pkt, mdata, count, false));
+    TSUNIT_EQUAL(0, count);
+    ring.releaseRead(0);
+
+    // Write 7 packets in two batches, committed together.
+    TSUNIT_ASSERT(ring.lockWrite(pkt, mdata, count));
+    TSUNIT_EQUAL(10, count);
+    for (uint32_t i = 0; i < 7; ++i) {
+        SetIndex(pkt[i], i);
+        mdata[i].reset();
+        mdata[i].setLabel(i);
+    }
+    ring.commitWrite(7);
+    TSUNIT_EQUAL(7, ring.currentSize());
+
+    // Read 5 of them.
+    TSUNIT_ASSERT(ring.lockRead(pkt, mdata, count));
+    TSUNIT_EQUAL(7, count);
+    for (uint32_t i = 0; i < 5; ++i) {
+        TSUNIT_EQUAL(i, GetIndex(pkt[i]));
+        TSUNIT_ASSERT(mdata[i].hasLabel(i));
+    }
+    ring.releaseRead(5);
+    TSUNIT_EQUAL(2, ring.currentSize());
+
+    // The write window stops at the end of the ring.
+    TSUNIT_ASSERT(ring.lockWrite(pkt, mdata, count));
+    TSUNIT_EQUAL(3, count);
+    for (uint32_t i = 0; i < 3; ++i) {
+        SetIndex(pkt[i], 7 + i);
+    }
+    ring.commitWrite(3);
+
+    // Then wraps up.
+    TSUNIT_ASSERT(ring.lockWrite(pkt, mdata, count));
+    TSUNIT_EQUAL(5, count);
+    for (uint32_t i = 0; i < 4; ++i) {
+        SetIndex(pkt[i], 10 + i);
+    }
+    ring.commitWrite(4);
+    TSUNIT_EQUAL(9, ring.currentSize());
+
+    // Full copy-out of the packets, across the end of the ring.
+    ts::TSPacketVector out(20);
+    ts::TSPacketMetadataVector outmd(20);
+    TSUNIT_ASSERT(ring.read(out.data(), outmd.data(), out.size(), count));
+    TSUNIT_EQUAL(9, count);
+    for (uint32_t i = 0; i < 9; ++i) {
+        TSUNIT_EQUAL(5 + i, GetIndex(out[i]));
+    }
+    TSUNIT_EQUAL(0, ring.currentSize());
+
+    // End of file: remaining packets first.
+    TSUNIT_ASSERT(ring.write(out.data(), nullptr, 2));
+    ring.setEOF();
+    TSUNIT_ASSERT(!ring.eof());
+    TSUNIT_ASSERT(ring.read(out.data(), outmd.data(), out.size(), count));
+    TSUNIT_EQUAL(2, count);
+    TSUNIT_ASSERT(ring.eof());
+    TSUNIT_ASSERT(!ring.read(out.data(), outmd.data(), out.size(), count));
+    TSUNIT_EQUAL(0, count);
+
+    // Stop condition: no longer possible to write.
+    ring.reset(4);
+    TSUNIT_EQUAL(4, ring.bufferSize());
+    TSUNIT_ASSERT(!ring.eof());
+    ring.stop();
+    TSUNIT_ASSERT(ring.stopped());
+    TSUNIT_ASSERT(!ring.lockWrite(pkt, mdata, count));
+    TSUNIT_EQUAL(0, count);
+    TSUNIT_ASSERT(!ring.waitEmpty());
+    TSUNIT_ASSERT(!ring.lockRead(pkt, mdata, count));
+}
+
+TSUNIT_DEFINE_TEST(Drop)
+{
+    ts::TSPacketRing ring(8);
+    ts::TSPacketVector in(8);
+    for (uint32_t i = 0; i < in.size(); ++i) {
+        SetIndex(in[i], i);
+    }
+    TSUNIT_ASSERT(ring.write(in.data(), nullptr, in.size()));
+    TSUNIT_EQUAL(8, ring.currentSize());
+
+    // Cannot drop while the consumer holds a read window.
+    ts::TSPacket* pkt = nullptr;
+    ts::TSPacketMetadata* mdata = nullptr;
+    size_t count = 0;
+    TSUNIT_ASSERT(ring.lockRead(pkt, mdata, count));
+    TSUNIT_EQUAL(8, count);
+    TSUNIT_EQUAL(0, ring.dropOldest(3));
+    ring.releaseRead(1);
+
+    TSUNIT_EQUAL(3, ring.dropOldest(3));
+    TSUNIT_EQUAL(4, ring.currentSize());
+    TSUNIT_ASSERT(ring.lockRead(pkt, mdata, count));
+    TSUNIT_EQUAL(4, count);
+    TSUNIT_EQUAL(4, GetIndex(pkt[0]));
+    ring.releaseRead(0);
+
+    TSUNIT_EQUAL(4, ring.dropOldest(100));
+    TSUNIT_EQUAL(0, ring.currentSize());
+    TSUNIT_ASSERT(ring.waitEmpty());
+}
+
+namespace {
+    constexpr uint32_t THREAD_PACKETS = 100000;
+
+    // Producer thread, writing numbered packets in batches of variable sizes.
+    class RingProducer: public utest::TSUnitThread
+    {
+        TS_NOBUILD_NOCOPY(RingProducer);
+    private:
+        ts::TSPacketRing& _ring;
+    public:
+        explicit RingProducer(ts::TSPacketRing& ring) : _ring(ring) {}
+        virtual ~RingProducer() override { waitForTermination(); }
+        virtual void test() override
+        {
+            uint32_t index = 0;
+            while (index < THREAD_PACKETS) {
+                ts::TSPacket* pkt = nullptr;
+                ts::TSPacketMetadata* mdata = nullptr;
+                size_t count = 0;
+                TSUNIT_ASSERT(_ring.lockWrite(pkt, mdata, count, 1 + index % 7));
+                count = std::min<size_t>({count, 1 + index % 13, THREAD_PACKETS - index});
+                for (size_t i = 0; i < count; ++i) {
+                    SetIndex(pkt[i], index++);
+                }
+                _ring.commitWrite(count);
+            }
+            _ring.setEOF();
+        }
+    };
+}
+
+TSUNIT_DEFINE_TEST(Threads)
+{
+    ts::TSPacketRing ring(64);
+    RingProducer producer(ring);
+    TSUNIT_ASSERT(producer.start());
+
+    uint32_t expected = 0;
+    ts::TSPacket* pkt = nullptr;
+    ts::TSPacketMetadata* mdata = nullptr;
+    size_t count = 0;
+    while (ring.lockRead(pkt, mdata, count)) {
+        TSUNIT_ASSERT(count > 0);
+        // Free part of the window only.
+        count = std::min<size_t>(count, 1 + expected % 11);
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_EQUAL(expected, GetIndex(pkt[i]));
+            expected++;
+        }
+        ring.releaseRead(count);
+    }
+    TSUNIT_EQUAL(THREAD_PACKETS, expected);
+    TSUNIT_ASSERT(ring.eof());
+}
+
+namespace {
+    // Producer thread for TSPacketQueue.
+    class QueueProducer: public utest::TSUnitThread
+    {
+        TS_NOBUILD_NOCOPY(QueueProducer);
+    private:
+        ts::TSPacketQueue& _queue;
+    public:
+        explicit QueueProducer(ts::TSPacketQueue& queue) : _queue(queue) {}
+        virtual ~QueueProducer() override { waitForTermination(); }
+        virtual void test() override
+        {
+            _queue.setBitrate(1000000);
+            uint32_t index = 0;
+            while (index < THREAD_PACKETS) {
+                ts::TSPacket* pkt = nullptr;
+                ts::TSPacketMetadata* mdata = nullptr;
+                size_t count = 0;
+                TSUNIT_ASSERT(_queue.lockWriteBuffer(pkt, mdata, count));
+                count = std::min<size_t>(count, THREAD_PACKETS - index);
+                for (size_t i = 0; i < count; ++i) {
+                    SetIndex(pkt[i], index++);
+                }
+                _queue.releaseWriteBuffer(count);
+            }
+            _queue.setEOF();
+        }
+    };
+}
+
+TSUNIT_DEFINE_TEST(Queue)
+{
+    ts::TSPacketQueue queue(100);
+    QueueProducer producer(queue);
+    TSUNIT_ASSERT(producer.start());
+
+    uint32_t expected = 0;
+    ts::TSPacketVector buffer(37);
+    size_t count = 0;
+    ts::BitRate bitrate;
+    while (queue.waitPackets(buffer.data(), nullptr, buffer.size(), count, bitrate)) {
+        TSUNIT_ASSERT(bitrate == 1000000);
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_EQUAL(expected, GetIndex(buffer[i]));
+            expected++;
+        }
+    }
+    TSUNIT_EQUAL(THREAD_PACKETS, expected);
+    TSUNIT_ASSERT(queue.eof());
+}
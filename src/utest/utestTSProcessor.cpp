@@ -11,8 +11,15 @@
 //----------------------------------------------------------------------------
 
 #include "tsTSProcessor.h"
+#include "tsTSProcessorPipe.h"
 #include "tsPluginRepository.h"
 #include "tsCerrReport.h"
+#include "tsNullReport.h"
+#include "tsErrCodeReport.h"
+#include "tsFileUtils.h"
+#include "tsReportBuffer.h"
+#include "tsTSFile.h"
+#include "utestTSUnitBenchmark.h"
 #include "tsunit.h"
 
 
@@ -23,6 +30,14 @@
 class TSProcessorTest: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(Processing);
+    TSUNIT_DECLARE_TEST(LockFree);
+    TSUNIT_DECLARE_TEST(PacketBatch);
+    TSUNIT_DECLARE_TEST(InProcessPipe);
+    TSUNIT_DECLARE_TEST(FilterPIDOnly);
+    TSUNIT_DECLARE_TEST(RemapNoPSI);
+    TSUNIT_DECLARE_TEST(Metrics);
+    TSUNIT_DECLARE_TEST(AdaptiveBatch);
+    TSUNIT_DECLARE_TEST(LowLatencyBenchmark);
 };
 
 TSUNIT_REGISTER(TSProcessorTest);
@@ -127,6 +142,120 @@ TestPlugin::Status TestPlugin::processPacket(ts::TSPacket& pkt, ts::TSPacketMeta
 }
 
 
+//----------------------------------------------------------------------------
+// Internal packet processing plugin class using packet batches.
+// Drop one packet out of two, based on the packet index.
+//----------------------------------------------------------------------------
+
+namespace {
+    class TestBatchPlugin : ts::ProcessorPlugin
+    {
+    public:
+        TestBatchPlugin(ts::TSP* t) : ts::ProcessorPlugin(t, u"Test batch plugin", u"[options]") {}
+        virtual size_t processPackets(ts::TSPacket*, ts::TSPacketMetadata*, Status*, size_t) override;
+        static ts::ProcessorPlugin* CreateInstance(ts::TSP* t) { return new TestBatchPlugin(t); }
+    };
+}
+
+size_t TestBatchPlugin::processPackets(ts::TSPacket* pkt, ts::TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        status[i] = (tsp->pluginPackets() + i) % 2 == 0 ? TSP_OK : TSP_DROP;
+    }
+    return count;
+}
+
+
+//----------------------------------------------------------------------------
+// Internal packet processing plugin class which slows down the stream.
+// Sleep one millisecond every 20 packets, at most 20,000 packets per second.
+//----------------------------------------------------------------------------
+
+namespace {
+    class TestPacePlugin : ts::ProcessorPlugin
+    {
+    public:
+        TestPacePlugin(ts::TSP* t) : ts::ProcessorPlugin(t, u"Test pace plugin", u"[options]") {}
+        virtual Status processPacket(ts::TSPacket&, ts::TSPacketMetadata&) override;
+        static ts::ProcessorPlugin* CreateInstance(ts::TSP* t) { return new TestPacePlugin(t); }
+    };
+}
+
+TestPacePlugin::Status TestPacePlugin::processPacket(ts::TSPacket& pkt, ts::TSPacketMetadata& metadata)
+{
+    if (tsp->pluginPackets() % 20 == 0) {
+        std::this_thread::sleep_for(cn::milliseconds(1));
+    }
+    return TSP_OK;
+}
+
+
+//----------------------------------------------------------------------------
+// Internal input and output plugins to measure the latency through tsp.
+// The input plugin produces 7 null packets every 100 microseconds, with the
+// monotonic clock as input time stamp. The output plugin computes the delay
+// between the input time stamp and send().
+//----------------------------------------------------------------------------
+
+namespace {
+    class LatencyStats
+    {
+    public:
+        size_t          count = 0;
+        cn::nanoseconds total {};
+        cn::nanoseconds max {};
+    };
+
+    LatencyStats latency_stats;
+
+    class TestLatencyInput : ts::InputPlugin
+    {
+    public:
+        static constexpr size_t PACKETS = 2100;
+        TestLatencyInput(ts::TSP* t) : ts::InputPlugin(t, u"Test latency input plugin", u"[options]") {}
+        virtual size_t receive(ts::TSPacket*, ts::TSPacketMetadata*, size_t) override;
+        static ts::InputPlugin* CreateInstance(ts::TSP* t) { return new TestLatencyInput(t); }
+    private:
+        size_t _sent = 0;
+    };
+
+    class TestLatencyOutput : ts::OutputPlugin
+    {
+    public:
+        TestLatencyOutput(ts::TSP* t) : ts::OutputPlugin(t, u"Test latency output plugin", u"[options]") {}
+        virtual bool send(const ts::TSPacket*, const ts::TSPacketMetadata*, size_t) override;
+        static ts::OutputPlugin* CreateInstance(ts::TSP* t) { return new TestLatencyOutput(t); }
+    };
+}
+
+size_t TestLatencyInput::receive(ts::TSPacket* buffer, ts::TSPacketMetadata* pkt_data, size_t max_packets)
+{
+    const size_t count = std::min({max_packets, PACKETS - _sent, size_t(7)});
+    if (count > 0) {
+        std::this_thread::sleep_for(cn::microseconds(100));
+        const auto now = ts::monotonic_time::clock::now().time_since_epoch();
+        for (size_t i = 0; i < count; ++i) {
+            buffer[i] = ts::NullPacket;
+            pkt_data[i].setInputTimeStamp(now, ts::TimeSource::TSP);
+        }
+        _sent += count;
+    }
+    return count;
+}
+
+bool TestLatencyOutput::send(const ts::TSPacket* buffer, const ts::TSPacketMetadata* pkt_data, size_t packet_count)
+{
+    const cn::nanoseconds now = ts::monotonic_time::clock::now().time_since_epoch();
+    for (size_t i = 0; i < packet_count; ++i) {
+        const cn::nanoseconds delay = now - cn::duration_cast<cn::nanoseconds>(pkt_data[i].getInputTimeStamp());
+        latency_stats.count++;
+        latency_stats.total += delay;
+        latency_stats.max = std::max(latency_stats.max, delay);
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // A test plugin event handler.
 // We don't do the TSUNIT assertions in the event handler (called in plugin
@@ -274,3 +403,301 @@ TSUNIT_DEFINE_TEST(Processing)
     TSUNIT_EQUAL(3,          handler2.logs[0].count);
     TSUNIT_EQUAL(26,         handler2.logs[0].packets);
 }
+
+TSUNIT_DEFINE_TEST(LockFree)
+{
+    ts::PluginRepository::Instance().registerProcessor(u"test1", TestPlugin::CreateInstance);
+
+    // Chain of plugins with a small buffer to force many wrap-ups and waits.
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"TSProcessorTest::testLockFree";
+    opt.lock_free = true;
+    opt.ts_buffer_size = ts::TSProcessorArgs::MIN_BUFFER_SIZE;
+    opt.max_flush_pkt = 7;
+    opt.input = {u"null", {u"20000"}};
+    opt.plugins = {
+        {u"test1", {u"--count", u"1000"}},
+        {u"test1", {u"--count", u"1000"}},
+        {u"test1", {u"--count", u"1000"}},
+        {u"test1", {u"--count", u"1000"}},
+    };
+    opt.output = {u"drop"};
+
+    ts::TSProcessor tsproc(CERR);
+    TestEventHandler handler;
+    ts::TSProcessor::Criteria crit;
+    crit.event_code = TestPlugin::EVENT_STOP;
+    tsproc.registerEventHandler(&handler, crit);
+
+    TSUNIT_ASSERT(tsproc.start(opt));
+    tsproc.waitForTermination();
+
+    // All plugins have seen all packets.
+    TSUNIT_EQUAL(4, handler.logs.size());
+    for (const auto& log : handler.logs) {
+        TSUNIT_EQUAL(0xBEEF0002, log.code);
+        TSUNIT_EQUAL(6, log.count);
+        TSUNIT_EQUAL(20000, log.packets);
+    }
+}
+
+TSUNIT_DEFINE_TEST(PacketBatch)
+{
+    ts::PluginRepository::Instance().registerProcessor(u"test1", TestPlugin::CreateInstance);
+    ts::PluginRepository::Instance().registerProcessor(u"testbatch", TestBatchPlugin::CreateInstance);
+
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"TSProcessorTest::testPacketBatch";
+    opt.max_flush_pkt = 100;
+    opt.input = {u"null", {u"10001"}};
+    opt.plugins = {
+        {u"testbatch", {}},
+        {u"test1", {u"--count", u"1000"}},
+    };
+    opt.output = {u"drop"};
+
+    ts::TSProcessor tsproc(CERR);
+    TestEventHandler handler;
+    ts::TSProcessor::Criteria crit;
+    crit.event_code = TestPlugin::EVENT_STOP;
+    tsproc.registerEventHandler(&handler, crit);
+
+    TSUNIT_ASSERT(tsproc.start(opt));
+    tsproc.waitForTermination();
+
+    // The second plugin has seen half of the packets, plus the first one.
+    TSUNIT_EQUAL(1, handler.logs.size());
+    TSUNIT_EQUAL(0xBEEF0002, handler.logs[0].code);
+    TSUNIT_EQUAL(2, handler.logs[0].index);
+    TSUNIT_EQUAL(5001, handler.logs[0].packets);
+}
+
+TSUNIT_DEFINE_TEST(InProcessPipe)
+{
+    // Read the output of a pipeline.
+    ts::TSProcessorPipe in;
+    TSUNIT_ASSERT(in.open(u"tsp -I null 1000", ts::TSProcessorPipe::READ_OUTPUT, 100, CERR));
+    TSUNIT_ASSERT(in.isOpen());
+
+    ts::TSPacketVector packets(64);
+    size_t total = 0;
+    size_t nulls = 0;
+    for (size_t count = 0; (count = in.readPackets(packets.data(), nullptr, packets.size(), CERR)) > 0; total += count) {
+        for (size_t i = 0; i < count; ++i) {
+            nulls += packets[i].getPID() == ts::PID_NULL;
+        }
+    }
+    TSUNIT_EQUAL(1000, total);
+    TSUNIT_EQUAL(1000, nulls);
+    TSUNIT_ASSERT(in.close(CERR));
+    TSUNIT_ASSERT(!in.isOpen());
+
+    // Write the input of a pipeline. An output plugin is not allowed when reading.
+    ts::TSProcessorPipe out;
+    TSUNIT_ASSERT(!out.open(u"-I null -O drop", ts::TSProcessorPipe::READ_OUTPUT, 100, NULLREP));
+    TSUNIT_ASSERT(out.open(u"-O drop", ts::TSProcessorPipe::WRITE_INPUT, 100, CERR));
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i] = ts::NullPacket;
+    }
+    for (size_t i = 0; i < 20; ++i) {
+        TSUNIT_ASSERT(out.writePackets(packets.data(), nullptr, packets.size(), CERR));
+    }
+    TSUNIT_ASSERT(out.close(CERR));
+}
+
+//----------------------------------------------------------------------------
+// Test the batch fast paths of the filter and remap plugins.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Create a TS file with packets on PID's 100 to 109, in sequence.
+    void WriteSequenceFile(const fs::path& file, size_t count)
+    {
+        ts::TSPacketVector packets(count);
+        for (size_t i = 0; i < count; ++i) {
+            packets[i] = ts::NullPacket;
+            packets[i].setPID(ts::PID(100 + i % 10));
+            packets[i].setCC(uint8_t((i / 10) & ts::CC_MASK));
+        }
+        ts::TSFile out;
+        TSUNIT_ASSERT(out.open(file, ts::TSFile::WRITE, CERR));
+        TSUNIT_ASSERT(out.writePackets(packets.data(), nullptr, packets.size(), CERR));
+        TSUNIT_ASSERT(out.close(CERR));
+    }
+
+    // Read all output packets of a tsp command.
+    void ReadPipeline(const ts::UString& command, ts::TSPacketVector& packets)
+    {
+        ts::TSProcessorPipe in;
+        TSUNIT_ASSERT(in.open(command, ts::TSProcessorPipe::READ_OUTPUT, 100, CERR));
+        ts::TSPacketVector buffer(64);
+        packets.clear();
+        for (size_t count = 0; (count = in.readPackets(buffer.data(), nullptr, buffer.size(), CERR)) > 0; ) {
+            packets.insert(packets.end(), buffer.begin(), buffer.begin() + count);
+        }
+        TSUNIT_ASSERT(in.close(CERR));
+    }
+}
+
+TSUNIT_DEFINE_TEST(FilterPIDOnly)
+{
+    const fs::path file(ts::TempFile(u".ts"));
+    WriteSequenceFile(file, 1000);
+
+    // Explicit PID's only: the filter plugin uses its PID-only path.
+    ts::TSPacketVector packets;
+    ReadPipeline(ts::UString::Format(u"tsp -I file %s -P filter --pid 101 --pid 105", file), packets);
+    TSUNIT_EQUAL(200, packets.size());
+    for (size_t i = 0; i < packets.size(); ++i) {
+        TSUNIT_EQUAL(i % 2 == 0 ? 101 : 105, packets[i].getPID());
+        TSUNIT_EQUAL((i / 2) & ts::CC_MASK, packets[i].getCC());
+    }
+
+    // Same with --negate, the other PID's are passed.
+    ReadPipeline(ts::UString::Format(u"tsp -I file %s -P filter --negate --pid 100-107", file), packets);
+    TSUNIT_EQUAL(200, packets.size());
+    for (size_t i = 0; i < packets.size(); ++i) {
+        TSUNIT_EQUAL(i % 2 == 0 ? 108 : 109, packets[i].getPID());
+    }
+
+    fs::remove(file, &ts::ErrCodeReport());
+}
+
+TSUNIT_DEFINE_TEST(RemapNoPSI)
+{
+    const fs::path file(ts::TempFile(u".ts"));
+    WriteSequenceFile(file, 1000);
+
+    // Without PSI update, the remap plugin only rewrites the PID's of a packet batch.
+    ts::TSPacketVector packets;
+    ReadPipeline(ts::UString::Format(u"tsp -I file %s -P remap --no-psi 101=201 105=300", file), packets);
+    TSUNIT_EQUAL(1000, packets.size());
+    for (size_t i = 0; i < packets.size(); ++i) {
+        const ts::PID pid = ts::PID(100 + i % 10);
+        TSUNIT_EQUAL(pid == 101 ? 201 : (pid == 105 ? 300 : pid), packets[i].getPID());
+        TSUNIT_EQUAL((i / 10) & ts::CC_MASK, packets[i].getCC());
+    }
+
+    fs::remove(file, &ts::ErrCodeReport());
+}
+
+TSUNIT_DEFINE_TEST(Metrics)
+{
+    ts::PluginRepository::Instance().registerProcessor(u"test1", TestPlugin::CreateInstance);
+    ts::PluginRepository::Instance().registerProcessor(u"testbatch", TestBatchPlugin::CreateInstance);
+    const fs::path file(ts::TempFile(u".tmp.txt"));
+
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"TSProcessorTest::testMetrics";
+    opt.metrics_file = file;
+    opt.ts_buffer_size = ts::TSProcessorArgs::MIN_BUFFER_SIZE;
+    opt.input = {u"null", {u"20000"}};
+    opt.plugins = {
+        {u"testbatch", {}},
+        {u"test1", {u"--count", u"1000"}},
+    };
+    opt.output = {u"drop"};
+
+    ts::TSProcessor tsproc(CERR);
+    TSUNIT_ASSERT(tsproc.start(opt));
+    tsproc.waitForTermination();
+
+    // The metrics file is written one last time after the termination of all plugins.
+    ts::UStringVector lines;
+    TSUNIT_ASSERT(ts::UString::Load(lines, file));
+    fs::remove(file, &ts::ErrCodeReport());
+    debug() << "TSProcessorTest::Metrics:" << std::endl << ts::UString::Join(lines, u"\n") << std::endl;
+
+    const auto contains = [&lines](const ts::UString& line) { return std::find(lines.begin(), lines.end(), line) != lines.end(); };
+    TSUNIT_ASSERT(!lines.empty());
+    TSUNIT_EQUAL(u"# EOF", lines.back());
+    TSUNIT_ASSERT(contains(u"tsp_buffer_packets 100"));
+    TSUNIT_ASSERT(contains(u"# TYPE tsp_plugin_packets counter"));
+    TSUNIT_ASSERT(contains(u"tsp_plugin_packets_total{index=\"0\",type=\"input\",name=\"null\",restart=\"0\"} 20000"));
+    TSUNIT_ASSERT(contains(u"tsp_plugin_packets_total{index=\"1\",type=\"processor\",name=\"testbatch\",restart=\"0\"} 20000"));
+    TSUNIT_ASSERT(contains(u"tsp_plugin_packets_total{index=\"2\",type=\"processor\",name=\"test1\",restart=\"0\"} 10000"));
+    TSUNIT_ASSERT(contains(u"tsp_plugin_packets_total{index=\"3\",type=\"output\",name=\"drop\",restart=\"0\"} 10000"));
+    TSUNIT_ASSERT(contains(u"tsp_plugin_thread_packets_total{index=\"3\",type=\"output\",name=\"drop\",restart=\"0\"} 20000"));
+    TSUNIT_ASSERT(contains(u"# TYPE tsp_plugin_busy_seconds counter"));
+    TSUNIT_ASSERT(contains(u"# UNIT tsp_plugin_busy_seconds seconds"));
+    TSUNIT_ASSERT(contains(u"# TYPE tsp_plugin_wait_seconds counter"));
+    TSUNIT_ASSERT(contains(u"# TYPE tsp_plugin_cpu_seconds counter"));
+    TSUNIT_ASSERT(contains(u"# TYPE tsp_plugin_buffer_packets gauge"));
+}
+
+TSUNIT_DEFINE_TEST(AdaptiveBatch)
+{
+    ts::PluginRepository::Instance().registerProcessor(u"test1", TestPlugin::CreateInstance);
+    ts::PluginRepository::Instance().registerProcessor(u"testpace", TestPacePlugin::CreateInstance);
+
+    // A slow plugin at the end of the chain fills the buffer: the latency is far above the target.
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"TSProcessorTest::testAdaptiveBatch";
+    opt.adaptive_batch = true;
+    opt.target_latency = cn::milliseconds(10);
+    opt.ts_buffer_size = 1'000'000;
+    opt.input = {u"null", {u"20000"}};
+    opt.plugins = {
+        {u"test1", {u"--count", u"1000"}},
+        {u"testpace", {}},
+    };
+    opt.output = {u"drop"};
+
+    ts::ReportBuffer<ts::ThreadSafety::Full> log(ts::Severity::Verbose);
+    ts::TSProcessor tsproc(log);
+    TestEventHandler handler;
+    ts::TSProcessor::Criteria crit;
+    crit.event_code = TestPlugin::EVENT_STOP;
+    tsproc.registerEventHandler(&handler, crit);
+
+    TSUNIT_ASSERT(tsproc.start(opt));
+    tsproc.waitForTermination();
+    debug() << "TSProcessorTest::AdaptiveBatch:" << std::endl << log.messages() << std::endl;
+
+    // All packets went through the chain, the batch size was reduced.
+    TSUNIT_EQUAL(1, handler.logs.size());
+    TSUNIT_EQUAL(20000, handler.logs[0].packets);
+    TSUNIT_ASSERT(log.messages().contains(u"adaptive batch: latency above target, batch size: "));
+}
+
+TSUNIT_DEFINE_TEST(LowLatencyBenchmark)
+{
+    ts::PluginRepository::Instance().registerInput(u"testlatency", TestLatencyInput::CreateInstance);
+    ts::PluginRepository::Instance().registerOutput(u"testlatency", TestLatencyOutput::CreateInstance);
+    ts::PluginRepository::Instance().registerProcessor(u"test1", TestPlugin::CreateInstance);
+
+    // Compare the per-packet latency from input time stamp to output send(), in default and low-latency modes.
+    for (bool low_latency : {false, true}) {
+        utest::TSUnitBenchmark bench(u"TSUNIT_TSP_LATENCY_ITERATIONS");
+        LatencyStats stats;
+        bench.start();
+        for (size_t iter = 0; iter < bench.iterations; ++iter) {
+            ts::TSProcessorArgs opt;
+            opt.app_name = u"TSProcessorTest::testLowLatencyBenchmark";
+            opt.low_latency = low_latency;
+            opt.realtime = ts::Tristate::True;
+            opt.input = {u"testlatency"};
+            opt.plugins = {
+                {u"test1", {}},
+            };
+            opt.output = {u"testlatency"};
+
+            latency_stats = LatencyStats();
+            ts::TSProcessor tsproc(CERR);
+            TSUNIT_ASSERT(tsproc.start(opt));
+            tsproc.waitForTermination();
+
+            TSUNIT_EQUAL(TestLatencyInput::PACKETS, latency_stats.count);
+            stats.count += latency_stats.count;
+            stats.total += latency_stats.total;
+            stats.max = std::max(stats.max, latency_stats.max);
+        }
+        bench.stop();
+
+        const ts::UString name(low_latency ? u"TSProcessorTest::LowLatencyBenchmark (low latency)" : u"TSProcessorTest::LowLatencyBenchmark (default)");
+        debug() << name << ": " << stats.count << " packets, average latency: "
+                << cn::duration_cast<cn::microseconds>(stats.total / int64_t(std::max<size_t>(1, stats.count))).count() << " us, max: "
+                << cn::duration_cast<cn::microseconds>(stats.max).count() << " us" << std::endl;
+        bench.report(name);
+    }
+}
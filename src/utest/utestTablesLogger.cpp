@@ -0,0 +1,80 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2025, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::TablesLogger
+//
+//----------------------------------------------------------------------------
+
+#include "tsTablesLogger.h"
+#include "tsTablesDisplay.h"
+#include "tsOneShotPacketizer.h"
+#include "tsDuckContext.h"
+#include "tsReportBuffer.h"
+#include "tsArgs.h"
+#include "tsPAT.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TablesLoggerTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Threads);
+};
+
+TSUNIT_REGISTER(TablesLoggerTest);
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+// Tables which are formatted by worker threads are logged in order.
+TSUNIT_DEFINE_TEST(Threads)
+{
+    constexpr size_t table_count = 200;
+
+    // All tables are packetized in one cycle, in order.
+    ts::DuckContext pzer_duck;
+    ts::OneShotPacketizer pzer(pzer_duck, ts::PID_PAT);
+    for (size_t i = 0; i < table_count; ++i) {
+        ts::PAT pat(uint8_t(i % 32), true, uint16_t(i));
+        for (size_t srv = 0; srv < i % 20; ++srv) {
+            pat.pmts[uint16_t(srv + 1)] = ts::PID(0x0100 + srv);
+        }
+        pzer.addTable(pzer_duck, pat);
+    }
+    ts::TSPacketVector packets;
+    pzer.getPackets(packets);
+
+    // Log all tables as XML and JSON one-liners, with the specified number of threads.
+    const auto log = [&packets](const ts::UString& threads) {
+        ts::ReportBuffer<ts::ThreadSafety::Full> rep;
+        ts::DuckContext duck(&rep);
+        ts::TablesDisplay display(duck);
+        ts::TablesLogger logger(display);
+        ts::Args args(u"test", u"", ts::Args::NO_EXIT_ON_ERROR);
+        logger.defineArgs(args);
+        TSUNIT_ASSERT(args.analyze(u"test", {u"--log-xml-line", u"--log-json-line", u"--threads", threads}));
+        TSUNIT_ASSERT(logger.loadArgs(duck, args));
+        TSUNIT_ASSERT(logger.open());
+        for (const auto& pkt : packets) {
+            logger.feedPacket(pkt);
+        }
+        logger.close();
+        return rep.messages();
+    };
+
+    const ts::UString sequential(log(u"1"));
+    const ts::UString parallel(log(u"4"));
+    TSUNIT_EQUAL(2 * table_count, size_t(std::count(sequential.begin(), sequential.end(), u'\n')) + 1);
+    TSUNIT_ASSERT(sequential.contains(u"<PAT ") && sequential.contains(u"version=\"31\""));
+    TSUNIT_EQUAL(sequential, parallel);
+}
@@ -24,9 +24,13 @@ class TimeShiftBufferTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(Minimum);
     TSUNIT_DECLARE_TEST(Memory);
     TSUNIT_DECLARE_TEST(File);
+    TSUNIT_DECLARE_TEST(AsyncMinimum);
+    TSUNIT_DECLARE_TEST(AsyncFile);
+    TSUNIT_DECLARE_TEST(DirectIO);
 
 private:
-    void testCommon(uint8_t total, uint8_t memory);
+    // With a non-zero segment size, use asynchronous I/O.
+    void testCommon(uint8_t total, uint8_t memory, size_t segment = 0, bool direct = false);
 };
 
 TSUNIT_REGISTER(TimeShiftBufferTest);
@@ -36,10 +40,13 @@ TSUNIT_REGISTER(TimeShiftBufferTest);
 // Unitary tests.
 //----------------------------------------------------------------------------
 
-void TimeShiftBufferTest::testCommon(uint8_t total, uint8_t memory)
+void TimeShiftBufferTest::testCommon(uint8_t total, uint8_t memory, size_t segment, bool direct)
 {
     ts::TimeShiftBuffer buf(total);
     TSUNIT_ASSERT(buf.setMemoryPackets(memory));
+    TSUNIT_ASSERT(buf.setAsyncIO(segment > 0));
+    TSUNIT_ASSERT(buf.setSegmentPackets(segment));
+    TSUNIT_ASSERT(buf.setDirectIO(direct));
     TSUNIT_ASSERT(!buf.isOpen());
     TSUNIT_ASSERT(buf.open(CERR));
     TSUNIT_ASSERT(buf.isOpen());
@@ -120,3 +127,21 @@ TSUNIT_DEFINE_TEST(File)
 {
     testCommon(20, 4);
 }
+
+TSUNIT_DEFINE_TEST(AsyncMinimum)
+{
+    // Three segments of one packet.
+    testCommon(3, 2, 16);
+}
+
+TSUNIT_DEFINE_TEST(AsyncFile)
+{
+    // Six segments of 3 packets and a last segment of 2 packets.
+    testCommon(20, 4, 3);
+}
+
+TSUNIT_DEFINE_TEST(DirectIO)
+{
+    // Four segments of 5 packets and a last segment of 1 packet.
+    testCommon(21, 4, 5, true);
+}
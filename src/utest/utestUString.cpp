@@ -243,6 +243,25 @@ TSUNIT_DEFINE_TEST(UTF)
     TSUNIT_EQUAL(s1, s2);
     TSUNIT_EQUAL(s1, s3);
     TSUNIT_EQUAL(s1, s4);
+
+    // Conversions to UTF-8: new string, appended to an existing string, on a text stream.
+    const std::string utf8(reinterpret_cast<const char*>(utf8_bytes), utf8_count);
+    TSUNIT_ASSERT(s1.toUTF8() == utf8);
+
+    std::string str8("abc");
+    s1.appendUTF8(str8);
+    TSUNIT_ASSERT(str8 == "abc" + utf8);
+
+    // Larger than the internal buffer of the output operator.
+    ts::UString large;
+    std::string large8;
+    for (int i = 0; i < 20; ++i) {
+        large.append(s1);
+        large8.append(utf8);
+    }
+    std::stringstream strm;
+    strm << large << std::setw(5) << u"ab" << ts::UString(u"cd");
+    TSUNIT_ASSERT(strm.str() == large8 + "   abcd");
 }
 
 TSUNIT_DEFINE_TEST(Diacritical)